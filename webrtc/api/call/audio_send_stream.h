@@ -15,6 +15,9 @@
 #include <string>
 #include <vector>
 
+#include "webrtc/base/array_view.h"
+#include "webrtc/base/optional.h"
+#include "webrtc/common_types.h"
 #include "webrtc/config.h"
 #include "webrtc/modules/audio_coding/codecs/audio_encoder.h"
 #include "webrtc/transport.h"
@@ -52,6 +55,23 @@ class AudioSendStream {
     bool typing_noise_detected = false;
   };
 
+  // An already encoded audio frame, to be sent as is.
+  struct EncodedFrame {
+    // Must be a payload type registered for sending, i.e., that of the send
+    // codec or of comfort noise.
+    int payload_type = -1;
+    // kAudioFrameSpeech, or kAudioFrameCN for comfort noise and for the
+    // frames an encoder sends in DTX mode.
+    FrameType frame_type = kAudioFrameSpeech;
+    // The RTP timestamps of the sent packets follow the timestamps of the
+    // frames, with a fixed offset.
+    uint32_t rtp_timestamp = 0;
+    // Audio level, in -dBov (0 to 127), for the RFC 6464 header extension.
+    // If not set, the extension is left out of the packet.
+    rtc::Optional<uint8_t> audio_level_dbov;
+    rtc::ArrayView<const uint8_t> payload;
+  };
+
   struct Config {
     Config() = delete;
     explicit Config(Transport* send_transport);
@@ -97,6 +117,11 @@ class AudioSendStream {
     // string.
     rtc::Optional<std::string> audio_network_adaptor_config;
 
+    // If set, the captured audio is not encoded and sent. Instead, the stream
+    // sends the already encoded frames passed to SendEncodedFrame(), e.g., to
+    // forward the audio of another participant without transcoding.
+    bool encoded_audio_passthrough = false;
+
     struct SendCodecSpec {
       SendCodecSpec();
       std::string ToString() const;
@@ -134,6 +159,11 @@ class AudioSendStream {
 
   virtual Stats GetStats() const = 0;
 
+  // Packetizes and sends |frame| without decoding or re-encoding it. Only
+  // allowed if |Config::encoded_audio_passthrough| is set. May be called on any
+  // thread. Returns false if the frame could not be sent.
+  virtual bool SendEncodedFrame(const EncodedFrame& frame) = 0;
+
  protected:
   virtual ~AudioSendStream() {}
 };
@@ -89,6 +89,9 @@ AudioSendStream::AudioSendStream(
   if (!SetupSendCodec()) {
     LOG(LS_ERROR) << "Failed to set up send codec state.";
   }
+  if (config_.encoded_audio_passthrough) {
+    channel_proxy_->SetEncodedAudioPassthrough(true);
+  }
 }
 
 AudioSendStream::~AudioSendStream() {
@@ -233,6 +236,14 @@ webrtc::AudioSendStream::Stats AudioSendStream::GetStats() const {
   return stats;
 }
 
+bool AudioSendStream::SendEncodedFrame(const EncodedFrame& frame) {
+  // May be called on any thread, e.g., the one receiving the forwarded audio.
+  RTC_DCHECK(config_.encoded_audio_passthrough);
+  return channel_proxy_->SendEncodedAudio(frame.frame_type, frame.payload_type,
+                                          frame.rtp_timestamp, frame.payload,
+                                          frame.audio_level_dbov);
+}
+
 void AudioSendStream::SignalNetworkState(NetworkState state) {
   RTC_DCHECK(thread_checker_.CalledOnValidThread());
 }
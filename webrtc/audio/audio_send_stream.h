@@ -47,6 +47,7 @@ class AudioSendStream final : public webrtc::AudioSendStream,
                           int duration_ms) override;
   void SetMuted(bool muted) override;
   webrtc::AudioSendStream::Stats GetStats() const override;
+  bool SendEncodedFrame(const EncodedFrame& frame) override;
 
   void SignalNetworkState(NetworkState state);
   bool DeliverRtcp(const uint8_t* packet, size_t length);
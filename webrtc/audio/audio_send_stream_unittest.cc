@@ -381,5 +381,36 @@ TEST(AudioSendStreamTest, SendCodecCanApplyVad) {
       helper.event_log());
 }
 
+TEST(AudioSendStreamTest, SendEncodedFrameForwardsPayload) {
+  ConfigHelper helper;
+  helper.config().encoded_audio_passthrough = true;
+  EXPECT_CALL(*helper.channel_proxy(), SetEncodedAudioPassthrough(true));
+  internal::AudioSendStream send_stream(
+      helper.config(), helper.audio_state(), helper.worker_queue(),
+      helper.congestion_controller(), helper.bitrate_allocator(),
+      helper.event_log());
+
+  const uint8_t kPayload[] = {1, 2, 3, 4, 5};
+  AudioSendStream::EncodedFrame frame;
+  frame.payload_type = kIsacCodec.pltype;
+  frame.frame_type = kAudioFrameCN;
+  frame.rtp_timestamp = 0x12345678;
+  frame.audio_level_dbov = rtc::Optional<uint8_t>(42);
+  frame.payload = kPayload;
+  EXPECT_CALL(*helper.channel_proxy(),
+              SendEncodedAudio(kAudioFrameCN, kIsacCodec.pltype, 0x12345678u,
+                               _, rtc::Optional<uint8_t>(42)))
+      .WillOnce(testing::Invoke(
+          [&kPayload](FrameType frame_type, int payload_type,
+                      uint32_t rtp_timestamp,
+                      rtc::ArrayView<const uint8_t> payload,
+                      const rtc::Optional<uint8_t>& audio_level_dbov) {
+            EXPECT_EQ(kPayload, payload.data());
+            EXPECT_EQ(sizeof(kPayload), payload.size());
+            return true;
+          }));
+  EXPECT_TRUE(send_stream.SendEncodedFrame(frame));
+}
+
 }  // namespace test
 }  // namespace webrtc
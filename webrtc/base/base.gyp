@@ -70,6 +70,8 @@
         'onetimeevent.h',
         'optional.cc',
         'optional.h',
+        'parallel_task_thread.cc',
+        'parallel_task_thread.h',
         'platform_file.cc',
         'platform_file.h',
         'platform_thread.cc',
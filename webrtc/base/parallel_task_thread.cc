@@ -0,0 +1,51 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/base/parallel_task_thread.h"
+
+#include <utility>
+
+namespace rtc {
+
+ParallelTaskThread::ParallelTaskThread(const char* thread_name,
+                                       ThreadPriority priority)
+    : wake_event_(false, false),
+      done_event_(false, false),
+      thread_(&ParallelTaskThread::Run, this, thread_name) {
+  thread_.Start();
+  thread_.SetPriority(priority);
+}
+
+ParallelTaskThread::~ParallelTaskThread() {
+  stopping_ = true;
+  wake_event_.Set();
+  thread_.Stop();
+}
+
+void ParallelTaskThread::StartTask(std::function<void()> task) {
+  task_ = std::move(task);
+  wake_event_.Set();
+}
+
+void ParallelTaskThread::WaitForTask() {
+  done_event_.Wait(Event::kForever);
+}
+
+bool ParallelTaskThread::Run(void* obj) {
+  ParallelTaskThread* thread = static_cast<ParallelTaskThread*>(obj);
+  thread->wake_event_.Wait(Event::kForever);
+  if (thread->stopping_)
+    return false;
+  thread->task_();
+  thread->done_event_.Set();
+  return true;
+}
+
+}  // namespace rtc
@@ -0,0 +1,52 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_BASE_PARALLEL_TASK_THREAD_H_
+#define WEBRTC_BASE_PARALLEL_TASK_THREAD_H_
+
+#include <functional>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/event.h"
+#include "webrtc/base/platform_thread.h"
+
+namespace rtc {
+
+// A thread that runs one task at a time, started and waited for by its owner.
+// Meant for splitting the work on each frame over a few threads, where the
+// owner starts a task on each thread, does its own share of the work and then
+// waits for the tasks, with no more overhead than signaling two events.
+class ParallelTaskThread {
+ public:
+  ParallelTaskThread(const char* thread_name, ThreadPriority priority);
+  ~ParallelTaskThread();
+
+  // Runs |task| on the thread. Must not be called again before WaitForTask()
+  // has returned; anything |task| refers to must stay valid until then.
+  void StartTask(std::function<void()> task);
+
+  // Waits for the task that was started last to finish.
+  void WaitForTask();
+
+ private:
+  static bool Run(void* obj);
+
+  Event wake_event_;
+  Event done_event_;
+  bool stopping_ = false;
+  std::function<void()> task_;
+  PlatformThread thread_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(ParallelTaskThread);
+};
+
+}  // namespace rtc
+
+#endif  // WEBRTC_BASE_PARALLEL_TASK_THREAD_H_
@@ -0,0 +1,55 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/base/parallel_task_thread.h"
+
+#include <memory>
+#include <vector>
+
+#include "webrtc/test/gtest.h"
+
+namespace rtc {
+
+TEST(ParallelTaskThreadTest, StopsWithoutTask) {
+  ParallelTaskThread thread("ParallelTaskThreadTest", kNormalPriority);
+}
+
+TEST(ParallelTaskThreadTest, RunsTasksOnOwnThreads) {
+  const size_t kNumThreads = 3;
+  const int kNumRounds = 100;
+  std::vector<std::unique_ptr<ParallelTaskThread>> threads;
+  for (size_t i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back(
+        new ParallelTaskThread("ParallelTaskThreadTest", kNormalPriority));
+  }
+
+  const PlatformThreadRef caller = CurrentThreadRef();
+  std::vector<int> sums(kNumThreads, 0);
+  std::vector<bool> on_caller_thread(kNumThreads, false);
+  for (int round = 1; round <= kNumRounds; ++round) {
+    for (size_t i = 0; i < kNumThreads; ++i) {
+      int* sum = &sums[i];
+      threads[i]->StartTask([&on_caller_thread, caller, round, sum, i] {
+        *sum += round;
+        if (IsThreadRefEqual(CurrentThreadRef(), caller))
+          on_caller_thread[i] = true;
+      });
+    }
+    for (size_t i = 0; i < kNumThreads; ++i)
+      threads[i]->WaitForTask();
+  }
+
+  for (size_t i = 0; i < kNumThreads; ++i) {
+    EXPECT_EQ(kNumRounds * (kNumRounds + 1) / 2, sums[i]);
+    EXPECT_FALSE(on_caller_thread[i]);
+  }
+}
+
+}  // namespace rtc
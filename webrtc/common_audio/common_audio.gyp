@@ -200,6 +200,12 @@
           'sources': [
             'fir_filter_sse.cc',
             'resampler/sinc_resampler_sse.cc',
+            'signal_processing/cross_correlation_sse2.c',
+            'signal_processing/downsample_fast_sse2.c',
+            'signal_processing/min_max_operations_sse2.c',
+            'signal_processing/vector_scaling_operations_sse2.c',
+            'vad/vad_filterbank_sse2.c',
+            'vad/vad_gmm_sse2.c',
           ],
           'conditions': [
             ['os_posix==1', {
@@ -14,6 +14,19 @@ int32_t WebRtcSpl_DotProductWithScale(const int16_t* vector1,
                                       const int16_t* vector2,
                                       size_t length,
                                       int scaling) {
+#if defined(WEBRTC_ARCH_X86_FAMILY) &&            \
+    (defined(__SSE2__) || defined(_M_X64) ||      \
+     (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+  return WebRtcSpl_DotProductWithScaleSSE2(vector1, vector2, length, scaling);
+#else
+  return WebRtcSpl_DotProductWithScaleC(vector1, vector2, length, scaling);
+#endif
+}
+
+int32_t WebRtcSpl_DotProductWithScaleC(const int16_t* vector1,
+                                       const int16_t* vector2,
+                                       size_t length,
+                                       int scaling) {
   int32_t sum = 0;
   size_t i = 0;
 
@@ -11,7 +11,10 @@
 #include <algorithm>
 #include <sstream>
 
+#include "webrtc/base/random.h"
+#include "webrtc/base/timeutils.h"
 #include "webrtc/common_audio/signal_processing/include/signal_processing_library.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
 #include "webrtc/test/gtest.h"
 
 static const size_t kVector16Size = 9;
@@ -475,10 +478,10 @@ TEST_F(SplTest, CrossCorrelationTest) {
   const int32_t kExpected[kCrossCorrelationDimension] =
       {-266947903, -15579555, -171282001};
   const int32_t* expected = kExpected;
-#if !defined(MIPS32_LE)
+#if defined(WEBRTC_HAS_NEON)
   const int32_t kExpectedNeon[kCrossCorrelationDimension] =
       {-266947901, -15579553, -171281999};
-  if (WebRtcSpl_CrossCorrelation != WebRtcSpl_CrossCorrelationC) {
+  if (WebRtcSpl_CrossCorrelation == WebRtcSpl_CrossCorrelationNeon) {
     expected = kExpectedNeon;
   }
 #endif
@@ -605,3 +608,190 @@ TEST_F(SplTest, Resample48WithSaturationTest) {
     EXPECT_EQ(kRefValue16kHz2, out_vector_w16[i]);
   }
 }
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+namespace {
+
+const size_t kSse2TestLength = 480;
+const size_t kSse2CoefficientsLength = 23;
+
+void FillRandomW16(webrtc::Random* random, int16_t* vector, size_t length) {
+  for (size_t i = 0; i < length; ++i) {
+    vector[i] = random->Rand<int16_t>();
+  }
+}
+
+}  // namespace
+
+// The SSE2 versions must be bit-exact with the generic C versions. Use lengths
+// that are not multiples of the vector width to also cover the scalar tails.
+TEST_F(SplTest, Sse2BitExactTest) {
+  if (!WebRtc_GetCPUInfo(kSSE2)) {
+    return;
+  }
+  webrtc::Random random(42);
+  int16_t in1[kSse2TestLength];
+  int16_t in2[kSse2TestLength];
+  int32_t in32[kSse2TestLength];
+  int16_t coefficients[kSse2CoefficientsLength];
+  int16_t out_c[kSse2TestLength];
+  int16_t out_sse2[kSse2TestLength];
+  int32_t out32_c[kSse2TestLength];
+  int32_t out32_sse2[kSse2TestLength];
+
+  for (int trial = 0; trial < 50; ++trial) {
+    FillRandomW16(&random, in1, kSse2TestLength);
+    FillRandomW16(&random, in2, kSse2TestLength);
+    FillRandomW16(&random, coefficients, kSse2CoefficientsLength);
+    for (size_t i = 0; i < kSse2TestLength; ++i) {
+      // abs(WEBRTC_SPL_WORD32_MIN) is undefined in the C version.
+      in32[i] = std::max(random.Rand<int32_t>(), WEBRTC_SPL_WORD32_MIN + 1);
+    }
+    in1[random.Rand(kSse2TestLength - 1)] = WEBRTC_SPL_WORD16_MIN;
+    in1[random.Rand(kSse2TestLength - 1)] = WEBRTC_SPL_WORD16_MAX;
+    const size_t length =
+        random.Rand(1u, static_cast<uint32_t>(kSse2TestLength));
+
+    EXPECT_EQ(WebRtcSpl_MaxAbsValueW16C(in1, length),
+              WebRtcSpl_MaxAbsValueW16SSE2(in1, length));
+    EXPECT_EQ(WebRtcSpl_MaxAbsValueW32C(in32, length),
+              WebRtcSpl_MaxAbsValueW32SSE2(in32, length));
+    EXPECT_EQ(WebRtcSpl_MaxValueW16C(in1, length),
+              WebRtcSpl_MaxValueW16SSE2(in1, length));
+    EXPECT_EQ(WebRtcSpl_MaxValueW32C(in32, length),
+              WebRtcSpl_MaxValueW32SSE2(in32, length));
+    EXPECT_EQ(WebRtcSpl_MinValueW16C(in1, length),
+              WebRtcSpl_MinValueW16SSE2(in1, length));
+    EXPECT_EQ(WebRtcSpl_MinValueW32C(in32, length),
+              WebRtcSpl_MinValueW32SSE2(in32, length));
+
+    // Dot product and cross-correlation, with and without per-product shifts.
+    for (int shift = 0; shift < 3; ++shift) {
+      EXPECT_EQ(WebRtcSpl_DotProductWithScaleC(in1, in2, length, shift),
+                WebRtcSpl_DotProductWithScaleSSE2(in1, in2, length, shift));
+    }
+    const size_t kDimSeq = 67;
+    const size_t kDimCrossCorrelation = 40;
+    for (int shift = 0; shift < 3; ++shift) {
+      WebRtcSpl_CrossCorrelationC(out32_c, in1, &in2[kDimCrossCorrelation],
+                                  kDimSeq, kDimCrossCorrelation, shift, -1);
+      WebRtcSpl_CrossCorrelationSSE2(out32_sse2, in1,
+                                     &in2[kDimCrossCorrelation], kDimSeq,
+                                     kDimCrossCorrelation, shift, -1);
+      for (size_t i = 0; i < kDimCrossCorrelation; ++i) {
+        EXPECT_EQ(out32_c[i], out32_sse2[i]);
+      }
+    }
+
+    const int16_t scale1 = random.Rand<int16_t>();
+    const int16_t scale2 = random.Rand<int16_t>();
+    EXPECT_EQ(0, WebRtcSpl_ScaleAndAddVectorsWithRoundC(
+                     in1, scale1, in2, scale2, 15, out_c, length));
+    EXPECT_EQ(0, WebRtcSpl_ScaleAndAddVectorsWithRoundSSE2(
+                     in1, scale1, in2, scale2, 15, out_sse2, length));
+    for (size_t i = 0; i < length; ++i) {
+      EXPECT_EQ(out_c[i], out_sse2[i]);
+    }
+
+    // Keep the Q12 filter output mostly in range to also exercise the
+    // non-saturated path.
+    for (size_t i = 0; i < kSse2CoefficientsLength; ++i) {
+      coefficients[i] >>= 4;
+    }
+    for (int factor = 1; factor <= 4; ++factor) {
+      const size_t delay = kSse2CoefficientsLength - 1;
+      const size_t out_length =
+          (kSse2TestLength - kSse2CoefficientsLength) / factor;
+      EXPECT_EQ(0, WebRtcSpl_DownsampleFastC(
+                       in1, kSse2TestLength, out_c, out_length, coefficients,
+                       kSse2CoefficientsLength, factor, delay));
+      EXPECT_EQ(0, WebRtcSpl_DownsampleFastSSE2(
+                       in1, kSse2TestLength, out_sse2, out_length,
+                       coefficients, kSse2CoefficientsLength, factor, delay));
+      for (size_t i = 0; i < out_length; ++i) {
+        EXPECT_EQ(out_c[i], out_sse2[i]);
+      }
+    }
+  }
+}
+
+// Microbenchmark of the SSE2 kernels against the generic C versions. Make sure
+// to build in release mode so that RTC_DCHECKs are compiled out.
+TEST_F(SplTest, DISABLED_Sse2Benchmark) {
+  ASSERT_TRUE(WebRtc_GetCPUInfo(kSSE2));
+  const int kIterations = 100000;
+  webrtc::Random random(42);
+  int16_t in1[kSse2TestLength];
+  int16_t in2[kSse2TestLength];
+  int32_t in32[kSse2TestLength];
+  int16_t coefficients[kSse2CoefficientsLength];
+  int16_t out16[kSse2TestLength];
+  int32_t out32[kSse2TestLength];
+  FillRandomW16(&random, in1, kSse2TestLength);
+  FillRandomW16(&random, in2, kSse2TestLength);
+  FillRandomW16(&random, coefficients, kSse2CoefficientsLength);
+  for (size_t i = 0; i < kSse2TestLength; ++i) {
+    in32[i] = random.Rand<int32_t>();
+  }
+  // Accumulate the results so that the calls are not optimized away.
+  int32_t sink = 0;
+
+#define BENCHMARK_SPL_KERNEL(name, call_c, call_sse2)                       \
+  {                                                                         \
+    int64_t start = rtc::TimeNanos();                                       \
+    for (int i = 0; i < kIterations; ++i) {                                 \
+      sink += call_c;                                                       \
+    }                                                                       \
+    const double time_c_us =                                                \
+        (rtc::TimeNanos() - start) / rtc::kNumNanosecsPerMicrosec;          \
+    start = rtc::TimeNanos();                                               \
+    for (int i = 0; i < kIterations; ++i) {                                 \
+      sink += call_sse2;                                                    \
+    }                                                                       \
+    const double time_sse2_us =                                             \
+        (rtc::TimeNanos() - start) / rtc::kNumNanosecsPerMicrosec;          \
+    printf("%-32s C: %8.2fms SSE2: %8.2fms (%.2fx)\n", name,               \
+           time_c_us / 1000, time_sse2_us / 1000, time_c_us / time_sse2_us); \
+  }
+
+  BENCHMARK_SPL_KERNEL(
+      "MaxAbsValueW16", WebRtcSpl_MaxAbsValueW16C(in1, kSse2TestLength),
+      WebRtcSpl_MaxAbsValueW16SSE2(in1, kSse2TestLength));
+  BENCHMARK_SPL_KERNEL(
+      "MaxAbsValueW32", WebRtcSpl_MaxAbsValueW32C(in32, kSse2TestLength),
+      WebRtcSpl_MaxAbsValueW32SSE2(in32, kSse2TestLength));
+  BENCHMARK_SPL_KERNEL("MaxValueW16",
+                       WebRtcSpl_MaxValueW16C(in1, kSse2TestLength),
+                       WebRtcSpl_MaxValueW16SSE2(in1, kSse2TestLength));
+  BENCHMARK_SPL_KERNEL("MinValueW32",
+                       WebRtcSpl_MinValueW32C(in32, kSse2TestLength),
+                       WebRtcSpl_MinValueW32SSE2(in32, kSse2TestLength));
+  BENCHMARK_SPL_KERNEL(
+      "DotProductWithScale",
+      WebRtcSpl_DotProductWithScaleC(in1, in2, kSse2TestLength, 2),
+      WebRtcSpl_DotProductWithScaleSSE2(in1, in2, kSse2TestLength, 2));
+  BENCHMARK_SPL_KERNEL(
+      "CrossCorrelation",
+      (WebRtcSpl_CrossCorrelationC(out32, in1, &in2[40], 160, 40, 2, -1),
+       out32[0]),
+      (WebRtcSpl_CrossCorrelationSSE2(out32, in1, &in2[40], 160, 40, 2, -1),
+       out32[0]));
+  BENCHMARK_SPL_KERNEL(
+      "ScaleAndAddVectorsWithRound",
+      WebRtcSpl_ScaleAndAddVectorsWithRoundC(in1, 1000, in2, -2000, 14, out16,
+                                             kSse2TestLength),
+      WebRtcSpl_ScaleAndAddVectorsWithRoundSSE2(in1, 1000, in2, -2000, 14,
+                                                out16, kSse2TestLength));
+  BENCHMARK_SPL_KERNEL(
+      "DownsampleFast",
+      WebRtcSpl_DownsampleFastC(in1, kSse2TestLength, out16, 200, coefficients,
+                                kSse2CoefficientsLength, 2,
+                                kSse2CoefficientsLength - 1),
+      WebRtcSpl_DownsampleFastSSE2(in1, kSse2TestLength, out16, 200,
+                                   coefficients, kSse2CoefficientsLength, 2,
+                                   kSse2CoefficientsLength - 1));
+#undef BENCHMARK_SPL_KERNEL
+
+  printf("(Ignore: %d)\n", sink);
+}
+#endif  // defined(WEBRTC_ARCH_X86_FAMILY)
@@ -15,6 +15,7 @@
 #include "webrtc/common_audio/vad/vad_filterbank.h"
 #include "webrtc/common_audio/vad/vad_gmm.h"
 #include "webrtc/common_audio/vad/vad_sp.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
 #include "webrtc/typedefs.h"
 
 // Spectrum Weighting
@@ -146,6 +147,9 @@ static int16_t GmmProbability(VadInstT* self, int16_t* features,
   int16_t delt, ndelt;
   int16_t maxspe, maxmu;
   int16_t deltaN[kTableSize], deltaS[kTableSize];
+  int16_t gaussian_inputs[kTableSize];
+  int32_t noise_gaussian_probabilities[kTableSize];
+  int32_t speech_gaussian_probabilities[kTableSize];
   int16_t ngprvec[kTableSize] = { 0 };  // Conditional probability = 0.
   int16_t sgprvec[kTableSize] = { 0 };  // Conditional probability = 0.
   int32_t h0_test, h1_test;
@@ -185,6 +189,20 @@ static int16_t GmmProbability(VadInstT* self, int16_t* features,
     //
     // We combine a global LRT with local tests, for each frequency sub-band,
     // here defined as |channel|.
+    //
+    // All Gaussians are evaluated at once, which lets SIMD versions of the
+    // kernel work on all of them in parallel.
+    for (channel = 0; channel < kNumChannels; channel++) {
+      for (k = 0; k < kNumGaussians; k++) {
+        gaussian_inputs[channel + k * kNumChannels] = features[channel];
+      }
+    }
+    self->gaussian_probabilities(gaussian_inputs, self->noise_means,
+                                 self->noise_stds, kTableSize,
+                                 noise_gaussian_probabilities, deltaN);
+    self->gaussian_probabilities(gaussian_inputs, self->speech_means,
+                                 self->speech_stds, kTableSize,
+                                 speech_gaussian_probabilities, deltaS);
     for (channel = 0; channel < kNumChannels; channel++) {
       // For each channel we model the probability with a GMM consisting of
       // |kNumGaussians|, with different means and standard deviations depending
@@ -195,19 +213,13 @@ static int16_t GmmProbability(VadInstT* self, int16_t* features,
         gaussian = channel + k * kNumChannels;
         // Probability under H0, that is, probability of frame being noise.
         // Value given in Q27 = Q7 * Q20.
-        tmp1_s32 = WebRtcVad_GaussianProbability(features[channel],
-                                                 self->noise_means[gaussian],
-                                                 self->noise_stds[gaussian],
-                                                 &deltaN[gaussian]);
+        tmp1_s32 = noise_gaussian_probabilities[gaussian];
         noise_probability[k] = kNoiseDataWeights[gaussian] * tmp1_s32;
         h0_test += noise_probability[k];  // Q27
 
         // Probability under H1, that is, probability of frame being speech.
         // Value given in Q27 = Q7 * Q20.
-        tmp1_s32 = WebRtcVad_GaussianProbability(features[channel],
-                                                 self->speech_means[gaussian],
-                                                 self->speech_stds[gaussian],
-                                                 &deltaS[gaussian]);
+        tmp1_s32 = speech_gaussian_probabilities[gaussian];
         speech_probability[k] = kSpeechDataWeights[gaussian] * tmp1_s32;
         h1_test += speech_probability[k];  // Q27
       }
@@ -535,6 +547,18 @@ int WebRtcVad_InitCore(VadInstT* self) {
     self->mean_value[i] = 1600;
   }
 
+  // Select the kernels for the CPU.
+  self->split_bands = WebRtcVad_SplitBandsC;
+  self->energy = WebRtcSpl_Energy;
+  self->gaussian_probabilities = WebRtcVad_GaussianProbabilitiesC;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2)) {
+    self->split_bands = WebRtcVad_SplitBandsSSE2;
+    self->energy = WebRtcVad_EnergySSE2;
+    self->gaussian_probabilities = WebRtcVad_GaussianProbabilitiesSSE2;
+  }
+#endif
+
   // Set aggressiveness mode to default (=|kDefaultMode|).
   if (WebRtcVad_set_mode_core(self, kDefaultMode) != 0) {
     return -1;
@@ -24,6 +24,18 @@ enum { kNumGaussians = 2 };  // Number of Gaussians per channel in the GMM.
 enum { kTableSize = kNumChannels * kNumGaussians };
 enum { kMinEnergy = 10 };  // Minimum energy required to trigger audio signal.
 
+// Kernels of the feature extraction and the GMM, see vad_filterbank.h and
+// vad_gmm.h. WebRtcVad_InitCore() selects the fastest versions for the CPU.
+typedef void (*VadSplitBands)(int16_t* hp_data, int16_t* lp_data,
+                              size_t length);
+typedef int32_t (*VadEnergy)(int16_t* data, size_t length, int* scale_factor);
+typedef void (*VadGaussianProbabilities)(const int16_t* inputs,
+                                         const int16_t* means,
+                                         const int16_t* stds,
+                                         size_t length,
+                                         int32_t* probabilities,
+                                         int16_t* deltas);
+
 typedef struct VadInstT_
 {
 
@@ -51,6 +63,10 @@ typedef struct VadInstT_
     int16_t individual[3];
     int16_t total[3];
 
+    VadSplitBands split_bands;
+    VadEnergy energy;
+    VadGaussianProbabilities gaussian_probabilities;
+
     int init_flag;
 
 } VadInstT;
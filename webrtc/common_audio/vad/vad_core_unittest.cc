@@ -8,14 +8,24 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <math.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
+#include <vector>
+
+#include "webrtc/base/random.h"
+#include "webrtc/base/timeutils.h"
 #include "webrtc/common_audio/vad/vad_unittest.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
 #include "webrtc/test/gtest.h"
 #include "webrtc/typedefs.h"
 
 extern "C" {
 #include "webrtc/common_audio/vad/vad_core.h"
+#include "webrtc/common_audio/vad/vad_filterbank.h"
+#include "webrtc/common_audio/vad/vad_gmm.h"
 }
 
 namespace {
@@ -102,4 +112,106 @@ TEST_F(VadTest, CalcVad) {
 
   free(self);
 }
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void UseCKernels(VadInstT* self) {
+  self->split_bands = WebRtcVad_SplitBandsC;
+  self->energy = WebRtcSpl_Energy;
+  self->gaussian_probabilities = WebRtcVad_GaussianProbabilitiesC;
+}
+
+// Fills |frame| with a noisy tone whose level changes every second, so that
+// the VAD decisions and model updates switch between speech and noise.
+void FillTestFrame(webrtc::Random* random, size_t frame_index, int16_t* frame,
+                   size_t length) {
+  const double level = (frame_index / 100) % 2 ? 8000.0 : 200.0;
+  for (size_t i = 0; i < length; ++i) {
+    const size_t n = frame_index * length + i;
+    frame[i] = static_cast<int16_t>(level * sin(0.07 * n) +
+                                    random->Gaussian(0, 100));
+  }
+}
+
+TEST_F(VadTest, CalcVadSse2BitExact) {
+  if (!WebRtc_GetCPUInfo(kSSE2)) {
+    return;
+  }
+  const size_t kNumFrames = 500;
+  VadInstT* self_c = reinterpret_cast<VadInstT*>(malloc(sizeof(VadInstT)));
+  VadInstT* self_sse2 = reinterpret_cast<VadInstT*>(malloc(sizeof(VadInstT)));
+  webrtc::Random random(42);
+  int16_t speech[kMaxFrameLength];
+
+  for (size_t m = 0; m < kModesSize; ++m) {
+    for (size_t j = 0; j < kFrameLengthsSize; ++j) {
+      if (!ValidRatesAndFrameLengths(16000, kFrameLengths[j])) {
+        continue;
+      }
+      ASSERT_EQ(0, WebRtcVad_InitCore(self_c));
+      ASSERT_EQ(0, WebRtcVad_InitCore(self_sse2));
+      ASSERT_EQ(WebRtcVad_EnergySSE2, self_sse2->energy);
+      UseCKernels(self_c);
+      ASSERT_EQ(0, WebRtcVad_set_mode_core(self_c, kModes[m]));
+      ASSERT_EQ(0, WebRtcVad_set_mode_core(self_sse2, kModes[m]));
+      for (size_t frame = 0; frame < kNumFrames; ++frame) {
+        FillTestFrame(&random, frame, speech, kFrameLengths[j]);
+        ASSERT_EQ(WebRtcVad_CalcVad16khz(self_c, speech, kFrameLengths[j]),
+                  WebRtcVad_CalcVad16khz(self_sse2, speech, kFrameLengths[j]));
+        ASSERT_EQ(0, memcmp(self_c->noise_means, self_sse2->noise_means,
+                            sizeof(self_c->noise_means)));
+        ASSERT_EQ(0, memcmp(self_c->speech_means, self_sse2->speech_means,
+                            sizeof(self_c->speech_means)));
+        ASSERT_EQ(0, memcmp(self_c->noise_stds, self_sse2->noise_stds,
+                            sizeof(self_c->noise_stds)));
+        ASSERT_EQ(0, memcmp(self_c->speech_stds, self_sse2->speech_stds,
+                            sizeof(self_c->speech_stds)));
+      }
+    }
+  }
+
+  free(self_c);
+  free(self_sse2);
+}
+
+// Runs the VAD on many 16 kHz streams, as on a server that runs it on every
+// incoming and outgoing stream, with the C and the SSE2 kernels. Make sure to
+// build in release mode so that RTC_DCHECKs are compiled out.
+TEST_F(VadTest, DISABLED_MultiStreamBenchmark) {
+  ASSERT_TRUE(WebRtc_GetCPUInfo(kSSE2));
+  const size_t kNumStreams = 100;
+  const size_t kNumFrames = 1000;  // 10 seconds of 10 ms frames.
+  const size_t kFrameLength = 160;
+  webrtc::Random random(42);
+  std::vector<int16_t> audio(kNumFrames * kFrameLength);
+  for (size_t frame = 0; frame < kNumFrames; ++frame) {
+    FillTestFrame(&random, frame, &audio[frame * kFrameLength], kFrameLength);
+  }
+  std::vector<VadInstT> streams(kNumStreams);
+  // Accumulate the decisions so that the calls are not optimized away.
+  int sink = 0;
+
+  for (int use_sse2 = 0; use_sse2 <= 1; ++use_sse2) {
+    for (VadInstT& stream : streams) {
+      ASSERT_EQ(0, WebRtcVad_InitCore(&stream));
+      if (!use_sse2) {
+        UseCKernels(&stream);
+      }
+    }
+    const int64_t start = rtc::TimeNanos();
+    for (size_t frame = 0; frame < kNumFrames; ++frame) {
+      for (VadInstT& stream : streams) {
+        sink += WebRtcVad_CalcVad16khz(&stream, &audio[frame * kFrameLength],
+                                       kFrameLength);
+      }
+    }
+    const double time_ms = static_cast<double>(rtc::TimeNanos() - start) /
+                           rtc::kNumNanosecsPerMillisec;
+    printf("%s: %zu streams x %zu frames in %.2f ms (%.2f us per frame)\n",
+           use_sse2 ? "SSE2" : "C", kNumStreams, kNumFrames, time_ms,
+           1000 * time_ms / (kNumStreams * kNumFrames));
+  }
+
+  printf("(Ignore: %d)\n", sink);
+}
+#endif  // defined(WEBRTC_ARCH_X86_FAMILY)
 }  // namespace
@@ -116,12 +116,12 @@ static void AllPassFilter(const int16_t* data_in, size_t data_length,
 //                        The length is |data_length| / 2.
 // - lp_data_out  [o]   : Output audio data of the lower half of the spectrum.
 //                        The length is |data_length| / 2.
+// - split_bands  [i]   : Kernel making the bands, see WebRtcVad_SplitBandsC().
 static void SplitFilter(const int16_t* data_in, size_t data_length,
                         int16_t* upper_state, int16_t* lower_state,
-                        int16_t* hp_data_out, int16_t* lp_data_out) {
-  size_t i;
+                        int16_t* hp_data_out, int16_t* lp_data_out,
+                        VadSplitBands split_bands) {
   size_t half_length = data_length >> 1;  // Downsampling by 2.
-  int16_t tmp_out;
 
   // All-pass filtering upper branch.
   AllPassFilter(&data_in[0], half_length, kAllPassCoefsQ15[0], upper_state,
@@ -132,11 +132,7 @@ static void SplitFilter(const int16_t* data_in, size_t data_length,
                 lp_data_out);
 
   // Make LP and HP signals.
-  for (i = 0; i < half_length; i++) {
-    tmp_out = *hp_data_out;
-    *hp_data_out++ -= *lp_data_out;
-    *lp_data_out++ += tmp_out;
-  }
+  split_bands(hp_data_out, lp_data_out, half_length);
 }
 
 // Calculates the energy of |data_in| in dB, and also updates an overall
@@ -149,10 +145,11 @@ static void SplitFilter(const int16_t* data_in, size_t data_length,
 //                        |data_in|.
 //                        NOTE: |total_energy| is only updated if
 //                        |total_energy| <= |kMinEnergy|.
+// - energy_fn    [i]   : Kernel calculating the energy, see WebRtcSpl_Energy().
 // - log_energy   [o]   : 10 * log10("energy of |data_in|") given in Q4.
 static void LogOfEnergy(const int16_t* data_in, size_t data_length,
                         int16_t offset, int16_t* total_energy,
-                        int16_t* log_energy) {
+                        VadEnergy energy_fn, int16_t* log_energy) {
   // |tot_rshifts| accumulates the number of right shifts performed on |energy|.
   int tot_rshifts = 0;
   // The |energy| will be normalized to 15 bits. We use unsigned integer because
@@ -162,8 +159,8 @@ static void LogOfEnergy(const int16_t* data_in, size_t data_length,
   RTC_DCHECK(data_in);
   RTC_DCHECK_GT(data_length, 0);
 
-  energy = (uint32_t) WebRtcSpl_Energy((int16_t*) data_in, data_length,
-                                       &tot_rshifts);
+  energy = (uint32_t) energy_fn((int16_t*) data_in, data_length,
+                                &tot_rshifts);
 
   if (energy != 0) {
     // By construction, normalizing to 15 bits is equivalent with 17 leading
@@ -241,6 +238,17 @@ static void LogOfEnergy(const int16_t* data_in, size_t data_length,
   }
 }
 
+void WebRtcVad_SplitBandsC(int16_t* hp_data, int16_t* lp_data, size_t length) {
+  size_t i;
+  int16_t tmp_out;
+
+  for (i = 0; i < length; i++) {
+    tmp_out = *hp_data;
+    *hp_data++ -= *lp_data;
+    *lp_data++ += tmp_out;
+  }
+}
+
 int16_t WebRtcVad_CalculateFeatures(VadInstT* self, const int16_t* data_in,
                                     size_t data_length, int16_t* features) {
   int16_t total_energy = 0;
@@ -265,7 +273,8 @@ int16_t WebRtcVad_CalculateFeatures(VadInstT* self, const int16_t* data_in,
 
   // Split at 2000 Hz and downsample.
   SplitFilter(in_ptr, data_length, &self->upper_state[frequency_band],
-              &self->lower_state[frequency_band], hp_out_ptr, lp_out_ptr);
+              &self->lower_state[frequency_band], hp_out_ptr, lp_out_ptr,
+              self->split_bands);
 
   // For the upper band (2000 Hz - 4000 Hz) split at 3000 Hz and downsample.
   frequency_band = 1;
@@ -273,15 +282,18 @@ int16_t WebRtcVad_CalculateFeatures(VadInstT* self, const int16_t* data_in,
   hp_out_ptr = hp_60;  // [3000 - 4000] Hz.
   lp_out_ptr = lp_60;  // [2000 - 3000] Hz.
   SplitFilter(in_ptr, length, &self->upper_state[frequency_band],
-              &self->lower_state[frequency_band], hp_out_ptr, lp_out_ptr);
+              &self->lower_state[frequency_band], hp_out_ptr, lp_out_ptr,
+              self->split_bands);
 
   // Energy in 3000 Hz - 4000 Hz.
   length >>= 1;  // |data_length| / 4 <=> bandwidth = 1000 Hz.
 
-  LogOfEnergy(hp_60, length, kOffsetVector[5], &total_energy, &features[5]);
+  LogOfEnergy(hp_60, length, kOffsetVector[5], &total_energy, self->energy,
+              &features[5]);
 
   // Energy in 2000 Hz - 3000 Hz.
-  LogOfEnergy(lp_60, length, kOffsetVector[4], &total_energy, &features[4]);
+  LogOfEnergy(lp_60, length, kOffsetVector[4], &total_energy, self->energy,
+              &features[4]);
 
   // For the lower band (0 Hz - 2000 Hz) split at 1000 Hz and downsample.
   frequency_band = 2;
@@ -290,11 +302,13 @@ int16_t WebRtcVad_CalculateFeatures(VadInstT* self, const int16_t* data_in,
   lp_out_ptr = lp_60;  // [0 - 1000] Hz.
   length = half_data_length;  // |data_length| / 2 <=> bandwidth = 2000 Hz.
   SplitFilter(in_ptr, length, &self->upper_state[frequency_band],
-              &self->lower_state[frequency_band], hp_out_ptr, lp_out_ptr);
+              &self->lower_state[frequency_band], hp_out_ptr, lp_out_ptr,
+              self->split_bands);
 
   // Energy in 1000 Hz - 2000 Hz.
   length >>= 1;  // |data_length| / 4 <=> bandwidth = 1000 Hz.
-  LogOfEnergy(hp_60, length, kOffsetVector[3], &total_energy, &features[3]);
+  LogOfEnergy(hp_60, length, kOffsetVector[3], &total_energy, self->energy,
+              &features[3]);
 
   // For the lower band (0 Hz - 1000 Hz) split at 500 Hz and downsample.
   frequency_band = 3;
@@ -302,11 +316,13 @@ int16_t WebRtcVad_CalculateFeatures(VadInstT* self, const int16_t* data_in,
   hp_out_ptr = hp_120;  // [500 - 1000] Hz.
   lp_out_ptr = lp_120;  // [0 - 500] Hz.
   SplitFilter(in_ptr, length, &self->upper_state[frequency_band],
-              &self->lower_state[frequency_band], hp_out_ptr, lp_out_ptr);
+              &self->lower_state[frequency_band], hp_out_ptr, lp_out_ptr,
+              self->split_bands);
 
   // Energy in 500 Hz - 1000 Hz.
   length >>= 1;  // |data_length| / 8 <=> bandwidth = 500 Hz.
-  LogOfEnergy(hp_120, length, kOffsetVector[2], &total_energy, &features[2]);
+  LogOfEnergy(hp_120, length, kOffsetVector[2], &total_energy, self->energy,
+              &features[2]);
 
   // For the lower band (0 Hz - 500 Hz) split at 250 Hz and downsample.
   frequency_band = 4;
@@ -314,17 +330,20 @@ int16_t WebRtcVad_CalculateFeatures(VadInstT* self, const int16_t* data_in,
   hp_out_ptr = hp_60;  // [250 - 500] Hz.
   lp_out_ptr = lp_60;  // [0 - 250] Hz.
   SplitFilter(in_ptr, length, &self->upper_state[frequency_band],
-              &self->lower_state[frequency_band], hp_out_ptr, lp_out_ptr);
+              &self->lower_state[frequency_band], hp_out_ptr, lp_out_ptr,
+              self->split_bands);
 
   // Energy in 250 Hz - 500 Hz.
   length >>= 1;  // |data_length| / 16 <=> bandwidth = 250 Hz.
-  LogOfEnergy(hp_60, length, kOffsetVector[1], &total_energy, &features[1]);
+  LogOfEnergy(hp_60, length, kOffsetVector[1], &total_energy, self->energy,
+              &features[1]);
 
   // Remove 0 Hz - 80 Hz, by high pass filtering the lower band.
   HighPassFilter(lp_60, length, self->hp_filter_state, hp_120);
 
   // Energy in 80 Hz - 250 Hz.
-  LogOfEnergy(hp_120, length, kOffsetVector[0], &total_energy, &features[0]);
+  LogOfEnergy(hp_120, length, kOffsetVector[0], &total_energy, self->energy,
+              &features[0]);
 
   return total_energy;
 }
@@ -41,4 +41,18 @@
 int16_t WebRtcVad_CalculateFeatures(VadInstT* self, const int16_t* data_in,
                                     size_t data_length, int16_t* features);
 
+// Turns the outputs of the two all-pass filters of a split filter into the
+// upper (high pass) and lower (low pass) band, in place:
+//   |hp_data|[i] = |hp_data|[i] - |lp_data|[i]
+//   |lp_data|[i] = |lp_data|[i] + |hp_data|[i] (the old value)
+// with 16-bit wrap-around, for i = 0, ..., |length| - 1.
+void WebRtcVad_SplitBandsC(int16_t* hp_data, int16_t* lp_data, size_t length);
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void WebRtcVad_SplitBandsSSE2(int16_t* hp_data, int16_t* lp_data,
+                              size_t length);
+// Bit-exact SSE2 version of WebRtcSpl_Energy().
+int32_t WebRtcVad_EnergySSE2(int16_t* data, size_t length, int* scale_factor);
+#endif
+
 #endif  // WEBRTC_COMMON_AUDIO_VAD_VAD_FILTERBANK_H_
@@ -0,0 +1,93 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+
+#include "webrtc/common_audio/signal_processing/include/signal_processing_library.h"
+#include "webrtc/common_audio/vad/vad_filterbank.h"
+
+// The all-pass filters of the split filter are recursive, so only the band
+// splitting after them and the energy of the bands are vectorized.
+
+void WebRtcVad_SplitBandsSSE2(int16_t* hp_data, int16_t* lp_data,
+                              size_t length) {
+  size_t i = 0;
+  size_t length8 = length & ~(size_t)7;
+  int16_t tmp_out;
+
+  for (i = 0; i < length8; i += 8) {
+    __m128i hp = _mm_loadu_si128((const __m128i*)&hp_data[i]);
+    __m128i lp = _mm_loadu_si128((const __m128i*)&lp_data[i]);
+    _mm_storeu_si128((__m128i*)&hp_data[i], _mm_sub_epi16(hp, lp));
+    _mm_storeu_si128((__m128i*)&lp_data[i], _mm_add_epi16(lp, hp));
+  }
+
+  for (; i < length; i++) {
+    tmp_out = hp_data[i];
+    hp_data[i] -= lp_data[i];
+    lp_data[i] += tmp_out;
+  }
+}
+
+int32_t WebRtcVad_EnergySSE2(int16_t* data, size_t length, int* scale_factor) {
+  size_t i = 0;
+  size_t length8 = length & ~(size_t)7;
+  int16_t smax = -1;
+  int16_t sabs;
+  int16_t nbits;
+  int16_t t;
+  int scaling = 0;
+  int32_t energy = 0;
+  int32_t sums[4];
+  __m128i max_abs = _mm_set1_epi16(-1);
+  __m128i sum = _mm_setzero_si128();
+  __m128i shift;
+
+  // Find the largest absolute value as WebRtcSpl_GetScalingSquare() does,
+  // where the absolute value of -32768 wraps around to -32768 and is ignored.
+  for (i = 0; i < length8; i += 8) {
+    __m128i in = _mm_loadu_si128((const __m128i*)&data[i]);
+    __m128i neg = _mm_sub_epi16(_mm_setzero_si128(), in);
+    max_abs = _mm_max_epi16(max_abs, _mm_max_epi16(in, neg));
+  }
+  max_abs = _mm_max_epi16(max_abs, _mm_srli_si128(max_abs, 8));
+  max_abs = _mm_max_epi16(max_abs, _mm_srli_si128(max_abs, 4));
+  max_abs = _mm_max_epi16(max_abs, _mm_srli_si128(max_abs, 2));
+  smax = (int16_t)_mm_extract_epi16(max_abs, 0);
+  for (; i < length; i++) {
+    sabs = (int16_t)(data[i] > 0 ? data[i] : -data[i]);
+    smax = (sabs > smax ? sabs : smax);
+  }
+  if (smax != 0) {
+    nbits = WebRtcSpl_GetSizeInBits((uint32_t)length);
+    t = WebRtcSpl_NormW32(WEBRTC_SPL_MUL(smax, smax));
+    scaling = (t > nbits) ? 0 : nbits - t;
+  }
+
+  // Sum the squares, each shifted by |scaling|, in 32-bit lanes.
+  shift = _mm_cvtsi32_si128(scaling);
+  for (i = 0; i < length8; i += 8) {
+    __m128i in = _mm_loadu_si128((const __m128i*)&data[i]);
+    __m128i lo = _mm_mullo_epi16(in, in);
+    __m128i hi = _mm_mulhi_epi16(in, in);
+    sum = _mm_add_epi32(sum,
+                        _mm_sra_epi32(_mm_unpacklo_epi16(lo, hi), shift));
+    sum = _mm_add_epi32(sum,
+                        _mm_sra_epi32(_mm_unpackhi_epi16(lo, hi), shift));
+  }
+  _mm_storeu_si128((__m128i*)sums, sum);
+  energy = sums[0] + sums[1] + sums[2] + sums[3];
+  for (; i < length; i++) {
+    energy += (data[i] * data[i]) >> scaling;
+  }
+
+  *scale_factor = scaling;
+  return energy;
+}
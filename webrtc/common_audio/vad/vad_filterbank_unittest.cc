@@ -10,7 +10,9 @@
 
 #include <stdlib.h>
 
+#include "webrtc/base/random.h"
 #include "webrtc/common_audio/vad/vad_unittest.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
 #include "webrtc/test/gtest.h"
 #include "webrtc/typedefs.h"
 
@@ -89,4 +91,41 @@ TEST_F(VadTest, vad_filterbank) {
 
   free(self);
 }
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+TEST_F(VadTest, vad_filterbank_sse2) {
+  if (!WebRtc_GetCPUInfo(kSSE2)) {
+    return;
+  }
+  const size_t kLength = 123;
+  webrtc::Random random(42);
+  for (int trial = 0; trial < 100; ++trial) {
+    int16_t hp_c[kLength], lp_c[kLength];
+    int16_t hp_sse2[kLength], lp_sse2[kLength];
+    // Scale the signal down in some trials, for other energy scalings.
+    const int shift = trial % 16;
+    for (size_t i = 0; i < kLength; ++i) {
+      hp_c[i] = hp_sse2[i] = random.Rand<int16_t>() >> shift;
+      lp_c[i] = lp_sse2[i] = random.Rand<int16_t>() >> shift;
+    }
+    if (trial % 10 == 0) {
+      hp_c[trial % kLength] = hp_sse2[trial % kLength] = -32768;
+    }
+    const size_t length = kLength - trial % 20;
+
+    int scale_c = -1;
+    int scale_sse2 = -1;
+    EXPECT_EQ(WebRtcSpl_Energy(hp_c, length, &scale_c),
+              WebRtcVad_EnergySSE2(hp_sse2, length, &scale_sse2));
+    EXPECT_EQ(scale_c, scale_sse2);
+
+    WebRtcVad_SplitBandsC(hp_c, lp_c, length);
+    WebRtcVad_SplitBandsSSE2(hp_sse2, lp_sse2, length);
+    for (size_t i = 0; i < kLength; ++i) {
+      ASSERT_EQ(hp_c[i], hp_sse2[i]);
+      ASSERT_EQ(lp_c[i], lp_sse2[i]);
+    }
+  }
+}
+#endif  // defined(WEBRTC_ARCH_X86_FAMILY)
 }  // namespace
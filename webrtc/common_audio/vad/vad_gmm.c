@@ -81,3 +81,17 @@ int32_t WebRtcVad_GaussianProbability(int16_t input,
   // Q-domain: Q10 * Q10 = Q20.
   return inv_std * exp_value;
 }
+
+void WebRtcVad_GaussianProbabilitiesC(const int16_t* inputs,
+                                      const int16_t* means,
+                                      const int16_t* stds,
+                                      size_t length,
+                                      int32_t* probabilities,
+                                      int16_t* deltas) {
+  size_t i;
+
+  for (i = 0; i < length; i++) {
+    probabilities[i] = WebRtcVad_GaussianProbability(inputs[i], means[i],
+                                                     stds[i], &deltas[i]);
+  }
+}
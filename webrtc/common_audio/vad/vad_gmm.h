@@ -13,6 +13,8 @@
 #ifndef WEBRTC_COMMON_AUDIO_VAD_VAD_GMM_H_
 #define WEBRTC_COMMON_AUDIO_VAD_VAD_GMM_H_
 
+#include <stddef.h>
+
 #include "webrtc/typedefs.h"
 
 // Calculates the probability for |input|, given that |input| comes from a
@@ -36,4 +38,25 @@ int32_t WebRtcVad_GaussianProbability(int16_t input,
                                       int16_t std,
                                       int16_t* delta);
 
+// Calls WebRtcVad_GaussianProbability() for |length| (input, mean, std)
+// triplets, and writes the returned probabilities and the |delta|s to
+// |probabilities| and |deltas|.
+void WebRtcVad_GaussianProbabilitiesC(const int16_t* inputs,
+                                      const int16_t* means,
+                                      const int16_t* stds,
+                                      size_t length,
+                                      int32_t* probabilities,
+                                      int16_t* deltas);
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// SSE2 version of WebRtcVad_GaussianProbabilitiesC(). Bit-exact for the
+// positive standard deviations of the VAD models.
+void WebRtcVad_GaussianProbabilitiesSSE2(const int16_t* inputs,
+                                         const int16_t* means,
+                                         const int16_t* stds,
+                                         size_t length,
+                                         int32_t* probabilities,
+                                         int16_t* deltas);
+#endif
+
 #endif  // WEBRTC_COMMON_AUDIO_VAD_VAD_GMM_H_
@@ -0,0 +1,156 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+#include <string.h>
+
+#include "webrtc/common_audio/vad/vad_gmm.h"
+
+// Constants from vad_gmm.c.
+static const int32_t kCompVar = 22005;
+static const int16_t kLog2Exp = 5909;  // log2(exp(1)) in Q12.
+
+// Truncates the 32-bit lanes of |lo| and |hi| to 16 bits, like a cast to
+// int16_t does.
+static __m128i TruncateToInt16(__m128i lo, __m128i hi) {
+  lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+  hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+  return _mm_packs_epi32(lo, hi);
+}
+
+// Bits [|shift|, |shift| + 15] of the 32-bit products of the 16-bit lanes of
+// |a| and |b|, i.e., (int16_t)((a * b) >> shift) for 0 < |shift| < 16.
+#define MUL_SHIFT_TO_INT16(a, b, shift)                       \
+  _mm_or_si128(_mm_srli_epi16(_mm_mullo_epi16(a, b), shift), \
+               _mm_slli_epi16(_mm_mulhi_epi16(a, b), 16 - (shift)))
+
+// Low 32 bits of the products of the 32-bit lanes of |a| and |b|.
+static __m128i MulLo32(__m128i a, __m128i b) {
+  __m128i even = _mm_mul_epu32(a, b);
+  __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+  return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                            _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+// (int16_t)(|num| / |den|) of the 32-bit lanes. The float division gives the
+// exact truncated quotient, since |num| + |den| < 2^24 (see below).
+static __m128i Divide(__m128i num_lo, __m128i num_hi,
+                      __m128i den_lo, __m128i den_hi) {
+  __m128i quotient_lo = _mm_cvttps_epi32(
+      _mm_div_ps(_mm_cvtepi32_ps(num_lo), _mm_cvtepi32_ps(den_lo)));
+  __m128i quotient_hi = _mm_cvttps_epi32(
+      _mm_div_ps(_mm_cvtepi32_ps(num_hi), _mm_cvtepi32_ps(den_hi)));
+  return TruncateToInt16(quotient_lo, quotient_hi);
+}
+
+// WebRtcVad_GaussianProbability() for eight (input, mean, std) triplets. See
+// vad_gmm.c for the Q domains.
+static void GaussianProbabilities8(const int16_t* inputs,
+                                   const int16_t* means,
+                                   const int16_t* stds,
+                                   int32_t* probabilities,
+                                   int16_t* deltas) {
+  const __m128i zero = _mm_setzero_si128();
+  __m128i input = _mm_loadu_si128((const __m128i*)inputs);
+  __m128i mean = _mm_loadu_si128((const __m128i*)means);
+  __m128i std = _mm_loadu_si128((const __m128i*)stds);
+  __m128i std_sign = _mm_srai_epi16(std, 15);
+  __m128i std_lo = _mm_unpacklo_epi16(std, std_sign);
+  __m128i std_hi = _mm_unpackhi_epi16(std, std_sign);
+  __m128i inv_std, inv_std2, tmp16, diff, delta, exponent_lo, exponent_hi;
+  __m128i below_comp_var, exp_value, shifts, lo, hi;
+  int bit;
+
+  // |inv_std| = 1 / s, in Q10. With 0 < |std| < 2^15 the numerator is below
+  // 2^17 + 2^14, so the sum of numerator and denominator is below 2^24, which
+  // keeps the float quotient from rounding up to the next integer.
+  inv_std = Divide(
+      _mm_add_epi32(_mm_set1_epi32(131072), _mm_srai_epi32(std_lo, 1)),
+      _mm_add_epi32(_mm_set1_epi32(131072), _mm_srai_epi32(std_hi, 1)),
+      std_lo, std_hi);
+
+  // |inv_std2| = 1 / s^2, in Q14.
+  tmp16 = _mm_srai_epi16(inv_std, 2);
+  inv_std2 = MUL_SHIFT_TO_INT16(tmp16, tmp16, 2);
+
+  // (x - m) in Q7, and |delta| = (x - m) / s^2, in Q11.
+  diff = _mm_sub_epi16(_mm_slli_epi16(input, 3), mean);
+  delta = MUL_SHIFT_TO_INT16(inv_std2, diff, 10);
+  _mm_storeu_si128((__m128i*)deltas, delta);
+
+  // The exponent (x - m)^2 / (2 * s^2), in Q10.
+  lo = _mm_mullo_epi16(delta, diff);
+  hi = _mm_mulhi_epi16(delta, diff);
+  exponent_lo = _mm_srai_epi32(_mm_unpacklo_epi16(lo, hi), 9);
+  exponent_hi = _mm_srai_epi32(_mm_unpackhi_epi16(lo, hi), 9);
+  below_comp_var = _mm_packs_epi32(
+      _mm_cmplt_epi32(exponent_lo, _mm_set1_epi32(kCompVar)),
+      _mm_cmplt_epi32(exponent_hi, _mm_set1_epi32(kCompVar)));
+
+  // |exp_value| ~= exp2(-log2(exp(1)) * exponent), in Q10.
+  tmp16 = TruncateToInt16(
+      _mm_srai_epi32(MulLo32(exponent_lo, _mm_set1_epi32(kLog2Exp)), 12),
+      _mm_srai_epi32(MulLo32(exponent_hi, _mm_set1_epi32(kLog2Exp)), 12));
+  tmp16 = _mm_sub_epi16(zero, tmp16);
+  exp_value = _mm_or_si128(_mm_set1_epi16(0x0400),
+                           _mm_and_si128(tmp16, _mm_set1_epi16(0x03FF)));
+  shifts = _mm_add_epi16(
+      _mm_srai_epi16(_mm_xor_si128(tmp16, _mm_set1_epi16(-1)), 10),
+      _mm_set1_epi16(1));
+  // Shift each lane by its own amount, one bit of the amount at a time.
+  for (bit = 1; bit <= 16; bit <<= 1) {
+    __m128i mask = _mm_cmpeq_epi16(
+        _mm_and_si128(shifts, _mm_set1_epi16(bit)), _mm_set1_epi16(bit));
+    exp_value = _mm_or_si128(
+        _mm_and_si128(mask, _mm_srl_epi16(exp_value, _mm_cvtsi32_si128(bit))),
+        _mm_andnot_si128(mask, exp_value));
+  }
+  exp_value = _mm_and_si128(below_comp_var, exp_value);
+
+  // (1 / s) * exp(-(x - m)^2 / (2 * s^2)), in Q20.
+  lo = _mm_mullo_epi16(inv_std, exp_value);
+  hi = _mm_mulhi_epi16(inv_std, exp_value);
+  _mm_storeu_si128((__m128i*)probabilities, _mm_unpacklo_epi16(lo, hi));
+  _mm_storeu_si128((__m128i*)&probabilities[4], _mm_unpackhi_epi16(lo, hi));
+}
+
+void WebRtcVad_GaussianProbabilitiesSSE2(const int16_t* inputs,
+                                         const int16_t* means,
+                                         const int16_t* stds,
+                                         size_t length,
+                                         int32_t* probabilities,
+                                         int16_t* deltas) {
+  size_t i = 0;
+  size_t length8 = length & ~(size_t)7;
+
+  for (i = 0; i < length8; i += 8) {
+    GaussianProbabilities8(&inputs[i], &means[i], &stds[i], &probabilities[i],
+                           &deltas[i]);
+  }
+
+  if (i < length) {
+    // Pad the remaining triplets to a full vector, with a valid |std|.
+    int16_t padded_inputs[8] = { 0 };
+    int16_t padded_means[8] = { 0 };
+    int16_t padded_stds[8] = { 128, 128, 128, 128, 128, 128, 128, 128 };
+    int32_t padded_probabilities[8];
+    int16_t padded_deltas[8];
+    size_t remaining = length - i;
+
+    memcpy(padded_inputs, &inputs[i], remaining * sizeof(*inputs));
+    memcpy(padded_means, &means[i], remaining * sizeof(*means));
+    memcpy(padded_stds, &stds[i], remaining * sizeof(*stds));
+    GaussianProbabilities8(padded_inputs, padded_means, padded_stds,
+                           padded_probabilities, padded_deltas);
+    memcpy(&probabilities[i], padded_probabilities,
+           remaining * sizeof(*probabilities));
+    memcpy(&deltas[i], padded_deltas, remaining * sizeof(*deltas));
+  }
+}
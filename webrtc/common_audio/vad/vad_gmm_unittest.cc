@@ -8,7 +8,9 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include "webrtc/base/random.h"
 #include "webrtc/common_audio/vad/vad_unittest.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
 #include "webrtc/test/gtest.h"
 #include "webrtc/typedefs.h"
 
@@ -40,4 +42,55 @@ TEST_F(VadTest, vad_gmm) {
   EXPECT_EQ(0, WebRtcVad_GaussianProbability(105, 0, 128, &delta));
   EXPECT_EQ(13440, delta);
 }
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+TEST_F(VadTest, vad_gmm_sse2) {
+  if (!WebRtc_GetCPUInfo(kSSE2)) {
+    return;
+  }
+  // Lengths that are not a multiple of the vector size exercise the padding.
+  const size_t kLength = 1003;
+  webrtc::Random random(42);
+  int16_t inputs[kLength];
+  int16_t means[kLength];
+  int16_t stds[kLength];
+  for (size_t i = 0; i < kLength; ++i) {
+    inputs[i] = random.Rand<int16_t>();
+    means[i] = random.Rand<int16_t>();
+    stds[i] = static_cast<int16_t>(random.Rand(1, 32767));
+  }
+  // The cases above, and inputs close to the means.
+  const int16_t kCases[][3] = {
+      {0, 0, 128},      {16, 128, 128},  {-16, -128, 128}, {59, 0, 128},
+      {75, 128, 128},   {-75, -128, 128}, {105, 0, 128},   {0, 0, 1},
+      {0, 0, 32767},    {-32768, 32767, 384}};
+  for (size_t i = 0; i < sizeof(kCases) / sizeof(*kCases); ++i) {
+    inputs[i] = kCases[i][0];
+    means[i] = kCases[i][1];
+    stds[i] = kCases[i][2];
+  }
+  for (size_t i = 100; i < 500; ++i) {
+    inputs[i] = static_cast<int16_t>(random.Rand(-1000, 1000));
+    means[i] = static_cast<int16_t>(inputs[i] * 8 + random.Rand(-2000, 2000));
+    stds[i] = static_cast<int16_t>(random.Rand(384, 2000));
+  }
+
+  const size_t kLengths[] = {1, 7, 8, 12, 97, kLength};
+  for (size_t length : kLengths) {
+    int32_t probabilities_c[kLength];
+    int32_t probabilities_sse2[kLength];
+    int16_t deltas_c[kLength];
+    int16_t deltas_sse2[kLength];
+    WebRtcVad_GaussianProbabilitiesC(inputs, means, stds, length,
+                                     probabilities_c, deltas_c);
+    WebRtcVad_GaussianProbabilitiesSSE2(inputs, means, stds, length,
+                                        probabilities_sse2, deltas_sse2);
+    for (size_t i = 0; i < length; ++i) {
+      ASSERT_EQ(probabilities_c[i], probabilities_sse2[i])
+          << inputs[i] << ", " << means[i] << ", " << stds[i];
+      ASSERT_EQ(deltas_c[i], deltas_sse2[i]);
+    }
+  }
+}
+#endif  // defined(WEBRTC_ARCH_X86_FAMILY)
 }  // namespace
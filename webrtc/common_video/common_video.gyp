@@ -74,9 +74,11 @@
         'include/i420_buffer_pool.h',
         'include/incoming_video_stream.h',
         'include/video_frame_buffer.h',
+        'include/video_frame_pyramid.h',
         'libyuv/include/webrtc_libyuv.h',
         'libyuv/webrtc_libyuv.cc',
         'video_frame_buffer.cc',
+        'video_frame_pyramid.cc',
         'video_render_frames.cc',
         'video_render_frames.h',
       ],
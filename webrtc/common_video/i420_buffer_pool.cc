@@ -10,48 +10,256 @@
 
 #include "webrtc/common_video/include/i420_buffer_pool.h"
 
+#include "webrtc/base/atomicops.h"
 #include "webrtc/base/checks.h"
+#include "webrtc/base/refcountedobject.h"
+#include "webrtc/base/scoped_ref_ptr.h"
 
 namespace webrtc {
 
+namespace {
+
+size_t I420BufferSize(int width, int height) {
+  return width * height + 2 * ((width + 1) / 2) * ((height + 1) / 2);
+}
+
+}  // namespace
+
+// A buffer that, when its last reference is released, is put back on the free
+// list of its size class instead of being deleted.
+class I420BufferPool::PooledI420Buffer : public I420Buffer {
+ public:
+  PooledI420Buffer(int width, int height, SizeClass* size_class)
+      : I420Buffer(width, height), size_class_(size_class) {}
+
+  int AddRef() const override {
+    return rtc::AtomicOps::Increment(&ref_count_);
+  }
+  int Release() const override;
+
+  // Next buffer on the free list, only used while the buffer is free.
+  PooledI420Buffer* next = nullptr;
+
+ private:
+  friend class I420BufferPool;
+  friend class SizeClass;
+  ~PooledI420Buffer() override {}
+
+  // Keeps the size class alive as long as it has buffers.
+  const rtc::scoped_refptr<SizeClass> size_class_;
+  mutable volatile int ref_count_ = 0;
+};
+
+// The buffers of one resolution. The free buffers are on a lock-free stack,
+// which buffers are pushed to on any thread. The pool takes the whole stack at
+// once when it runs out of the buffers taken before, which avoids the ABA
+// problem of popping single buffers.
+class I420BufferPool::SizeClass : public rtc::RefCountInterface {
+ public:
+  SizeClass(int width, int height)
+      : width(width),
+        height(height),
+        buffer_size(I420BufferSize(width, height)) {}
+
+  // Called on any thread when the last reference to |buffer| is released.
+  void Return(PooledI420Buffer* buffer) {
+    Push(buffer);
+    // If the pool has removed this size class meanwhile, make sure that the
+    // buffer is not left on the stack. Push() is a full memory barrier, as is
+    // the swap in Remove(), so either this sees |removed_| set, or Remove()
+    // sees the buffer on the stack.
+    if (rtc::AtomicOps::AcquireLoad(&removed_))
+      DeleteBuffers(TakeAll());
+  }
+
+  // Returns a free buffer, or null if there is none. Called on the pool thread.
+  PooledI420Buffer* TakeFreeBuffer() {
+    if (!taken_)
+      taken_ = TakeAll();
+    PooledI420Buffer* buffer = taken_;
+    if (buffer)
+      taken_ = buffer->next;
+    return buffer;
+  }
+
+  // Marks the size class as removed from the pool, and deletes its free
+  // buffers. The buffers in use delete themselves when released.
+  void Remove() {
+    rtc::AtomicOps::CompareAndSwap(&removed_, 0, 1);
+    DeleteBuffers(taken_);
+    taken_ = nullptr;
+    DeleteBuffers(TakeAll());
+  }
+
+  const int width;
+  const int height;
+  const size_t buffer_size;
+  // Buffers of this size held by the pool, in use or free. Used on the pool
+  // thread only.
+  size_t num_buffers = 0;
+
+ protected:
+  ~SizeClass() override {}
+
+ private:
+  void Push(PooledI420Buffer* buffer) {
+    PooledI420Buffer* head = rtc::AtomicOps::AcquireLoadPtr(&free_list_);
+    while (true) {
+      buffer->next = head;
+      PooledI420Buffer* old_head =
+          rtc::AtomicOps::CompareAndSwapPtr(&free_list_, head, buffer);
+      if (old_head == head)
+        return;
+      head = old_head;
+    }
+  }
+
+  PooledI420Buffer* TakeAll() {
+    PooledI420Buffer* head = rtc::AtomicOps::AcquireLoadPtr(&free_list_);
+    while (head) {
+      PooledI420Buffer* old_head = rtc::AtomicOps::CompareAndSwapPtr(
+          &free_list_, head, static_cast<PooledI420Buffer*>(nullptr));
+      if (old_head == head)
+        break;
+      head = old_head;
+    }
+    return head;
+  }
+
+  // Each buffer holds a reference to this size class, which is deleted along
+  // with the last buffer, unless the caller holds a reference as well.
+  static void DeleteBuffers(PooledI420Buffer* buffer) {
+    while (buffer) {
+      PooledI420Buffer* next = buffer->next;
+      delete buffer;
+      buffer = next;
+    }
+  }
+
+  PooledI420Buffer* volatile free_list_ = nullptr;
+  // Free buffers taken from |free_list_| by the pool thread.
+  PooledI420Buffer* taken_ = nullptr;
+  volatile int removed_ = 0;
+};
+
+int I420BufferPool::PooledI420Buffer::Release() const {
+  int count = rtc::AtomicOps::Decrement(&ref_count_);
+  if (!count) {
+    // Once on the free list, the buffer may be deleted by another thread at
+    // any time. Keep the size class alive until Return() is done with it.
+    rtc::scoped_refptr<SizeClass> size_class(size_class_);
+    size_class->Return(const_cast<PooledI420Buffer*>(this));
+  }
+  return count;
+}
+
+const size_t I420BufferPool::kDefaultMaxNumberOfSizes;
+
 I420BufferPool::I420BufferPool(bool zero_initialize,
                                size_t max_number_of_buffers)
+    : I420BufferPool(zero_initialize,
+                     max_number_of_buffers,
+                     kDefaultMaxNumberOfSizes,
+                     std::numeric_limits<size_t>::max()) {}
+
+I420BufferPool::I420BufferPool(bool zero_initialize,
+                               size_t max_number_of_buffers,
+                               size_t max_number_of_sizes,
+                               size_t max_bytes)
     : zero_initialize_(zero_initialize),
-      max_number_of_buffers_(max_number_of_buffers) {}
+      max_number_of_buffers_(max_number_of_buffers),
+      max_number_of_sizes_(max_number_of_sizes),
+      max_bytes_(max_bytes),
+      num_buffers_(0),
+      bytes_held_(0),
+      num_hits_(0),
+      num_misses_(0) {
+  RTC_DCHECK_GT(max_number_of_sizes, 0u);
+}
+
+I420BufferPool::~I420BufferPool() {
+  RemoveAllSizeClasses();
+}
 
 void I420BufferPool::Release() {
-  buffers_.clear();
+  RemoveAllSizeClasses();
 }
 
 rtc::scoped_refptr<I420Buffer> I420BufferPool::CreateBuffer(int width,
                                                             int height) {
   RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
-  // Release buffers with wrong resolution.
-  for (auto it = buffers_.begin(); it != buffers_.end();) {
-    if ((*it)->width() != width || (*it)->height() != height)
-      it = buffers_.erase(it);
-    else
-      ++it;
+  // Find the size class, and move it to the front.
+  auto it = size_classes_.begin();
+  while (it != size_classes_.end() &&
+         ((*it)->width != width || (*it)->height != height)) {
+    ++it;
+  }
+  rtc::scoped_refptr<SizeClass> size_class;
+  if (it != size_classes_.end()) {
+    size_class = *it;
+    size_classes_.erase(it);
+  } else {
+    if (size_classes_.size() >= max_number_of_sizes_) {
+      SizeClass* least_recently_used = size_classes_.back().get();
+      num_buffers_ -= least_recently_used->num_buffers;
+      bytes_held_ -=
+          least_recently_used->num_buffers * least_recently_used->buffer_size;
+      least_recently_used->Remove();
+      size_classes_.pop_back();
+    }
+    size_class = new rtc::RefCountedObject<SizeClass>(width, height);
   }
+  size_classes_.insert(size_classes_.begin(), size_class);
+
   // Look for a free buffer.
-  for (const rtc::scoped_refptr<PooledI420Buffer>& buffer : buffers_) {
-    // If the buffer is in use, the ref count will be >= 2, one from the list we
-    // are looping over and one from the application. If the ref count is 1,
-    // then the list we are looping over holds the only reference and it's safe
-    // to reuse.
-    if (buffer->HasOneRef())
-      return buffer;
+  if (PooledI420Buffer* buffer = size_class->TakeFreeBuffer()) {
+    ++num_hits_;
+    return buffer;
   }
+  ++num_misses_;
 
-  if (buffers_.size() >= max_number_of_buffers_)
+  if (!MakeRoomFor(size_class->buffer_size)) {
     return nullptr;
+  }
   // Allocate new buffer.
   rtc::scoped_refptr<PooledI420Buffer> buffer =
-      new PooledI420Buffer(width, height);
+      new PooledI420Buffer(width, height, size_class.get());
   if (zero_initialize_)
     buffer->InitializeData();
-  buffers_.push_back(buffer);
+  ++size_class->num_buffers;
+  ++num_buffers_;
+  bytes_held_ += size_class->buffer_size;
   return buffer;
 }
 
+bool I420BufferPool::MakeRoomFor(size_t bytes) {
+  // The front size class is the one to make room for, and has no free buffers.
+  for (size_t i = size_classes_.size(); i > 1 && !HasRoomFor(bytes); --i) {
+    SizeClass* size_class = size_classes_[i - 1].get();
+    while (!HasRoomFor(bytes)) {
+      PooledI420Buffer* buffer = size_class->TakeFreeBuffer();
+      if (!buffer)
+        break;
+      delete buffer;
+      --size_class->num_buffers;
+      --num_buffers_;
+      bytes_held_ -= size_class->buffer_size;
+    }
+  }
+  return HasRoomFor(bytes);
+}
+
+bool I420BufferPool::HasRoomFor(size_t bytes) const {
+  return num_buffers_ < max_number_of_buffers_ &&
+         bytes_held_ + bytes <= max_bytes_;
+}
+
+void I420BufferPool::RemoveAllSizeClasses() {
+  for (const rtc::scoped_refptr<SizeClass>& size_class : size_classes_)
+    size_class->Remove();
+  size_classes_.clear();
+  num_buffers_ = 0;
+  bytes_held_ = 0;
+}
+
 }  // namespace webrtc
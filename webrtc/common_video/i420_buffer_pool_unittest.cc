@@ -9,7 +9,9 @@
  */
 
 #include <string>
+#include <vector>
 
+#include "webrtc/base/platform_thread.h"
 #include "webrtc/common_video/include/i420_buffer_pool.h"
 #include "webrtc/test/gtest.h"
 
@@ -70,4 +72,96 @@ TEST(TestI420BufferPool, MaxNumberOfBuffers) {
   EXPECT_EQ(nullptr, pool.CreateBuffer(16, 16).get());
 }
 
+TEST(TestI420BufferPool, MaxNumberOfBuffersCountsAllResolutions) {
+  I420BufferPool pool(false, 2);
+  pool.CreateBuffer(16, 16);
+  rtc::scoped_refptr<I420Buffer> buffer_32 = pool.CreateBuffer(32, 16);
+  rtc::scoped_refptr<I420Buffer> buffer_48 = pool.CreateBuffer(48, 16);
+  // The free 16x16 buffer is deleted to make room for the 48x16 buffer.
+  ASSERT_NE(nullptr, buffer_48.get());
+  EXPECT_EQ(32u * 16 * 3 / 2 + 48u * 16 * 3 / 2, pool.bytes_held());
+  // Both buffers are in use.
+  EXPECT_EQ(nullptr, pool.CreateBuffer(16, 16).get());
+}
+
+TEST(TestI420BufferPool, ReusesBuffersOfRecentResolutions) {
+  I420BufferPool pool;
+  rtc::scoped_refptr<VideoFrameBuffer> buffer = pool.CreateBuffer(16, 16);
+  const uint8_t* y_ptr_16 = buffer->DataY();
+  buffer = pool.CreateBuffer(32, 16);
+  const uint8_t* y_ptr_32 = buffer->DataY();
+  buffer = nullptr;
+  EXPECT_EQ(0, pool.num_hits());
+  EXPECT_EQ(2, pool.num_misses());
+
+  EXPECT_EQ(y_ptr_16, pool.CreateBuffer(16, 16)->DataY());
+  EXPECT_EQ(y_ptr_32, pool.CreateBuffer(32, 16)->DataY());
+  EXPECT_EQ(2, pool.num_hits());
+  EXPECT_EQ(2, pool.num_misses());
+  EXPECT_EQ(16u * 16 * 3 / 2 + 32u * 16 * 3 / 2, pool.bytes_held());
+}
+
+TEST(TestI420BufferPool, DropsLeastRecentlyUsedResolution) {
+  I420BufferPool pool(false, std::numeric_limits<size_t>::max(), 2,
+                      std::numeric_limits<size_t>::max());
+  const uint8_t* y_ptr_16 = pool.CreateBuffer(16, 16)->DataY();
+  pool.CreateBuffer(32, 16);
+  // Make 16x16 the most recently used resolution.
+  EXPECT_EQ(y_ptr_16, pool.CreateBuffer(16, 16)->DataY());
+  rtc::scoped_refptr<I420Buffer> buffer_48 = pool.CreateBuffer(48, 16);
+  EXPECT_EQ(16u * 16 * 3 / 2 + 48u * 16 * 3 / 2, pool.bytes_held());
+
+  // The buffers of a dropped resolution stay valid until released.
+  rtc::scoped_refptr<I420Buffer> buffer_16 = pool.CreateBuffer(16, 16);
+  pool.CreateBuffer(32, 16);
+  EXPECT_EQ(16u * 16 * 3 / 2 + 32u * 16 * 3 / 2, pool.bytes_held());
+  EXPECT_EQ(48, buffer_48->width());
+  memset(buffer_48->MutableDataY(), 0xA5, 16 * buffer_48->StrideY());
+}
+
+TEST(TestI420BufferPool, StaysWithinMemoryBudget) {
+  const size_t kBufferSize = 32 * 16 * 3 / 2;
+  I420BufferPool pool(false, std::numeric_limits<size_t>::max(),
+                      I420BufferPool::kDefaultMaxNumberOfSizes,
+                      2 * kBufferSize);
+  pool.CreateBuffer(32, 16);
+  rtc::scoped_refptr<I420Buffer> buffer = pool.CreateBuffer(16, 32);
+  EXPECT_EQ(2 * kBufferSize, pool.bytes_held());
+
+  // The free 32x16 buffer is deleted to make room for a new resolution.
+  rtc::scoped_refptr<I420Buffer> buffer2 = pool.CreateBuffer(8, 64);
+  ASSERT_NE(nullptr, buffer2.get());
+  EXPECT_EQ(2 * kBufferSize, pool.bytes_held());
+
+  // Both buffers are in use.
+  EXPECT_EQ(nullptr, pool.CreateBuffer(32, 16).get());
+  buffer = nullptr;
+  EXPECT_NE(nullptr, pool.CreateBuffer(16, 32).get());
+  EXPECT_EQ(1, pool.num_hits());
+}
+
+namespace {
+
+bool ReleaseBuffers(void* obj) {
+  static_cast<std::vector<rtc::scoped_refptr<I420Buffer>>*>(obj)->clear();
+  return false;
+}
+
+}  // namespace
+
+TEST(TestI420BufferPool, ReusesBuffersReleasedOnOtherThreads) {
+  const size_t kNumBuffers = 50;
+  I420BufferPool pool;
+  for (int round = 0; round < 10; ++round) {
+    std::vector<rtc::scoped_refptr<I420Buffer>> buffers;
+    for (size_t i = 0; i < kNumBuffers; ++i)
+      buffers.push_back(pool.CreateBuffer(16, 16));
+    rtc::PlatformThread thread(&ReleaseBuffers, &buffers, "ReleaseBuffers");
+    thread.Start();
+    thread.Stop();
+  }
+  EXPECT_EQ(static_cast<int>(kNumBuffers), pool.num_misses());
+  EXPECT_EQ(static_cast<int>(9 * kNumBuffers), pool.num_hits());
+}
+
 }  // namespace webrtc
@@ -44,6 +44,23 @@ rtc::scoped_refptr<I420Buffer> CreateGradient(int width, int height) {
   return buffer;
 }
 
+rtc::scoped_refptr<NV12Buffer> CreateNV12Gradient(int width, int height) {
+  rtc::scoped_refptr<I420Buffer> i420_buffer = CreateGradient(width, height);
+  rtc::scoped_refptr<NV12Buffer> buffer(NV12Buffer::Create(width, height));
+  memcpy(buffer->MutableDataY(), i420_buffer->DataY(), width * height);
+  int chroma_width = (width + 1) / 2;
+  int chroma_height = (height + 1) / 2;
+  for (int x = 0; x < chroma_width; x++) {
+    for (int y = 0; y < chroma_height; y++) {
+      buffer->MutableDataUV()[2 * x + y * buffer->StrideUV()] =
+          i420_buffer->DataU()[x + y * chroma_width];
+      buffer->MutableDataUV()[2 * x + 1 + y * buffer->StrideUV()] =
+          i420_buffer->DataV()[x + y * chroma_width];
+    }
+  }
+  return buffer;
+}
+
 // The offsets and sizes describe the rectangle extracted from the
 // original (gradient) frame, in relative coordinates where the
 // original frame correspond to the unit square, 0.0 <= x, y < 1.0.
@@ -191,6 +208,26 @@ TEST(TestVideoFrame, ShallowCopy) {
   EXPECT_NE(frame2.rotation(), frame1.rotation());
 }
 
+TEST(TestVideoFrame, UpdateRectUnion) {
+  VideoFrame::UpdateRect rect = {0, 0, 0, 0};
+  rect.Union({10, 20, 30, 40});
+  EXPECT_EQ(10, rect.offset_x);
+  EXPECT_EQ(20, rect.offset_y);
+  EXPECT_EQ(30, rect.width);
+  EXPECT_EQ(40, rect.height);
+
+  rect.Union({0, 50, 5, 20});
+  EXPECT_EQ(0, rect.offset_x);
+  EXPECT_EQ(20, rect.offset_y);
+  EXPECT_EQ(40, rect.width);
+  EXPECT_EQ(50, rect.height);
+
+  // Empty rectangles do not add to the union wherever they are.
+  rect.Union({100, 100, 0, 10});
+  EXPECT_EQ(40, rect.width);
+  EXPECT_EQ(50, rect.height);
+}
+
 TEST(TestVideoFrame, TextureInitialValues) {
   test::FakeNativeHandle* handle = new test::FakeNativeHandle();
   VideoFrame frame = test::FakeNativeHandle::CreateFrame(
@@ -284,6 +321,53 @@ TEST(TestI420FrameBuffer, CropAndScale16x9) {
   CheckCrop(*scaled_buffer, 0.0, 0.125, 1.0, 0.75);
 }
 
+TEST(TestNV12FrameBuffer, ConvertsToI420Once) {
+  rtc::scoped_refptr<NV12Buffer> buf = CreateNV12Gradient(200, 100);
+  EXPECT_EQ(VideoFrameBuffer::Type::kNV12, buf->type());
+  EXPECT_FALSE(VideoFrame(buf, 0, 0, kVideoRotation_0).is_texture());
+  EXPECT_EQ(0, buf->num_i420_conversions());
+
+  rtc::scoped_refptr<VideoFrameBuffer> i420_buffer = buf->NativeToI420Buffer();
+  EXPECT_EQ(VideoFrameBuffer::Type::kI420, i420_buffer->type());
+  EXPECT_TRUE(test::FrameBufsEqual(CreateGradient(200, 100), i420_buffer));
+  EXPECT_EQ(1, buf->num_i420_conversions());
+
+  EXPECT_EQ(i420_buffer.get(), buf->NativeToI420Buffer().get());
+  EXPECT_EQ(1, buf->num_i420_conversions());
+}
+
+TEST(TestNV12FrameBuffer, ReadsAsI420) {
+  rtc::scoped_refptr<NV12Buffer> buf = CreateNV12Gradient(200, 100);
+  EXPECT_EQ(nullptr, buf->native_handle());
+
+  // Consumers that only handle I420 read the planes directly.
+  EXPECT_TRUE(test::FrameBufsEqual(CreateGradient(200, 100), buf));
+  EXPECT_EQ(1, buf->num_i420_conversions());
+  EXPECT_EQ(buf->NativeToI420Buffer()->DataU(), buf->DataU());
+  EXPECT_EQ(1, buf->num_i420_conversions());
+}
+
+TEST(TestNV12FrameBuffer, CropAndScale) {
+  rtc::scoped_refptr<NV12Buffer> buf = CreateNV12Gradient(200, 100);
+
+  // Crop the center half horizontally, and scale down by 2.
+  rtc::scoped_refptr<NV12Buffer> scaled_buffer(NV12Buffer::Create(50, 50));
+  scaled_buffer->CropAndScaleFrom(*buf, 50, 0, 100, 100);
+  CheckCrop(*scaled_buffer->NativeToI420Buffer(), 0.25, 0.0, 0.5, 1.0);
+}
+
+TEST(TestNV12FrameBuffer, GetScaledBufferKeepsNV12) {
+  rtc::scoped_refptr<NV12Buffer> buf = CreateNV12Gradient(200, 100);
+
+  rtc::scoped_refptr<VideoFrameBuffer> scaled_buffer =
+      buf->GetScaledBuffer(100, 50);
+  EXPECT_EQ(VideoFrameBuffer::Type::kNV12, scaled_buffer->type());
+  EXPECT_EQ(100, scaled_buffer->width());
+  EXPECT_EQ(50, scaled_buffer->height());
+  EXPECT_EQ(0, buf->num_i420_conversions());
+  CheckCrop(*scaled_buffer, 0.0, 0.0, 1.0, 1.0);
+}
+
 class TestI420BufferRotate
     : public ::testing::TestWithParam<webrtc::VideoRotation> {};
 
@@ -11,10 +11,12 @@
 #ifndef WEBRTC_COMMON_VIDEO_INCLUDE_I420_BUFFER_POOL_H_
 #define WEBRTC_COMMON_VIDEO_INCLUDE_I420_BUFFER_POOL_H_
 
-#include <list>
 #include <limits>
+#include <vector>
 
+#include "webrtc/base/constructormagic.h"
 #include "webrtc/base/race_checker.h"
+#include "webrtc/base/scoped_ref_ptr.h"
 #include "webrtc/common_video/include/video_frame_buffer.h"
 
 namespace webrtc {
@@ -22,33 +24,64 @@ namespace webrtc {
 // Simple buffer pool to avoid unnecessary allocations of I420Buffer objects.
 // The pool manages the memory of the I420Buffer returned from CreateBuffer.
 // When the I420Buffer is destructed, the memory is returned to the pool for use
-// by subsequent calls to CreateBuffer. If the resolution passed to CreateBuffer
-// changes, old buffers will be purged from the pool.
-// Note that CreateBuffer will crash if more than kMaxNumberOfFramesBeforeCrash
-// are created. This is to prevent memory leaks where frames are not returned.
+// by subsequent calls to CreateBuffer.
+//
+// Free buffers are kept for the |max_number_of_sizes| most recently used
+// resolutions, so that switching back and forth between resolutions (e.g.,
+// with simulcast or resolution adaptation) does not allocate new buffers. A
+// buffer released on any thread is put on a lock-free list of its resolution;
+// CreateBuffer itself must be called on one thread at a time.
+//
+// CreateBuffer returns null rather than exceeding the limits on the number of
+// buffers or the memory used; callers with no limits never get null.
 class I420BufferPool {
  public:
+  static const size_t kDefaultMaxNumberOfSizes = 4;
+
   I420BufferPool()
       : I420BufferPool(false) {}
   explicit I420BufferPool(bool zero_initialize)
       : I420BufferPool(zero_initialize, std::numeric_limits<size_t>::max()) {}
   I420BufferPool(bool zero_initialze, size_t max_number_of_buffers);
+  // |max_number_of_buffers| limits the number of buffers, and |max_bytes| their
+  // memory, counting the buffers of all resolutions, both in use and free.
+  I420BufferPool(bool zero_initialize,
+                 size_t max_number_of_buffers,
+                 size_t max_number_of_sizes,
+                 size_t max_bytes);
+  ~I420BufferPool();
 
-  // Returns a buffer from the pool. If no suitable buffer exist in the pool
-  // and there are less than |max_number_of_buffers| pending, a buffer is
-  // created. Returns null otherwise.
+  // Returns a buffer from the pool. If no suitable buffer exist in the pool, a
+  // buffer is created. Free buffers of the least recently used resolutions are
+  // deleted to stay within |max_number_of_buffers| and |max_bytes|. Returns
+  // null if the limits can't be met.
   rtc::scoped_refptr<I420Buffer> CreateBuffer(int width, int height);
-  // Clears buffers_ and detaches the thread checker so that it can be reused
-  // later from another thread.
+  // Deletes the free buffers. The buffers in use are deleted when released.
+  // CreateBuffer may be called on another thread afterwards, as long as the
+  // calls don't overlap.
   void Release();
 
+  // Statistics, to be read on the thread calling CreateBuffer. A hit is a call
+  // to CreateBuffer that reused a free buffer, and a miss one that did not.
+  int num_hits() const { return num_hits_; }
+  int num_misses() const { return num_misses_; }
+  // Memory of the buffers of the resolutions kept by the pool, in use or free.
+  size_t bytes_held() const { return bytes_held_; }
+
  private:
-  // Explicitly use a RefCountedObject to get access to HasOneRef,
-  // needed by the pool to check exclusive access.
-  using PooledI420Buffer = rtc::RefCountedObject<I420Buffer>;
+  class PooledI420Buffer;
+  class SizeClass;
+
+  // Deletes free buffers, starting with the least recently used resolution,
+  // until one more buffer of |bytes| fits within |max_number_of_buffers_| and
+  // |max_bytes_|. Returns false if it doesn't.
+  bool MakeRoomFor(size_t bytes);
+  bool HasRoomFor(size_t bytes) const;
+  void RemoveAllSizeClasses();
 
   rtc::RaceChecker race_checker_;
-  std::list<rtc::scoped_refptr<PooledI420Buffer>> buffers_;
+  // Most recently used first.
+  std::vector<rtc::scoped_refptr<SizeClass>> size_classes_;
   // If true, newly allocated buffers are zero-initialized. Note that recycled
   // buffers are not zero'd before reuse. This is required of buffers used by
   // FFmpeg according to http://crbug.com/390941, which only requires it for the
@@ -57,6 +90,14 @@ class I420BufferPool {
   const bool zero_initialize_;
   // Max number of buffers this pool can have pending.
   const size_t max_number_of_buffers_;
+  const size_t max_number_of_sizes_;
+  const size_t max_bytes_;
+  size_t num_buffers_;
+  size_t bytes_held_;
+  int num_hits_;
+  int num_misses_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(I420BufferPool);
 };
 
 }  // namespace webrtc
@@ -16,8 +16,10 @@
 #include <memory>
 
 #include "webrtc/base/callback.h"
+#include "webrtc/base/criticalsection.h"
 #include "webrtc/base/refcount.h"
 #include "webrtc/base/scoped_ref_ptr.h"
+#include "webrtc/base/thread_annotations.h"
 #include "webrtc/common_video/rotation.h"
 #include "webrtc/system_wrappers/include/aligned_malloc.h"
 
@@ -27,6 +29,20 @@ namespace webrtc {
 // not contain any frame metadata such as rotation, timestamp, pixel_width, etc.
 class VideoFrameBuffer : public rtc::RefCountInterface {
  public:
+  // The layout of the pixel data. Only kNative buffers have a platform
+  // specific native_handle(), e.g., a texture, and must be converted with
+  // NativeToI420Buffer(). All other buffers can be read through their Y, U and
+  // V planes, whatever their own layout.
+  enum class Type {
+    kNative,
+    kI420,
+    kNV12,
+  };
+
+  // By default, kNative if the buffer has a native handle, and kI420
+  // otherwise.
+  virtual Type type() const;
+
   // The resolution of the frame in pixels. For formats where some planes are
   // subsampled, this is the highest-resolution plane.
   virtual int width() const = 0;
@@ -51,6 +67,14 @@ class VideoFrameBuffer : public rtc::RefCountInterface {
   // native handle.
   virtual rtc::scoped_refptr<VideoFrameBuffer> NativeToI420Buffer() = 0;
 
+  // Returns the frame scaled to |width| x |height| with the bilinear filter and
+  // no cropping, or this buffer if it already has that size. By default, a new
+  // buffer is scaled on each call; buffers wrapped by a VideoFramePyramidPool
+  // instead scale each size only once, and return the same buffer to all
+  // callers. The returned buffer must therefore not be modified.
+  virtual rtc::scoped_refptr<VideoFrameBuffer> GetScaledBuffer(int width,
+                                                               int height);
+
  protected:
   virtual ~VideoFrameBuffer();
 };
@@ -177,6 +201,82 @@ class NativeHandleBuffer : public VideoFrameBuffer {
   const int height_;
 };
 
+// Plain NV12 buffer in standard memory: a full resolution Y plane, and a half
+// resolution plane of interleaved U and V samples, as delivered by many
+// cameras. Consumers that handle NV12 use DataUV(). For all others, the first
+// call to DataU(), DataV() or NativeToI420Buffer() converts the buffer to
+// I420, and later calls use the same I420 buffer, so that a frame is converted
+// at most once however many of its consumers need I420.
+class NV12Buffer : public VideoFrameBuffer {
+ public:
+  NV12Buffer(int width, int height);
+  NV12Buffer(int width, int height, int stride_y, int stride_uv);
+
+  static rtc::scoped_refptr<NV12Buffer> Create(int width, int height);
+  static rtc::scoped_refptr<NV12Buffer> Create(int width,
+                                               int height,
+                                               int stride_y,
+                                               int stride_uv);
+  // Create a new buffer and copy the pixel data, e.g., from a capture buffer
+  // that is about to be reused.
+  static rtc::scoped_refptr<NV12Buffer> Copy(int width,
+                                             int height,
+                                             const uint8_t* data_y,
+                                             int stride_y,
+                                             const uint8_t* data_uv,
+                                             int stride_uv);
+
+  Type type() const override;
+
+  int width() const override;
+  int height() const override;
+  const uint8_t* DataY() const override;
+  const uint8_t* DataU() const override;
+  const uint8_t* DataV() const override;
+  const uint8_t* DataUV() const;
+
+  uint8_t* MutableDataY();
+  uint8_t* MutableDataUV();
+  int StrideY() const override;
+  int StrideU() const override;
+  int StrideV() const override;
+  int StrideUV() const;
+
+  void* native_handle() const override;
+  rtc::scoped_refptr<VideoFrameBuffer> NativeToI420Buffer() override;
+
+  // Returns a new NV12 buffer, so that scaling does not convert to I420.
+  rtc::scoped_refptr<VideoFrameBuffer> GetScaledBuffer(int width,
+                                                       int height) override;
+
+  // Scale the cropped area of |src| to the size of |this| buffer, and
+  // write the result into |this|, without converting to I420.
+  void CropAndScaleFrom(const NV12Buffer& src,
+                        int offset_x,
+                        int offset_y,
+                        int crop_width,
+                        int crop_height);
+
+  // Number of times this buffer has been converted to I420, which is 1 once
+  // any consumer has read it as I420.
+  int num_i420_conversions() const;
+
+ protected:
+  ~NV12Buffer() override;
+
+ private:
+  // Converts to I420 on the first call, and returns the same buffer later.
+  rtc::scoped_refptr<VideoFrameBuffer> GetI420Buffer() const;
+
+  const int width_;
+  const int height_;
+  const int stride_y_;
+  const int stride_uv_;
+  const std::unique_ptr<uint8_t, AlignedFreeDeleter> data_;
+  mutable rtc::CriticalSection crit_;
+  mutable rtc::scoped_refptr<VideoFrameBuffer> i420_buffer_ GUARDED_BY(crit_);
+};
+
 class WrappedI420Buffer : public webrtc::VideoFrameBuffer {
  public:
   WrappedI420Buffer(int width,
@@ -0,0 +1,56 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_COMMON_VIDEO_INCLUDE_VIDEO_FRAME_PYRAMID_H_
+#define WEBRTC_COMMON_VIDEO_INCLUDE_VIDEO_FRAME_PYRAMID_H_
+
+#include <memory>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/scoped_ref_ptr.h"
+#include "webrtc/common_video/include/video_frame_buffer.h"
+
+namespace webrtc {
+
+// Wraps the frames of a video source in buffers that keep the scaled versions
+// of the frame, so that each resolution asked for through GetScaledBuffer() is
+// computed once per frame (unless two consumers ask for it at the same time),
+// and then shared by all consumers (e.g., the simulcast encoders and a local
+// preview). Each resolution is scaled from the original frame, like
+// GetScaledBuffer() does for buffers that are not wrapped. The scaled versions
+// are kept until the wrapped frame is released, and their memory is recycled
+// through an I420BufferPool shared by all frames of the source.
+//
+// The wrapped buffers can be used on any thread, and may outlive the pool.
+class VideoFramePyramidPool {
+ public:
+  VideoFramePyramidPool();
+  ~VideoFramePyramidPool();
+
+  // Returns |buffer| wrapped in a pyramid. Native (texture) and NV12 buffers
+  // are returned as they are, since their consumers need the original object.
+  rtc::scoped_refptr<VideoFrameBuffer> Wrap(
+      const rtc::scoped_refptr<VideoFrameBuffer>& buffer);
+
+  // Number of scaled versions computed so far for all wrapped frames.
+  int num_scaled_buffers() const;
+
+ private:
+  class LevelAllocator;
+  class Pyramid;
+
+  const std::shared_ptr<LevelAllocator> allocator_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(VideoFramePyramidPool);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_COMMON_VIDEO_INCLUDE_VIDEO_FRAME_PYRAMID_H_
@@ -134,6 +134,11 @@ double I420SSIM(const VideoFrame* ref_frame, const VideoFrame* test_frame);
 double I420SSIM(const VideoFrameBuffer& ref_buffer,
                 const VideoFrameBuffer& test_buffer);
 
+// Scales |src| to the size of |dst| with the bilinear filter, which is what
+// SimulcastEncoderAdapter has always scaled its layers with. I420Buffer's
+// ScaleFrom() uses the box filter instead.
+void I420ScaleBilinear(const VideoFrameBuffer& src, I420Buffer* dst);
+
 // Helper function for scaling NV12 to NV12.
 void NV12Scale(std::vector<uint8_t>* tmp_buffer,
                const uint8_t* src_y, int src_stride_y,
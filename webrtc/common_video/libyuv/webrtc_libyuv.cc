@@ -340,6 +340,18 @@ double I420SSIM(const VideoFrame* ref_frame, const VideoFrame* test_frame) {
                   *test_frame->video_frame_buffer());
 }
 
+void I420ScaleBilinear(const VideoFrameBuffer& src, I420Buffer* dst) {
+  libyuv::I420Scale(src.DataY(), src.StrideY(),
+                    src.DataU(), src.StrideU(),
+                    src.DataV(), src.StrideV(),
+                    src.width(), src.height(),
+                    dst->MutableDataY(), dst->StrideY(),
+                    dst->MutableDataU(), dst->StrideU(),
+                    dst->MutableDataV(), dst->StrideV(),
+                    dst->width(), dst->height(),
+                    libyuv::kFilterBilinear);
+}
+
 void NV12Scale(std::vector<uint8_t>* tmp_buffer,
                const uint8_t* src_y, int src_stride_y,
                const uint8_t* src_uv, int src_stride_uv,
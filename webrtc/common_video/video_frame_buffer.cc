@@ -12,9 +12,11 @@
 #include <string.h>
 
 #include <algorithm>
+#include <vector>
 
 #include "webrtc/base/checks.h"
 #include "webrtc/base/keep_ref_until_done.h"
+#include "webrtc/common_video/libyuv/include/webrtc_libyuv.h"
 #include "libyuv/convert.h"
 #include "libyuv/planar_functions.h"
 #include "libyuv/scale.h"
@@ -30,10 +32,32 @@ int I420DataSize(int height, int stride_y, int stride_u, int stride_v) {
   return stride_y * height + (stride_u + stride_v) * ((height + 1) / 2);
 }
 
+int NV12DataSize(int height, int stride_y, int stride_uv) {
+  return stride_y * height + stride_uv * ((height + 1) / 2);
+}
+
 }  // namespace
 
 VideoFrameBuffer::~VideoFrameBuffer() {}
 
+VideoFrameBuffer::Type VideoFrameBuffer::type() const {
+  return native_handle() ? Type::kNative : Type::kI420;
+}
+
+rtc::scoped_refptr<VideoFrameBuffer> VideoFrameBuffer::GetScaledBuffer(
+    int width,
+    int height) {
+  if (width == this->width() && height == this->height())
+    return this;
+  rtc::scoped_refptr<VideoFrameBuffer> source(this);
+  if (native_handle())
+    source = NativeToI420Buffer();
+  rtc::scoped_refptr<I420Buffer> scaled_buffer =
+      I420Buffer::Create(width, height);
+  I420ScaleBilinear(*source, scaled_buffer.get());
+  return scaled_buffer;
+}
+
 I420Buffer::I420Buffer(int width, int height)
     : I420Buffer(width, height, width, (width + 1) / 2, (width + 1) / 2) {
 }
@@ -287,6 +311,164 @@ void* NativeHandleBuffer::native_handle() const {
   return native_handle_;
 }
 
+NV12Buffer::NV12Buffer(int width, int height)
+    : NV12Buffer(width, height, width, width + (width & 1)) {}
+
+NV12Buffer::NV12Buffer(int width, int height, int stride_y, int stride_uv)
+    : width_(width),
+      height_(height),
+      stride_y_(stride_y),
+      stride_uv_(stride_uv),
+      data_(static_cast<uint8_t*>(
+          AlignedMalloc(NV12DataSize(height, stride_y, stride_uv),
+                        kBufferAlignment))) {
+  RTC_DCHECK_GT(width, 0);
+  RTC_DCHECK_GT(height, 0);
+  RTC_DCHECK_GE(stride_y, width);
+  RTC_DCHECK_GE(stride_uv, 2 * ((width + 1) / 2));
+}
+
+NV12Buffer::~NV12Buffer() {}
+
+rtc::scoped_refptr<NV12Buffer> NV12Buffer::Create(int width, int height) {
+  return new rtc::RefCountedObject<NV12Buffer>(width, height);
+}
+
+rtc::scoped_refptr<NV12Buffer> NV12Buffer::Create(int width,
+                                                  int height,
+                                                  int stride_y,
+                                                  int stride_uv) {
+  return new rtc::RefCountedObject<NV12Buffer>(width, height, stride_y,
+                                               stride_uv);
+}
+
+rtc::scoped_refptr<NV12Buffer> NV12Buffer::Copy(int width,
+                                                int height,
+                                                const uint8_t* data_y,
+                                                int stride_y,
+                                                const uint8_t* data_uv,
+                                                int stride_uv) {
+  rtc::scoped_refptr<NV12Buffer> buffer = Create(width, height);
+  libyuv::CopyPlane(data_y, stride_y, buffer->MutableDataY(),
+                    buffer->StrideY(), width, height);
+  libyuv::CopyPlane(data_uv, stride_uv, buffer->MutableDataUV(),
+                    buffer->StrideUV(), 2 * ((width + 1) / 2),
+                    (height + 1) / 2);
+  return buffer;
+}
+
+VideoFrameBuffer::Type NV12Buffer::type() const {
+  return Type::kNV12;
+}
+
+int NV12Buffer::width() const {
+  return width_;
+}
+
+int NV12Buffer::height() const {
+  return height_;
+}
+
+const uint8_t* NV12Buffer::DataY() const {
+  return data_.get();
+}
+
+const uint8_t* NV12Buffer::DataU() const {
+  return GetI420Buffer()->DataU();
+}
+
+const uint8_t* NV12Buffer::DataV() const {
+  return GetI420Buffer()->DataV();
+}
+
+const uint8_t* NV12Buffer::DataUV() const {
+  return data_.get() + stride_y_ * height_;
+}
+
+uint8_t* NV12Buffer::MutableDataY() {
+  return const_cast<uint8_t*>(DataY());
+}
+
+uint8_t* NV12Buffer::MutableDataUV() {
+  return const_cast<uint8_t*>(DataUV());
+}
+
+int NV12Buffer::StrideY() const {
+  return stride_y_;
+}
+
+int NV12Buffer::StrideU() const {
+  return GetI420Buffer()->StrideU();
+}
+
+int NV12Buffer::StrideV() const {
+  return GetI420Buffer()->StrideV();
+}
+
+int NV12Buffer::StrideUV() const {
+  return stride_uv_;
+}
+
+void* NV12Buffer::native_handle() const {
+  return nullptr;
+}
+
+rtc::scoped_refptr<VideoFrameBuffer> NV12Buffer::NativeToI420Buffer() {
+  return GetI420Buffer();
+}
+
+rtc::scoped_refptr<VideoFrameBuffer> NV12Buffer::GetScaledBuffer(int width,
+                                                                 int height) {
+  if (width == width_ && height == height_)
+    return this;
+  rtc::scoped_refptr<NV12Buffer> scaled_buffer = Create(width, height);
+  scaled_buffer->CropAndScaleFrom(*this, 0, 0, width_, height_);
+  return scaled_buffer;
+}
+
+void NV12Buffer::CropAndScaleFrom(const NV12Buffer& src,
+                                  int offset_x,
+                                  int offset_y,
+                                  int crop_width,
+                                  int crop_height) {
+  RTC_CHECK_LE(crop_width + offset_x, src.width());
+  RTC_CHECK_LE(crop_height + offset_y, src.height());
+  RTC_CHECK_GE(offset_x, 0);
+  RTC_CHECK_GE(offset_y, 0);
+
+  // Make sure offset is even so that the uv plane becomes aligned.
+  offset_x &= ~1;
+  offset_y &= ~1;
+
+  std::vector<uint8_t> tmp_buffer;
+  NV12Scale(&tmp_buffer,
+            src.DataY() + src.StrideY() * offset_y + offset_x, src.StrideY(),
+            src.DataUV() + src.StrideUV() * (offset_y / 2) + offset_x,
+            src.StrideUV(), crop_width, crop_height,
+            MutableDataY(), StrideY(), MutableDataUV(), StrideUV(), width(),
+            height());
+}
+
+int NV12Buffer::num_i420_conversions() const {
+  rtc::CritScope lock(&crit_);
+  return i420_buffer_ ? 1 : 0;
+}
+
+rtc::scoped_refptr<VideoFrameBuffer> NV12Buffer::GetI420Buffer() const {
+  rtc::CritScope lock(&crit_);
+  if (!i420_buffer_) {
+    rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(width_, height_);
+    RTC_CHECK_EQ(0, libyuv::NV12ToI420(
+                        DataY(), StrideY(), DataUV(), StrideUV(),
+                        buffer->MutableDataY(), buffer->StrideY(),
+                        buffer->MutableDataU(), buffer->StrideU(),
+                        buffer->MutableDataV(), buffer->StrideV(), width_,
+                        height_));
+    i420_buffer_ = buffer;
+  }
+  return i420_buffer_;
+}
+
 WrappedI420Buffer::WrappedI420Buffer(int width,
                                      int height,
                                      const uint8_t* y_plane,
@@ -0,0 +1,137 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/common_video/include/video_frame_pyramid.h"
+
+#include <limits>
+#include <vector>
+
+#include "webrtc/base/checks.h"
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/thread_annotations.h"
+#include "webrtc/common_video/include/i420_buffer_pool.h"
+#include "webrtc/common_video/libyuv/include/webrtc_libyuv.h"
+
+namespace webrtc {
+
+namespace {
+
+// Enough sizes for the simulcast layers and other consumers of a source.
+const size_t kMaxNumberOfSizes = 8;
+
+}  // namespace
+
+// Hands out the buffers of the scaled versions. Shared by the pool and all
+// pyramids, which may live on any thread.
+class VideoFramePyramidPool::LevelAllocator {
+ public:
+  LevelAllocator()
+      : pool_(false,
+              std::numeric_limits<size_t>::max(),
+              kMaxNumberOfSizes,
+              std::numeric_limits<size_t>::max()),
+        num_scaled_buffers_(0) {}
+
+  rtc::scoped_refptr<I420Buffer> CreateBuffer(int width, int height) {
+    rtc::CritScope lock(&crit_);
+    ++num_scaled_buffers_;
+    return pool_.CreateBuffer(width, height);
+  }
+
+  int num_scaled_buffers() const {
+    rtc::CritScope lock(&crit_);
+    return num_scaled_buffers_;
+  }
+
+ private:
+  mutable rtc::CriticalSection crit_;
+  I420BufferPool pool_ GUARDED_BY(crit_);
+  int num_scaled_buffers_ GUARDED_BY(crit_);
+};
+
+// A frame buffer that forwards the pixel data of the original frame, and keeps
+// the scaled versions made by GetScaledBuffer().
+class VideoFramePyramidPool::Pyramid : public VideoFrameBuffer {
+ public:
+  Pyramid(const rtc::scoped_refptr<VideoFrameBuffer>& source,
+          const std::shared_ptr<LevelAllocator>& allocator)
+      : source_(source), allocator_(allocator) {
+    RTC_DCHECK(source->type() == VideoFrameBuffer::Type::kI420);
+  }
+
+  int width() const override { return source_->width(); }
+  int height() const override { return source_->height(); }
+  const uint8_t* DataY() const override { return source_->DataY(); }
+  const uint8_t* DataU() const override { return source_->DataU(); }
+  const uint8_t* DataV() const override { return source_->DataV(); }
+  int StrideY() const override { return source_->StrideY(); }
+  int StrideU() const override { return source_->StrideU(); }
+  int StrideV() const override { return source_->StrideV(); }
+  void* native_handle() const override { return nullptr; }
+
+  rtc::scoped_refptr<VideoFrameBuffer> NativeToI420Buffer() override {
+    RTC_NOTREACHED();
+    return nullptr;
+  }
+
+  rtc::scoped_refptr<VideoFrameBuffer> GetScaledBuffer(int width,
+                                                       int height) override {
+    if (width == source_->width() && height == source_->height())
+      return this;
+    {
+      rtc::CritScope lock(&crit_);
+      for (const rtc::scoped_refptr<VideoFrameBuffer>& level : levels_) {
+        if (level->width() == width && level->height() == height)
+          return level;
+      }
+    }
+    // Scale without the lock held, so that the consumers of different sizes
+    // (e.g., simulcast encoders on their own threads) can run in parallel.
+    // Each size is scaled from the original frame, so that it is the same as
+    // without the pyramid, whichever sizes were asked for before.
+    rtc::scoped_refptr<I420Buffer> scaled_buffer =
+        allocator_->CreateBuffer(width, height);
+    I420ScaleBilinear(*source_, scaled_buffer.get());
+
+    rtc::CritScope lock(&crit_);
+    for (const rtc::scoped_refptr<VideoFrameBuffer>& level : levels_) {
+      // Use the version of a consumer that got here first, so that all
+      // consumers see the same buffer.
+      if (level->width() == width && level->height() == height)
+        return level;
+    }
+    levels_.push_back(scaled_buffer);
+    return scaled_buffer;
+  }
+
+ private:
+  const rtc::scoped_refptr<VideoFrameBuffer> source_;
+  const std::shared_ptr<LevelAllocator> allocator_;
+  rtc::CriticalSection crit_;
+  std::vector<rtc::scoped_refptr<VideoFrameBuffer>> levels_ GUARDED_BY(crit_);
+};
+
+VideoFramePyramidPool::VideoFramePyramidPool()
+    : allocator_(new LevelAllocator()) {}
+
+VideoFramePyramidPool::~VideoFramePyramidPool() {}
+
+rtc::scoped_refptr<VideoFrameBuffer> VideoFramePyramidPool::Wrap(
+    const rtc::scoped_refptr<VideoFrameBuffer>& buffer) {
+  if (!buffer || buffer->type() != VideoFrameBuffer::Type::kI420)
+    return buffer;
+  return new rtc::RefCountedObject<Pyramid>(buffer, allocator_);
+}
+
+int VideoFramePyramidPool::num_scaled_buffers() const {
+  return allocator_->num_scaled_buffers();
+}
+
+}  // namespace webrtc
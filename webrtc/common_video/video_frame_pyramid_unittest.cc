@@ -0,0 +1,192 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "webrtc/base/timeutils.h"
+#include "webrtc/common_video/include/video_frame_pyramid.h"
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+class FakeNativeBuffer : public NativeHandleBuffer {
+ public:
+  FakeNativeBuffer(int width, int height)
+      : NativeHandleBuffer(this, width, height) {}
+
+  rtc::scoped_refptr<VideoFrameBuffer> NativeToI420Buffer() override {
+    return I420Buffer::Create(width_, height_);
+  }
+};
+
+rtc::scoped_refptr<I420Buffer> CreateGradientBuffer(int width, int height) {
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(width, height);
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x)
+      buffer->MutableDataY()[y * buffer->StrideY() + x] = (x + y) & 0xff;
+  }
+  for (int y = 0; y < (height + 1) / 2; ++y) {
+    for (int x = 0; x < (width + 1) / 2; ++x) {
+      buffer->MutableDataU()[y * buffer->StrideU() + x] = x & 0xff;
+      buffer->MutableDataV()[y * buffer->StrideV() + x] = y & 0xff;
+    }
+  }
+  return buffer;
+}
+
+}  // namespace
+
+TEST(VideoFramePyramidTest, ForwardsSourceFrame) {
+  VideoFramePyramidPool pool;
+  rtc::scoped_refptr<I420Buffer> source = CreateGradientBuffer(64, 48);
+  rtc::scoped_refptr<VideoFrameBuffer> pyramid = pool.Wrap(source);
+  EXPECT_NE(source.get(), pyramid.get());
+  EXPECT_EQ(64, pyramid->width());
+  EXPECT_EQ(48, pyramid->height());
+  EXPECT_EQ(source->DataY(), pyramid->DataY());
+  EXPECT_EQ(source->DataU(), pyramid->DataU());
+  EXPECT_EQ(source->DataV(), pyramid->DataV());
+  EXPECT_EQ(source->StrideY(), pyramid->StrideY());
+  EXPECT_EQ(source->StrideU(), pyramid->StrideU());
+  EXPECT_EQ(source->StrideV(), pyramid->StrideV());
+  EXPECT_EQ(nullptr, pyramid->native_handle());
+
+  EXPECT_EQ(pyramid.get(), pyramid->GetScaledBuffer(64, 48).get());
+  EXPECT_EQ(0, pool.num_scaled_buffers());
+}
+
+TEST(VideoFramePyramidTest, DoesNotWrapNativeBuffers) {
+  VideoFramePyramidPool pool;
+  rtc::scoped_refptr<VideoFrameBuffer> source(
+      new rtc::RefCountedObject<FakeNativeBuffer>(64, 48));
+  EXPECT_EQ(source.get(), pool.Wrap(source).get());
+}
+
+TEST(VideoFramePyramidTest, ScalesEachSizeOnce) {
+  VideoFramePyramidPool pool;
+  rtc::scoped_refptr<VideoFrameBuffer> pyramid =
+      pool.Wrap(CreateGradientBuffer(64, 48));
+
+  rtc::scoped_refptr<VideoFrameBuffer> half = pyramid->GetScaledBuffer(32, 24);
+  EXPECT_EQ(32, half->width());
+  EXPECT_EQ(24, half->height());
+  EXPECT_EQ(1, pool.num_scaled_buffers());
+  EXPECT_EQ(half.get(), pyramid->GetScaledBuffer(32, 24).get());
+  EXPECT_EQ(1, pool.num_scaled_buffers());
+
+  rtc::scoped_refptr<VideoFrameBuffer> quarter =
+      pyramid->GetScaledBuffer(16, 12);
+  EXPECT_EQ(16, quarter->width());
+  EXPECT_EQ(12, quarter->height());
+  EXPECT_EQ(2, pool.num_scaled_buffers());
+  EXPECT_EQ(half.get(), pyramid->GetScaledBuffer(32, 24).get());
+  EXPECT_EQ(quarter.get(), pyramid->GetScaledBuffer(16, 12).get());
+  EXPECT_EQ(2, pool.num_scaled_buffers());
+}
+
+TEST(VideoFramePyramidTest, ScalesLikePlainBuffers) {
+  VideoFramePyramidPool pool;
+  rtc::scoped_refptr<VideoFrameBuffer> source = CreateGradientBuffer(64, 48);
+  rtc::scoped_refptr<VideoFrameBuffer> pyramid = pool.Wrap(source);
+  pyramid->GetScaledBuffer(32, 24);
+
+  // Not scaled from the 32x24 version.
+  rtc::scoped_refptr<VideoFrameBuffer> quarter =
+      pyramid->GetScaledBuffer(16, 12);
+  rtc::scoped_refptr<VideoFrameBuffer> expected =
+      source->GetScaledBuffer(16, 12);
+  for (int y = 0; y < 12; ++y) {
+    EXPECT_EQ(0, memcmp(expected->DataY() + y * expected->StrideY(),
+                        quarter->DataY() + y * quarter->StrideY(), 16));
+  }
+  for (int y = 0; y < 6; ++y) {
+    EXPECT_EQ(0, memcmp(expected->DataU() + y * expected->StrideU(),
+                        quarter->DataU() + y * quarter->StrideU(), 8));
+    EXPECT_EQ(0, memcmp(expected->DataV() + y * expected->StrideV(),
+                        quarter->DataV() + y * quarter->StrideV(), 8));
+  }
+}
+
+TEST(VideoFramePyramidTest, PlainBuffersAreScaledOnEveryCall) {
+  rtc::scoped_refptr<VideoFrameBuffer> buffer = CreateGradientBuffer(64, 48);
+  EXPECT_EQ(buffer.get(), buffer->GetScaledBuffer(64, 48).get());
+  rtc::scoped_refptr<VideoFrameBuffer> half = buffer->GetScaledBuffer(32, 24);
+  EXPECT_EQ(32, half->width());
+  EXPECT_EQ(24, half->height());
+  EXPECT_NE(half.get(), buffer->GetScaledBuffer(32, 24).get());
+}
+
+TEST(VideoFramePyramidTest, ReusesMemoryOfReleasedFrames) {
+  VideoFramePyramidPool pool;
+  rtc::scoped_refptr<VideoFrameBuffer> pyramid =
+      pool.Wrap(CreateGradientBuffer(64, 48));
+  const uint8_t* y_ptr = pyramid->GetScaledBuffer(32, 24)->DataY();
+  pyramid = nullptr;
+
+  pyramid = pool.Wrap(CreateGradientBuffer(64, 48));
+  EXPECT_EQ(y_ptr, pyramid->GetScaledBuffer(32, 24)->DataY());
+  EXPECT_EQ(2, pool.num_scaled_buffers());
+}
+
+TEST(VideoFramePyramidTest, ScaledBuffersOutliveThePool) {
+  rtc::scoped_refptr<VideoFrameBuffer> pyramid;
+  {
+    VideoFramePyramidPool pool;
+    pyramid = pool.Wrap(CreateGradientBuffer(64, 48));
+  }
+  rtc::scoped_refptr<VideoFrameBuffer> half = pyramid->GetScaledBuffer(32, 24);
+  EXPECT_EQ(32, half->width());
+  EXPECT_EQ(24, half->height());
+}
+
+// Counts the scale operations per captured frame when a 720p source feeds a
+// three layer simulcast encoder and a local preview at the size of the middle
+// layer, with and without the frames wrapped in a pyramid.
+TEST(VideoFramePyramidTest, DISABLED_ScaleOperationsPerFrameWithSimulcast) {
+  const int kNumFrames = 300;
+  const int kLayerWidths[] = {320, 640, 1280};
+  const int kLayerHeights[] = {180, 360, 720};
+  const int kPreviewWidth = 640;
+  const int kPreviewHeight = 360;
+  rtc::scoped_refptr<I420Buffer> source = CreateGradientBuffer(1280, 720);
+
+  for (bool use_pyramid : {false, true}) {
+    VideoFramePyramidPool pool;
+    int num_scale_operations = 0;
+    const int64_t start_us = rtc::TimeMicros();
+    for (int i = 0; i < kNumFrames; ++i) {
+      rtc::scoped_refptr<VideoFrameBuffer> frame =
+          use_pyramid ? pool.Wrap(source)
+                      : rtc::scoped_refptr<VideoFrameBuffer>(source);
+      for (size_t layer = 0; layer < 3; ++layer) {
+        rtc::scoped_refptr<VideoFrameBuffer> scaled =
+            frame->GetScaledBuffer(kLayerWidths[layer], kLayerHeights[layer]);
+        if (!use_pyramid && scaled.get() != frame.get())
+          ++num_scale_operations;
+      }
+      rtc::scoped_refptr<VideoFrameBuffer> preview =
+          frame->GetScaledBuffer(kPreviewWidth, kPreviewHeight);
+      if (!use_pyramid && preview.get() != frame.get())
+        ++num_scale_operations;
+    }
+    const int64_t elapsed_us = rtc::TimeMicros() - start_us;
+    if (use_pyramid)
+      num_scale_operations = pool.num_scaled_buffers();
+    printf("%s: %.2f scale operations per frame, %.1f us per frame\n",
+           use_pyramid ? "Pyramid" : "No pyramid",
+           static_cast<double>(num_scale_operations) / kNumFrames,
+           static_cast<double>(elapsed_us) / kNumFrames);
+  }
+}
+
+}  // namespace webrtc
@@ -51,7 +51,7 @@ namespace webrtc {
 
 class RtcEventLogImpl final : public RtcEventLog {
  public:
-  explicit RtcEventLogImpl(const Clock* clock);
+  RtcEventLogImpl(const Clock* clock, RtpEncoding rtp_encoding);
   ~RtcEventLogImpl() override;
 
   bool StartLogging(const std::string& file_name,
@@ -87,6 +87,11 @@ class RtcEventLogImpl final : public RtcEventLog {
   // Message queue for passing events to the logging thread.
   SwapQueue<std::unique_ptr<rtclog::Event> > event_queue_;
 
+  // Message queue for passing RTP headers to the logging thread, with
+  // RtpEncoding::kBatched.
+  const std::unique_ptr<SwapQueue<RtcEventLogHelperThread::RtpHeaderMessage>>
+      rtp_header_queue_;
+
   const Clock* const clock_;
 
   RtcEventLogHelperThread helper_thread_;
@@ -133,15 +138,27 @@ rtclog::MediaType ConvertMediaType(MediaType media_type) {
 // sent packets because they also contain received packets.
 static const int kEventsPerSecond = 1000;
 static const int kControlMessagesPerSecond = 10;
+
+// Longer headers are logged as individual RTP events.
+const size_t kMaxBatchedRtpHeaderLength =
+    RtcEventLogHelperThread::RtpHeaderMessage::kMaxHeaderLength;
 }  // namespace
 
 // RtcEventLogImpl member functions.
-RtcEventLogImpl::RtcEventLogImpl(const Clock* clock)
+RtcEventLogImpl::RtcEventLogImpl(const Clock* clock, RtpEncoding rtp_encoding)
     // Allocate buffers for roughly one second of history.
     : message_queue_(kControlMessagesPerSecond),
       event_queue_(kEventsPerSecond),
+      rtp_header_queue_(
+          rtp_encoding == RtpEncoding::kBatched
+              ? new SwapQueue<RtcEventLogHelperThread::RtpHeaderMessage>(
+                    kEventsPerSecond)
+              : nullptr),
       clock_(clock),
-      helper_thread_(&message_queue_, &event_queue_, clock),
+      helper_thread_(&message_queue_,
+                     &event_queue_,
+                     rtp_header_queue_.get(),
+                     clock),
       thread_checker_() {
   thread_checker_.DetachFromThread();
 }
@@ -355,6 +372,21 @@ void RtcEventLogImpl::LogRtpHeader(PacketDirection direction,
     header_length += (x_len + 1) * 4;
   }
 
+  if (rtp_header_queue_ && header_length <= kMaxBatchedRtpHeaderLength) {
+    RtcEventLogHelperThread::RtpHeaderMessage message;
+    message.timestamp_us = clock_->TimeInMicroseconds();
+    message.incoming = direction == kIncomingPacket;
+    message.media_type = ConvertMediaType(media_type);
+    message.packet_length = packet_length;
+    message.header_length = header_length;
+    memcpy(message.header, header, header_length);
+    if (!rtp_header_queue_->Insert(&message)) {
+      LOG(LS_ERROR) << "WebRTC event log queue full. Dropping event.";
+    }
+    helper_thread_.SignalNewEvent();
+    return;
+  }
+
   std::unique_ptr<rtclog::Event> rtp_event(new rtclog::Event());
   rtp_event->set_timestamp_us(clock_->TimeInMicroseconds());
   rtp_event->set_type(rtclog::Event::RTP_EVENT);
@@ -473,8 +505,13 @@ bool RtcEventLogNullImpl::StartLogging(rtc::PlatformFile platform_file,
 
 // RtcEventLog member functions.
 std::unique_ptr<RtcEventLog> RtcEventLog::Create(const Clock* clock) {
+  return Create(clock, RtpEncoding::kPerPacket);
+}
+
+std::unique_ptr<RtcEventLog> RtcEventLog::Create(const Clock* clock,
+                                                 RtpEncoding rtp_encoding) {
 #ifdef ENABLE_RTC_EVENT_LOG
-  return std::unique_ptr<RtcEventLog>(new RtcEventLogImpl(clock));
+  return std::unique_ptr<RtcEventLog>(new RtcEventLogImpl(clock, rtp_encoding));
 #else
   return std::unique_ptr<RtcEventLog>(new RtcEventLogNullImpl());
 #endif  // ENABLE_RTC_EVENT_LOG
@@ -20,7 +20,24 @@
 namespace webrtc {
 
 namespace {
-const int kEventsInHistory = 10000;
+// The history holds at most kEventsInHistory events, where each packet of a
+// batch counts as one event, like it did before RTP headers were batched. A
+// batched packet takes at most ~140 bytes (a header of up to
+// RtpHeaderMessage::kMaxHeaderLength bytes, less the fields that are delta
+// encoded, plus their varints) and typically ~30 bytes, so the history takes
+// no more memory than with one event per packet.
+const size_t kEventsInHistory = 10000;
+// Small enough that the encoded batches stay far below the maximum event size
+// of the parser.
+const size_t kMaxRtpPacketsPerBatch = 16;
+
+// The number of events that |event| counts as in the history.
+size_t NumberOfEvents(const rtclog::Event& event) {
+  if (event.type() == rtclog::Event::RTP_PACKET_BATCH_EVENT) {
+    return event.rtp_packet_batch().number_of_packets();
+  }
+  return 1;
+}
 
 bool IsConfigEvent(const rtclog::Event& event) {
   rtclog::Event_EventType event_type = event.type();
@@ -35,10 +52,13 @@ bool IsConfigEvent(const rtclog::Event& event) {
 RtcEventLogHelperThread::RtcEventLogHelperThread(
     SwapQueue<ControlMessage>* message_queue,
     SwapQueue<std::unique_ptr<rtclog::Event>>* event_queue,
+    SwapQueue<RtpHeaderMessage>* rtp_header_queue,
     const Clock* const clock)
     : message_queue_(message_queue),
       event_queue_(event_queue),
+      rtp_header_queue_(rtp_header_queue),
       history_(kEventsInHistory),
+      events_in_history_(0),
       config_history_(),
       file_(FileWrapper::Create()),
       thread_(&ThreadOutputFunction, this, "RtcEventLog thread"),
@@ -48,6 +68,7 @@ RtcEventLogHelperThread::RtcEventLogHelperThread(
       stop_time_(std::numeric_limits<int64_t>::max()),
       has_recent_event_(false),
       most_recent_event_(),
+      has_recent_rtp_header_(false),
       output_string_(),
       wake_periodically_(false, false),
       wake_from_hibernation_(false, false),
@@ -106,31 +127,96 @@ bool RtcEventLogHelperThread::AppendEventToString(rtclog::Event* event) {
   return stop;
 }
 
+bool RtcEventLogHelperThread::AppendRtpBatchToString() {
+  if (rtp_batch_.num_packets() == 0) {
+    return false;
+  }
+  rtclog::Event batch_event;
+  rtp_batch_.Finish(&batch_event);
+  return AppendEventToString(&batch_event);
+}
+
+void RtcEventLogHelperThread::MoveRtpBatchToHistory() {
+  if (rtp_batch_.num_packets() == 0) {
+    return;
+  }
+  std::unique_ptr<rtclog::Event> batch_event(new rtclog::Event());
+  rtp_batch_.Finish(batch_event.get());
+  AddToHistory(std::move(batch_event));
+}
+
+void RtcEventLogHelperThread::AddToHistory(
+    std::unique_ptr<rtclog::Event> event) {
+  const size_t num_events = NumberOfEvents(*event);
+  // Every entry counts as at least one event, so |history_| never has to
+  // discard entries on its own.
+  while (!history_.empty() &&
+         events_in_history_ + num_events > kEventsInHistory) {
+    events_in_history_ -= NumberOfEvents(*history_.front());
+    history_.pop_front();
+  }
+  events_in_history_ += num_events;
+  history_.push_back(std::move(event));
+}
+
+void RtcEventLogHelperThread::ReadNextEvents() {
+  if (!has_recent_event_) {
+    has_recent_event_ = event_queue_->Remove(&most_recent_event_);
+  }
+  if (rtp_header_queue_ && !has_recent_rtp_header_) {
+    has_recent_rtp_header_ =
+        rtp_header_queue_->Remove(&most_recent_rtp_header_);
+  }
+}
+
+bool RtcEventLogHelperThread::RtpHeaderIsNext() const {
+  return has_recent_rtp_header_ &&
+         (!has_recent_event_ || most_recent_rtp_header_.timestamp_us <
+                                    most_recent_event_->timestamp_us());
+}
+
 bool RtcEventLogHelperThread::LogToMemory() {
   RTC_DCHECK(!file_->is_open());
   bool message_received = false;
 
   // Process each event earlier than the current time and append it to the
-  // appropriate history_.
+  // appropriate history_. Batched RTP headers are added to the history as
+  // soon as another event comes in between, so that the order is kept.
   int64_t current_time = clock_->TimeInMicroseconds();
-  if (!has_recent_event_) {
-    has_recent_event_ = event_queue_->Remove(&most_recent_event_);
-  }
-  while (has_recent_event_ &&
-         most_recent_event_->timestamp_us() <= current_time) {
-    if (IsConfigEvent(*most_recent_event_)) {
-      config_history_.push_back(std::move(most_recent_event_));
+  while (true) {
+    ReadNextEvents();
+    if (RtpHeaderIsNext()) {
+      if (most_recent_rtp_header_.timestamp_us > current_time) {
+        break;
+      }
+      const RtpHeaderMessage& rtp = most_recent_rtp_header_;
+      rtp_batch_.AddPacket(rtp.timestamp_us, rtp.incoming, rtp.media_type,
+                           rtp.header, rtp.header_length, rtp.packet_length);
+      has_recent_rtp_header_ = false;
+      if (rtp_batch_.num_packets() >= kMaxRtpPacketsPerBatch) {
+        MoveRtpBatchToHistory();
+      }
+    } else if (has_recent_event_ &&
+               most_recent_event_->timestamp_us() <= current_time) {
+      MoveRtpBatchToHistory();
+      if (IsConfigEvent(*most_recent_event_)) {
+        config_history_.push_back(std::move(most_recent_event_));
+      } else {
+        AddToHistory(std::move(most_recent_event_));
+      }
+      has_recent_event_ = false;
     } else {
-      history_.push_back(std::move(most_recent_event_));
+      break;
     }
-    has_recent_event_ = event_queue_->Remove(&most_recent_event_);
     message_received = true;
   }
+  MoveRtpBatchToHistory();
   return message_received;
 }
 
 void RtcEventLogHelperThread::StartLogFile() {
   RTC_DCHECK(file_->is_open());
+  RTC_DCHECK_EQ(rtp_batch_.num_packets(), 0u);
   bool stop = false;
   output_string_.clear();
 
@@ -149,6 +235,7 @@ void RtcEventLogHelperThread::StartLogFile() {
   while (!history_.empty() && !stop) {
     stop = AppendEventToString(history_.front().get());
     if (!stop) {
+      events_in_history_ -= NumberOfEvents(*history_.front());
       history_.pop_front();
     }
   }
@@ -180,23 +267,42 @@ bool RtcEventLogHelperThread::LogToFile() {
 
   // Append each event older than both the current time and the stop time
   // to the output_string_.
+  // Batched RTP headers are written as soon as another event comes in
+  // between, so that the order is kept.
   int64_t current_time = clock_->TimeInMicroseconds();
   int64_t time_limit = std::min(current_time, stop_time_);
-  if (!has_recent_event_) {
-    has_recent_event_ = event_queue_->Remove(&most_recent_event_);
-  }
   bool stop = false;
-  while (!stop && has_recent_event_ &&
-         most_recent_event_->timestamp_us() <= time_limit) {
-    stop = AppendEventToString(most_recent_event_.get());
-    if (!stop) {
-      if (IsConfigEvent(*most_recent_event_)) {
-        config_history_.push_back(std::move(most_recent_event_));
+  while (!stop) {
+    ReadNextEvents();
+    if (RtpHeaderIsNext()) {
+      if (most_recent_rtp_header_.timestamp_us > time_limit) {
+        break;
+      }
+      const RtpHeaderMessage& rtp = most_recent_rtp_header_;
+      rtp_batch_.AddPacket(rtp.timestamp_us, rtp.incoming, rtp.media_type,
+                           rtp.header, rtp.header_length, rtp.packet_length);
+      has_recent_rtp_header_ = false;
+      if (rtp_batch_.num_packets() >= kMaxRtpPacketsPerBatch) {
+        stop = AppendRtpBatchToString();
+      }
+    } else if (has_recent_event_ &&
+               most_recent_event_->timestamp_us() <= time_limit) {
+      stop = AppendRtpBatchToString() ||
+             AppendEventToString(most_recent_event_.get());
+      if (!stop) {
+        if (IsConfigEvent(*most_recent_event_)) {
+          config_history_.push_back(std::move(most_recent_event_));
+        }
+        has_recent_event_ = false;
       }
-      has_recent_event_ = event_queue_->Remove(&most_recent_event_);
+    } else {
+      break;
     }
     message_received = true;
   }
+  if (!stop) {
+    stop = AppendRtpBatchToString();
+  }
 
   // Write string to file.
   if (!file_->Write(output_string_.data(), output_string_.size())) {
@@ -212,6 +318,8 @@ bool RtcEventLogHelperThread::LogToFile() {
   // time limit, or in other words if we have terminated the loop despite
   // having more events in the queue.
   if ((has_recent_event_ && most_recent_event_->timestamp_us() > stop_time_) ||
+      (has_recent_rtp_header_ &&
+       most_recent_rtp_header_.timestamp_us > stop_time_) ||
       stop) {
     RTC_DCHECK(file_->is_open());
     StopLogFile();
@@ -23,6 +23,7 @@
 #include "webrtc/base/platform_thread.h"
 #include "webrtc/base/swap_queue.h"
 #include "webrtc/logging/rtc_event_log/ringbuffer.h"
+#include "webrtc/logging/rtc_event_log/rtp_packet_batch.h"
 #include "webrtc/system_wrappers/include/clock.h"
 #include "webrtc/system_wrappers/include/file_wrapper.h"
 
@@ -67,9 +68,27 @@ class RtcEventLogHelperThread final {
     }
   };
 
+  // An RTP header to be logged in an RTP_PACKET_BATCH_EVENT. The header is
+  // stored inline, so that the message can be passed through the queue
+  // without any allocation. Longer headers are logged as RTP_EVENTs.
+  struct RtpHeaderMessage {
+    static const size_t kMaxHeaderLength = 128;
+
+    int64_t timestamp_us = 0;
+    bool incoming = false;
+    rtclog::MediaType media_type = rtclog::ANY;
+    size_t packet_length = 0;
+    size_t header_length = 0;
+    uint8_t header[kMaxHeaderLength];
+  };
+
+  // If |rtp_header_queue| is non-null, the RTP headers from that queue are
+  // logged in batches, merged with the events from |event_queue| in
+  // timestamp order.
   RtcEventLogHelperThread(
       SwapQueue<ControlMessage>* message_queue,
       SwapQueue<std::unique_ptr<rtclog::Event>>* event_queue,
+      SwapQueue<RtpHeaderMessage>* rtp_header_queue,
       const Clock* const clock);
   ~RtcEventLogHelperThread();
 
@@ -86,6 +105,11 @@ class RtcEventLogHelperThread final {
   static bool ThreadOutputFunction(void* obj);
 
   bool AppendEventToString(rtclog::Event* event);
+  bool AppendRtpBatchToString();
+  void MoveRtpBatchToHistory();
+  void AddToHistory(std::unique_ptr<rtclog::Event> event);
+  void ReadNextEvents();
+  bool RtpHeaderIsNext() const;
   bool LogToMemory();
   void StartLogFile();
   bool LogToFile();
@@ -95,9 +119,12 @@ class RtcEventLogHelperThread final {
   // Message queues for passing events to the logging thread.
   SwapQueue<ControlMessage>* message_queue_;
   SwapQueue<std::unique_ptr<rtclog::Event>>* event_queue_;
+  SwapQueue<RtpHeaderMessage>* rtp_header_queue_;
 
-  // History containing the most recent events (~ 10 s).
+  // History containing the most recent events (~ 10 s). The number of events
+  // is bounded, where each packet of an RTP_PACKET_BATCH_EVENT counts as one.
   RingBuffer<std::unique_ptr<rtclog::Event>> history_;
+  size_t events_in_history_;
 
   // History containing all past configuration events.
   std::vector<std::unique_ptr<rtclog::Event>> config_history_;
@@ -112,6 +139,11 @@ class RtcEventLogHelperThread final {
 
   bool has_recent_event_;
   std::unique_ptr<rtclog::Event> most_recent_event_;
+  bool has_recent_rtp_header_;
+  RtpHeaderMessage most_recent_rtp_header_;
+
+  // The RTP headers that are not yet written to file or history.
+  RtpPacketBatchEncoder rtp_batch_;
 
   // Temporary space for serializing profobuf data.
   std::string output_string_;
@@ -11,15 +11,27 @@
 #include "webrtc/logging/rtc_event_log/rtc_event_log_parser.h"
 
 #include <string.h>
-
+#if defined(WEBRTC_POSIX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
 #include <fstream>
 #include <istream>
+#include <iterator>
+#include <limits>
 #include <utility>
 
 #include "webrtc/base/checks.h"
 #include "webrtc/base/logging.h"
+#include "webrtc/base/optional.h"
+#include "webrtc/base/platform_thread.h"
 #include "webrtc/call.h"
 #include "webrtc/logging/rtc_event_log/rtc_event_log.h"
+#include "webrtc/logging/rtc_event_log/rtp_packet_batch.h"
 #include "webrtc/modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "webrtc/system_wrappers/include/file_wrapper.h"
 
@@ -79,29 +91,83 @@ ParsedRtcEventLog::EventType GetRuntimeEventType(
       return ParsedRtcEventLog::EventType::AUDIO_RECEIVER_CONFIG_EVENT;
     case rtclog::Event::AUDIO_SENDER_CONFIG_EVENT:
       return ParsedRtcEventLog::EventType::AUDIO_SENDER_CONFIG_EVENT;
+    case rtclog::Event::RTP_PACKET_BATCH_EVENT:
+      // Batches are split into RTP events when the log is parsed.
+      RTC_NOTREACHED();
+      return ParsedRtcEventLog::EventType::UNKNOWN_EVENT;
   }
   RTC_NOTREACHED();
   return ParsedRtcEventLog::EventType::UNKNOWN_EVENT;
 }
 
-std::pair<uint64_t, bool> ParseVarInt(std::istream& stream) {
-  uint64_t varint = 0;
-  for (size_t bytes_read = 0; bytes_read < 10; ++bytes_read) {
+const size_t kEventsPerChunk = 1024;
+const size_t kDefaultMaxDecodedEvents = 1 << 18;
+
+// Reads a varint at |*position| in |data| and advances |*position| past it.
+bool ReadVarInt(const uint8_t* data,
+                size_t size,
+                size_t* position,
+                uint64_t* varint) {
+  *varint = 0;
+  for (size_t bytes_read = 0; bytes_read < 10 && *position < size;
+       ++bytes_read) {
     // The most significant bit of each byte is 0 if it is the last byte in
     // the varint and 1 otherwise. Thus, we take the 7 least significant bits
     // of each byte and shift them 7 bits for each byte read previously to get
     // the (unsigned) integer.
-    int byte = stream.get();
-    if (stream.eof()) {
-      return std::make_pair(varint, false);
-    }
-    RTC_DCHECK(0 <= byte && byte <= 255);
-    varint |= static_cast<uint64_t>(byte & 0x7F) << (7 * bytes_read);
+    const uint8_t byte = data[(*position)++];
+    *varint |= static_cast<uint64_t>(byte & 0x7F) << (7 * bytes_read);
     if ((byte & 0x80) == 0) {
-      return std::make_pair(varint, true);
+      return true;
+    }
+  }
+  return false;
+}
+
+// Finds the timestamp (field 1) and type (field 2) of a serialized
+// rtclog::Event by skipping over the other fields, which is much cheaper than
+// parsing the whole event. Returns false if the event is malformed before
+// both fields have been found.
+bool ScanEvent(const uint8_t* data,
+               size_t size,
+               rtc::Optional<int64_t>* timestamp_us,
+               rtc::Optional<uint64_t>* type) {
+  size_t position = 0;
+  while (position < size && !(*timestamp_us && *type)) {
+    uint64_t tag;
+    uint64_t value;
+    if (!ReadVarInt(data, size, &position, &tag)) {
+      return false;
+    }
+    switch (tag & 0x7) {
+      case 0:  // Varint.
+        if (!ReadVarInt(data, size, &position, &value)) {
+          return false;
+        }
+        if ((tag >> 3) == 1) {
+          *timestamp_us = rtc::Optional<int64_t>(static_cast<int64_t>(value));
+        } else if ((tag >> 3) == 2) {
+          *type = rtc::Optional<uint64_t>(value);
+        }
+        break;
+      case 1:  // 64-bit.
+        position += 8;
+        break;
+      case 2:  // Length delimited.
+        if (!ReadVarInt(data, size, &position, &value) ||
+            value > size - position) {
+          return false;
+        }
+        position += value;
+        break;
+      case 5:  // 32-bit.
+        position += 4;
+        break;
+      default:
+        return false;
     }
   }
-  return std::make_pair(varint, false);
+  return position <= size;
 }
 
 void GetHeaderExtensions(
@@ -120,7 +186,93 @@ void GetHeaderExtensions(
 
 }  // namespace
 
+// The serialized log, either owned in memory or memory mapped from a file.
+class ParsedRtcEventLog::LogData {
+ public:
+  // Takes over the contents of |buffer|.
+  explicit LogData(std::string* buffer) {
+    buffer_.swap(*buffer);
+    data_ = reinterpret_cast<const uint8_t*>(buffer_.data());
+    size_ = buffer_.size();
+  }
+
+#if defined(WEBRTC_POSIX)
+  // Returns nullptr if the file could not be mapped.
+  static std::unique_ptr<LogData> MapFile(const std::string& file_name) {
+    int fd = open(file_name.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return nullptr;
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0) {
+      close(fd);
+      return nullptr;
+    }
+    std::unique_ptr<LogData> log_data;
+    const size_t size = static_cast<size_t>(file_stat.st_size);
+    if (size == 0) {
+      // Empty files can not be mapped.
+      std::string empty;
+      log_data.reset(new LogData(&empty));
+    } else {
+      void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mapping != MAP_FAILED) {
+        log_data.reset(new LogData(mapping, size));
+      }
+    }
+    close(fd);
+    return log_data;
+  }
+#endif
+
+  ~LogData() {
+#if defined(WEBRTC_POSIX)
+    if (mapping_) {
+      munmap(mapping_, size_);
+    }
+#endif
+  }
+
+  const uint8_t* data() const { return data_; }
+  size_t size() const { return size_; }
+
+ private:
+  LogData(void* mapping, size_t size)
+      : mapping_(mapping),
+        data_(static_cast<const uint8_t*>(mapping)),
+        size_(size) {}
+
+  std::string buffer_;
+  void* mapping_ = nullptr;
+  const uint8_t* data_;
+  size_t size_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(LogData);
+};
+
+// The chunks decoded by one thread in DecodeEvents().
+struct ParsedRtcEventLog::DecodeTask {
+  const ParsedRtcEventLog* log = nullptr;
+  std::vector<size_t> chunk_indices;
+  std::vector<std::unique_ptr<Chunk>> chunks;
+};
+
+const size_t ParsedRtcEventLog::kNumEventTypes;
+
+ParsedRtcEventLog::ParsedRtcEventLog()
+    : max_decoded_chunks_(kDefaultMaxDecodedEvents / kEventsPerChunk) {}
+
+ParsedRtcEventLog::~ParsedRtcEventLog() = default;
+
 bool ParsedRtcEventLog::ParseFile(const std::string& filename) {
+#if defined(WEBRTC_POSIX)
+  std::unique_ptr<LogData> log_data = LogData::MapFile(filename);
+  if (!log_data) {
+    LOG(LS_WARNING) << "Could not open file for reading.";
+    return false;
+  }
+  return ParseLogData(std::move(log_data));
+#else
   std::ifstream file(filename, std::ios_base::in | std::ios_base::binary);
   if (!file.good() || !file.is_open()) {
     LOG(LS_WARNING) << "Could not open file for reading.";
@@ -128,68 +280,131 @@ bool ParsedRtcEventLog::ParseFile(const std::string& filename) {
   }
 
   return ParseStream(file);
+#endif
 }
 
 bool ParsedRtcEventLog::ParseString(const std::string& s) {
-  std::istringstream stream(s, std::ios_base::in | std::ios_base::binary);
-  return ParseStream(stream);
+  std::string buffer(s);
+  return ParseLogData(std::unique_ptr<LogData>(new LogData(&buffer)));
 }
 
 bool ParsedRtcEventLog::ParseStream(std::istream& stream) {
-  events_.clear();
-  const size_t kMaxEventSize = (1u << 16) - 1;
-  std::vector<char> tmp_buffer(kMaxEventSize);
-  uint64_t tag;
-  uint64_t message_length;
-  bool success;
-
   RTC_DCHECK(stream.good());
+  std::string buffer((std::istreambuf_iterator<char>(stream)),
+                     std::istreambuf_iterator<char>());
+  return ParseLogData(std::unique_ptr<LogData>(new LogData(&buffer)));
+}
 
-  while (1) {
-    // Check whether we have reached end of file.
-    stream.peek();
-    if (stream.eof()) {
-      return true;
-    }
+bool ParsedRtcEventLog::ParseLogData(std::unique_ptr<LogData> log_data) {
+  {
+    rtc::CritScope lock(&crit_);
+    chunks_.clear();
+    decoded_chunks_.clear();
+  }
+  events_.clear();
+  for (std::vector<size_t>& indices : event_indices_) {
+    indices.clear();
+  }
+  log_data_ = std::move(log_data);
 
+  const size_t kMaxEventSize = (1u << 16) - 1;
+  const uint8_t* data = log_data_->data();
+  const size_t size = log_data_->size();
+  size_t position = 0;
+  bool success = true;
+  while (success && position < size) {
     // Read the next message tag. The tag number is defined as
     // (fieldnumber << 3) | wire_type. In our case, the field number is
     // supposed to be 1 and the wire type for an length-delimited field is 2.
     const uint64_t kExpectedTag = (1 << 3) | 2;
-    std::tie(tag, success) = ParseVarInt(stream);
-    if (!success) {
+    uint64_t tag;
+    if (!ReadVarInt(data, size, &position, &tag)) {
       LOG(LS_WARNING) << "Missing field tag from beginning of protobuf event.";
-      return false;
+      success = false;
+      break;
     } else if (tag != kExpectedTag) {
       LOG(LS_WARNING) << "Unexpected field tag at beginning of protobuf event.";
-      return false;
+      success = false;
+      break;
     }
 
     // Read the length field.
-    std::tie(message_length, success) = ParseVarInt(stream);
-    if (!success) {
+    uint64_t message_length;
+    if (!ReadVarInt(data, size, &position, &message_length)) {
       LOG(LS_WARNING) << "Missing message length after protobuf field tag.";
-      return false;
+      success = false;
+      break;
     } else if (message_length > kMaxEventSize) {
       LOG(LS_WARNING) << "Protobuf message length is too large.";
-      return false;
+      success = false;
+      break;
     }
 
-    // Read the next protobuf event to a temporary char buffer.
-    stream.read(tmp_buffer.data(), message_length);
-    if (stream.gcount() != static_cast<int>(message_length)) {
+    if (message_length > size - position) {
       LOG(LS_WARNING) << "Failed to read protobuf message from file.";
-      return false;
+      success = false;
+      break;
     }
+    success = IndexEvent(position, message_length);
+    position += message_length;
+  }
 
-    // Parse the protobuf event from the buffer.
-    rtclog::Event event;
-    if (!event.ParseFromArray(tmp_buffer.data(), message_length)) {
-      LOG(LS_WARNING) << "Failed to parse protobuf message.";
+  rtc::CritScope lock(&crit_);
+  chunks_.resize((events_.size() + kEventsPerChunk - 1) / kEventsPerChunk);
+  return success;
+}
+
+bool ParsedRtcEventLog::IndexEvent(size_t offset, size_t length) {
+  const uint8_t* data = log_data_->data() + offset;
+  rtc::Optional<int64_t> timestamp_us;
+  rtc::Optional<uint64_t> type;
+  if (!ScanEvent(data, length, &timestamp_us, &type)) {
+    LOG(LS_WARNING) << "Failed to parse protobuf message.";
+    return false;
+  }
+
+  EventIndex index;
+  index.timestamp_us = timestamp_us.value_or(0);
+  index.offset = offset;
+  index.length = static_cast<uint32_t>(length);
+  index.in_batch = false;
+  index.batch_position = 0;
+  index.has_timestamp = static_cast<bool>(timestamp_us);
+  // Like the protobuf parser, treat unknown enum values as a missing type.
+  index.has_type = type && *type <= std::numeric_limits<int>::max() &&
+                   rtclog::Event::EventType_IsValid(static_cast<int>(*type));
+  index.type = UNKNOWN_EVENT;
+
+  if (index.has_type &&
+      *type == static_cast<uint64_t>(rtclog::Event::RTP_PACKET_BATCH_EVENT)) {
+    // The timestamps of the packets are delta encoded in the batch, so the
+    // batch has to be decoded already here.
+    rtclog::Event batch_event;
+    std::vector<rtclog::Event> packets;
+    if (!batch_event.ParseFromArray(data, length) ||
+        !DecodeRtpPacketBatch(batch_event, &packets)) {
+      LOG(LS_WARNING) << "Failed to decode batch of RTP packets.";
       return false;
     }
-    events_.push_back(event);
+    index.in_batch = true;
+    index.type = RTP_EVENT;
+    for (const rtclog::Event& packet : packets) {
+      index.has_timestamp = packet.has_timestamp_us();
+      index.timestamp_us = packet.timestamp_us();
+      event_indices_[index.type].push_back(events_.size());
+      events_.push_back(index);
+      ++index.batch_position;
+    }
+    return true;
   }
+
+  if (index.has_type) {
+    index.type = GetRuntimeEventType(
+        static_cast<rtclog::Event::EventType>(static_cast<int>(*type)));
+    event_indices_[index.type].push_back(events_.size());
+  }
+  events_.push_back(index);
+  return true;
 }
 
 size_t ParsedRtcEventLog::GetNumberOfEvents() const {
@@ -198,17 +413,180 @@ size_t ParsedRtcEventLog::GetNumberOfEvents() const {
 
 int64_t ParsedRtcEventLog::GetTimestamp(size_t index) const {
   RTC_CHECK_LT(index, GetNumberOfEvents());
-  const rtclog::Event& event = events_[index];
-  RTC_CHECK(event.has_timestamp_us());
-  return event.timestamp_us();
+  RTC_CHECK(events_[index].has_timestamp);
+  return events_[index].timestamp_us;
 }
 
 ParsedRtcEventLog::EventType ParsedRtcEventLog::GetEventType(
     size_t index) const {
   RTC_CHECK_LT(index, GetNumberOfEvents());
-  const rtclog::Event& event = events_[index];
-  RTC_CHECK(event.has_type());
-  return GetRuntimeEventType(event.type());
+  RTC_CHECK(events_[index].has_type);
+  return events_[index].type;
+}
+
+const std::vector<size_t>& ParsedRtcEventLog::GetEventIndices(
+    EventType type) const {
+  RTC_CHECK_LT(static_cast<size_t>(type), kNumEventTypes);
+  return event_indices_[type];
+}
+
+bool ParsedRtcEventLog::DecodeEvents(size_t begin,
+                                     size_t end,
+                                     size_t num_threads) const {
+  RTC_CHECK_LE(begin, end);
+  RTC_CHECK_LE(end, GetNumberOfEvents());
+  if (begin == end) {
+    return true;
+  }
+
+  // Spread the chunks that are not decoded yet over the threads.
+  std::vector<DecodeTask> tasks(std::max<size_t>(num_threads, 1));
+  size_t num_chunks = 0;
+  {
+    rtc::CritScope lock(&crit_);
+    for (size_t chunk_index = begin / kEventsPerChunk;
+         chunk_index <= (end - 1) / kEventsPerChunk &&
+         num_chunks < max_decoded_chunks_;
+         ++chunk_index) {
+      if (!chunks_[chunk_index]) {
+        DecodeTask& task = tasks[num_chunks++ % tasks.size()];
+        task.log = this;
+        task.chunk_indices.push_back(chunk_index);
+      }
+    }
+  }
+  if (num_chunks == 0) {
+    return true;
+  }
+  tasks.resize(std::min(tasks.size(), num_chunks));
+
+  if (tasks.size() == 1) {
+    DecodeThread(&tasks[0]);
+  } else {
+    std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+    for (DecodeTask& task : tasks) {
+      threads.emplace_back(
+          new rtc::PlatformThread(&DecodeThread, &task, "RtcEventLogDecode"));
+      threads.back()->Start();
+    }
+    for (auto& thread : threads) {
+      thread->Stop();
+    }
+  }
+
+  bool success = true;
+  rtc::CritScope lock(&crit_);
+  for (DecodeTask& task : tasks) {
+    for (size_t i = 0; i < task.chunk_indices.size(); ++i) {
+      if (!task.chunks[i]) {
+        success = false;
+      } else if (!chunks_[task.chunk_indices[i]]) {
+        StoreChunk(task.chunk_indices[i], std::move(task.chunks[i]));
+      }
+    }
+  }
+  return success;
+}
+
+void ParsedRtcEventLog::SetMaxDecodedEvents(size_t max_decoded_events) {
+  rtc::CritScope lock(&crit_);
+  max_decoded_chunks_ = std::max<size_t>(max_decoded_events / kEventsPerChunk,
+                                         1);
+  while (decoded_chunks_.size() > max_decoded_chunks_) {
+    chunks_[decoded_chunks_.front()] = nullptr;
+    decoded_chunks_.pop_front();
+  }
+}
+
+std::shared_ptr<const rtclog::Event> ParsedRtcEventLog::GetEvent(
+    size_t index) const {
+  RTC_CHECK_LT(index, GetNumberOfEvents());
+  std::shared_ptr<const Chunk> chunk = GetChunk(index / kEventsPerChunk);
+  if (!chunk) {
+    return nullptr;
+  }
+  // Share ownership of the chunk, so that the event outlives its eviction.
+  return std::shared_ptr<const rtclog::Event>(
+      chunk, &(*chunk)[index % kEventsPerChunk]);
+}
+
+std::shared_ptr<const ParsedRtcEventLog::Chunk> ParsedRtcEventLog::GetChunk(
+    size_t chunk_index) const {
+  {
+    rtc::CritScope lock(&crit_);
+    if (chunks_[chunk_index]) {
+      return chunks_[chunk_index];
+    }
+  }
+  // Decode without holding the lock, so that other threads can read other
+  // chunks meanwhile. If two threads decode the same chunk, the first one is
+  // kept.
+  std::shared_ptr<const Chunk> chunk = DecodeChunk(chunk_index);
+  if (!chunk) {
+    return nullptr;
+  }
+  rtc::CritScope lock(&crit_);
+  if (chunks_[chunk_index]) {
+    return chunks_[chunk_index];
+  }
+  StoreChunk(chunk_index, chunk);
+  return chunk;
+}
+
+std::unique_ptr<ParsedRtcEventLog::Chunk> ParsedRtcEventLog::DecodeChunk(
+    size_t chunk_index) const {
+  const size_t begin = chunk_index * kEventsPerChunk;
+  const size_t end = std::min(begin + kEventsPerChunk, events_.size());
+  std::unique_ptr<Chunk> chunk(new Chunk(end - begin));
+  // The packets of the most recently decoded batch. The packets of a batch
+  // are consecutive, so each batch is decoded at most once per chunk.
+  std::vector<rtclog::Event> batch;
+  size_t batch_offset = 0;
+  for (size_t i = begin; i < end; ++i) {
+    const EventIndex& index = events_[i];
+    rtclog::Event* event = &(*chunk)[i - begin];
+    const uint8_t* data = log_data_->data() + index.offset;
+    if (!index.in_batch) {
+      if (!event->ParseFromArray(data, index.length)) {
+        LOG(LS_WARNING) << "Failed to parse protobuf message.";
+        return nullptr;
+      }
+      continue;
+    }
+    if (batch.empty() || batch_offset != index.offset) {
+      rtclog::Event batch_event;
+      batch.clear();
+      if (!batch_event.ParseFromArray(data, index.length) ||
+          !DecodeRtpPacketBatch(batch_event, &batch)) {
+        LOG(LS_WARNING) << "Failed to decode batch of RTP packets.";
+        return nullptr;
+      }
+      batch_offset = index.offset;
+    }
+    RTC_CHECK_LT(index.batch_position, batch.size());
+    event->Swap(&batch[index.batch_position]);
+  }
+  return chunk;
+}
+
+void ParsedRtcEventLog::StoreChunk(size_t chunk_index,
+                                   std::shared_ptr<const Chunk> chunk) const {
+  while (!decoded_chunks_.empty() &&
+         decoded_chunks_.size() >= max_decoded_chunks_) {
+    chunks_[decoded_chunks_.front()] = nullptr;
+    decoded_chunks_.pop_front();
+  }
+  chunks_[chunk_index] = std::move(chunk);
+  decoded_chunks_.push_back(chunk_index);
+}
+
+bool ParsedRtcEventLog::DecodeThread(void* obj) {
+  DecodeTask* task = static_cast<DecodeTask*>(obj);
+  for (size_t chunk_index : task->chunk_indices) {
+    task->chunks.push_back(task->log->DecodeChunk(chunk_index));
+  }
+  // Decode once; the thread is then stopped.
+  return false;
 }
 
 // The header must have space for at least IP_PACKET_SIZE bytes.
@@ -218,8 +596,9 @@ void ParsedRtcEventLog::GetRtpHeader(size_t index,
                                      uint8_t* header,
                                      size_t* header_length,
                                      size_t* total_length) const {
-  RTC_CHECK_LT(index, GetNumberOfEvents());
-  const rtclog::Event& event = events_[index];
+  std::shared_ptr<const rtclog::Event> event_ptr = GetEvent(index);
+  RTC_CHECK(event_ptr) << "Failed to decode event.";
+  const rtclog::Event& event = *event_ptr;
   RTC_CHECK(event.has_type());
   RTC_CHECK_EQ(event.type(), rtclog::Event::RTP_EVENT);
   RTC_CHECK(event.has_rtp_packet());
@@ -260,8 +639,9 @@ void ParsedRtcEventLog::GetRtcpPacket(size_t index,
                                       MediaType* media_type,
                                       uint8_t* packet,
                                       size_t* length) const {
-  RTC_CHECK_LT(index, GetNumberOfEvents());
-  const rtclog::Event& event = events_[index];
+  std::shared_ptr<const rtclog::Event> event_ptr = GetEvent(index);
+  RTC_CHECK(event_ptr) << "Failed to decode event.";
+  const rtclog::Event& event = *event_ptr;
   RTC_CHECK(event.has_type());
   RTC_CHECK_EQ(event.type(), rtclog::Event::RTCP_EVENT);
   RTC_CHECK(event.has_rtcp_packet());
@@ -293,8 +673,9 @@ void ParsedRtcEventLog::GetRtcpPacket(size_t index,
 void ParsedRtcEventLog::GetVideoReceiveConfig(
     size_t index,
     VideoReceiveStream::Config* config) const {
-  RTC_CHECK_LT(index, GetNumberOfEvents());
-  const rtclog::Event& event = events_[index];
+  std::shared_ptr<const rtclog::Event> event_ptr = GetEvent(index);
+  RTC_CHECK(event_ptr) << "Failed to decode event.";
+  const rtclog::Event& event = *event_ptr;
   RTC_CHECK(config != nullptr);
   RTC_CHECK(event.has_type());
   RTC_CHECK_EQ(event.type(), rtclog::Event::VIDEO_RECEIVER_CONFIG_EVENT);
@@ -342,8 +723,9 @@ void ParsedRtcEventLog::GetVideoReceiveConfig(
 void ParsedRtcEventLog::GetVideoSendConfig(
     size_t index,
     VideoSendStream::Config* config) const {
-  RTC_CHECK_LT(index, GetNumberOfEvents());
-  const rtclog::Event& event = events_[index];
+  std::shared_ptr<const rtclog::Event> event_ptr = GetEvent(index);
+  RTC_CHECK(event_ptr) << "Failed to decode event.";
+  const rtclog::Event& event = *event_ptr;
   RTC_CHECK(config != nullptr);
   RTC_CHECK(event.has_type());
   RTC_CHECK_EQ(event.type(), rtclog::Event::VIDEO_SENDER_CONFIG_EVENT);
@@ -381,8 +763,9 @@ void ParsedRtcEventLog::GetVideoSendConfig(
 void ParsedRtcEventLog::GetAudioReceiveConfig(
     size_t index,
     AudioReceiveStream::Config* config) const {
-  RTC_CHECK_LT(index, GetNumberOfEvents());
-  const rtclog::Event& event = events_[index];
+  std::shared_ptr<const rtclog::Event> event_ptr = GetEvent(index);
+  RTC_CHECK(event_ptr) << "Failed to decode event.";
+  const rtclog::Event& event = *event_ptr;
   RTC_CHECK(config != nullptr);
   RTC_CHECK(event.has_type());
   RTC_CHECK_EQ(event.type(), rtclog::Event::AUDIO_RECEIVER_CONFIG_EVENT);
@@ -402,8 +785,9 @@ void ParsedRtcEventLog::GetAudioReceiveConfig(
 void ParsedRtcEventLog::GetAudioSendConfig(
     size_t index,
     AudioSendStream::Config* config) const {
-  RTC_CHECK_LT(index, GetNumberOfEvents());
-  const rtclog::Event& event = events_[index];
+  std::shared_ptr<const rtclog::Event> event_ptr = GetEvent(index);
+  RTC_CHECK(event_ptr) << "Failed to decode event.";
+  const rtclog::Event& event = *event_ptr;
   RTC_CHECK(config != nullptr);
   RTC_CHECK(event.has_type());
   RTC_CHECK_EQ(event.type(), rtclog::Event::AUDIO_SENDER_CONFIG_EVENT);
@@ -418,8 +802,9 @@ void ParsedRtcEventLog::GetAudioSendConfig(
 }
 
 void ParsedRtcEventLog::GetAudioPlayout(size_t index, uint32_t* ssrc) const {
-  RTC_CHECK_LT(index, GetNumberOfEvents());
-  const rtclog::Event& event = events_[index];
+  std::shared_ptr<const rtclog::Event> event_ptr = GetEvent(index);
+  RTC_CHECK(event_ptr) << "Failed to decode event.";
+  const rtclog::Event& event = *event_ptr;
   RTC_CHECK(event.has_type());
   RTC_CHECK_EQ(event.type(), rtclog::Event::AUDIO_PLAYOUT_EVENT);
   RTC_CHECK(event.has_audio_playout_event());
@@ -434,8 +819,9 @@ void ParsedRtcEventLog::GetBwePacketLossEvent(size_t index,
                                               int32_t* bitrate,
                                               uint8_t* fraction_loss,
                                               int32_t* total_packets) const {
-  RTC_CHECK_LT(index, GetNumberOfEvents());
-  const rtclog::Event& event = events_[index];
+  std::shared_ptr<const rtclog::Event> event_ptr = GetEvent(index);
+  RTC_CHECK(event_ptr) << "Failed to decode event.";
+  const rtclog::Event& event = *event_ptr;
   RTC_CHECK(event.has_type());
   RTC_CHECK_EQ(event.type(), rtclog::Event::BWE_PACKET_LOSS_EVENT);
   RTC_CHECK(event.has_bwe_packet_loss_event());
@@ -10,10 +10,15 @@
 #ifndef WEBRTC_LOGGING_RTC_EVENT_LOG_RTC_EVENT_LOG_PARSER_H_
 #define WEBRTC_LOGGING_RTC_EVENT_LOG_RTC_EVENT_LOG_PARSER_H_
 
+#include <deque>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/criticalsection.h"
 #include "webrtc/base/ignore_wundef.h"
+#include "webrtc/base/thread_annotations.h"
 #include "webrtc/logging/rtc_event_log/rtc_event_log.h"
 #include "webrtc/video_receive_stream.h"
 #include "webrtc/video_send_stream.h"
@@ -31,6 +36,13 @@ namespace webrtc {
 
 enum class MediaType;
 
+// Reads an RtcEventLog. Parsing only indexes the events, which takes a single
+// pass over the log without decoding the events. The events are decoded on
+// demand, in chunks of consecutive events, and only a limited number of
+// decoded events are kept, so that even logs of many hours can be analyzed
+// with little memory. Files are memory mapped where supported.
+//
+// The const methods may be called from several threads at once.
 class ParsedRtcEventLog {
   friend class RtcEventLogTestHelper;
 
@@ -49,8 +61,14 @@ class ParsedRtcEventLog {
     AUDIO_RECEIVER_CONFIG_EVENT = 10,
     AUDIO_SENDER_CONFIG_EVENT = 11
   };
+  static const size_t kNumEventTypes = 12;
+
+  ParsedRtcEventLog();
+  ~ParsedRtcEventLog();
 
   // Reads an RtcEventLog file and returns true if parsing was successful.
+  // RTP packets that were logged in batches (with RtpEncoding::kBatched) are
+  // returned as individual RTP_EVENTs.
   bool ParseFile(const std::string& file_name);
 
   // Reads an RtcEventLog from a string and returns true if successful.
@@ -68,6 +86,23 @@ class ParsedRtcEventLog {
   // Reads the event type of the rtclog::Event at |index|.
   EventType GetEventType(size_t index) const;
 
+  // Returns the indices of all events of |type|, in increasing order. Like
+  // GetTimestamp() and GetEventType(), this does not decode any events, so a
+  // tool can iterate over only the events it needs.
+  const std::vector<size_t>& GetEventIndices(EventType type) const;
+
+  // Decodes the events with indices in [|begin|, |end|) on |num_threads|
+  // threads, so that the following calls to read them are fast. Useful
+  // before a pass over many events. Decodes no more events than are kept.
+  // Returns false if an event in the range is malformed; the events that
+  // share a chunk with it can then not be read.
+  bool DecodeEvents(size_t begin, size_t end, size_t num_threads) const;
+
+  // Sets the number of decoded events to keep. When more events are decoded,
+  // the events that were decoded first are discarded; they are decoded again
+  // if needed.
+  void SetMaxDecodedEvents(size_t max_decoded_events);
+
   // Reads the header, direction, media type, header length and packet length
   // from the RTP event at |index|, and stores the values in the corresponding
   // output parameters. The output parameters can be set to nullptr if those
@@ -124,7 +159,50 @@ class ParsedRtcEventLog {
                              int32_t* total_packets) const;
 
  private:
-  std::vector<rtclog::Event> events_;
+  class LogData;
+  struct DecodeTask;
+  typedef std::vector<rtclog::Event> Chunk;
+
+  // Where to find an event in the log, and the fields that are needed for
+  // indexing.
+  struct EventIndex {
+    int64_t timestamp_us;
+    // Offset and length of the serialized rtclog::Event in the log.
+    size_t offset;
+    uint32_t length;
+    // RTP packets from an RTP_PACKET_BATCH_EVENT share offset and length,
+    // and are told apart by their position in the batch.
+    bool in_batch;
+    uint32_t batch_position;
+    bool has_timestamp;
+    bool has_type;
+    EventType type;
+  };
+
+  bool ParseLogData(std::unique_ptr<LogData> log_data);
+  bool IndexEvent(size_t offset, size_t length);
+
+  // Returns the event at |index|, decoding it if needed. The returned pointer
+  // keeps the event alive, even if it is discarded by the parser meanwhile.
+  // Returns nullptr if the chunk of the event can not be decoded.
+  std::shared_ptr<const rtclog::Event> GetEvent(size_t index) const;
+  std::shared_ptr<const Chunk> GetChunk(size_t chunk_index) const;
+  std::unique_ptr<Chunk> DecodeChunk(size_t chunk_index) const;
+  void StoreChunk(size_t chunk_index, std::shared_ptr<const Chunk> chunk) const
+      EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  static bool DecodeThread(void* obj);
+
+  std::unique_ptr<LogData> log_data_;
+  std::vector<EventIndex> events_;
+  std::vector<size_t> event_indices_[kNumEventTypes];
+
+  rtc::CriticalSection crit_;
+  size_t max_decoded_chunks_ GUARDED_BY(crit_);
+  mutable std::vector<std::shared_ptr<const Chunk>> chunks_ GUARDED_BY(crit_);
+  // The indices of the decoded chunks, in the order they were decoded.
+  mutable std::deque<size_t> decoded_chunks_ GUARDED_BY(crit_);
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(ParsedRtcEventLog);
 };
 
 }  // namespace webrtc
@@ -17,10 +17,12 @@
 #include "webrtc/base/buffer.h"
 #include "webrtc/base/checks.h"
 #include "webrtc/base/random.h"
+#include "webrtc/base/timeutils.h"
 #include "webrtc/call.h"
 #include "webrtc/logging/rtc_event_log/rtc_event_log.h"
 #include "webrtc/logging/rtc_event_log/rtc_event_log_parser.h"
 #include "webrtc/logging/rtc_event_log/rtc_event_log_unittest_helper.h"
+#include "webrtc/logging/rtc_event_log/rtp_packet_batch.h"
 #include "webrtc/modules/rtp_rtcp/source/rtcp_packet.h"
 #include "webrtc/modules/rtp_rtcp/source/rtcp_packet/sender_report.h"
 #include "webrtc/modules/rtp_rtcp/source/rtp_header_extension.h"
@@ -237,7 +239,8 @@ void LogSessionAndReadBack(size_t rtp_count,
                            size_t bwe_loss_count,
                            uint32_t extensions_bitvector,
                            uint32_t csrcs_count,
-                           unsigned int random_seed) {
+                           unsigned int random_seed,
+                           RtcEventLog::RtpEncoding rtp_encoding) {
   ASSERT_LE(rtcp_count, rtp_count);
   ASSERT_LE(playout_count, rtp_count);
   ASSERT_LE(bwe_loss_count, rtp_count);
@@ -292,7 +295,8 @@ void LogSessionAndReadBack(size_t rtp_count,
   // to disk.
   {
     SimulatedClock fake_clock(prng.Rand<uint32_t>());
-    std::unique_ptr<RtcEventLog> log_dumper(RtcEventLog::Create(&fake_clock));
+    std::unique_ptr<RtcEventLog> log_dumper(
+        RtcEventLog::Create(&fake_clock, rtp_encoding));
     log_dumper->LogVideoReceiveStreamConfig(receiver_config);
     fake_clock.AdvanceTimeMicroseconds(prng.Rand(1, 1000));
     log_dumper->LogVideoSendStreamConfig(sender_config);
@@ -398,10 +402,10 @@ void LogSessionAndReadBack(size_t rtp_count,
   remove(temp_filename.c_str());
 }
 
-TEST(RtcEventLogTest, LogSessionAndReadBack) {
+void LogSessionsAndReadBack(RtcEventLog::RtpEncoding rtp_encoding) {
   // Log 5 RTP, 2 RTCP, 0 playout events and 0 BWE events
   // with no header extensions or CSRCS.
-  LogSessionAndReadBack(5, 2, 0, 0, 0, 0, 321);
+  LogSessionAndReadBack(5, 2, 0, 0, 0, 0, 321, rtp_encoding);
 
   // Enable AbsSendTime and TransportSequenceNumbers.
   uint32_t extensions = 0;
@@ -412,10 +416,12 @@ TEST(RtcEventLogTest, LogSessionAndReadBack) {
       extensions |= 1u << i;
     }
   }
-  LogSessionAndReadBack(8, 2, 0, 0, extensions, 0, 3141592653u);
+  LogSessionAndReadBack(8, 2, 0, 0, extensions, 0, 3141592653u,
+                        rtp_encoding);
 
   extensions = (1u << kNumExtensions) - 1;  // Enable all header extensions.
-  LogSessionAndReadBack(9, 2, 3, 2, extensions, 2, 2718281828u);
+  LogSessionAndReadBack(9, 2, 3, 2, extensions, 2, 2718281828u,
+                        rtp_encoding);
 
   // Try all combinations of header extensions and up to 2 CSRCS.
   for (extensions = 0; extensions < (1u << kNumExtensions); extensions++) {
@@ -426,9 +432,279 @@ TEST(RtcEventLogTest, LogSessionAndReadBack) {
                             1 + csrcs_count,  // Number of BWE loss events.
                             extensions,       // Bit vector choosing extensions.
                             csrcs_count,      // Number of contributing sources.
-                            extensions * 3 + csrcs_count + 1);  // Random seed.
+                            extensions * 3 + csrcs_count + 1,  // Random seed.
+                            rtp_encoding);
+    }
+  }
+}
+
+TEST(RtcEventLogTest, LogSessionAndReadBack) {
+  LogSessionsAndReadBack(RtcEventLog::RtpEncoding::kPerPacket);
+}
+
+TEST(RtcEventLogTest, LogSessionWithBatchedRtpAndReadBack) {
+  LogSessionsAndReadBack(RtcEventLog::RtpEncoding::kBatched);
+}
+
+// Logs packets of a few streams, with realistic sequence numbers and
+// timestamps, in enough batches to cover wraparound and the batch size limit.
+TEST(RtcEventLogTest, LogBatchedRtpStreamsAndReadBack) {
+  const size_t kNumPackets = 900;
+  const uint32_t kSsrcs[] = {0x12345678, 0x9abcdef0, 0x13579bdf};
+  Random prng(1234567);
+  RtpHeaderExtensionMap extensions;
+  extensions.Register(kRtpExtensionAbsoluteSendTime, 3);
+  extensions.Register(kRtpExtensionTransportSequenceNumber, 5);
+
+  std::vector<RtpPacketToSend> rtp_packets;
+  std::vector<int64_t> timestamps_us;
+  uint16_t sequence_numbers[] = {65000, 10, 30000};
+  uint32_t rtp_timestamps[] = {0xfffff000, 4711, 0};
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    const size_t stream = prng.Rand(2);
+    RtpPacketToSend rtp_packet =
+        GenerateRtpPacket(&extensions, stream, prng.Rand(100, 1200), &prng);
+    rtp_packet.SetSsrc(kSsrcs[stream]);
+    rtp_packet.SetSequenceNumber(sequence_numbers[stream]++);
+    rtp_packet.SetTimestamp(rtp_timestamps[stream]);
+    rtp_timestamps[stream] += prng.Rand(3) * 3000;
+    rtp_packets.push_back(rtp_packet);
+  }
+
+  auto test_info = ::testing::UnitTest::GetInstance()->current_test_info();
+  const std::string temp_filename =
+      test::OutputPath() + test_info->test_case_name() + test_info->name();
+  {
+    SimulatedClock fake_clock(prng.Rand<uint32_t>());
+    std::unique_ptr<RtcEventLog> log_dumper(RtcEventLog::Create(
+        &fake_clock, RtcEventLog::RtpEncoding::kBatched));
+    log_dumper->StartLogging(temp_filename, 10000000);
+    for (const RtpPacketToSend& rtp_packet : rtp_packets) {
+      fake_clock.AdvanceTimeMicroseconds(prng.Rand(0, 20000));
+      timestamps_us.push_back(fake_clock.TimeInMicroseconds());
+      log_dumper->LogRtpHeader(kIncomingPacket, MediaType::VIDEO,
+                               rtp_packet.data(), rtp_packet.size());
     }
+    log_dumper->StopLogging();
   }
+
+  ParsedRtcEventLog parsed_log;
+  ASSERT_TRUE(parsed_log.ParseFile(temp_filename));
+  ASSERT_EQ(kNumPackets + 2, parsed_log.GetNumberOfEvents());
+  RtcEventLogTestHelper::VerifyLogStartEvent(parsed_log, 0);
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    RtcEventLogTestHelper::VerifyRtpEvent(
+        parsed_log, i + 1, kIncomingPacket, MediaType::VIDEO,
+        rtp_packets[i].data(), rtp_packets[i].headers_size(),
+        rtp_packets[i].size());
+    EXPECT_EQ(timestamps_us[i], parsed_log.GetTimestamp(i + 1));
+  }
+  RtcEventLogTestHelper::VerifyLogEndEvent(parsed_log, kNumPackets + 1);
+
+  remove(temp_filename.c_str());
+}
+
+// Logs enough events for several chunks of decoded events, and reads them back
+// in different orders, with few decoded events kept and on several threads.
+TEST(RtcEventLogTest, DecodeEventsOnDemand) {
+  const size_t kNumPackets = 3000;
+  Random prng(7654321);
+  std::vector<RtpPacketToSend> rtp_packets;
+  std::vector<rtc::Buffer> rtcp_packets;
+  std::vector<bool> is_rtcp;
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    is_rtcp.push_back(prng.Rand(9) == 0);
+    if (is_rtcp.back()) {
+      rtcp_packets.push_back(GenerateRtcpPacket(&prng));
+    } else {
+      rtp_packets.push_back(
+          GenerateRtpPacket(nullptr, 0, prng.Rand(100, 1200), &prng));
+    }
+  }
+
+  // Build the log directly, since RtcEventLog would drop events logged this
+  // fast.
+  rtclog::EventStream stream;
+  int64_t timestamp_us = prng.Rand<uint32_t>();
+  rtclog::Event* event = stream.add_stream();
+  event->set_timestamp_us(timestamp_us);
+  event->set_type(rtclog::Event::LOG_START);
+  RtpPacketBatchEncoder batch_encoder;
+  size_t rtp_index = 0;
+  size_t rtcp_index = 0;
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    timestamp_us += prng.Rand(0, 20000);
+    if (!is_rtcp[i]) {
+      const RtpPacketToSend& rtp_packet = rtp_packets[rtp_index++];
+      batch_encoder.AddPacket(timestamp_us, true, rtclog::MediaType::AUDIO,
+                              rtp_packet.data(), rtp_packet.headers_size(),
+                              rtp_packet.size());
+      if (batch_encoder.num_packets() < 64) {
+        continue;
+      }
+    }
+    if (batch_encoder.num_packets() > 0) {
+      batch_encoder.Finish(stream.add_stream());
+    }
+    if (is_rtcp[i]) {
+      const rtc::Buffer& rtcp_packet = rtcp_packets[rtcp_index++];
+      event = stream.add_stream();
+      event->set_timestamp_us(timestamp_us);
+      event->set_type(rtclog::Event::RTCP_EVENT);
+      event->mutable_rtcp_packet()->set_incoming(false);
+      event->mutable_rtcp_packet()->set_type(rtclog::MediaType::AUDIO);
+      event->mutable_rtcp_packet()->set_packet_data(rtcp_packet.data(),
+                                                    rtcp_packet.size());
+    }
+  }
+  if (batch_encoder.num_packets() > 0) {
+    batch_encoder.Finish(stream.add_stream());
+  }
+  event = stream.add_stream();
+  event->set_timestamp_us(timestamp_us);
+  event->set_type(rtclog::Event::LOG_END);
+  std::string log_string;
+  ASSERT_TRUE(stream.SerializeToString(&log_string));
+
+  ParsedRtcEventLog parsed_log;
+  ASSERT_TRUE(parsed_log.ParseString(log_string));
+  ASSERT_EQ(kNumPackets + 2, parsed_log.GetNumberOfEvents());
+  const std::vector<size_t>& rtp_indices =
+      parsed_log.GetEventIndices(ParsedRtcEventLog::RTP_EVENT);
+  const std::vector<size_t>& rtcp_indices =
+      parsed_log.GetEventIndices(ParsedRtcEventLog::RTCP_EVENT);
+  ASSERT_EQ(rtp_packets.size(), rtp_indices.size());
+  ASSERT_EQ(rtcp_packets.size(), rtcp_indices.size());
+  EXPECT_EQ(std::vector<size_t>(1, 0),
+            parsed_log.GetEventIndices(ParsedRtcEventLog::LOG_START));
+  EXPECT_EQ(std::vector<size_t>(1, kNumPackets + 1),
+            parsed_log.GetEventIndices(ParsedRtcEventLog::LOG_END));
+
+  auto verify_packets = [&](bool reverse) {
+    for (size_t n = 0; n < rtp_indices.size(); ++n) {
+      const size_t i = reverse ? rtp_indices.size() - 1 - n : n;
+      RtcEventLogTestHelper::VerifyRtpEvent(
+          parsed_log, rtp_indices[i], kIncomingPacket, MediaType::AUDIO,
+          rtp_packets[i].data(), rtp_packets[i].headers_size(),
+          rtp_packets[i].size());
+    }
+    for (size_t i = 0; i < rtcp_indices.size(); ++i) {
+      RtcEventLogTestHelper::VerifyRtcpEvent(
+          parsed_log, rtcp_indices[i], kOutgoingPacket, MediaType::AUDIO,
+          rtcp_packets[i].data(), rtcp_packets[i].size());
+    }
+  };
+  verify_packets(false);
+
+  // Keep a single chunk, so that the events are decoded again and again.
+  parsed_log.SetMaxDecodedEvents(1);
+  verify_packets(true);
+
+  ParsedRtcEventLog threaded_log;
+  ASSERT_TRUE(threaded_log.ParseString(log_string));
+  EXPECT_TRUE(
+      threaded_log.DecodeEvents(0, threaded_log.GetNumberOfEvents(), 3));
+  ASSERT_EQ(parsed_log.GetNumberOfEvents(), threaded_log.GetNumberOfEvents());
+  for (size_t i = 0; i < parsed_log.GetNumberOfEvents(); ++i) {
+    EXPECT_EQ(parsed_log.GetEventType(i), threaded_log.GetEventType(i));
+    EXPECT_EQ(parsed_log.GetTimestamp(i), threaded_log.GetTimestamp(i));
+  }
+  for (size_t i = 0; i < rtp_indices.size(); ++i) {
+    RtcEventLogTestHelper::VerifyRtpEvent(
+        threaded_log, rtp_indices[i], kIncomingPacket, MediaType::AUDIO,
+        rtp_packets[i].data(), rtp_packets[i].headers_size(),
+        rtp_packets[i].size());
+  }
+}
+
+// An event whose framing, timestamp and type are fine, but whose RTP packet
+// is malformed, is rejected when the log is parsed, not when it is decoded.
+TEST(RtcEventLogTest, RejectMalformedEventWhenDecoding) {
+  rtclog::Event log_start;
+  log_start.set_timestamp_us(1);
+  log_start.set_type(rtclog::Event::LOG_START);
+  const std::string log_start_bytes = log_start.SerializeAsString();
+  // timestamp_us = 2, type = RTP_EVENT, and an rtp_packet that ends within
+  // the varint of its |incoming| field.
+  const char kMalformedRtpEvent[] = {0x08, 0x02, 0x10, 0x03,
+                                     0x1A, 0x02, 0x08, '\xff'};
+
+  std::string log_string;
+  log_string.push_back(0x0A);  // Field 1 of EventStream, length delimited.
+  log_string.push_back(static_cast<char>(log_start_bytes.size()));
+  log_string.append(log_start_bytes);
+  ParsedRtcEventLog parsed_log;
+  ASSERT_TRUE(parsed_log.ParseString(log_string));
+  EXPECT_EQ(1u, parsed_log.GetNumberOfEvents());
+
+  log_string.push_back(0x0A);
+  log_string.push_back(sizeof(kMalformedRtpEvent));
+  log_string.append(kMalformedRtpEvent, sizeof(kMalformedRtpEvent));
+  // Indexing reads only the timestamp and type, so the event is only found
+  // to be malformed when it is decoded.
+  ASSERT_TRUE(parsed_log.ParseString(log_string));
+  ASSERT_EQ(2u, parsed_log.GetNumberOfEvents());
+  EXPECT_EQ(ParsedRtcEventLog::RTP_EVENT, parsed_log.GetEventType(1));
+  EXPECT_EQ(2, parsed_log.GetTimestamp(1));
+  EXPECT_FALSE(parsed_log.DecodeEvents(0, 2, 1));
+}
+
+// Compares the RTP encodings: the time spent by the caller in LogRtpHeader(),
+// the total time including the encoding and writing on the logging thread
+// (on a single core, both are CPU time) and the bytes written per packet.
+TEST(RtcEventLogTest, DISABLED_RtpEncodingBenchmark) {
+  const size_t kPacketsPerFile = 900;  // Fits in the event queue.
+  const size_t kNumFiles = 100;
+  const uint32_t kSsrcs[] = {0x11111111, 0x22222222, 0x33333333};
+  Random prng(4711);
+  RtpHeaderExtensionMap extensions;
+  extensions.Register(kRtpExtensionAbsoluteSendTime, 3);
+  extensions.Register(kRtpExtensionTransportSequenceNumber, 5);
+  std::vector<RtpPacketToSend> rtp_packets;
+  uint16_t sequence_numbers[] = {0, 0, 0};
+  for (size_t i = 0; i < kPacketsPerFile; ++i) {
+    const size_t stream = prng.Rand(2);
+    RtpPacketToSend rtp_packet =
+        GenerateRtpPacket(&extensions, 0, prng.Rand(100, 1200), &prng);
+    rtp_packet.SetSsrc(kSsrcs[stream]);
+    rtp_packet.SetSequenceNumber(sequence_numbers[stream]++);
+    rtp_packet.SetTimestamp(static_cast<uint32_t>(i / 10 * 3000));
+    rtp_packets.push_back(rtp_packet);
+  }
+
+  auto test_info = ::testing::UnitTest::GetInstance()->current_test_info();
+  const std::string temp_filename =
+      test::OutputPath() + test_info->test_case_name() + test_info->name();
+  for (auto rtp_encoding : {RtcEventLog::RtpEncoding::kPerPacket,
+                            RtcEventLog::RtpEncoding::kBatched}) {
+    std::unique_ptr<RtcEventLog> log_dumper(
+        RtcEventLog::Create(Clock::GetRealTimeClock(), rtp_encoding));
+    int64_t log_time_us = 0;
+    int64_t total_time_us = 0;
+    size_t bytes = 0;
+    for (size_t file = 0; file < kNumFiles; ++file) {
+      log_dumper->StartLogging(temp_filename, 10000000);
+      const int64_t start_time_us = rtc::TimeMicros();
+      for (const RtpPacketToSend& rtp_packet : rtp_packets) {
+        log_dumper->LogRtpHeader(kIncomingPacket, MediaType::VIDEO,
+                                 rtp_packet.data(), rtp_packet.size());
+      }
+      log_time_us += rtc::TimeMicros() - start_time_us;
+      log_dumper->StopLogging();
+      total_time_us += rtc::TimeMicros() - start_time_us;
+      bytes += test::GetFileSize(temp_filename);
+    }
+    const size_t num_packets = kNumFiles * kPacketsPerFile;
+    printf(
+        "%s: %.3f us per packet in LogRtpHeader(), %.3f us per packet in "
+        "total, %.1f bytes per packet\n",
+        rtp_encoding == RtcEventLog::RtpEncoding::kBatched ? "Batched"
+                                                            : "Per packet",
+        static_cast<double>(log_time_us) / num_packets,
+        static_cast<double>(total_time_us) / num_packets,
+        static_cast<double>(bytes) / num_packets);
+  }
+  remove(temp_filename.c_str());
 }
 
 TEST(RtcEventLogTest, LogEventAndReadBack) {
@@ -12,6 +12,7 @@
 
 #include <string.h>
 
+#include <memory>
 #include <string>
 
 #include "webrtc/base/checks.h"
@@ -106,7 +107,8 @@ void RtcEventLogTestHelper::VerifyVideoReceiveStreamConfig(
     const ParsedRtcEventLog& parsed_log,
     size_t index,
     const VideoReceiveStream::Config& config) {
-  const rtclog::Event& event = parsed_log.events_[index];
+  std::shared_ptr<const rtclog::Event> event_ptr = parsed_log.GetEvent(index);
+  const rtclog::Event& event = *event_ptr;
   ASSERT_TRUE(IsValidBasicEvent(event));
   ASSERT_EQ(rtclog::Event::VIDEO_RECEIVER_CONFIG_EVENT, event.type());
   const rtclog::VideoReceiveConfig& receiver_config =
@@ -202,7 +204,8 @@ void RtcEventLogTestHelper::VerifyVideoSendStreamConfig(
     const ParsedRtcEventLog& parsed_log,
     size_t index,
     const VideoSendStream::Config& config) {
-  const rtclog::Event& event = parsed_log.events_[index];
+  std::shared_ptr<const rtclog::Event> event_ptr = parsed_log.GetEvent(index);
+  const rtclog::Event& event = *event_ptr;
   ASSERT_TRUE(IsValidBasicEvent(event));
   ASSERT_EQ(rtclog::Event::VIDEO_SENDER_CONFIG_EVENT, event.type());
   const rtclog::VideoSendConfig& sender_config = event.video_sender_config();
@@ -274,7 +277,8 @@ void RtcEventLogTestHelper::VerifyAudioReceiveStreamConfig(
     const ParsedRtcEventLog& parsed_log,
     size_t index,
     const AudioReceiveStream::Config& config) {
-  const rtclog::Event& event = parsed_log.events_[index];
+  std::shared_ptr<const rtclog::Event> event_ptr = parsed_log.GetEvent(index);
+  const rtclog::Event& event = *event_ptr;
   ASSERT_TRUE(IsValidBasicEvent(event));
   ASSERT_EQ(rtclog::Event::AUDIO_RECEIVER_CONFIG_EVENT, event.type());
   const rtclog::AudioReceiveConfig& receiver_config =
@@ -314,7 +318,8 @@ void RtcEventLogTestHelper::VerifyAudioSendStreamConfig(
     const ParsedRtcEventLog& parsed_log,
     size_t index,
     const AudioSendStream::Config& config) {
-  const rtclog::Event& event = parsed_log.events_[index];
+  std::shared_ptr<const rtclog::Event> event_ptr = parsed_log.GetEvent(index);
+  const rtclog::Event& event = *event_ptr;
   ASSERT_TRUE(IsValidBasicEvent(event));
   ASSERT_EQ(rtclog::Event::AUDIO_SENDER_CONFIG_EVENT, event.type());
   const rtclog::AudioSendConfig& sender_config = event.audio_sender_config();
@@ -353,7 +358,8 @@ void RtcEventLogTestHelper::VerifyRtpEvent(const ParsedRtcEventLog& parsed_log,
                                            const uint8_t* header,
                                            size_t header_size,
                                            size_t total_size) {
-  const rtclog::Event& event = parsed_log.events_[index];
+  std::shared_ptr<const rtclog::Event> event_ptr = parsed_log.GetEvent(index);
+  const rtclog::Event& event = *event_ptr;
   ASSERT_TRUE(IsValidBasicEvent(event));
   ASSERT_EQ(rtclog::Event::RTP_EVENT, event.type());
   const rtclog::RtpPacket& rtp_packet = event.rtp_packet();
@@ -390,7 +396,8 @@ void RtcEventLogTestHelper::VerifyRtcpEvent(const ParsedRtcEventLog& parsed_log,
                                             MediaType media_type,
                                             const uint8_t* packet,
                                             size_t total_size) {
-  const rtclog::Event& event = parsed_log.events_[index];
+  std::shared_ptr<const rtclog::Event> event_ptr = parsed_log.GetEvent(index);
+  const rtclog::Event& event = *event_ptr;
   ASSERT_TRUE(IsValidBasicEvent(event));
   ASSERT_EQ(rtclog::Event::RTCP_EVENT, event.type());
   const rtclog::RtcpPacket& rtcp_packet = event.rtcp_packet();
@@ -421,7 +428,8 @@ void RtcEventLogTestHelper::VerifyPlayoutEvent(
     const ParsedRtcEventLog& parsed_log,
     size_t index,
     uint32_t ssrc) {
-  const rtclog::Event& event = parsed_log.events_[index];
+  std::shared_ptr<const rtclog::Event> event_ptr = parsed_log.GetEvent(index);
+  const rtclog::Event& event = *event_ptr;
   ASSERT_TRUE(IsValidBasicEvent(event));
   ASSERT_EQ(rtclog::Event::AUDIO_PLAYOUT_EVENT, event.type());
   const rtclog::AudioPlayoutEvent& playout_event = event.audio_playout_event();
@@ -440,7 +448,8 @@ void RtcEventLogTestHelper::VerifyBweLossEvent(
     int32_t bitrate,
     uint8_t fraction_loss,
     int32_t total_packets) {
-  const rtclog::Event& event = parsed_log.events_[index];
+  std::shared_ptr<const rtclog::Event> event_ptr = parsed_log.GetEvent(index);
+  const rtclog::Event& event = *event_ptr;
   ASSERT_TRUE(IsValidBasicEvent(event));
   ASSERT_EQ(rtclog::Event::BWE_PACKET_LOSS_EVENT, event.type());
   const rtclog::BwePacketLossEvent& bwe_event = event.bwe_packet_loss_event();
@@ -465,7 +474,8 @@ void RtcEventLogTestHelper::VerifyBweLossEvent(
 void RtcEventLogTestHelper::VerifyLogStartEvent(
     const ParsedRtcEventLog& parsed_log,
     size_t index) {
-  const rtclog::Event& event = parsed_log.events_[index];
+  std::shared_ptr<const rtclog::Event> event_ptr = parsed_log.GetEvent(index);
+  const rtclog::Event& event = *event_ptr;
   ASSERT_TRUE(IsValidBasicEvent(event));
   EXPECT_EQ(rtclog::Event::LOG_START, event.type());
 }
@@ -473,7 +483,8 @@ void RtcEventLogTestHelper::VerifyLogStartEvent(
 void RtcEventLogTestHelper::VerifyLogEndEvent(
     const ParsedRtcEventLog& parsed_log,
     size_t index) {
-  const rtclog::Event& event = parsed_log.events_[index];
+  std::shared_ptr<const rtclog::Event> event_ptr = parsed_log.GetEvent(index);
+  const rtclog::Event& event = *event_ptr;
   ASSERT_TRUE(IsValidBasicEvent(event));
   EXPECT_EQ(rtclog::Event::LOG_END, event.type());
 }
@@ -0,0 +1,243 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/logging/rtc_event_log/rtp_packet_batch.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+
+#include "webrtc/base/checks.h"
+#include "webrtc/modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "webrtc/modules/rtp_rtcp/source/byte_io.h"
+
+namespace webrtc {
+
+namespace {
+const size_t kFixedHeaderLength = 12;
+const size_t kMaxVarIntLength = 10;
+
+void AppendVarInt(uint64_t value, std::string* output) {
+  char buffer[kMaxVarIntLength];
+  size_t length = 0;
+  while (value >= 0x80) {
+    buffer[length++] = static_cast<char>(0x80 | (value & 0x7F));
+    value >>= 7;
+  }
+  buffer[length++] = static_cast<char>(value);
+  output->append(buffer, length);
+}
+
+// Maps signed values to unsigned ones so that small deltas of either sign
+// get short varints: 0, -1, 1, -2, ... become 0, 1, 2, 3, ...
+uint64_t ZigZagEncode(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^
+         static_cast<uint64_t>(value >> 63);
+}
+
+int64_t ZigZagDecode(uint64_t value) {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+// Reads the varints of one column of an rtclog::RtpPacketBatch.
+class VarIntReader {
+ public:
+  explicit VarIntReader(const std::string& column) : column_(column) {}
+
+  bool Read(uint64_t* value) {
+    *value = 0;
+    for (size_t i = 0; i < kMaxVarIntLength && position_ < column_.size();
+         ++i) {
+      const uint8_t byte = static_cast<uint8_t>(column_[position_++]);
+      *value |= static_cast<uint64_t>(byte & 0x7F) << (7 * i);
+      if ((byte & 0x80) == 0)
+        return true;
+    }
+    return false;
+  }
+
+  bool ReadBytes(size_t length, uint8_t* bytes) {
+    if (column_.size() - position_ < length)
+      return false;
+    memcpy(bytes, column_.data() + position_, length);
+    position_ += length;
+    return true;
+  }
+
+  bool AtEnd() const { return position_ == column_.size(); }
+
+ private:
+  const std::string& column_;
+  size_t position_ = 0;
+};
+
+// Reads the header bytes that are not in other columns into |header|, with
+// room left for the sequence number, timestamp and SSRC. Returns the header
+// length, or 0 if the bytes are malformed.
+size_t ReadRemainingHeaderBytes(VarIntReader* reader, uint8_t* header) {
+  if (!reader->ReadBytes(2, header))
+    return 0;
+  const size_t csrc_count = header[0] & 0x0F;
+  const bool has_extension = (header[0] & 0x10) != 0;
+  size_t header_length = kFixedHeaderLength + 4 * csrc_count;
+  if (!reader->ReadBytes(4 * csrc_count, header + kFixedHeaderLength))
+    return 0;
+  if (has_extension) {
+    if (!reader->ReadBytes(4, header + header_length))
+      return 0;
+    const size_t extension_length =
+        4 * ByteReader<uint16_t>::ReadBigEndian(header + header_length + 2);
+    header_length += 4;
+    if (header_length + extension_length > IP_PACKET_SIZE ||
+        !reader->ReadBytes(extension_length, header + header_length)) {
+      return 0;
+    }
+    header_length += extension_length;
+  }
+  return header_length;
+}
+}  // namespace
+
+RtpPacketBatchEncoder::RtpPacketBatchEncoder()
+    : first_timestamp_us_(0), last_timestamp_us_(0) {}
+
+RtpPacketBatchEncoder::~RtpPacketBatchEncoder() {}
+
+void RtpPacketBatchEncoder::AddPacket(int64_t timestamp_us,
+                                      bool incoming,
+                                      rtclog::MediaType media_type,
+                                      const uint8_t* header,
+                                      size_t header_length,
+                                      size_t packet_length) {
+  RTC_DCHECK_GE(header_length, kFixedHeaderLength);
+  if (batch_.number_of_packets() == 0) {
+    first_timestamp_us_ = timestamp_us;
+    last_timestamp_us_ = timestamp_us;
+  }
+  batch_.set_number_of_packets(batch_.number_of_packets() + 1);
+
+  AppendVarInt(ZigZagEncode(timestamp_us - last_timestamp_us_),
+               batch_.mutable_timestamp_deltas());
+  last_timestamp_us_ = timestamp_us;
+  batch_.mutable_directions_and_media_types()->push_back(
+      static_cast<char>((incoming ? 4 : 0) | media_type));
+
+  const uint16_t sequence_number =
+      ByteReader<uint16_t>::ReadBigEndian(header + 2);
+  const uint32_t rtp_timestamp = ByteReader<uint32_t>::ReadBigEndian(header + 4);
+  const uint32_t ssrc = ByteReader<uint32_t>::ReadBigEndian(header + 8);
+  const auto& ssrcs = batch_.ssrcs();
+  const size_t ssrc_index =
+      std::find(ssrcs.begin(), ssrcs.end(), ssrc) - ssrcs.begin();
+  if (ssrc_index == static_cast<size_t>(ssrcs.size())) {
+    batch_.add_ssrcs(ssrc);
+    last_sequence_numbers_.push_back(0);
+    last_rtp_timestamps_.push_back(0);
+  }
+  AppendVarInt(ssrc_index, batch_.mutable_ssrc_indices());
+  AppendVarInt(ZigZagEncode(static_cast<int16_t>(
+                   sequence_number - last_sequence_numbers_[ssrc_index])),
+               batch_.mutable_sequence_number_deltas());
+  AppendVarInt(ZigZagEncode(static_cast<int32_t>(
+                   rtp_timestamp - last_rtp_timestamps_[ssrc_index])),
+               batch_.mutable_rtp_timestamp_deltas());
+  last_sequence_numbers_[ssrc_index] = sequence_number;
+  last_rtp_timestamps_[ssrc_index] = rtp_timestamp;
+
+  AppendVarInt(packet_length, batch_.mutable_packet_lengths());
+  std::string* remaining_header_bytes = batch_.mutable_remaining_header_bytes();
+  remaining_header_bytes->append(reinterpret_cast<const char*>(header), 2);
+  remaining_header_bytes->append(
+      reinterpret_cast<const char*>(header + kFixedHeaderLength),
+      header_length - kFixedHeaderLength);
+}
+
+void RtpPacketBatchEncoder::Finish(rtclog::Event* event) {
+  RTC_DCHECK_GT(batch_.number_of_packets(), 0u);
+  event->Clear();
+  event->set_timestamp_us(first_timestamp_us_);
+  event->set_type(rtclog::Event::RTP_PACKET_BATCH_EVENT);
+  event->mutable_rtp_packet_batch()->Swap(&batch_);
+  batch_.Clear();
+  last_sequence_numbers_.clear();
+  last_rtp_timestamps_.clear();
+}
+
+bool DecodeRtpPacketBatch(const rtclog::Event& batch_event,
+                          std::vector<rtclog::Event>* events) {
+  RTC_DCHECK_EQ(batch_event.type(), rtclog::Event::RTP_PACKET_BATCH_EVENT);
+  if (!batch_event.has_timestamp_us() || !batch_event.has_rtp_packet_batch())
+    return false;
+  const rtclog::RtpPacketBatch& batch = batch_event.rtp_packet_batch();
+  const uint32_t num_packets = batch.number_of_packets();
+  if (batch.directions_and_media_types().size() != num_packets)
+    return false;
+
+  VarIntReader timestamp_deltas(batch.timestamp_deltas());
+  VarIntReader ssrc_indices(batch.ssrc_indices());
+  VarIntReader sequence_number_deltas(batch.sequence_number_deltas());
+  VarIntReader rtp_timestamp_deltas(batch.rtp_timestamp_deltas());
+  VarIntReader packet_lengths(batch.packet_lengths());
+  VarIntReader remaining_header_bytes(batch.remaining_header_bytes());
+  std::vector<uint16_t> sequence_numbers(batch.ssrcs_size(), 0);
+  std::vector<uint32_t> rtp_timestamps(batch.ssrcs_size(), 0);
+  int64_t timestamp_us = batch_event.timestamp_us();
+  uint8_t header[IP_PACKET_SIZE];
+
+  for (uint32_t i = 0; i < num_packets; ++i) {
+    uint64_t timestamp_delta;
+    uint64_t ssrc_index;
+    uint64_t sequence_number_delta;
+    uint64_t rtp_timestamp_delta;
+    uint64_t packet_length;
+    if (!timestamp_deltas.Read(&timestamp_delta) ||
+        !ssrc_indices.Read(&ssrc_index) ||
+        ssrc_index >= static_cast<uint64_t>(batch.ssrcs_size()) ||
+        !sequence_number_deltas.Read(&sequence_number_delta) ||
+        !rtp_timestamp_deltas.Read(&rtp_timestamp_delta) ||
+        !packet_lengths.Read(&packet_length)) {
+      return false;
+    }
+    const size_t header_length =
+        ReadRemainingHeaderBytes(&remaining_header_bytes, header);
+    const uint8_t direction_and_media_type =
+        static_cast<uint8_t>(batch.directions_and_media_types()[i]);
+    if (header_length == 0 || direction_and_media_type > 7)
+      return false;
+
+    timestamp_us += ZigZagDecode(timestamp_delta);
+    sequence_numbers[ssrc_index] +=
+        static_cast<uint16_t>(ZigZagDecode(sequence_number_delta));
+    rtp_timestamps[ssrc_index] +=
+        static_cast<uint32_t>(ZigZagDecode(rtp_timestamp_delta));
+    ByteWriter<uint16_t>::WriteBigEndian(header + 2,
+                                         sequence_numbers[ssrc_index]);
+    ByteWriter<uint32_t>::WriteBigEndian(header + 4,
+                                         rtp_timestamps[ssrc_index]);
+    ByteWriter<uint32_t>::WriteBigEndian(header + 8, batch.ssrcs(ssrc_index));
+
+    events->push_back(rtclog::Event());
+    rtclog::Event& event = events->back();
+    event.set_timestamp_us(timestamp_us);
+    event.set_type(rtclog::Event::RTP_EVENT);
+    rtclog::RtpPacket* rtp_packet = event.mutable_rtp_packet();
+    rtp_packet->set_incoming((direction_and_media_type & 4) != 0);
+    rtp_packet->set_type(
+        static_cast<rtclog::MediaType>(direction_and_media_type & 3));
+    rtp_packet->set_packet_length(packet_length);
+    rtp_packet->set_header(header, header_length);
+  }
+  return timestamp_deltas.AtEnd() && ssrc_indices.AtEnd() &&
+         sequence_number_deltas.AtEnd() && rtp_timestamp_deltas.AtEnd() &&
+         packet_lengths.AtEnd() && remaining_header_bytes.AtEnd();
+}
+
+}  // namespace webrtc
@@ -0,0 +1,74 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_LOGGING_RTC_EVENT_LOG_RTP_PACKET_BATCH_H_
+#define WEBRTC_LOGGING_RTC_EVENT_LOG_RTP_PACKET_BATCH_H_
+
+#include <vector>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/ignore_wundef.h"
+
+// Files generated at build-time by the protobuf compiler.
+RTC_PUSH_IGNORING_WUNDEF()
+#ifdef WEBRTC_ANDROID_PLATFORM_BUILD
+#include "external/webrtc/webrtc/logging/rtc_event_log/rtc_event_log.pb.h"
+#else
+#include "webrtc/logging/rtc_event_log/rtc_event_log.pb.h"
+#endif
+RTC_POP_IGNORING_WUNDEF()
+
+namespace webrtc {
+
+// Encodes consecutive RTP headers into the delta encoded columns of an
+// rtclog::RtpPacketBatch. Adding a packet only appends a few varints to
+// buffers that are reused from batch to batch, which is much cheaper than
+// building and serializing an rtclog::Event per packet.
+class RtpPacketBatchEncoder {
+ public:
+  RtpPacketBatchEncoder();
+  ~RtpPacketBatchEncoder();
+
+  // Adds a packet to the batch. |header| must be a complete RTP header of
+  // |header_length| bytes, including CSRCs and header extensions.
+  void AddPacket(int64_t timestamp_us,
+                 bool incoming,
+                 rtclog::MediaType media_type,
+                 const uint8_t* header,
+                 size_t header_length,
+                 size_t packet_length);
+
+  size_t num_packets() const { return batch_.number_of_packets(); }
+
+  // Moves the packets added so far to |event| as an RTP_PACKET_BATCH_EVENT,
+  // and starts a new batch.
+  void Finish(rtclog::Event* event);
+
+ private:
+  rtclog::RtpPacketBatch batch_;
+  int64_t first_timestamp_us_;
+  int64_t last_timestamp_us_;
+  // The last sequence number and RTP timestamp of each SSRC in the batch, in
+  // the order of batch_.ssrcs().
+  std::vector<uint16_t> last_sequence_numbers_;
+  std::vector<uint32_t> last_rtp_timestamps_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(RtpPacketBatchEncoder);
+};
+
+// Appends the packets of the RTP_PACKET_BATCH_EVENT |batch_event| to |events|
+// as individual RTP_EVENTs. Returns false if the batch is malformed, in which
+// case |events| may contain some of the packets.
+bool DecodeRtpPacketBatch(const rtclog::Event& batch_event,
+                          std::vector<rtclog::Event>* events);
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_LOGGING_RTC_EVENT_LOG_RTP_PACKET_BATCH_H_
@@ -50,8 +50,27 @@ VideoSinkWants VideoBroadcaster::wants() const {
   return current_wants_;
 }
 
-void VideoBroadcaster::OnFrame(const cricket::VideoFrame& frame) {
+void VideoBroadcaster::OnFrame(const cricket::VideoFrame& input_frame) {
   rtc::CritScope cs(&sinks_and_wants_lock_);
+  // Let the sinks share the scaled versions of the frame, e.g., the simulcast
+  // layers of an encoder and the local preview. A single sink has no one to
+  // share with. The cricket::VideoAdapter of the capturer doesn't go through
+  // the pyramid either: it crops as well as scales, and its output is the one
+  // frame that is broadcast here.
+  cricket::WebRtcVideoFrame frame = input_frame;
+  int num_sinks_with_frame = 0;
+  for (auto& sink_pair : sink_pairs()) {
+    if (!sink_pair.wants.black_frames)
+      ++num_sinks_with_frame;
+  }
+  if (num_sinks_with_frame >= 2 && !frame.IsZeroSize() &&
+      !frame.is_texture()) {
+    frame = cricket::WebRtcVideoFrame(
+        pyramid_pool_.Wrap(input_frame.video_frame_buffer()),
+        input_frame.rotation(), input_frame.timestamp_us());
+    frame.set_timestamp(input_frame.timestamp());
+    frame.set_ntp_time_ms(input_frame.ntp_time_ms());
+  }
   for (auto& sink_pair : sink_pairs()) {
     if (sink_pair.wants.rotation_applied &&
         frame.rotation() != webrtc::kVideoRotation_0) {
@@ -17,6 +17,7 @@
 
 #include "webrtc/base/criticalsection.h"
 #include "webrtc/base/thread_checker.h"
+#include "webrtc/common_video/include/video_frame_pyramid.h"
 #include "webrtc/media/base/videoframe.h"
 #include "webrtc/media/base/videosinkinterface.h"
 #include "webrtc/media/base/videosourcebase.h"
@@ -62,6 +63,7 @@ class VideoBroadcaster : public VideoSourceBase,
 
   VideoSinkWants current_wants_ GUARDED_BY(sinks_and_wants_lock_);
   rtc::scoped_refptr<webrtc::VideoFrameBuffer> black_frame_buffer_;
+  webrtc::VideoFramePyramidPool pyramid_pool_;
 };
 
 }  // namespace rtc
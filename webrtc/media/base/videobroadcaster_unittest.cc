@@ -18,6 +18,29 @@ using rtc::VideoSinkWants;
 using cricket::FakeVideoRenderer;
 using cricket::WebRtcVideoFrame;
 
+namespace {
+
+// Scales each frame to a fixed size, like an encoder or a preview would.
+class ScalingSink : public rtc::VideoSinkInterface<cricket::VideoFrame> {
+ public:
+  ScalingSink(int width, int height) : width_(width), height_(height) {}
+
+  void OnFrame(const cricket::VideoFrame& frame) override {
+    scaled_buffer_ =
+        frame.video_frame_buffer()->GetScaledBuffer(width_, height_);
+  }
+
+  const rtc::scoped_refptr<webrtc::VideoFrameBuffer>& scaled_buffer() const {
+    return scaled_buffer_;
+  }
+
+ private:
+  const int width_;
+  const int height_;
+  rtc::scoped_refptr<webrtc::VideoFrameBuffer> scaled_buffer_;
+};
+
+}  // namespace
 
 TEST(VideoBroadcasterTest, frame_wanted) {
   VideoBroadcaster broadcaster;
@@ -56,6 +79,42 @@ TEST(VideoBroadcasterTest, OnFrame) {
   EXPECT_EQ(3, sink2.num_rendered_frames());
 }
 
+TEST(VideoBroadcasterTest, SinksShareScaledFrames) {
+  VideoBroadcaster broadcaster;
+  ScalingSink sink1(50, 100);
+  ScalingSink sink2(50, 100);
+  broadcaster.AddOrUpdateSink(&sink1, rtc::VideoSinkWants());
+  broadcaster.AddOrUpdateSink(&sink2, rtc::VideoSinkWants());
+
+  rtc::scoped_refptr<webrtc::I420Buffer> buffer(
+      webrtc::I420Buffer::Create(100, 200));
+  buffer->InitializeData();
+  broadcaster.OnFrame(WebRtcVideoFrame(buffer, webrtc::kVideoRotation_0,
+                                       10 /* timestamp_us */));
+  ASSERT_TRUE(sink1.scaled_buffer());
+  EXPECT_EQ(50, sink1.scaled_buffer()->width());
+  EXPECT_EQ(100, sink1.scaled_buffer()->height());
+  EXPECT_EQ(sink1.scaled_buffer().get(), sink2.scaled_buffer().get());
+}
+
+TEST(VideoBroadcasterTest, SingleSinkGetsFrameUnwrapped) {
+  VideoBroadcaster broadcaster;
+  // Scaling to the frame size returns the buffer that the sink got.
+  ScalingSink sink1(100, 200);
+  FakeVideoRenderer sink2;
+  broadcaster.AddOrUpdateSink(&sink1, rtc::VideoSinkWants());
+  VideoSinkWants black_frames;
+  black_frames.black_frames = true;
+  broadcaster.AddOrUpdateSink(&sink2, black_frames);
+
+  rtc::scoped_refptr<webrtc::I420Buffer> buffer(
+      webrtc::I420Buffer::Create(100, 200));
+  buffer->InitializeData();
+  broadcaster.OnFrame(WebRtcVideoFrame(buffer, webrtc::kVideoRotation_0,
+                                       10 /* timestamp_us */));
+  EXPECT_EQ(buffer.get(), sink1.scaled_buffer().get());
+}
+
 TEST(VideoBroadcasterTest, AppliesRotationIfAnySinkWantsRotationApplied) {
   VideoBroadcaster broadcaster;
   EXPECT_FALSE(broadcaster.wants().rotation_applied);
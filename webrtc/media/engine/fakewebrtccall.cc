@@ -56,6 +56,11 @@ webrtc::AudioSendStream::Stats FakeAudioSendStream::GetStats() const {
   return stats_;
 }
 
+bool FakeAudioSendStream::SendEncodedFrame(const EncodedFrame& frame) {
+  ++encoded_frames_sent_;
+  return true;
+}
+
 FakeAudioReceiveStream::FakeAudioReceiveStream(
     const webrtc::AudioReceiveStream::Config& config)
     : config_(config) {
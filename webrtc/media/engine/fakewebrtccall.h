@@ -48,6 +48,7 @@ class FakeAudioSendStream final : public webrtc::AudioSendStream {
   TelephoneEvent GetLatestTelephoneEvent() const;
   bool IsSending() const { return sending_; }
   bool muted() const { return muted_; }
+  int encoded_frames_sent() const { return encoded_frames_sent_; }
 
  private:
   // webrtc::AudioSendStream implementation.
@@ -58,12 +59,14 @@ class FakeAudioSendStream final : public webrtc::AudioSendStream {
                           int duration_ms) override;
   void SetMuted(bool muted) override;
   webrtc::AudioSendStream::Stats GetStats() const override;
+  bool SendEncodedFrame(const EncodedFrame& frame) override;
 
   TelephoneEvent latest_telephone_event_;
   webrtc::AudioSendStream::Config config_;
   webrtc::AudioSendStream::Stats stats_;
   bool sending_ = false;
   bool muted_ = false;
+  int encoded_frames_sent_ = 0;
 };
 
 class FakeAudioReceiveStream final : public webrtc::AudioReceiveStream {
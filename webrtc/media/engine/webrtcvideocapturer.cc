@@ -353,9 +353,50 @@ void WebRtcVideoCapturer::OnIncomingCapturedFrame(
                  << ". Expected format " << GetCaptureFormat()->ToString();
   }
 
-  OnFrame(cricket::WebRtcVideoFrame(
-              sample.video_frame_buffer(), sample.rotation(),
-              sample.render_time_ms() * rtc::kNumMicrosecsPerMillisec),
+  rtc::scoped_refptr<webrtc::VideoFrameBuffer> buffer =
+      sample.video_frame_buffer();
+  const int64_t time_us =
+      sample.render_time_ms() * rtc::kNumMicrosecsPerMillisec;
+
+  int adapted_width;
+  int adapted_height;
+  int crop_width;
+  int crop_height;
+  int crop_x;
+  int crop_y;
+  if (!AdaptFrame(sample.width(), sample.height(), time_us, rtc::TimeMicros(),
+                  &adapted_width, &adapted_height, &crop_width, &crop_height,
+                  &crop_x, &crop_y, nullptr)) {
+    return;
+  }
+
+  if (adapted_width != sample.width() || adapted_height != sample.height()) {
+    // NV12 frames are cropped and scaled without converting them to I420.
+    switch (buffer->type()) {
+      case webrtc::VideoFrameBuffer::Type::kNative:
+        // Sources producing native frames must handle adaptation themselves.
+        break;
+      case webrtc::VideoFrameBuffer::Type::kI420: {
+        rtc::scoped_refptr<webrtc::I420Buffer> scaled_buffer =
+            webrtc::I420Buffer::Create(adapted_width, adapted_height);
+        scaled_buffer->CropAndScaleFrom(*buffer, crop_x, crop_y, crop_width,
+                                        crop_height);
+        buffer = scaled_buffer;
+        break;
+      }
+      case webrtc::VideoFrameBuffer::Type::kNV12: {
+        rtc::scoped_refptr<webrtc::NV12Buffer> scaled_buffer =
+            webrtc::NV12Buffer::Create(adapted_width, adapted_height);
+        scaled_buffer->CropAndScaleFrom(
+            static_cast<const webrtc::NV12Buffer&>(*buffer), crop_x, crop_y,
+            crop_width, crop_height);
+        buffer = scaled_buffer;
+        break;
+      }
+    }
+  }
+
+  OnFrame(cricket::WebRtcVideoFrame(buffer, sample.rotation(), time_us),
           sample.width(), sample.height());
 }
 
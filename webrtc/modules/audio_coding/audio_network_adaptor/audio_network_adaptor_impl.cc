@@ -54,6 +54,13 @@ void AudioNetworkAdaptorImpl::SetRtt(int rtt_ms) {
   DumpNetworkMetrics();
 }
 
+void AudioNetworkAdaptorImpl::SetEncodeTimeFraction(
+    float encode_time_fraction) {
+  last_metrics_.encode_time_fraction =
+      rtc::Optional<float>(encode_time_fraction);
+  DumpNetworkMetrics();
+}
+
 AudioNetworkAdaptor::EncoderRuntimeConfig
 AudioNetworkAdaptorImpl::GetEncoderRuntimeConfig() {
   EncoderRuntimeConfig config;
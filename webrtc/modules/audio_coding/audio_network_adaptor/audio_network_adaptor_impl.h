@@ -45,6 +45,8 @@ class AudioNetworkAdaptorImpl final : public AudioNetworkAdaptor {
 
   void SetTargetAudioBitrate(int target_audio_bitrate_bps) override;
 
+  void SetEncodeTimeFraction(float encode_time_fraction) override;
+
   EncoderRuntimeConfig GetEncoderRuntimeConfig() override;
 
   void StartDebugDump(FILE* file_handle) override;
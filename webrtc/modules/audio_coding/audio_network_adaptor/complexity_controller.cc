@@ -0,0 +1,74 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_coding/audio_network_adaptor/complexity_controller.h"
+
+#include <algorithm>
+
+#include "webrtc/base/checks.h"
+#include "webrtc/system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+ComplexityController::Config::Config(
+    int initial_complexity,
+    int min_complexity,
+    int max_complexity,
+    float complexity_decreasing_encode_time_fraction,
+    float complexity_increasing_encode_time_fraction,
+    int min_time_between_changes_ms,
+    const Clock* clock)
+    : initial_complexity(initial_complexity),
+      min_complexity(min_complexity),
+      max_complexity(max_complexity),
+      complexity_decreasing_encode_time_fraction(
+          complexity_decreasing_encode_time_fraction),
+      complexity_increasing_encode_time_fraction(
+          complexity_increasing_encode_time_fraction),
+      min_time_between_changes_ms(min_time_between_changes_ms),
+      clock(clock) {}
+
+ComplexityController::ComplexityController(const Config& config)
+    : config_(config),
+      complexity_(std::max(config_.min_complexity,
+                           std::min(config_.initial_complexity,
+                                    config_.max_complexity))) {
+  RTC_DCHECK_LE(config_.min_complexity, config_.max_complexity);
+  RTC_DCHECK_LT(config_.complexity_increasing_encode_time_fraction,
+                config_.complexity_decreasing_encode_time_fraction);
+  RTC_DCHECK(config_.clock);
+}
+
+void ComplexityController::MakeDecision(
+    const NetworkMetrics& metrics,
+    AudioNetworkAdaptor::EncoderRuntimeConfig* config) {
+  // Decision on |complexity| should not have been made.
+  RTC_DCHECK(!config->complexity);
+
+  const int64_t now_ms = config_.clock->TimeInMilliseconds();
+  if (metrics.encode_time_fraction &&
+      (!last_change_time_ms_ ||
+       now_ms - *last_change_time_ms_ >= config_.min_time_between_changes_ms)) {
+    if (*metrics.encode_time_fraction >
+            config_.complexity_decreasing_encode_time_fraction &&
+        complexity_ > config_.min_complexity) {
+      --complexity_;
+      last_change_time_ms_ = rtc::Optional<int64_t>(now_ms);
+    } else if (*metrics.encode_time_fraction <
+                   config_.complexity_increasing_encode_time_fraction &&
+               complexity_ < config_.max_complexity) {
+      ++complexity_;
+      last_change_time_ms_ = rtc::Optional<int64_t>(now_ms);
+    }
+  }
+  config->complexity = rtc::Optional<int>(complexity_);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,64 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_AUDIO_CODING_AUDIO_NETWORK_ADAPTOR_COMPLEXITY_CONTROLLER_H_
+#define WEBRTC_MODULES_AUDIO_CODING_AUDIO_NETWORK_ADAPTOR_COMPLEXITY_CONTROLLER_H_
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/optional.h"
+#include "webrtc/modules/audio_coding/audio_network_adaptor/controller.h"
+
+namespace webrtc {
+
+class Clock;
+
+// Adapts the encoder complexity to the measured encode time, so that the
+// encoder does not use up the CPU on slow or busy devices, but gets the best
+// quality that the CPU allows. The complexity is changed one step at a time,
+// and not before the encode time has been measured with the current setting.
+class ComplexityController final : public Controller {
+ public:
+  struct Config {
+    Config(int initial_complexity,
+           int min_complexity,
+           int max_complexity,
+           float complexity_decreasing_encode_time_fraction,
+           float complexity_increasing_encode_time_fraction,
+           int min_time_between_changes_ms,
+           const Clock* clock);
+    int initial_complexity;
+    int min_complexity;
+    int max_complexity;
+    // Encode time fraction above which the complexity should decrease.
+    float complexity_decreasing_encode_time_fraction;
+    // Encode time fraction below which the complexity can increase.
+    float complexity_increasing_encode_time_fraction;
+    // Least time after a change of complexity for a new change to be made.
+    // Should be well above the interval at which the encode time is reported,
+    // so that the next decision is based on the new complexity.
+    int min_time_between_changes_ms;
+    const Clock* clock;
+  };
+
+  explicit ComplexityController(const Config& config);
+
+  void MakeDecision(const NetworkMetrics& metrics,
+                    AudioNetworkAdaptor::EncoderRuntimeConfig* config) override;
+
+ private:
+  const Config config_;
+  int complexity_;
+  rtc::Optional<int64_t> last_change_time_ms_;
+  RTC_DISALLOW_COPY_AND_ASSIGN(ComplexityController);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_AUDIO_CODING_AUDIO_NETWORK_ADAPTOR_COMPLEXITY_CONTROLLER_H_
@@ -0,0 +1,144 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+
+#include "webrtc/modules/audio_coding/audio_network_adaptor/complexity_controller.h"
+#include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr int kMinComplexity = 2;
+constexpr int kMaxComplexity = 9;
+constexpr float kComplexityDecreasingEncodeTimeFraction = 0.2f;
+constexpr float kComplexityIncreasingEncodeTimeFraction = 0.1f;
+constexpr float kMediumEncodeTimeFraction =
+    (kComplexityDecreasingEncodeTimeFraction +
+     kComplexityIncreasingEncodeTimeFraction) /
+    2;
+constexpr float kHighEncodeTimeFraction = 0.5f;
+constexpr float kLowEncodeTimeFraction = 0.05f;
+constexpr int kMinTimeBetweenChangesMs = 5000;
+constexpr int64_t kClockInitialTimeMs = 12345678;
+
+struct ControllerStates {
+  std::unique_ptr<SimulatedClock> simulated_clock;
+  std::unique_ptr<ComplexityController> controller;
+};
+
+ControllerStates CreateController(int initial_complexity) {
+  ControllerStates states;
+  states.simulated_clock.reset(new SimulatedClock(kClockInitialTimeMs));
+  states.controller.reset(new ComplexityController(ComplexityController::Config(
+      initial_complexity, kMinComplexity, kMaxComplexity,
+      kComplexityDecreasingEncodeTimeFraction,
+      kComplexityIncreasingEncodeTimeFraction, kMinTimeBetweenChangesMs,
+      states.simulated_clock.get())));
+  return states;
+}
+
+void CheckDecision(ComplexityController* controller,
+                   const rtc::Optional<float>& encode_time_fraction,
+                   int expected_complexity) {
+  AudioNetworkAdaptor::EncoderRuntimeConfig config;
+  Controller::NetworkMetrics metrics;
+  metrics.encode_time_fraction = encode_time_fraction;
+  controller->MakeDecision(metrics, &config);
+  EXPECT_EQ(rtc::Optional<int>(expected_complexity), config.complexity);
+}
+
+}  // namespace
+
+TEST(ComplexityControllerTest, OutputInitValueWhenEncodeTimeUnknown) {
+  constexpr int kInitialComplexity = 5;
+  auto states = CreateController(kInitialComplexity);
+  CheckDecision(states.controller.get(), rtc::Optional<float>(),
+                kInitialComplexity);
+}
+
+TEST(ComplexityControllerTest, ClampInitValueToRange) {
+  auto states = CreateController(kMaxComplexity + 1);
+  CheckDecision(states.controller.get(), rtc::Optional<float>(),
+                kMaxComplexity);
+}
+
+TEST(ComplexityControllerTest, DecreaseComplexityOnHighEncodeTime) {
+  constexpr int kInitialComplexity = 5;
+  auto states = CreateController(kInitialComplexity);
+  CheckDecision(states.controller.get(),
+                rtc::Optional<float>(kHighEncodeTimeFraction),
+                kInitialComplexity - 1);
+}
+
+TEST(ComplexityControllerTest, IncreaseComplexityOnLowEncodeTime) {
+  constexpr int kInitialComplexity = 5;
+  auto states = CreateController(kInitialComplexity);
+  CheckDecision(states.controller.get(),
+                rtc::Optional<float>(kLowEncodeTimeFraction),
+                kInitialComplexity + 1);
+}
+
+TEST(ComplexityControllerTest, MaintainComplexityOnMediumEncodeTime) {
+  constexpr int kInitialComplexity = 5;
+  auto states = CreateController(kInitialComplexity);
+  CheckDecision(states.controller.get(),
+                rtc::Optional<float>(kMediumEncodeTimeFraction),
+                kInitialComplexity);
+}
+
+TEST(ComplexityControllerTest, StayWithinRange) {
+  auto states = CreateController(kMinComplexity);
+  CheckDecision(states.controller.get(),
+                rtc::Optional<float>(kHighEncodeTimeFraction), kMinComplexity);
+
+  states = CreateController(kMaxComplexity);
+  CheckDecision(states.controller.get(),
+                rtc::Optional<float>(kLowEncodeTimeFraction), kMaxComplexity);
+}
+
+TEST(ComplexityControllerTest, WaitMinTimeBetweenChanges) {
+  constexpr int kInitialComplexity = 5;
+  auto states = CreateController(kInitialComplexity);
+  CheckDecision(states.controller.get(),
+                rtc::Optional<float>(kHighEncodeTimeFraction),
+                kInitialComplexity - 1);
+  states.simulated_clock->AdvanceTimeMilliseconds(kMinTimeBetweenChangesMs - 1);
+  // Too early for another change.
+  CheckDecision(states.controller.get(),
+                rtc::Optional<float>(kHighEncodeTimeFraction),
+                kInitialComplexity - 1);
+  states.simulated_clock->AdvanceTimeMilliseconds(1);
+  CheckDecision(states.controller.get(),
+                rtc::Optional<float>(kHighEncodeTimeFraction),
+                kInitialComplexity - 2);
+}
+
+TEST(ComplexityControllerTest, CheckBehaviorOnChangingEncodeTime) {
+  constexpr int kInitialComplexity = 5;
+  auto states = CreateController(kInitialComplexity);
+  CheckDecision(states.controller.get(),
+                rtc::Optional<float>(kMediumEncodeTimeFraction),
+                kInitialComplexity);
+  CheckDecision(states.controller.get(),
+                rtc::Optional<float>(kHighEncodeTimeFraction),
+                kInitialComplexity - 1);
+  states.simulated_clock->AdvanceTimeMilliseconds(kMinTimeBetweenChangesMs);
+  CheckDecision(states.controller.get(),
+                rtc::Optional<float>(kMediumEncodeTimeFraction),
+                kInitialComplexity - 1);
+  CheckDecision(states.controller.get(),
+                rtc::Optional<float>(kLowEncodeTimeFraction),
+                kInitialComplexity);
+}
+
+}  // namespace webrtc
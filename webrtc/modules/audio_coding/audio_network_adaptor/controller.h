@@ -25,6 +25,8 @@ class Controller {
     rtc::Optional<float> uplink_packet_loss_fraction;
     rtc::Optional<int> target_audio_bitrate_bps;
     rtc::Optional<int> rtt_ms;
+    // Time spent encoding, as a fraction of the duration of the encoded audio.
+    rtc::Optional<float> encode_time_fraction;
   };
 
   virtual ~Controller() = default;
@@ -16,6 +16,7 @@
 #include "webrtc/base/ignore_wundef.h"
 #include "webrtc/modules/audio_coding/audio_network_adaptor/bitrate_controller.h"
 #include "webrtc/modules/audio_coding/audio_network_adaptor/channel_controller.h"
+#include "webrtc/modules/audio_coding/audio_network_adaptor/complexity_controller.h"
 #include "webrtc/modules/audio_coding/audio_network_adaptor/dtx_controller.h"
 #include "webrtc/modules/audio_coding/audio_network_adaptor/fec_controller.h"
 #include "webrtc/modules/audio_coding/audio_network_adaptor/frame_length_controller.h"
@@ -126,6 +127,28 @@ std::unique_ptr<BitrateController> CreateBitrateController(
   return std::unique_ptr<BitrateController>(new BitrateController(
       BitrateController::Config(initial_bitrate_bps, initial_frame_length_ms)));
 }
+
+std::unique_ptr<ComplexityController> CreateComplexityController(
+    const audio_network_adaptor::config::ComplexityController& config,
+    int initial_complexity,
+    const Clock* clock) {
+  RTC_CHECK(config.has_min_complexity());
+  RTC_CHECK(config.has_max_complexity());
+  RTC_CHECK(config.has_complexity_decreasing_encode_time_fraction());
+  RTC_CHECK(config.has_complexity_increasing_encode_time_fraction());
+  RTC_CHECK(config.has_min_time_between_changes_ms());
+  // Opus complexities range from 0 to 10.
+  RTC_CHECK_GE(config.min_complexity(), 0);
+  RTC_CHECK_LE(config.max_complexity(), 10);
+  RTC_CHECK_LE(config.min_complexity(), config.max_complexity());
+
+  return std::unique_ptr<ComplexityController>(
+      new ComplexityController(ComplexityController::Config(
+          initial_complexity, config.min_complexity(), config.max_complexity(),
+          config.complexity_decreasing_encode_time_fraction(),
+          config.complexity_increasing_encode_time_fraction(),
+          config.min_time_between_changes_ms(), clock)));
+}
 #endif  // WEBRTC_AUDIO_NETWORK_ADAPTOR_DEBUG_DUMP
 
 }  // namespace
@@ -148,6 +171,7 @@ std::unique_ptr<ControllerManager> ControllerManagerImpl::Create(
     int initial_bitrate_bps,
     bool initial_fec_enabled,
     bool initial_dtx_enabled,
+    int initial_complexity,
     const Clock* clock) {
 #ifdef WEBRTC_AUDIO_NETWORK_ADAPTOR_DEBUG_DUMP
   audio_network_adaptor::config::ControllerManager controller_manager_config;
@@ -182,6 +206,11 @@ std::unique_ptr<ControllerManager> ControllerManagerImpl::Create(
         controller = CreateBitrateController(initial_bitrate_bps,
                                              initial_frame_length_ms);
         break;
+      case audio_network_adaptor::config::Controller::kComplexityController:
+        controller = CreateComplexityController(
+            controller_config.complexity_controller(), initial_complexity,
+            clock);
+        break;
       default:
         RTC_NOTREACHED();
     }
@@ -57,6 +57,7 @@ class ControllerManagerImpl final : public ControllerManager {
       int initial_bitrate_bps,
       bool initial_fec_enabled,
       bool initial_dtx_enabled,
+      int initial_complexity,
       const Clock* clock);
 
   explicit ControllerManagerImpl(const Config& config);
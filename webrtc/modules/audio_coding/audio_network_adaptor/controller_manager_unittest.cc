@@ -218,6 +218,17 @@ void AddChannelControllerConfig(
   controller_config->set_channel_2_to_1_bandwidth_bps(29000);
 }
 
+void AddComplexityControllerConfig(
+    audio_network_adaptor::config::ControllerManager* config) {
+  auto controller_config =
+      config->add_controllers()->mutable_complexity_controller();
+  controller_config->set_min_complexity(2);
+  controller_config->set_max_complexity(9);
+  controller_config->set_complexity_decreasing_encode_time_fraction(0.2f);
+  controller_config->set_complexity_increasing_encode_time_fraction(0.1f);
+  controller_config->set_min_time_between_changes_ms(5000);
+}
+
 void AddDtxControllerConfig(
     audio_network_adaptor::config::ControllerManager* config) {
   auto controller_config = config->add_controllers()->mutable_dtx_controller();
@@ -270,6 +281,7 @@ constexpr size_t kIntialChannelsToEncode = 1;
 constexpr bool kInitialDtxEnabled = true;
 constexpr bool kInitialFecEnabled = true;
 constexpr int kInitialFrameLengthMs = 60;
+constexpr int kInitialComplexity = 8;
 
 ControllerManagerStates CreateControllerManager(
     const std::string& config_string) {
@@ -280,7 +292,8 @@ ControllerManagerStates CreateControllerManager(
   states.controller_manager = ControllerManagerImpl::Create(
       config_string, kNumEncoderChannels, encoder_frame_lengths_ms,
       kIntialChannelsToEncode, kInitialFrameLengthMs, kInitialBitrateBps,
-      kInitialFecEnabled, kInitialDtxEnabled, states.simulated_clock.get());
+      kInitialFecEnabled, kInitialDtxEnabled, kInitialComplexity,
+      states.simulated_clock.get());
   return states;
 }
 
@@ -289,7 +302,8 @@ enum class ControllerType : int8_t {
   CHANNEL,
   DTX,
   FRAME_LENGTH,
-  BIT_RATE
+  BIT_RATE,
+  COMPLEXITY
 };
 
 void CheckControllersOrder(const std::vector<Controller*>& controllers,
@@ -327,6 +341,10 @@ void CheckControllersOrder(const std::vector<Controller*>& controllers,
       case ControllerType::BIT_RATE:
         EXPECT_EQ(rtc::Optional<int>(kInitialBitrateBps),
                   encoder_config.bitrate_bps);
+        break;
+      case ControllerType::COMPLEXITY:
+        EXPECT_EQ(rtc::Optional<int>(kInitialComplexity),
+                  encoder_config.complexity);
     }
   }
 }
@@ -343,6 +361,7 @@ TEST(ControllerManagerTest, CreateFromConfigStringAndCheckDefaultOrder) {
   AddDtxControllerConfig(&config);
   AddFrameLengthControllerConfig(&config);
   AddBitrateControllerConfig(&config);
+  AddComplexityControllerConfig(&config);
 
   std::string config_string;
   config.SerializeToString(&config_string);
@@ -355,7 +374,8 @@ TEST(ControllerManagerTest, CreateFromConfigStringAndCheckDefaultOrder) {
       controllers,
       std::vector<ControllerType>{
           ControllerType::FEC, ControllerType::CHANNEL, ControllerType::DTX,
-          ControllerType::FRAME_LENGTH, ControllerType::BIT_RATE});
+          ControllerType::FRAME_LENGTH, ControllerType::BIT_RATE,
+          ControllerType::COMPLEXITY});
 }
 
 TEST(ControllerManagerTest, CreateFromConfigStringAndCheckReordering) {
@@ -415,6 +435,27 @@ TEST(ControllerManagerTest, CreateFromConfigStringAndCheckReordering) {
                             ControllerType::CHANNEL, ControllerType::DTX,
                             ControllerType::BIT_RATE});
 }
+
+#if GTEST_HAS_DEATH_TEST && !defined(WEBRTC_ANDROID)
+TEST(ControllerManagerDeathTest, RejectComplexityOutOfRange) {
+  audio_network_adaptor::config::ControllerManager config;
+  config.set_min_reordering_time_ms(kMinReorderingTimeMs);
+  config.set_min_reordering_squared_distance(kMinReorderingSquareDistance);
+  AddComplexityControllerConfig(&config);
+  auto complexity_config =
+      config.mutable_controllers(0)->mutable_complexity_controller();
+
+  complexity_config->set_max_complexity(11);
+  std::string config_string;
+  config.SerializeToString(&config_string);
+  EXPECT_DEATH(CreateControllerManager(config_string), "Check failed");
+
+  complexity_config->set_max_complexity(9);
+  complexity_config->set_min_complexity(-1);
+  config.SerializeToString(&config_string);
+  EXPECT_DEATH(CreateControllerManager(config_string), "Check failed");
+}
+#endif
 #endif  // WEBRTC_AUDIO_NETWORK_ADAPTOR_DEBUG_DUMP
 
 }  // namespace webrtc
@@ -94,6 +94,9 @@ void DebugDumpWriterImpl::DumpNetworkMetrics(
   if (metrics.rtt_ms)
     dump_metrics->set_rtt_ms(*metrics.rtt_ms);
 
+  if (metrics.encode_time_fraction)
+    dump_metrics->set_encode_time_fraction(*metrics.encode_time_fraction);
+
   DumpEventToFile(event, dump_file_.get());
 #endif  // WEBRTC_AUDIO_NETWORK_ADAPTOR_DEBUG_DUMP
 }
@@ -127,6 +130,9 @@ void DebugDumpWriterImpl::DumpEncoderRuntimeConfig(
   if (config.num_channels)
     dump_config->set_num_channels(*config.num_channels);
 
+  if (config.complexity)
+    dump_config->set_complexity(*config.complexity);
+
   DumpEventToFile(event, dump_file_.get());
 #endif  // WEBRTC_AUDIO_NETWORK_ADAPTOR_DEBUG_DUMP
 }
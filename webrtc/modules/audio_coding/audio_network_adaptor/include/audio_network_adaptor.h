@@ -34,6 +34,9 @@ class AudioNetworkAdaptor {
     // better use of the bandwidth. |num_channels| sets the number of channels
     // to encode.
     rtc::Optional<size_t> num_channels;
+
+    // Encoder complexity, on the scale of the encoder (0 to 10 for Opus).
+    rtc::Optional<int> complexity;
   };
 
   virtual ~AudioNetworkAdaptor() = default;
@@ -47,6 +50,10 @@ class AudioNetworkAdaptor {
 
   virtual void SetTargetAudioBitrate(int target_audio_bitrate_bps) = 0;
 
+  // Reports the time spent encoding, as a fraction of the duration of the
+  // encoded audio.
+  virtual void SetEncodeTimeFraction(float encode_time_fraction) = 0;
+
   virtual EncoderRuntimeConfig GetEncoderRuntimeConfig() = 0;
 
   virtual void StartDebugDump(FILE* file_handle) = 0;
@@ -31,6 +31,10 @@ constexpr int kMinBitrateBps = 500;
 constexpr int kMaxBitrateBps = 512000;
 constexpr int kSupportedFrameLengths[] = {20, 60};
 
+// Interval, in encoded audio, at which the encode time is reported to the
+// audio network adaptor.
+constexpr int kEncodeTimeReportIntervalMs = 1000;
+
 // PacketLossFractionSmoother uses an exponential filter with a time constant
 // of -1.0 / ln(0.9999) = 10000 ms.
 constexpr float kAlphaForPacketLossFractionSmoother = 0.9999f;
@@ -157,7 +161,9 @@ AudioEncoderOpus::AudioEncoderOpus(
               : [this](const std::string& config_string, const Clock* clock) {
                   return DefaultAudioNetworkAdaptorCreator(config_string,
                                                            clock);
-                }) {
+                }),
+      encode_time_us_(0),
+      encoded_audio_ms_(0) {
   RTC_CHECK(RecreateEncoderInstance(config));
 }
 
@@ -256,6 +262,8 @@ bool AudioEncoderOpus::EnableAudioNetworkAdaptor(
     const std::string& config_string,
     const Clock* clock) {
   audio_network_adaptor_ = audio_network_adaptor_creator_(config_string, clock);
+  encode_time_us_ = 0;
+  encoded_audio_ms_ = 0;
   return audio_network_adaptor_.get() != nullptr;
 }
 
@@ -333,6 +341,11 @@ AudioEncoder::EncodedInfo AudioEncoderOpus::EncodeImpl(
                Num10msFramesPerPacket() * SamplesPer10msFrame());
 
   const size_t max_encoded_bytes = SufficientOutputBufferSize();
+  // The encode time is only measured for the audio network adaptor.
+  const Clock* clock = nullptr;
+  if (audio_network_adaptor_)
+    clock = config_.clock ? config_.clock : Clock::GetRealTimeClock();
+  const int64_t encode_start_us = clock ? clock->TimeInMicroseconds() : 0;
   EncodedInfo info;
   info.encoded_bytes =
       encoded->AppendData(
@@ -350,6 +363,9 @@ AudioEncoder::EncodedInfo AudioEncoderOpus::EncodeImpl(
           });
   input_buffer_.clear();
 
+  if (clock)
+    ReportEncodeTime(clock->TimeInMicroseconds() - encode_start_us);
+
   // Will use new packet size for next encoding.
   config_.frame_size_ms = next_frame_length_ms_;
 
@@ -430,6 +446,32 @@ void AudioEncoderOpus::SetNumChannelsToEncode(size_t num_channels_to_encode) {
   num_channels_to_encode_ = num_channels_to_encode;
 }
 
+void AudioEncoderOpus::SetComplexity(int complexity) {
+  RTC_DCHECK_GE(complexity, 0);
+  RTC_DCHECK_LE(complexity, 10);
+
+  if (config_.complexity == complexity)
+    return;
+
+  RTC_CHECK_EQ(0, WebRtcOpus_SetComplexity(inst_, complexity));
+  config_.complexity = complexity;
+}
+
+// Accumulates the time spent encoding the current packet, and lets the audio
+// network adaptor act on the encode time fraction once per report interval.
+void AudioEncoderOpus::ReportEncodeTime(int64_t encode_time_us) {
+  encode_time_us_ += encode_time_us;
+  encoded_audio_ms_ += config_.frame_size_ms;
+  if (encoded_audio_ms_ < kEncodeTimeReportIntervalMs)
+    return;
+
+  audio_network_adaptor_->SetEncodeTimeFraction(
+      static_cast<float>(encode_time_us_) / (encoded_audio_ms_ * 1000));
+  encode_time_us_ = 0;
+  encoded_audio_ms_ = 0;
+  ApplyAudioNetworkAdaptor();
+}
+
 void AudioEncoderOpus::ApplyAudioNetworkAdaptor() {
   auto config = audio_network_adaptor_->GetEncoderRuntimeConfig();
   // |audio_network_adaptor_| is supposed to be configured to output all
@@ -449,6 +491,9 @@ void AudioEncoderOpus::ApplyAudioNetworkAdaptor() {
   SetProjectedPacketLossRate(*config.uplink_packet_loss_fraction);
   SetDtx(*config.enable_dtx);
   SetNumChannelsToEncode(*config.num_channels);
+  // Complexity is only adapted if the adaptor is configured to do so.
+  if (config.complexity)
+    SetComplexity(*config.complexity);
 }
 
 std::unique_ptr<AudioNetworkAdaptor>
@@ -461,7 +506,8 @@ AudioEncoderOpus::DefaultAudioNetworkAdaptorCreator(
       config, ControllerManagerImpl::Create(
                   config_string, NumChannels(), supported_frame_lengths_ms(),
                   num_channels_to_encode_, next_frame_length_ms_,
-                  GetTargetBitrate(), config_.fec_enabled, GetDtx(), clock)));
+                  GetTargetBitrate(), config_.fec_enabled, GetDtx(),
+                  config_.complexity, clock)));
 }
 
 }  // namespace webrtc
@@ -113,6 +113,7 @@ class AudioEncoderOpus final : public AudioEncoder {
   bool fec_enabled() const { return config_.fec_enabled; }
   size_t num_channels_to_encode() const { return num_channels_to_encode_; }
   int next_frame_length_ms() const { return next_frame_length_ms_; }
+  int complexity() const { return config_.complexity; }
 
  protected:
   EncodedInfo EncodeImpl(uint32_t rtp_timestamp,
@@ -128,6 +129,8 @@ class AudioEncoderOpus final : public AudioEncoder {
   bool RecreateEncoderInstance(const Config& config);
   void SetFrameLength(int frame_length_ms);
   void SetNumChannelsToEncode(size_t num_channels_to_encode);
+  void SetComplexity(int complexity);
+  void ReportEncodeTime(int64_t encode_time_us);
   void ApplyAudioNetworkAdaptor();
   std::unique_ptr<AudioNetworkAdaptor> DefaultAudioNetworkAdaptorCreator(
       const std::string& config_string,
@@ -143,6 +146,10 @@ class AudioEncoderOpus final : public AudioEncoder {
   std::unique_ptr<PacketLossFractionSmoother> packet_loss_fraction_smoother_;
   AudioNetworkAdaptorCreator audio_network_adaptor_creator_;
   std::unique_ptr<AudioNetworkAdaptor> audio_network_adaptor_;
+  // Encode time and duration of the encoded audio since the last report to
+  // |audio_network_adaptor_|.
+  int64_t encode_time_us_;
+  int encoded_audio_ms_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(AudioEncoderOpus);
 };
@@ -82,6 +82,7 @@ AudioNetworkAdaptor::EncoderRuntimeConfig CreateEncoderRuntimeConfig() {
   constexpr bool kEnableDtx = false;
   constexpr size_t kNumChannels = 1;
   constexpr float kPacketLossFraction = 0.1f;
+  constexpr int kComplexity = 6;
   AudioNetworkAdaptor::EncoderRuntimeConfig config;
   config.bitrate_bps = rtc::Optional<int>(kBitrate);
   config.frame_length_ms = rtc::Optional<int>(kFrameLength);
@@ -90,6 +91,7 @@ AudioNetworkAdaptor::EncoderRuntimeConfig CreateEncoderRuntimeConfig() {
   config.num_channels = rtc::Optional<size_t>(kNumChannels);
   config.uplink_packet_loss_fraction =
       rtc::Optional<float>(kPacketLossFraction);
+  config.complexity = rtc::Optional<int>(kComplexity);
   return config;
 }
 
@@ -101,6 +103,7 @@ void CheckEncoderRuntimeConfig(
   EXPECT_EQ(*config.enable_fec, encoder->fec_enabled());
   EXPECT_EQ(*config.enable_dtx, encoder->GetDtx());
   EXPECT_EQ(*config.num_channels, encoder->num_channels_to_encode());
+  EXPECT_EQ(*config.complexity, encoder->complexity());
 }
 
 }  // namespace
@@ -309,6 +312,26 @@ TEST(AudioEncoderOpusTest, InvokeAudioNetworkAdaptorOnSetRtt) {
   CheckEncoderRuntimeConfig(states.encoder.get(), config);
 }
 
+TEST(AudioEncoderOpusTest, InvokeAudioNetworkAdaptorOnEncodeTime) {
+  auto states = CreateCodec(2);
+  states.encoder->EnableAudioNetworkAdaptor("", nullptr);
+
+  auto config = CreateEncoderRuntimeConfig();
+  EXPECT_CALL(**states.mock_audio_network_adaptor, GetEncoderRuntimeConfig())
+      .WillOnce(Return(config));
+
+  // The simulated clock does not advance while encoding, so the encode time
+  // is reported as zero, once per second of encoded audio.
+  EXPECT_CALL(**states.mock_audio_network_adaptor, SetEncodeTimeFraction(0.0f));
+  constexpr size_t kNumBlocks = 100;  // 1 second of audio.
+  const std::vector<int16_t> audio(480 * 2, 0);
+  rtc::Buffer encoded;
+  for (size_t i = 0; i < kNumBlocks; ++i)
+    states.encoder->Encode(i * 480, audio, &encoded);
+
+  CheckEncoderRuntimeConfig(states.encoder.get(), config);
+}
+
 TEST(AudioEncoderOpusTest,
      PacketLossFractionSmoothedOnSetUplinkPacketLossFraction) {
   auto states = CreateCodec(2);
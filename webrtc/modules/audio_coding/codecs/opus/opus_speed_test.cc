@@ -17,6 +17,8 @@ namespace webrtc {
 
 static const int kOpusBlockDurationMs = 20;
 static const int kOpusSamplingKhz = 48;
+// The Opus encoder delays the audio by its lookahead, 6.5 ms at 48 kHz.
+static const size_t kOpusDelaySamples = 312;
 
 class OpusSpeedTest : public AudioCodecSpeedTest {
  protected:
@@ -37,6 +39,7 @@ OpusSpeedTest::OpusSpeedTest()
                           kOpusSamplingKhz),
       opus_encoder_(NULL),
       opus_decoder_(NULL) {
+  codec_delay_samples_ = rtc::Optional<size_t>(kOpusDelaySamples);
 }
 
 void OpusSpeedTest::SetUp() {
@@ -10,6 +10,9 @@
 
 #include "webrtc/modules/audio_coding/codecs/tools/audio_codec_speed_test.h"
 
+#include <math.h>
+
+#include "webrtc/base/checks.h"
 #include "webrtc/base/format_macros.h"
 #include "webrtc/test/gtest.h"
 #include "webrtc/test/testsupport/fileutils.h"
@@ -103,6 +106,14 @@ void AudioCodecSpeedTest::EncodeDecode(size_t audio_duration_sec) {
   printf("Coding %d kHz-sampled %" PRIuS "-channel audio at %d bps ...\n",
          input_sampling_khz_, channels_, bit_rate_);
 
+  RTC_DCHECK(!codec_delay_samples_ ||
+             input_sampling_khz_ == output_sampling_khz_);
+  // Number of interleaved output samples so far, and the energies of the
+  // input and of the coding error, for the signal-to-noise ratio.
+  size_t output_pos = 0;
+  double signal_energy = 0.0;
+  double noise_energy = 0.0;
+
   while (time_now_ms < audio_duration_sec * 1000) {
     // Encode & decode.
     time_ms = EncodeABlock(&in_data_[data_pointer_], &bit_stream_[0],
@@ -114,6 +125,19 @@ void AudioCodecSpeedTest::EncodeDecode(size_t audio_duration_sec) {
       fwrite(&out_data_[0], sizeof(int16_t),
              output_length_sample_ * channels_, out_file_);
     }
+    if (codec_delay_samples_) {
+      const size_t delay = *codec_delay_samples_ * channels_;
+      for (size_t i = 0; i < output_length_sample_ * channels_;
+           ++i, ++output_pos) {
+        if (output_pos < delay)
+          continue;
+        const double input =
+            in_data_[(output_pos - delay) % loop_length_samples_];
+        const double error = out_data_[i] - input;
+        signal_energy += input * input;
+        noise_energy += error * error;
+      }
+    }
     data_pointer_ = (data_pointer_ + input_length_sample_ * channels_) %
         loop_length_samples_;
     time_now_ms += block_duration_ms_;
@@ -122,6 +146,10 @@ void AudioCodecSpeedTest::EncodeDecode(size_t audio_duration_sec) {
   printf("Encoding: %.2f%% real time,\nDecoding: %.2f%% real time.\n",
          (encoding_time_ms_ / audio_duration_sec) / 10.0,
          (decoding_time_ms_ / audio_duration_sec) / 10.0);
+  if (codec_delay_samples_ && noise_energy > 0.0) {
+    printf("Quality: %.2f dB SNR.\n",
+           10.0 * log10(signal_energy / noise_energy));
+  }
 }
 
 }  // namespace webrtc
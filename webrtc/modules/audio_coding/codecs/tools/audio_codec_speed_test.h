@@ -14,6 +14,7 @@
 #include <memory>
 #include <string>
 
+#include "webrtc/base/optional.h"
 #include "webrtc/test/gtest.h"
 #include "webrtc/typedefs.h"
 
@@ -49,7 +50,9 @@ class AudioCodecSpeedTest : public testing::TestWithParam<coding_param> {
                              int16_t* out_data) = 0;
 
   // Encoding and decode an audio of |audio_duration| (in seconds) and
-  // record the runtime for encoding and decoding separately.
+  // record the runtime for encoding and decoding separately. If
+  // |codec_delay_samples_| is set, the signal-to-noise ratio of the decoded
+  // audio is reported as well, as a measure of the coding quality.
   void EncodeDecode(size_t audio_duration);
 
   int block_duration_ms_;
@@ -76,6 +79,10 @@ class AudioCodecSpeedTest : public testing::TestWithParam<coding_param> {
   float decoding_time_ms_;
   FILE* out_file_;
 
+  // Delay, in samples-per-channel, of the decoded audio relative to the input.
+  // Only to be set if the input and output sampling rates are the same.
+  rtc::Optional<size_t> codec_delay_samples_;
+
   size_t channels_;
 
   // Bit rate is in bit-per-second.
@@ -16,9 +16,24 @@
 #include <algorithm>  // Access to min, max.
 
 #include "webrtc/common_audio/signal_processing/include/signal_processing_library.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
 
 namespace webrtc {
 
+namespace {
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// Returns true if the SSE2 versions of the kernels should be used. The CPU
+// features are only queried once, since these are called for every channel in
+// every Expand, Merge and time-stretching operation.
+bool UseSSE2() {
+  static const bool use_sse2 = WebRtc_GetCPUInfo(kSSE2) != 0;
+  return use_sse2;
+}
+#endif
+
+}  // namespace
+
 // Table of constants used in method DspHelper::ParabolicFit().
 const int16_t DspHelper::kParabolaCoefficients[17][3] = {
     { 120, 32, 64 },
@@ -254,6 +269,31 @@ void DspHelper::ParabolicFit(int16_t* signal_points, int fs_mult,
 size_t DspHelper::MinDistortion(const int16_t* signal, size_t min_lag,
                                 size_t max_lag, size_t length,
                                 int32_t* distortion_value) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (UseSSE2()) {
+    return MinDistortionSSE2(signal, min_lag, max_lag, length,
+                             distortion_value);
+  }
+#endif
+  return MinDistortionC(signal, min_lag, max_lag, length, distortion_value);
+}
+
+void DspHelper::CrossFade(const int16_t* input1, const int16_t* input2,
+                          size_t length, int16_t* mix_factor,
+                          int16_t factor_decrement, int16_t* output) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (UseSSE2()) {
+    CrossFadeSSE2(input1, input2, length, mix_factor, factor_decrement,
+                  output);
+    return;
+  }
+#endif
+  CrossFadeC(input1, input2, length, mix_factor, factor_decrement, output);
+}
+
+size_t DspHelper::MinDistortionC(const int16_t* signal, size_t min_lag,
+                                 size_t max_lag, size_t length,
+                                 int32_t* distortion_value) {
   size_t best_index = 0;
   int32_t min_distortion = WEBRTC_SPL_WORD32_MAX;
   for (size_t i = min_lag; i <= max_lag; i++) {
@@ -273,9 +313,9 @@ size_t DspHelper::MinDistortion(const int16_t* signal, size_t min_lag,
   return best_index;
 }
 
-void DspHelper::CrossFade(const int16_t* input1, const int16_t* input2,
-                          size_t length, int16_t* mix_factor,
-                          int16_t factor_decrement, int16_t* output) {
+void DspHelper::CrossFadeC(const int16_t* input1, const int16_t* input2,
+                           size_t length, int16_t* mix_factor,
+                           int16_t factor_decrement, int16_t* output) {
   int16_t factor = *mix_factor;
   int16_t complement_factor = 16384 - factor;
   for (size_t i = 0; i < length; i++) {
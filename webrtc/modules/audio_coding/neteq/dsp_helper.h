@@ -114,6 +114,26 @@ class DspHelper {
                         size_t length, int16_t* mix_factor,
                         int16_t factor_decrement, int16_t* output);
 
+  // Generic versions of MinDistortion() and CrossFade().
+  static size_t MinDistortionC(const int16_t* signal, size_t min_lag,
+                               size_t max_lag, size_t length,
+                               int32_t* distortion_value);
+  static void CrossFadeC(const int16_t* input1, const int16_t* input2,
+                         size_t length, int16_t* mix_factor,
+                         int16_t factor_decrement, int16_t* output);
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  // SSE2 versions of MinDistortion() and CrossFade(), which are bit-exact with
+  // the generic versions. Used by MinDistortion() and CrossFade() when the CPU
+  // supports SSE2.
+  static size_t MinDistortionSSE2(const int16_t* signal, size_t min_lag,
+                                  size_t max_lag, size_t length,
+                                  int32_t* distortion_value);
+  static void CrossFadeSSE2(const int16_t* input1, const int16_t* input2,
+                            size_t length, int16_t* mix_factor,
+                            int16_t factor_decrement, int16_t* output);
+#endif
+
   // Scales |input| with an increasing gain. Applies |factor| (Q14) to the first
   // sample and increases the gain by |increment| (Q20) for each sample. The
   // result is written to |output|. |length| samples are processed.
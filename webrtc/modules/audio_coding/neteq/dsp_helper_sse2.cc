@@ -0,0 +1,119 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_coding/neteq/dsp_helper.h"
+
+#include <emmintrin.h>
+
+#include "webrtc/common_audio/signal_processing/include/signal_processing_library.h"
+
+namespace webrtc {
+
+namespace {
+
+int32_t HorizontalSum(__m128i sum) {
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(sum);
+}
+
+// Truncates each 32-bit value to 16 bits and sign-extends the result, the way
+// a conversion to int16_t does. Packing the result with saturation is then
+// exact.
+__m128i TruncateTo16Bits(__m128i value) {
+  return _mm_srai_epi32(_mm_slli_epi32(value, 16), 16);
+}
+
+}  // namespace
+
+size_t DspHelper::MinDistortionSSE2(const int16_t* signal, size_t min_lag,
+                                    size_t max_lag, size_t length,
+                                    int32_t* distortion_value) {
+  const size_t vector_length = length & ~static_cast<size_t>(7);
+  const __m128i zero = _mm_setzero_si128();
+  size_t best_index = 0;
+  int32_t min_distortion = WEBRTC_SPL_WORD32_MAX;
+  for (size_t i = min_lag; i <= max_lag; i++) {
+    const int16_t* data1 = signal;
+    const int16_t* data2 = signal - i;
+    __m128i sum = zero;
+    size_t j = 0;
+    for (; j < vector_length; j += 8) {
+      const __m128i x1 =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(&data1[j]));
+      const __m128i x2 =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(&data2[j]));
+      // The absolute difference fits in an unsigned 16-bit value.
+      const __m128i abs_diff =
+          _mm_sub_epi16(_mm_max_epi16(x1, x2), _mm_min_epi16(x1, x2));
+      sum = _mm_add_epi32(sum, _mm_unpacklo_epi16(abs_diff, zero));
+      sum = _mm_add_epi32(sum, _mm_unpackhi_epi16(abs_diff, zero));
+    }
+    int32_t sum_diff = HorizontalSum(sum);
+    for (; j < length; j++) {
+      sum_diff += WEBRTC_SPL_ABS_W32(data1[j] - data2[j]);
+    }
+    // Compare with previous minimum.
+    if (sum_diff < min_distortion) {
+      min_distortion = sum_diff;
+      best_index = i;
+    }
+  }
+  *distortion_value = min_distortion;
+  return best_index;
+}
+
+void DspHelper::CrossFadeSSE2(const int16_t* input1, const int16_t* input2,
+                              size_t length, int16_t* mix_factor,
+                              int16_t factor_decrement, int16_t* output) {
+  const size_t vector_length = length & ~static_cast<size_t>(7);
+  int16_t factor = *mix_factor;
+  // The gains for eight consecutive samples. All gain arithmetic wraps around
+  // at 16 bits, like the int16_t arithmetic in the generic version.
+  __m128i factors = _mm_sub_epi16(
+      _mm_set1_epi16(factor),
+      _mm_mullo_epi16(_mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7),
+                      _mm_set1_epi16(factor_decrement)));
+  const __m128i factors_decrement =
+      _mm_set1_epi16(static_cast<int16_t>(8 * factor_decrement));
+  const __m128i unity = _mm_set1_epi16(16384);
+  const __m128i rounding = _mm_set1_epi32(8192);
+  size_t i = 0;
+  for (; i < vector_length; i += 8) {
+    const __m128i complement_factors = _mm_sub_epi16(unity, factors);
+    const __m128i x1 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&input1[i]));
+    const __m128i x2 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&input2[i]));
+    // factor * input1 + complement_factor * input2, in 32 bits.
+    __m128i lo = _mm_madd_epi16(_mm_unpacklo_epi16(factors, complement_factors),
+                                _mm_unpacklo_epi16(x1, x2));
+    __m128i hi = _mm_madd_epi16(_mm_unpackhi_epi16(factors, complement_factors),
+                                _mm_unpackhi_epi16(x1, x2));
+    lo = TruncateTo16Bits(_mm_srai_epi32(_mm_add_epi32(lo, rounding), 14));
+    hi = TruncateTo16Bits(_mm_srai_epi32(_mm_add_epi32(hi, rounding), 14));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&output[i]),
+                     _mm_packs_epi32(lo, hi));
+    factors = _mm_sub_epi16(factors, factors_decrement);
+  }
+
+  factor = static_cast<int16_t>(
+      factor - static_cast<int>(vector_length) * factor_decrement);
+  int16_t complement_factor = 16384 - factor;
+  for (; i < length; i++) {
+    output[i] =
+        (factor * input1[i] + complement_factor * input2[i] + 8192) >> 14;
+    factor -= factor_decrement;
+    complement_factor += factor_decrement;
+  }
+  *mix_factor = factor;
+}
+
+}  // namespace webrtc
@@ -10,7 +10,9 @@
 
 #include "webrtc/modules/audio_coding/neteq/dsp_helper.h"
 
+#include "webrtc/base/random.h"
 #include "webrtc/modules/audio_coding/neteq/audio_multi_vector.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
 #include "webrtc/test/gtest.h"
 #include "webrtc/typedefs.h"
 
@@ -86,4 +88,57 @@ TEST(DspHelper, RampSignalAudioMultiVector) {
     }
   }
 }
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// The SSE2 versions must be bit-exact with the generic versions. Use lengths
+// that are not multiples of the vector width to also cover the scalar tails.
+TEST(DspHelper, Sse2BitExact) {
+  if (!WebRtc_GetCPUInfo(kSSE2)) {
+    return;
+  }
+  static const size_t kMaxLag = 120;
+  static const size_t kMaxLength = 480;
+  Random random(42);
+  int16_t signal[kMaxLag + kMaxLength];
+  int16_t output_c[kMaxLength];
+  int16_t output_sse2[kMaxLength];
+  for (int trial = 0; trial < 100; ++trial) {
+    for (int16_t& sample : signal) {
+      sample = random.Rand<int16_t>();
+    }
+    const size_t length = random.Rand(1u, static_cast<uint32_t>(kMaxLength));
+
+    const size_t min_lag = random.Rand(1u, static_cast<uint32_t>(kMaxLag));
+    const size_t max_lag =
+        random.Rand(static_cast<uint32_t>(min_lag),
+                    static_cast<uint32_t>(kMaxLag));
+    int32_t distortion_c;
+    int32_t distortion_sse2;
+    EXPECT_EQ(DspHelper::MinDistortionC(&signal[kMaxLag], min_lag, max_lag,
+                                        length, &distortion_c),
+              DspHelper::MinDistortionSSE2(&signal[kMaxLag], min_lag, max_lag,
+                                           length, &distortion_sse2));
+    EXPECT_EQ(distortion_c, distortion_sse2);
+
+    // Fade over the whole length, as Merge and Expand do, and also use
+    // arbitrary gains to cover the wrap-around behavior.
+    int16_t factor_c = 16384;
+    int16_t factor_decrement =
+        static_cast<int16_t>(16384 / static_cast<int>(length));
+    if (trial % 2) {
+      factor_c = random.Rand<int16_t>();
+      factor_decrement = random.Rand<int16_t>();
+    }
+    int16_t factor_sse2 = factor_c;
+    DspHelper::CrossFadeC(signal, &signal[kMaxLag], length, &factor_c,
+                          factor_decrement, output_c);
+    DspHelper::CrossFadeSSE2(signal, &signal[kMaxLag], length, &factor_sse2,
+                             factor_decrement, output_sse2);
+    EXPECT_EQ(factor_c, factor_sse2);
+    for (size_t i = 0; i < length; ++i) {
+      EXPECT_EQ(output_c[i], output_sse2[i]) << "index " << i;
+    }
+  }
+}
+#endif  // defined(WEBRTC_ARCH_X86_FAMILY)
 }  // namespace webrtc
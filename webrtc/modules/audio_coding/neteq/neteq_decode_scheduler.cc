@@ -0,0 +1,192 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_coding/neteq/neteq_decode_scheduler.h"
+
+#include <algorithm>
+
+#include "webrtc/base/checks.h"
+#include "webrtc/base/event.h"
+#include "webrtc/base/platform_thread.h"
+#include "webrtc/modules/audio_coding/neteq/include/neteq.h"
+#include "webrtc/modules/include/module_common_types.h"
+
+namespace webrtc {
+
+struct NetEqDecodeScheduler::DecodedFrame {
+  AudioFrame audio_frame;
+  bool muted = false;
+  int error = NetEq::kOK;
+};
+
+// The pre-decoded frames of one NetEq instance, in a ring buffer. All calls to
+// NetEq::GetAudio() for the instance are made with |crit| held, so that the
+// frames are queued in the order they were produced.
+struct NetEqDecodeScheduler::Stream {
+  Stream(NetEq* neteq, size_t lookahead_frames)
+      : neteq(neteq), frames(lookahead_frames) {
+    for (auto& frame : frames)
+      frame.reset(new DecodedFrame());
+  }
+
+  NetEq* const neteq;
+  rtc::CriticalSection crit;
+  std::vector<std::unique_ptr<DecodedFrame>> frames GUARDED_BY(crit);
+  size_t first_frame GUARDED_BY(crit) = 0;
+  size_t num_frames GUARDED_BY(crit) = 0;
+  bool removed GUARDED_BY(crit) = false;
+};
+
+struct NetEqDecodeScheduler::Worker {
+  explicit Worker(NetEqDecodeScheduler* scheduler)
+      : scheduler(scheduler),
+        wake_event(false, false),
+        thread(&NetEqDecodeScheduler::WorkerThread,
+               this,
+               "NetEqDecodeWorker") {}
+
+  NetEqDecodeScheduler* const scheduler;
+  rtc::Event wake_event;
+  rtc::PlatformThread thread;
+};
+
+NetEqDecodeScheduler::NetEqDecodeScheduler(size_t num_threads,
+                                           size_t lookahead_frames)
+    : lookahead_frames_(lookahead_frames), next_stream_(0) {
+  for (size_t i = 0; i < num_threads; ++i) {
+    workers_.emplace_back(new Worker(this));
+    workers_.back()->thread.Start();
+    workers_.back()->thread.SetPriority(rtc::kRealtimePriority);
+  }
+}
+
+NetEqDecodeScheduler::~NetEqDecodeScheduler() {
+  {
+    rtc::CritScope lock(&crit_);
+    stopping_ = true;
+  }
+  for (auto& worker : workers_) {
+    worker->wake_event.Set();
+    worker->thread.Stop();
+  }
+}
+
+void NetEqDecodeScheduler::AddNetEq(NetEq* neteq) {
+  RTC_DCHECK(neteq);
+  std::shared_ptr<Stream> stream(new Stream(neteq, lookahead_frames_));
+  rtc::CritScope lock(&crit_);
+  RTC_DCHECK(stream_map_.find(neteq) == stream_map_.end());
+  streams_.push_back(stream);
+  stream_map_[neteq] = stream;
+}
+
+void NetEqDecodeScheduler::RemoveNetEq(NetEq* neteq) {
+  std::shared_ptr<Stream> stream;
+  {
+    rtc::CritScope lock(&crit_);
+    auto it = stream_map_.find(neteq);
+    if (it == stream_map_.end())
+      return;
+    stream = it->second;
+    stream_map_.erase(it);
+    auto pos = std::find(streams_.begin(), streams_.end(), stream);
+    RTC_DCHECK(pos != streams_.end());
+    // Keep the streams not yet decoded in this round at the same positions
+    // relative to |next_stream_|.
+    if (static_cast<size_t>(pos - streams_.begin()) < next_stream_)
+      --next_stream_;
+    streams_.erase(pos);
+  }
+  // Wait for a worker thread that may be decoding the stream right now.
+  rtc::CritScope lock(&stream->crit);
+  stream->removed = true;
+  stream->num_frames = 0;
+}
+
+int NetEqDecodeScheduler::GetAudio(NetEq* neteq,
+                                   AudioFrame* audio_frame,
+                                   bool* muted) {
+  std::shared_ptr<Stream> stream = FindStream(neteq);
+  if (!stream)
+    return neteq->GetAudio(audio_frame, muted);
+
+  rtc::CritScope lock(&stream->crit);
+  if (stream->num_frames == 0) {
+    // Nothing is ready; decode on the calling thread.
+    return neteq->GetAudio(audio_frame, muted);
+  }
+  const DecodedFrame& frame = *stream->frames[stream->first_frame];
+  audio_frame->CopyFrom(frame.audio_frame);
+  *muted = frame.muted;
+  stream->first_frame = (stream->first_frame + 1) % stream->frames.size();
+  --stream->num_frames;
+  return frame.error;
+}
+
+void NetEqDecodeScheduler::Schedule() {
+  if (workers_.empty()) {
+    // Decode everything right here.
+    while (std::shared_ptr<Stream> stream = NextStreamToDecode())
+      DecodeAhead(stream.get());
+  }
+  {
+    rtc::CritScope lock(&crit_);
+    next_stream_ = 0;
+  }
+  for (auto& worker : workers_)
+    worker->wake_event.Set();
+}
+
+bool NetEqDecodeScheduler::WorkerThread(void* obj) {
+  Worker* worker = static_cast<Worker*>(obj);
+  return worker->scheduler->ProcessStreams(worker);
+}
+
+bool NetEqDecodeScheduler::ProcessStreams(Worker* worker) {
+  worker->wake_event.Wait(rtc::Event::kForever);
+  {
+    rtc::CritScope lock(&crit_);
+    if (stopping_)
+      return false;
+  }
+  while (std::shared_ptr<Stream> stream = NextStreamToDecode())
+    DecodeAhead(stream.get());
+  return true;
+}
+
+std::shared_ptr<NetEqDecodeScheduler::Stream>
+NetEqDecodeScheduler::NextStreamToDecode() {
+  rtc::CritScope lock(&crit_);
+  if (stopping_ || next_stream_ >= streams_.size())
+    return nullptr;
+  return streams_[next_stream_++];
+}
+
+std::shared_ptr<NetEqDecodeScheduler::Stream> NetEqDecodeScheduler::FindStream(
+    NetEq* neteq) {
+  rtc::CritScope lock(&crit_);
+  auto it = stream_map_.find(neteq);
+  return it == stream_map_.end() ? nullptr : it->second;
+}
+
+void NetEqDecodeScheduler::DecodeAhead(Stream* stream) {
+  rtc::CritScope lock(&stream->crit);
+  if (stream->removed)
+    return;
+  while (stream->num_frames < stream->frames.size()) {
+    DecodedFrame* frame = stream->frames[(stream->first_frame +
+                                          stream->num_frames) %
+                                         stream->frames.size()].get();
+    frame->error = stream->neteq->GetAudio(&frame->audio_frame, &frame->muted);
+    ++stream->num_frames;
+  }
+}
+
+}  // namespace webrtc
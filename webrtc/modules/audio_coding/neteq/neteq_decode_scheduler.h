@@ -0,0 +1,103 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_AUDIO_CODING_NETEQ_NETEQ_DECODE_SCHEDULER_H_
+#define WEBRTC_MODULES_AUDIO_CODING_NETEQ_NETEQ_DECODE_SCHEDULER_H_
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/thread_annotations.h"
+
+namespace webrtc {
+
+class AudioFrame;
+class NetEq;
+
+// Produces the 10 ms output frames of a set of NetEq instances ahead of
+// playout, on a pool of worker threads. Each frame is made by a regular call to
+// NetEq::GetAudio(), so decisions, decoding and signal processing are exactly
+// as without the scheduler; they are only moved off the playout thread. The
+// playout thread then only copies the ready frames, which makes the pull of
+// many streams (e.g., on a server mixing hundreds of streams) cheap and
+// predictable.
+//
+// The price is an extra playout delay of |lookahead_frames| * 10 ms, since the
+// frames are decoded before the packets arriving in the meantime are inserted.
+// For the same reason, NetEq::GetPlayoutTimestamp() is ahead of the playout by
+// the number of pre-decoded frames.
+//
+// Typical use, once every 10 ms on the playout thread:
+//   for (NetEq* neteq : neteqs)
+//     scheduler.GetAudio(neteq, &frame, &muted);  // Only copies, if ready.
+//   scheduler.Schedule();  // Decode the next frames in the background.
+class NetEqDecodeScheduler {
+ public:
+  // Creates a scheduler that decodes up to |lookahead_frames| frames ahead for
+  // each NetEq instance, using |num_threads| worker threads. With no worker
+  // threads, the frames are decoded synchronously in Schedule().
+  NetEqDecodeScheduler(size_t num_threads, size_t lookahead_frames);
+
+  // Stops the worker threads. Any remaining NetEq instances are dropped.
+  ~NetEqDecodeScheduler();
+
+  // Adds |neteq| to the instances decoded ahead of playout. An instance must
+  // not be added twice, and must be removed before it is deleted.
+  void AddNetEq(NetEq* neteq);
+
+  // Removes |neteq| and discards its pre-decoded frames. When this method
+  // returns, no worker thread uses |neteq| anymore.
+  void RemoveNetEq(NetEq* neteq);
+
+  // Writes the next 10 ms frame of |neteq| to |audio_frame|, with the same
+  // semantics as NetEq::GetAudio(), whose return value and |muted| flag are
+  // passed on. The oldest pre-decoded frame is used if there is one; otherwise
+  // (e.g., if the workers have fallen behind, or |neteq| was never added) the
+  // frame is decoded directly.
+  int GetAudio(NetEq* neteq, AudioFrame* audio_frame, bool* muted);
+
+  // Lets the worker threads top up the pre-decoded frames of all instances.
+  // Returns immediately, unless there are no worker threads. Should be called
+  // right after the playout pull, so that decoding overlaps the time until the
+  // next pull.
+  void Schedule();
+
+ private:
+  struct DecodedFrame;
+  struct Stream;
+  struct Worker;
+
+  static bool WorkerThread(void* obj);
+  bool ProcessStreams(Worker* worker);
+  std::shared_ptr<Stream> NextStreamToDecode();
+  std::shared_ptr<Stream> FindStream(NetEq* neteq);
+  void DecodeAhead(Stream* stream);
+
+  const size_t lookahead_frames_;
+
+  rtc::CriticalSection crit_;
+  // The shared pointers let a worker thread finish with a stream that is
+  // removed meanwhile.
+  std::vector<std::shared_ptr<Stream>> streams_ GUARDED_BY(crit_);
+  std::map<NetEq*, std::shared_ptr<Stream>> stream_map_ GUARDED_BY(crit_);
+  // Index in |streams_| of the next stream to decode in the current round.
+  size_t next_stream_ GUARDED_BY(crit_);
+  bool stopping_ GUARDED_BY(crit_) = false;
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(NetEqDecodeScheduler);
+};
+
+}  // namespace webrtc
+#endif  // WEBRTC_MODULES_AUDIO_CODING_NETEQ_NETEQ_DECODE_SCHEDULER_H_
@@ -0,0 +1,144 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_coding/neteq/neteq_decode_scheduler.h"
+
+#include <math.h>
+
+#include <memory>
+#include <vector>
+
+#include "webrtc/modules/audio_coding/codecs/builtin_audio_decoder_factory.h"
+#include "webrtc/modules/audio_coding/codecs/pcm16b/pcm16b.h"
+#include "webrtc/modules/audio_coding/neteq/include/neteq.h"
+#include "webrtc/modules/include/module_common_types.h"
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+const int kSampleRateHz = 16000;
+const size_t kPacketSizeSamples = 320;  // 20 ms.
+const uint8_t kPayloadType = 94;
+const int kNumPackets = 40;
+const int kLossPeriod = 7;  // Drop every 7th packet, to exercise expand.
+const int kNumStreams = 4;
+const int kNumFrames = 100;
+
+// Creates a NetEq instance and fills it with the same packets as all other
+// instances, so that all instances produce identical output.
+std::unique_ptr<NetEq> CreateNetEqWithPackets() {
+  NetEq::Config config;
+  config.sample_rate_hz = kSampleRateHz;
+  std::unique_ptr<NetEq> neteq(
+      NetEq::Create(config, CreateBuiltinAudioDecoderFactory()));
+  EXPECT_EQ(NetEq::kOK,
+            neteq->RegisterPayloadType(NetEqDecoder::kDecoderPCM16Bwb,
+                                       "pcm16-wb", kPayloadType));
+
+  int16_t input[kPacketSizeSamples];
+  uint8_t payload[2 * kPacketSizeSamples];
+  for (int packet = 0; packet < kNumPackets; ++packet) {
+    for (size_t i = 0; i < kPacketSizeSamples; ++i) {
+      const size_t n = packet * kPacketSizeSamples + i;
+      input[i] = static_cast<int16_t>(8000 * sin(0.05 * n));
+    }
+    if (packet % kLossPeriod == kLossPeriod - 1)
+      continue;
+    WebRtcPcm16b_Encode(input, kPacketSizeSamples, payload);
+    WebRtcRTPHeader rtp_header;
+    rtp_header.header.payloadType = kPayloadType;
+    rtp_header.header.sequenceNumber = packet;
+    rtp_header.header.timestamp = packet * kPacketSizeSamples;
+    rtp_header.header.ssrc = 0x1234;
+    rtp_header.header.markerBit = false;
+    EXPECT_EQ(NetEq::kOK, neteq->InsertPacket(rtp_header, payload, 0));
+  }
+  return neteq;
+}
+
+void ExpectEqualFrames(const AudioFrame& reference, const AudioFrame& frame) {
+  ASSERT_EQ(reference.samples_per_channel_, frame.samples_per_channel_);
+  ASSERT_EQ(reference.num_channels_, frame.num_channels_);
+  EXPECT_EQ(reference.speech_type_, frame.speech_type_);
+  EXPECT_EQ(reference.timestamp_, frame.timestamp_);
+  for (size_t i = 0; i < frame.samples_per_channel_ * frame.num_channels_;
+       ++i) {
+    ASSERT_EQ(reference.data_[i], frame.data_[i]) << "sample " << i;
+  }
+}
+
+// Verifies that pulling through the scheduler gives the same output as calling
+// NetEq::GetAudio() directly, no matter how far ahead the frames are decoded.
+void RunAndCompare(size_t num_threads, size_t lookahead_frames) {
+  SCOPED_TRACE(testing::Message() << num_threads << " threads, "
+                                  << lookahead_frames << " lookahead frames");
+  std::vector<std::unique_ptr<NetEq>> references;
+  std::vector<std::unique_ptr<NetEq>> neteqs;
+  NetEqDecodeScheduler scheduler(num_threads, lookahead_frames);
+  for (int i = 0; i < kNumStreams; ++i) {
+    references.push_back(CreateNetEqWithPackets());
+    neteqs.push_back(CreateNetEqWithPackets());
+    scheduler.AddNetEq(neteqs.back().get());
+  }
+
+  AudioFrame reference_frame;
+  AudioFrame frame;
+  bool muted;
+  for (int frame_no = 0; frame_no < kNumFrames; ++frame_no) {
+    for (int i = 0; i < kNumStreams; ++i) {
+      ASSERT_EQ(NetEq::kOK, references[i]->GetAudio(&reference_frame, &muted));
+      ASSERT_EQ(NetEq::kOK,
+                scheduler.GetAudio(neteqs[i].get(), &frame, &muted));
+      EXPECT_FALSE(muted);
+      ExpectEqualFrames(reference_frame, frame);
+    }
+    scheduler.Schedule();
+  }
+
+  for (auto& neteq : neteqs)
+    scheduler.RemoveNetEq(neteq.get());
+}
+
+}  // namespace
+
+TEST(NetEqDecodeSchedulerTest, SameOutputWithoutWorkerThreads) {
+  RunAndCompare(0, 0);
+  RunAndCompare(0, 1);
+  RunAndCompare(0, 3);
+}
+
+TEST(NetEqDecodeSchedulerTest, SameOutputWithWorkerThreads) {
+  RunAndCompare(1, 1);
+  RunAndCompare(3, 1);
+  RunAndCompare(3, 4);
+}
+
+// Verifies that the frames decoded ahead are discarded when an instance is
+// removed, and that it can still be pulled through the scheduler afterwards.
+TEST(NetEqDecodeSchedulerTest, RemoveDiscardsDecodedFrames) {
+  const size_t kLookaheadFrames = 2;
+  std::unique_ptr<NetEq> reference = CreateNetEqWithPackets();
+  std::unique_ptr<NetEq> neteq = CreateNetEqWithPackets();
+  NetEqDecodeScheduler scheduler(0, kLookaheadFrames);
+  scheduler.AddNetEq(neteq.get());
+  scheduler.Schedule();
+  scheduler.RemoveNetEq(neteq.get());
+
+  AudioFrame reference_frame;
+  AudioFrame frame;
+  bool muted;
+  for (size_t i = 0; i <= kLookaheadFrames; ++i)
+    ASSERT_EQ(NetEq::kOK, reference->GetAudio(&reference_frame, &muted));
+  ASSERT_EQ(NetEq::kOK, scheduler.GetAudio(neteq.get(), &frame, &muted));
+  ExpectEqualFrames(reference_frame, frame);
+}
+
+}  // namespace webrtc
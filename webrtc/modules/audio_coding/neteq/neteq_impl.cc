@@ -590,7 +590,7 @@ int NetEqImpl::InsertPacketInternal(const WebRtcRTPHeader& rtp_header,
     packet.timestamp = rtp_header.header.timestamp;
     packet.payload.SetData(payload.data(), payload.size());
     // Waiting time will be set upon inserting the packet in the buffer.
-    RTC_DCHECK(!packet.waiting_time);
+    RTC_DCHECK(!packet.insert_ticks);
     return packet;
   }());
 
@@ -1962,7 +1962,10 @@ int NetEqImpl::ExtractPackets(size_t required_samples,
       assert(false);  // Should always be able to extract a packet here.
       return -1;
     }
-    stats_.StoreWaitingTime(packet->waiting_time->ElapsedMs());
+    RTC_DCHECK(packet->insert_ticks);
+    stats_.StoreWaitingTime(static_cast<int>(
+        (tick_timer_->ticks() - *packet->insert_ticks) *
+        tick_timer_->ms_per_tick()));
     RTC_DCHECK(!packet->empty());
 
     if (first_packet) {
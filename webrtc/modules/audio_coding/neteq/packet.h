@@ -15,6 +15,7 @@
 #include <memory>
 
 #include "webrtc/base/buffer.h"
+#include "webrtc/base/optional.h"
 #include "webrtc/modules/audio_coding/codecs/audio_decoder.h"
 #include "webrtc/modules/audio_coding/neteq/tick_timer.h"
 #include "webrtc/typedefs.h"
@@ -71,7 +72,10 @@ struct Packet {
   // Datagram excluding RTP header and header extension.
   rtc::Buffer payload;
   Priority priority;
-  std::unique_ptr<TickTimer::Stopwatch> waiting_time;
+  // TickTimer ticks when the packet was inserted into the PacketBuffer, from
+  // which its waiting time is computed. Kept as a count rather than as a
+  // TickTimer::Stopwatch, so that inserting a packet doesn't allocate.
+  rtc::Optional<uint64_t> insert_ticks;
   std::unique_ptr<AudioDecoder::EncodedAudioFrame> frame;
 
   Packet();
@@ -81,7 +85,7 @@ struct Packet {
   // Packets should generally be moved around but sometimes it's useful to make
   // a copy, for example for testing purposes. NOTE: Will only work for
   // un-parsed packets, i.e. |frame| must be unset. The payload will, however,
-  // be copied. |waiting_time| will also not be copied.
+  // be copied. |insert_ticks| will also not be copied.
   Packet Clone() const;
 
   Packet& operator=(Packet&& b);
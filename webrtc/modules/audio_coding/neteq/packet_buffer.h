@@ -11,6 +11,8 @@
 #ifndef WEBRTC_MODULES_AUDIO_CODING_NETEQ_PACKET_BUFFER_H_
 #define WEBRTC_MODULES_AUDIO_CODING_NETEQ_PACKET_BUFFER_H_
 
+#include <vector>
+
 #include "webrtc/base/constructormagic.h"
 #include "webrtc/base/optional.h"
 #include "webrtc/modules/audio_coding/neteq/packet.h"
@@ -22,7 +24,9 @@ namespace webrtc {
 class DecoderDatabase;
 class TickTimer;
 
-// This is the actual buffer holding the packets before decoding.
+// This is the actual buffer holding the packets before decoding. The packets
+// are kept in a fixed-capacity ring which is allocated up front, so inserting
+// and extracting packets does not allocate.
 class PacketBuffer {
  public:
   enum BufferReturnCodes {
@@ -134,8 +138,30 @@ class PacketBuffer {
   }
 
  private:
+  // Returns the packet |index| positions from the front of the buffer.
+  Packet& PacketAt(size_t index) {
+    return slots_[(head_ + index) & slot_mask_];
+  }
+  const Packet& PacketAt(size_t index) const {
+    return slots_[(head_ + index) & slot_mask_];
+  }
+
+  // Removes the first packet from the buffer. The packet must already have
+  // been released or moved from.
+  void PopFront();
+
+  // Inserts |packet| at position |index|, moving the shorter side of the
+  // buffer one step to make room.
+  void InsertAt(size_t index, Packet&& packet);
+
   size_t max_number_of_packets_;
-  PacketList buffer_;
+  // Ring of packet slots, sorted in decoding order starting at |head_|. The
+  // number of slots is a power of two no smaller than
+  // |max_number_of_packets_|, and is never changed after construction.
+  std::vector<Packet> slots_;
+  size_t slot_mask_;
+  size_t head_ = 0;
+  size_t size_ = 0;
   const TickTimer* tick_timer_;
   RTC_DISALLOW_COPY_AND_ASSIGN(PacketBuffer);
 };
@@ -368,6 +368,89 @@ TEST(PacketBuffer, Reordering) {
   EXPECT_CALL(decoder_database, Die());  // Called when object is deleted.
 }
 
+// Test that the packets stay in order while the buffer wraps around its
+// storage many times, with late packets being inserted in the middle and at the
+// front of the buffer.
+TEST(PacketBuffer, ReorderingWithWrapAround) {
+  TickTimer tick_timer;
+  PacketBuffer buffer(5, &tick_timer);  // 5 packets.
+  const uint32_t ts_increment = 10;
+  PacketGenerator gen(0, 0, 0, ts_increment);
+  const int payload_len = 10;
+
+  uint32_t expected_ts = 0;
+  for (int i = 0; i < 100; ++i) {
+    // Generate four packets and insert them in the order 3, 2, 0, 1.
+    Packet packets[4];
+    for (Packet& packet : packets) {
+      packet = gen.NextPacket(payload_len);
+    }
+    const size_t num_packets = buffer.NumPacketsInBuffer() + 4;
+    for (int j : {3, 2, 0, 1}) {
+      EXPECT_EQ(PacketBuffer::kOK, buffer.InsertPacket(std::move(packets[j])));
+    }
+    EXPECT_EQ(num_packets, buffer.NumPacketsInBuffer());
+
+    // Extract all but one of them, leaving one to be reordered with the next
+    // batch.
+    for (size_t j = 0; j < num_packets - 1; ++j) {
+      const rtc::Optional<Packet> packet = buffer.GetNextPacket();
+      ASSERT_TRUE(packet);
+      EXPECT_EQ(expected_ts, packet->timestamp);
+      expected_ts += ts_increment;
+    }
+    ASSERT_EQ(1u, buffer.NumPacketsInBuffer());
+    // Extract the last one too once in a while, to vary the alignment of the
+    // packets in the ring.
+    if (i % 3 == 0) {
+      EXPECT_EQ(PacketBuffer::kOK, buffer.DiscardNextPacket());
+      expected_ts += ts_increment;
+    }
+  }
+}
+
+// Test that removing the packets of one payload type keeps the order of the
+// remaining packets.
+TEST(PacketBuffer, DiscardPacketsWithPayloadTypeKeepsOrder) {
+  TickTimer tick_timer;
+  PacketBuffer buffer(10, &tick_timer);  // 10 packets.
+  const uint32_t ts_increment = 10;
+  PacketGenerator gen(0, 0, 0, ts_increment);
+  const int payload_len = 10;
+
+  // Make the buffer wrap around its storage before inserting the packets.
+  for (int i = 0; i < 7; ++i) {
+    EXPECT_EQ(PacketBuffer::kOK,
+              buffer.InsertPacket(gen.NextPacket(payload_len)));
+    EXPECT_EQ(PacketBuffer::kOK, buffer.DiscardNextPacket());
+  }
+
+  // Insert 10 packets, alternating between payload types 0 and 1.
+  const uint32_t start_ts = gen.ts_;
+  for (int i = 0; i < 10; ++i) {
+    gen.pt_ = i % 2;
+    EXPECT_EQ(PacketBuffer::kOK,
+              buffer.InsertPacket(gen.NextPacket(payload_len)));
+  }
+
+  buffer.DiscardPacketsWithPayloadType(1);
+  EXPECT_EQ(5u, buffer.NumPacketsInBuffer());
+  for (int i = 0; i < 5; ++i) {
+    const rtc::Optional<Packet> packet = buffer.GetNextPacket();
+    ASSERT_TRUE(packet);
+    EXPECT_EQ(0, packet->payload_type);
+    EXPECT_EQ(start_ts + 2 * i * ts_increment, packet->timestamp);
+  }
+  EXPECT_TRUE(buffer.Empty());
+
+  // The buffer must still be able to hold 10 packets.
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(PacketBuffer::kOK,
+              buffer.InsertPacket(gen.NextPacket(payload_len)));
+  }
+  EXPECT_EQ(10u, buffer.NumPacketsInBuffer());
+}
+
 // The test first inserts a packet with narrow-band CNG, then a packet with
 // wide-band speech. The expected behavior of the packet buffer is to detect a
 // change in sample rate, even though no speech packet has been inserted before,
@@ -8,7 +8,10 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <string>
+
 #include "webrtc/modules/audio_coding/neteq/tools/neteq_performance_test.h"
+#include "webrtc/system_wrappers/include/cpu_info.h"
 #include "webrtc/test/gtest.h"
 #include "webrtc/test/testsupport/perf_test.h"
 #include "webrtc/typedefs.h"
@@ -39,3 +42,88 @@ TEST(NetEqPerformanceTest, RunClean) {
   webrtc::test::PrintResult(
       "neteq_performance", "", "0_pl_0_drift", runtime, "ms", true);
 }
+
+// Runs a test with packets arriving with up to 120 ms of jitter, and thus
+// partly out of order, to exercise the time-stretching and merge code.
+TEST(NetEqPerformanceTest, RunJitter) {
+  const int kSimulationTimeMs = 10000000;
+  const int kLossPeriod = 0;  // No losses.
+  const double kDriftFactor = 0.0;  // No clock drift.
+  const int kMaxJitterMs = 120;
+  int64_t runtime = webrtc::test::NetEqPerformanceTest::Run(
+      kSimulationTimeMs, kLossPeriod, kDriftFactor, kMaxJitterMs);
+  ASSERT_GT(runtime, 0);
+  webrtc::test::PrintResult(
+      "neteq_performance", "", "0_pl_0_drift_120_jitter", runtime, "ms", true);
+}
+
+// Runs a test with 20% packet losses, 10% clock drift and up to 120 ms of
+// jitter, which keeps NetEq in loss concealment most of the time.
+TEST(NetEqPerformanceTest, RunLossyJitter) {
+  const int kSimulationTimeMs = 10000000;
+  const int kLossPeriod = 5;  // Drop every 5th packet.
+  const double kDriftFactor = 0.1;
+  const int kMaxJitterMs = 120;
+  int64_t runtime = webrtc::test::NetEqPerformanceTest::Run(
+      kSimulationTimeMs, kLossPeriod, kDriftFactor, kMaxJitterMs);
+  ASSERT_GT(runtime, 0);
+  webrtc::test::PrintResult(
+      "neteq_performance", "", "20_pl_10_drift_120_jitter", runtime, "ms",
+      true);
+}
+
+// Runs the packet buffer with a fill level typical for a jittery network, and
+// with every 10th packet arriving out of order.
+TEST(NetEqPerformanceTest, RunPacketBuffer) {
+  const int kNumPackets = 10000000;
+  const size_t kFillLevel = 20;
+  const int kReorderPeriod = 10;  // Reorder every 10th packet.
+  int64_t runtime = webrtc::test::NetEqPerformanceTest::RunPacketBuffer(
+      kNumPackets, kFillLevel, kReorderPeriod);
+  ASSERT_GE(runtime, 0);
+  webrtc::test::PrintResult(
+      "neteq_performance", "", "packet_buffer_20_fill_10_reorder", runtime,
+      "ms", true);
+}
+
+namespace {
+
+// Runs 200 streams in real time for 10 seconds, with up to 60 ms of jitter, and
+// reports the cost of the playout pull, the CPU load and the playout delay.
+void RunMultiStream(const std::string& trace,
+                    size_t num_threads,
+                    size_t lookahead_frames) {
+  const int kSimulationTimeMs = 10000;
+  const int kNumStreams = 200;
+  const int kMaxJitterMs = 60;
+  webrtc::test::NetEqPerformanceTest::MultiStreamStats stats;
+  int64_t runtime = webrtc::test::NetEqPerformanceTest::RunMultiStream(
+      kSimulationTimeMs, kNumStreams, num_threads, lookahead_frames,
+      kMaxJitterMs, &stats);
+  ASSERT_GT(runtime, 0);
+  webrtc::test::PrintResult("neteq_multi_stream_mean_pull_time", "", trace,
+                            std::to_string(stats.mean_pull_time_us), "us",
+                            true);
+  webrtc::test::PrintResult("neteq_multi_stream_max_pull_time", "", trace,
+                            std::to_string(stats.max_pull_time_us), "us",
+                            true);
+  webrtc::test::PrintResult("neteq_multi_stream_cpu_load", "", trace,
+                            std::to_string(stats.cpu_load_percent), "%", true);
+  webrtc::test::PrintResult("neteq_multi_stream_playout_delay", "", trace,
+                            std::to_string(stats.mean_playout_delay_ms), "ms",
+                            true);
+}
+
+}  // namespace
+
+// Decodes all streams in the playout pull, one after the other.
+TEST(NetEqPerformanceTest, RunMultiStreamSerial) {
+  RunMultiStream("200_streams_serial", 0, 0);
+}
+
+// Decodes all streams one frame ahead of the playout pull, on one worker
+// thread per core.
+TEST(NetEqPerformanceTest, RunMultiStreamScheduled) {
+  RunMultiStream("200_streams_scheduled",
+                 webrtc::CpuInfo::DetectNumberOfCores(), 1);
+}
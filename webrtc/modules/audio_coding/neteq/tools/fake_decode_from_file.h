@@ -26,7 +26,9 @@ namespace test {
 // encoding represents, and how many samples the decoder should produce for that
 // encoding. A helper method PrepareEncoded is provided to prepare such
 // encodings. If packets are missing, as determined from the timestamps, the
-// file reading will skip forward to match the loss.
+// file reading will skip forward to match the loss. If |input| is null, no
+// file is read and the decoder produces silence instead; this is useful when
+// only the NetEq statistics are of interest.
 class FakeDecodeFromFile : public AudioDecoder {
  public:
   FakeDecodeFromFile(std::unique_ptr<InputAudioFile> input,
@@ -10,14 +10,26 @@
 
 #include "webrtc/modules/audio_coding/neteq/tools/neteq_performance_test.h"
 
+#include <algorithm>
+#include <ctime>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include "webrtc/base/checks.h"
+#include "webrtc/base/random.h"
 #include "webrtc/modules/audio_coding/codecs/builtin_audio_decoder_factory.h"
 #include "webrtc/modules/audio_coding/codecs/pcm16b/pcm16b.h"
 #include "webrtc/modules/audio_coding/neteq/include/neteq.h"
+#include "webrtc/modules/audio_coding/neteq/neteq_decode_scheduler.h"
+#include "webrtc/modules/audio_coding/neteq/packet_buffer.h"
+#include "webrtc/modules/audio_coding/neteq/tick_timer.h"
 #include "webrtc/modules/audio_coding/neteq/tools/audio_loop.h"
 #include "webrtc/modules/audio_coding/neteq/tools/rtp_generator.h"
 #include "webrtc/modules/include/module_common_types.h"
 #include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/system_wrappers/include/sleep.h"
 #include "webrtc/test/testsupport/fileutils.h"
 #include "webrtc/typedefs.h"
 
@@ -32,6 +44,13 @@ namespace test {
 int64_t NetEqPerformanceTest::Run(int runtime_ms,
                                   int lossrate,
                                   double drift_factor) {
+  return Run(runtime_ms, lossrate, drift_factor, 0);
+}
+
+int64_t NetEqPerformanceTest::Run(int runtime_ms,
+                                  int lossrate,
+                                  double drift_factor,
+                                  int max_jitter_ms) {
   const std::string kInputFileName =
       webrtc::test::ResourcePath("audio_coding/testfile32kHz", "pcm");
   const int kSampRateHz = 32000;
@@ -74,6 +93,14 @@ int64_t NetEqPerformanceTest::Run(int runtime_ms,
                                            input_samples.size(), input_payload);
   RTC_CHECK_EQ(sizeof(input_payload), payload_len);
 
+  // Packets delayed by the network jitter, ordered by arrival time.
+  struct DelayedPacket {
+    WebRtcRTPHeader rtp_header;
+    std::vector<uint8_t> payload;
+  };
+  std::multimap<int32_t, DelayedPacket> delayed_packets;
+  Random random(0x1234);
+
   // Main loop.
   webrtc::Clock* clock = webrtc::Clock::GetRealTimeClock();
   int64_t start_time_ms = clock->TimeInMilliseconds();
@@ -85,7 +112,17 @@ int64_t NetEqPerformanceTest::Run(int runtime_ms,
       if (lossrate > 0) {
         lost = ((rtp_header.header.sequenceNumber - 1) % lossrate) == 0;
       }
-      if (!lost) {
+      if (!lost && max_jitter_ms > 0) {
+        // Hold the packet back until it arrives.
+        const int32_t arrival_time_ms =
+            packet_input_time_ms + random.Rand(0, max_jitter_ms);
+        delayed_packets.insert(std::make_pair(
+            arrival_time_ms,
+            DelayedPacket{rtp_header,
+                          std::vector<uint8_t>(
+                              input_payload,
+                              input_payload + sizeof(input_payload))}));
+      } else if (!lost) {
         // Insert packet.
         int error =
             neteq->InsertPacket(rtp_header, input_payload,
@@ -106,6 +143,18 @@ int64_t NetEqPerformanceTest::Run(int runtime_ms,
       assert(payload_len == kInputBlockSizeSamples * sizeof(int16_t));
     }
 
+    // Insert the delayed packets that have arrived.
+    while (!delayed_packets.empty() &&
+           delayed_packets.begin()->first <= time_now_ms) {
+      const auto& delayed_packet = *delayed_packets.begin();
+      int error = neteq->InsertPacket(
+          delayed_packet.second.rtp_header, delayed_packet.second.payload,
+          delayed_packet.first * kSampRateHz / 1000);
+      if (error != NetEq::kOK)
+        return -1;
+      delayed_packets.erase(delayed_packets.begin());
+    }
+
     // Get output audio, but don't do anything with it.
     bool muted;
     int error = neteq->GetAudio(&out_frame, &muted);
@@ -129,5 +178,186 @@ int64_t NetEqPerformanceTest::Run(int runtime_ms,
   return end_time_ms - start_time_ms;
 }
 
+int64_t NetEqPerformanceTest::RunPacketBuffer(int num_packets,
+                                              size_t fill_level,
+                                              int reorder_period) {
+  const size_t kPacketSizeSamples = 20 * 8;  // 20 ms at 8 kHz.
+  const size_t kPayloadSizeBytes = kPacketSizeSamples;  // One byte per sample.
+  const uint8_t kPayloadType = 0;
+  const uint8_t payload[kPayloadSizeBytes] = {0};
+
+  TickTimer tick_timer;
+  PacketBuffer packet_buffer(2 * fill_level, &tick_timer);
+
+  auto create_packet = [&](int packet_number) {
+    Packet packet;
+    packet.sequence_number = static_cast<uint16_t>(packet_number);
+    packet.timestamp =
+        static_cast<uint32_t>(packet_number * kPacketSizeSamples);
+    packet.payload_type = kPayloadType;
+    packet.payload.SetData(payload, kPayloadSizeBytes);
+    return packet;
+  };
+
+  webrtc::Clock* clock = webrtc::Clock::GetRealTimeClock();
+  int64_t start_time_ms = clock->TimeInMilliseconds();
+  for (int i = 0; i < num_packets; ++i) {
+    if (reorder_period > 0 && i % reorder_period == 0 &&
+        i + 1 < num_packets) {
+      // Swap this packet with the next one.
+      if (packet_buffer.InsertPacket(create_packet(i + 1)) !=
+              PacketBuffer::kOK ||
+          packet_buffer.InsertPacket(create_packet(i)) != PacketBuffer::kOK) {
+        return -1;
+      }
+      ++i;
+    } else if (packet_buffer.InsertPacket(create_packet(i)) !=
+               PacketBuffer::kOK) {
+      return -1;
+    }
+
+    // Consume packets to stay at the fill level, the way NetEq would when
+    // decoding.
+    while (packet_buffer.NumPacketsInBuffer() > fill_level) {
+      if (!packet_buffer.GetNextPacket())
+        return -1;
+    }
+    tick_timer.Increment();
+  }
+  int64_t end_time_ms = clock->TimeInMilliseconds();
+  return end_time_ms - start_time_ms;
+}
+
+int64_t NetEqPerformanceTest::RunMultiStream(int runtime_ms,
+                                             int num_streams,
+                                             size_t num_threads,
+                                             size_t lookahead_frames,
+                                             int max_jitter_ms,
+                                             MultiStreamStats* stats) {
+  const std::string kInputFileName =
+      webrtc::test::ResourcePath("audio_coding/testfile32kHz", "pcm");
+  const int kSampRateHz = 32000;
+  const webrtc::NetEqDecoder kDecoderType =
+      webrtc::NetEqDecoder::kDecoderPCM16Bswb32kHz;
+  const std::string kDecoderName = "pcm16-swb32";
+  const int kPayloadType = 95;
+  const int kPacketSizeMs = 20;
+  const size_t kPacketSizeSamples = kPacketSizeMs * kSampRateHz / 1000;
+  const int kOutputBlockSizeMs = 10;
+
+  // Encode all packets up front; all streams carry the same audio.
+  AudioLoop audio_loop;
+  const size_t kMaxLoopLengthSamples = kSampRateHz * 10;  // 10 second loop.
+  if (!audio_loop.Init(kInputFileName, kMaxLoopLengthSamples,
+                       kPacketSizeSamples))
+    return -1;
+  const int num_packets = runtime_ms / kPacketSizeMs + 1;
+  std::vector<std::vector<uint8_t>> payloads(num_packets);
+  for (auto& payload : payloads) {
+    auto input_samples = audio_loop.GetNextBlock();
+    if (input_samples.empty())
+      return -1;
+    payload.resize(kPacketSizeSamples * sizeof(int16_t));
+    WebRtcPcm16b_Encode(input_samples.data(), input_samples.size(),
+                        payload.data());
+  }
+
+  // Create the NetEq instances, and draw the arrival times of their packets.
+  NetEq::Config config;
+  config.sample_rate_hz = kSampRateHz;
+  NetEqDecodeScheduler scheduler(num_threads, lookahead_frames);
+  std::vector<std::unique_ptr<NetEq>> neteqs;
+  // Per stream, the (arrival time, packet number) of all packets, ordered by
+  // arrival time.
+  std::vector<std::vector<std::pair<int, int>>> arrivals(num_streams);
+  Random random(0x1234);
+  for (int i = 0; i < num_streams; ++i) {
+    neteqs.emplace_back(
+        NetEq::Create(config, CreateBuiltinAudioDecoderFactory()));
+    if (neteqs.back()->RegisterPayloadType(kDecoderType, kDecoderName,
+                                           kPayloadType) != 0)
+      return -1;
+    scheduler.AddNetEq(neteqs.back().get());
+    for (int packet = 0; packet < num_packets; ++packet) {
+      arrivals[i].push_back(std::make_pair(
+          packet * kPacketSizeMs + random.Rand(0, max_jitter_ms), packet));
+    }
+    std::sort(arrivals[i].begin(), arrivals[i].end());
+  }
+  std::vector<size_t> next_arrival(num_streams, 0);
+
+  // Main loop, paced by the real-time clock like a playout thread.
+  webrtc::Clock* clock = webrtc::Clock::GetRealTimeClock();
+  const int64_t start_time_us = clock->TimeInMicroseconds();
+  const std::clock_t start_cpu_time = std::clock();
+  double total_pull_time_us = 0.0;
+  double total_delay_ms = 0.0;
+  int num_pulls = 0;
+  AudioFrame out_frame;
+  for (int time_now_ms = 0; time_now_ms < runtime_ms;
+       time_now_ms += kOutputBlockSizeMs) {
+    // Insert the packets that have arrived.
+    for (int i = 0; i < num_streams; ++i) {
+      while (next_arrival[i] < arrivals[i].size() &&
+             arrivals[i][next_arrival[i]].first <= time_now_ms) {
+        const int arrival_time_ms = arrivals[i][next_arrival[i]].first;
+        const int packet = arrivals[i][next_arrival[i]].second;
+        WebRtcRTPHeader rtp_header;
+        rtp_header.header.payloadType = kPayloadType;
+        rtp_header.header.sequenceNumber = static_cast<uint16_t>(packet);
+        rtp_header.header.timestamp =
+            static_cast<uint32_t>(packet * kPacketSizeSamples);
+        rtp_header.header.ssrc = 0x1234 + i;
+        rtp_header.header.markerBit = false;
+        if (neteqs[i]->InsertPacket(rtp_header, payloads[packet],
+                                    arrival_time_ms * kSampRateHz / 1000) !=
+            NetEq::kOK)
+          return -1;
+        ++next_arrival[i];
+      }
+    }
+
+    // Pull 10 ms from all streams, as the mixer would.
+    const int64_t pull_start_us = clock->TimeInMicroseconds();
+    for (int i = 0; i < num_streams; ++i) {
+      bool muted;
+      if (scheduler.GetAudio(neteqs[i].get(), &out_frame, &muted) !=
+          NetEq::kOK)
+        return -1;
+    }
+    const double pull_time_us =
+        static_cast<double>(clock->TimeInMicroseconds() - pull_start_us);
+    total_pull_time_us += pull_time_us;
+    stats->max_pull_time_us = std::max(stats->max_pull_time_us, pull_time_us);
+    ++num_pulls;
+    scheduler.Schedule();
+
+    for (const auto& neteq : neteqs)
+      total_delay_ms += neteq->FilteredCurrentDelayMs();
+
+    // Sleep until the next pull.
+    const int64_t next_pull_us =
+        start_time_us + (time_now_ms + kOutputBlockSizeMs) * 1000;
+    const int64_t sleep_ms =
+        (next_pull_us - clock->TimeInMicroseconds()) / 1000;
+    if (sleep_ms > 0)
+      SleepMs(static_cast<int>(sleep_ms));
+  }
+  const int64_t runtime_us = clock->TimeInMicroseconds() - start_time_us;
+  // Note that std::clock() gives the wall-clock time on Windows.
+  const double cpu_time_us =
+      1e6 * (std::clock() - start_cpu_time) / CLOCKS_PER_SEC;
+
+  for (const auto& neteq : neteqs)
+    scheduler.RemoveNetEq(neteq.get());
+
+  stats->mean_pull_time_us = total_pull_time_us / num_pulls;
+  stats->cpu_load_percent = 100.0 * cpu_time_us / runtime_us;
+  stats->mean_playout_delay_ms =
+      total_delay_ms / (num_pulls * num_streams) +
+      lookahead_frames * kOutputBlockSizeMs;
+  return runtime_us / 1000;
+}
+
 }  // namespace test
 }  // namespace webrtc
@@ -11,6 +11,8 @@
 #ifndef WEBRTC_MODULES_AUDIO_CODING_NETEQ_TOOLS_NETEQ_PERFORMANCE_TEST_H_
 #define WEBRTC_MODULES_AUDIO_CODING_NETEQ_TOOLS_NETEQ_PERFORMANCE_TEST_H_
 
+#include <stddef.h>
+
 #include "webrtc/typedefs.h"
 
 namespace webrtc {
@@ -18,12 +20,58 @@ namespace test {
 
 class NetEqPerformanceTest {
  public:
+  struct MultiStreamStats {
+    // Average and maximum time spent pulling 10 ms of audio from all streams.
+    double mean_pull_time_us = 0.0;
+    double max_pull_time_us = 0.0;
+    // Process CPU time in percent of the runtime.
+    double cpu_load_percent = 0.0;
+    // Average delay from packet arrival to playout: the filtered NetEq delay
+    // plus the frames decoded ahead of playout.
+    double mean_playout_delay_ms = 0.0;
+  };
+
   // Runs a performance test with parameters as follows:
   //   |runtime_ms|: the simulation time, i.e., the duration of the audio data.
   //   |lossrate|: drop one out of |lossrate| packets, e.g., one out of 10.
   //   |drift_factor|: clock drift in [0, 1].
   // Returns the runtime in ms.
   static int64_t Run(int runtime_ms, int lossrate, double drift_factor);
+
+  // Same as above, but also delays each packet by a random network jitter,
+  // uniformly distributed in [0, |max_jitter_ms|]. A jitter larger than the
+  // packet length makes packets arrive out of order.
+  static int64_t Run(int runtime_ms,
+                     int lossrate,
+                     double drift_factor,
+                     int max_jitter_ms);
+
+  // Runs a performance test of the packet buffer alone, with parameters as
+  // follows:
+  //   |num_packets|: the number of packets to pass through the buffer.
+  //   |fill_level|: the number of packets kept in the buffer.
+  //   |reorder_period|: delay one out of |reorder_period| packets by one
+  //   packet, e.g., one out of 10.
+  // Returns the runtime in ms.
+  static int64_t RunPacketBuffer(int num_packets,
+                                 size_t fill_level,
+                                 int reorder_period);
+
+  // Runs a performance test of many NetEq instances pulled by one playout
+  // thread in real time, the way a server mixing many streams would, with
+  // parameters as follows:
+  //   |runtime_ms|: the duration of the audio data, and of the test.
+  //   |num_streams|: the number of NetEq instances.
+  //   |num_threads|, |lookahead_frames|: the NetEqDecodeScheduler parameters.
+  //   Without lookahead, each stream is decoded in the playout pull.
+  //   |max_jitter_ms|: the maximum network jitter, as for Run().
+  // Writes the measurements to |stats|, and returns the runtime in ms.
+  static int64_t RunMultiStream(int runtime_ms,
+                                int num_streams,
+                                size_t num_threads,
+                                size_t lookahead_frames,
+                                int max_jitter_ms,
+                                MultiStreamStats* stats);
 };
 
 }  // namespace test
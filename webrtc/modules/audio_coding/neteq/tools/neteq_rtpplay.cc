@@ -19,9 +19,13 @@
 #include <iostream>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "gflags/gflags.h"
+#include "webrtc/base/atomicops.h"
 #include "webrtc/base/checks.h"
+#include "webrtc/base/platform_thread.h"
 #include "webrtc/modules/audio_coding/neteq/include/neteq.h"
 #include "webrtc/modules/audio_coding/neteq/tools/fake_decode_from_file.h"
 #include "webrtc/modules/audio_coding/neteq/tools/input_audio_file.h"
@@ -32,6 +36,7 @@
 #include "webrtc/modules/audio_coding/neteq/tools/output_wav_file.h"
 #include "webrtc/modules/audio_coding/neteq/tools/rtp_file_source.h"
 #include "webrtc/modules/include/module_common_types.h"
+#include "webrtc/system_wrappers/include/cpu_info.h"
 #include "webrtc/test/testsupport/fileutils.h"
 #include "webrtc/typedefs.h"
 
@@ -75,6 +80,20 @@ bool ValidateSsrcValue(const char* flagname, const std::string& str) {
   return ParseSsrc(str, &dummy_ssrc);
 }
 
+bool ValidateStatsFormat(const char* flagname, const std::string& value) {
+  if (value == "csv" || value == "json")  // Value is ok.
+    return true;
+  printf("Invalid value for --%s: %s\n", flagname, value.c_str());
+  return false;
+}
+
+bool ValidateNumThreads(const char* flagname, int32_t value) {
+  if (value >= 0)  // Value is ok.
+    return true;
+  printf("Invalid value for --%s: %d\n", flagname, static_cast<int>(value));
+  return false;
+}
+
 static bool ValidateExtensionId(const char* flagname, int32_t value) {
   if (value > 0 && value <= 255)  // Value is ok.
     return true;
@@ -150,6 +169,22 @@ const bool audio_level_dummy =
 DEFINE_int32(abs_send_time, 3, "Extension ID for absolute sender time");
 const bool abs_send_time_dummy =
     google::RegisterFlagValidator(&FLAGS_abs_send_time, &ValidateExtensionId);
+DEFINE_bool(stats_only,
+            false,
+            "Fast-forward mode. All arguments are taken as input files, the "
+            "payloads are replaced with fake encodings that are not decoded, "
+            "no output audio is written, and only the simulation statistics "
+            "are reported for each file");
+DEFINE_string(stats_format, "csv", "Statistics format with --stats_only: "
+              "csv or json");
+const bool stats_format_dummy =
+    google::RegisterFlagValidator(&FLAGS_stats_format, &ValidateStatsFormat);
+DEFINE_int32(num_threads,
+             0,
+             "Number of input files simulated in parallel with --stats_only; "
+             "0 means one per CPU core");
+const bool num_threads_dummy =
+    google::RegisterFlagValidator(&FLAGS_num_threads, &ValidateNumThreads);
 
 // Maps a codec type to a printable name string.
 std::string CodecName(NetEqDecoder codec) {
@@ -290,44 +325,22 @@ class FilterSsrcInput : public NetEqInput {
   uint32_t ssrc_;
 };
 
-int RunTest(int argc, char* argv[]) {
-  std::string program_name = argv[0];
-  std::string usage = "Tool for decoding an RTP dump file using NetEq.\n"
-      "Run " + program_name + " --helpshort for usage.\n"
-      "Example usage:\n" + program_name +
-      " input.rtp output.{pcm, wav}\n";
-  google::SetUsageMessage(usage);
-  google::ParseCommandLineFlags(&argc, &argv, true);
-
-  if (FLAGS_codec_map) {
-    PrintCodecMapping();
-  }
-
-  if (argc != 3) {
-    if (FLAGS_codec_map) {
-      // We have already printed the codec map. Just end the program.
-      return 0;
-    }
-    // Print usage information.
-    std::cout << google::ProgramUsage();
-    return 0;
-  }
-
+// Opens the RTP dump, pcap or event log file |file_name| as a NetEqInput,
+// keeping only the packets with the SSRC given by the --ssrc flag, if any.
+std::unique_ptr<NetEqInput> CreateInput(const std::string& file_name) {
   // Gather RTP header extensions in a map.
   NetEqPacketSourceInput::RtpHeaderExtensionMap rtp_ext_map = {
       {FLAGS_audio_level, kRtpExtensionAudioLevel},
       {FLAGS_abs_send_time, kRtpExtensionAbsoluteSendTime}};
 
-  const std::string input_file_name = argv[1];
   std::unique_ptr<NetEqInput> input;
-  if (RtpFileSource::ValidRtpDump(input_file_name) ||
-      RtpFileSource::ValidPcap(input_file_name)) {
-    input.reset(new NetEqRtpDumpInput(input_file_name, rtp_ext_map));
+  if (RtpFileSource::ValidRtpDump(file_name) ||
+      RtpFileSource::ValidPcap(file_name)) {
+    input.reset(new NetEqRtpDumpInput(file_name, rtp_ext_map));
   } else {
-    input.reset(new NetEqEventLogInput(input_file_name, rtp_ext_map));
+    input.reset(new NetEqEventLogInput(file_name, rtp_ext_map));
   }
 
-  std::cout << "Input file: " << input_file_name << std::endl;
   RTC_CHECK(input) << "Cannot open input file";
   RTC_CHECK(!input->ended()) << "Input file is empty";
 
@@ -337,29 +350,11 @@ int RunTest(int argc, char* argv[]) {
     RTC_CHECK(ParseSsrc(FLAGS_ssrc, &ssrc)) << "Flag verification has failed.";
     input.reset(new FilterSsrcInput(std::move(input), ssrc));
   }
+  return input;
+}
 
-  // Check the sample rate.
-  rtc::Optional<RTPHeader> first_rtp_header = input->NextHeader();
-  RTC_CHECK(first_rtp_header);
-  const int sample_rate_hz = CodecSampleRate(first_rtp_header->payloadType);
-  RTC_CHECK_GT(sample_rate_hz, 0);
-
-  // Open the output file now that we know the sample rate. (Rate is only needed
-  // for wav files.)
-  const std::string output_file_name = argv[2];
-  std::unique_ptr<AudioSink> output;
-  if (output_file_name.size() >= 4 &&
-      output_file_name.substr(output_file_name.size() - 4) == ".wav") {
-    // Open a wav file.
-    output.reset(new OutputWavFile(output_file_name, sample_rate_hz));
-  } else {
-    // Open a pcm file.
-    output.reset(new OutputAudioFile(output_file_name));
-  }
-
-  std::cout << "Output file: " << output_file_name << std::endl;
-
-  NetEqTest::DecoderMap codecs = {
+NetEqTest::DecoderMap CreateCodecMap() {
+  return {
       {FLAGS_pcmu, std::make_pair(NetEqDecoder::kDecoderPCMu, "pcmu")},
       {FLAGS_pcma, std::make_pair(NetEqDecoder::kDecoderPCMa, "pcma")},
       {FLAGS_ilbc, std::make_pair(NetEqDecoder::kDecoderILBC, "ilbc")},
@@ -383,42 +378,270 @@ int RunTest(int argc, char* argv[]) {
        std::make_pair(NetEqDecoder::kDecoderCNGswb32kHz, "cng-swb32")},
       {FLAGS_cn_swb48,
        std::make_pair(NetEqDecoder::kDecoderCNGswb48kHz, "cng-swb48")}};
+}
+
+// Wraps |input| in a NetEqReplacementInput, and registers a FakeDecodeFromFile
+// decoder for the replacement payload type in |ext_codecs|. The decoder runs at
+// |sample_rate_hz| and reads its audio from |replacement_audio_file|, or
+// produces silence if the file name is empty. The returned decoder must
+// outlive the NetEqTest using it.
+std::unique_ptr<AudioDecoder> ReplacePayloads(
+    const std::string& replacement_audio_file,
+    int sample_rate_hz,
+    const NetEqTest::DecoderMap& codecs,
+    std::unique_ptr<NetEqInput>* input,
+    NetEqTest::ExtDecoderMap* ext_codecs) {
+  // Find largest unused payload type.
+  int replacement_pt = 127;
+  while (!(codecs.find(replacement_pt) == codecs.end() &&
+           ext_codecs->find(replacement_pt) == ext_codecs->end())) {
+    --replacement_pt;
+    RTC_CHECK_GE(replacement_pt, 0);
+  }
+
+  auto std_set_int32_to_uint8 = [](const std::set<int32_t>& a) {
+    std::set<uint8_t> b;
+    for (auto& x : a) {
+      b.insert(static_cast<uint8_t>(x));
+    }
+    return b;
+  };
+
+  std::set<uint8_t> cn_types = std_set_int32_to_uint8(
+      {FLAGS_cn_nb, FLAGS_cn_wb, FLAGS_cn_swb32, FLAGS_cn_swb48});
+  std::set<uint8_t> forbidden_types =
+      std_set_int32_to_uint8({FLAGS_g722, FLAGS_red, FLAGS_avt});
+  input->reset(new NetEqReplacementInput(std::move(*input), replacement_pt,
+                                         cn_types, forbidden_types));
+
+  std::unique_ptr<InputAudioFile> audio_file;
+  if (!replacement_audio_file.empty()) {
+    audio_file.reset(new InputAudioFile(replacement_audio_file));
+  }
+  std::unique_ptr<AudioDecoder> replacement_decoder(
+      new FakeDecodeFromFile(std::move(audio_file), sample_rate_hz, false));
+  NetEqTest::ExternalDecoderInfo ext_dec_info = {
+      replacement_decoder.get(), NetEqDecoder::kDecoderArbitrary,
+      "replacement codec"};
+  (*ext_codecs)[replacement_pt] = ext_dec_info;
+  return replacement_decoder;
+}
+
+// Returns the NetEq sample rate to use for |input|, based on the payload type
+// of its first packet.
+int InputSampleRate(const NetEqInput& input) {
+  rtc::Optional<RTPHeader> first_rtp_header = input.NextHeader();
+  RTC_CHECK(first_rtp_header);
+  const int sample_rate_hz = CodecSampleRate(first_rtp_header->payloadType);
+  RTC_CHECK_GT(sample_rate_hz, 0);
+  return sample_rate_hz;
+}
+
+struct SimulationResult {
+  std::string file_name;
+  int64_t duration_ms = 0;
+  NetEqNetworkStatistics stats;
+};
+
+// Simulates |file_name| in fast-forward mode: the payloads are replaced with
+// fake encodings, so that no real decoding takes place, and the output audio
+// is thrown away. The fake decoder runs at the sample rate of the original
+// codec, so that the fake frame sizes match the RTP timestamps.
+SimulationResult SimulateStatsOnly(const std::string& file_name) {
+  std::unique_ptr<NetEqInput> input = CreateInput(file_name);
+  NetEq::Config config;
+  config.sample_rate_hz = InputSampleRate(*input);
+
+  NetEqTest::DecoderMap codecs = CreateCodecMap();
+  NetEqTest::ExtDecoderMap ext_codecs;
+  std::unique_ptr<AudioDecoder> replacement_decoder =
+      ReplacePayloads(FLAGS_replacement_audio_file, config.sample_rate_hz,
+                      codecs, &input, &ext_codecs);
+
+  DefaultNetEqTestErrorCallback error_cb;
+  NetEqTest test(config, codecs, ext_codecs, std::move(input), nullptr,
+                 &error_cb);
+
+  SimulationResult result;
+  result.file_name = file_name;
+  result.duration_ms = test.Run();
+  result.stats = test.SimulationStats();
+  return result;
+}
+
+// Simulates a set of files in fast-forward mode on a number of worker threads.
+// Each worker repeatedly picks the next unprocessed file until all are done.
+class StatsOnlySimulator {
+ public:
+  explicit StatsOnlySimulator(const std::vector<std::string>& file_names)
+      : file_names_(file_names), results_(file_names.size()) {}
+
+  // Returns the results in the same order as the file names.
+  std::vector<SimulationResult> Run(size_t num_threads) {
+    std::vector<std::unique_ptr<rtc::PlatformThread>> workers;
+    for (size_t i = 0; i < std::min(num_threads, file_names_.size()); ++i) {
+      workers.emplace_back(new rtc::PlatformThread(
+          &StatsOnlySimulator::WorkerThread, this, "NetEqStatsWorker"));
+      workers.back()->Start();
+    }
+    for (auto& worker : workers) {
+      worker->Stop();
+    }
+    return results_;
+  }
+
+ private:
+  static bool WorkerThread(void* obj) {
+    static_cast<StatsOnlySimulator*>(obj)->ProcessFiles();
+    // All files are done; let the thread end.
+    return false;
+  }
+
+  void ProcessFiles() {
+    for (size_t index = rtc::AtomicOps::Increment(&next_file_) - 1;
+         index < file_names_.size();
+         index = rtc::AtomicOps::Increment(&next_file_) - 1) {
+      // Each result is written by exactly one worker, and only read after all
+      // workers have been joined.
+      results_[index] = SimulateStatsOnly(file_names_[index]);
+    }
+  }
+
+  const std::vector<std::string> file_names_;
+  std::vector<SimulationResult> results_;
+  volatile int next_file_ = 0;
+};
+
+// Returns the statistics of |result| as name-value pairs, with the rates given
+// in percent.
+std::vector<std::pair<std::string, double>> StatsFields(
+    const SimulationResult& result) {
+  const NetEqNetworkStatistics& stats = result.stats;
+  auto percent = [](uint16_t q14) { return 100.0 * q14 / 16384.0; };
+  std::vector<std::pair<std::string, double>> fields;
+  fields.emplace_back("output_duration_ms", result.duration_ms);
+  fields.emplace_back("packet_loss_rate", percent(stats.packet_loss_rate));
+  fields.emplace_back("packet_discard_rate",
+                      percent(stats.packet_discard_rate));
+  fields.emplace_back("expand_rate", percent(stats.expand_rate));
+  fields.emplace_back("speech_expand_rate", percent(stats.speech_expand_rate));
+  fields.emplace_back("preemptive_rate", percent(stats.preemptive_rate));
+  fields.emplace_back("accelerate_rate", percent(stats.accelerate_rate));
+  fields.emplace_back("secondary_decoded_rate",
+                      percent(stats.secondary_decoded_rate));
+  fields.emplace_back("clockdrift_ppm", stats.clockdrift_ppm);
+  fields.emplace_back("mean_waiting_time_ms", stats.mean_waiting_time_ms);
+  fields.emplace_back("median_waiting_time_ms", stats.median_waiting_time_ms);
+  fields.emplace_back("min_waiting_time_ms", stats.min_waiting_time_ms);
+  fields.emplace_back("max_waiting_time_ms", stats.max_waiting_time_ms);
+  return fields;
+}
+
+void PrintStatsCsv(const std::vector<SimulationResult>& results) {
+  if (results.empty())
+    return;
+  printf("file");
+  for (const auto& field : StatsFields(results[0]))
+    printf(",%s", field.first.c_str());
+  printf("\n");
+  for (const auto& result : results) {
+    printf("\"%s\"", result.file_name.c_str());
+    for (const auto& field : StatsFields(result))
+      printf(",%g", field.second);
+    printf("\n");
+  }
+}
+
+void PrintStatsJson(const std::vector<SimulationResult>& results) {
+  printf("[");
+  for (size_t i = 0; i < results.size(); ++i) {
+    std::string escaped_file_name;
+    for (char c : results[i].file_name) {
+      if (c == '"' || c == '\\')
+        escaped_file_name += '\\';
+      escaped_file_name += c;
+    }
+    printf("%s\n  {\"file\": \"%s\"", i == 0 ? "" : ",",
+           escaped_file_name.c_str());
+    for (const auto& field : StatsFields(results[i]))
+      printf(", \"%s\": %g", field.first.c_str(), field.second);
+    printf("}");
+  }
+  printf("\n]\n");
+}
+
+int RunStatsOnly(const std::vector<std::string>& file_names) {
+  size_t num_threads = FLAGS_num_threads > 0
+                           ? static_cast<size_t>(FLAGS_num_threads)
+                           : CpuInfo::DetectNumberOfCores();
+  std::vector<SimulationResult> results =
+      StatsOnlySimulator(file_names).Run(num_threads);
+  if (FLAGS_stats_format == "json") {
+    PrintStatsJson(results);
+  } else {
+    PrintStatsCsv(results);
+  }
+  return 0;
+}
+
+int RunTest(int argc, char* argv[]) {
+  std::string program_name = argv[0];
+  std::string usage = "Tool for decoding an RTP dump file using NetEq.\n"
+      "Run " + program_name + " --helpshort for usage.\n"
+      "Example usage:\n" + program_name +
+      " input.rtp output.{pcm, wav}\n" + program_name +
+      " --stats_only input1.rtp [input2.rtp ...]\n";
+  google::SetUsageMessage(usage);
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  if (FLAGS_codec_map) {
+    PrintCodecMapping();
+  }
+
+  if (FLAGS_stats_only && argc >= 2) {
+    return RunStatsOnly(std::vector<std::string>(argv + 1, argv + argc));
+  }
+
+  if (argc != 3) {
+    if (FLAGS_codec_map) {
+      // We have already printed the codec map. Just end the program.
+      return 0;
+    }
+    // Print usage information.
+    std::cout << google::ProgramUsage();
+    return 0;
+  }
+
+  const std::string input_file_name = argv[1];
+  std::unique_ptr<NetEqInput> input = CreateInput(input_file_name);
+  std::cout << "Input file: " << input_file_name << std::endl;
+
+  // Check the sample rate.
+  const int sample_rate_hz = InputSampleRate(*input);
+
+  // Open the output file now that we know the sample rate. (Rate is only needed
+  // for wav files.)
+  const std::string output_file_name = argv[2];
+  std::unique_ptr<AudioSink> output;
+  if (output_file_name.size() >= 4 &&
+      output_file_name.substr(output_file_name.size() - 4) == ".wav") {
+    // Open a wav file.
+    output.reset(new OutputWavFile(output_file_name, sample_rate_hz));
+  } else {
+    // Open a pcm file.
+    output.reset(new OutputAudioFile(output_file_name));
+  }
+
+  std::cout << "Output file: " << output_file_name << std::endl;
+
+  NetEqTest::DecoderMap codecs = CreateCodecMap();
 
   // Check if a replacement audio file was provided.
   std::unique_ptr<AudioDecoder> replacement_decoder;
   NetEqTest::ExtDecoderMap ext_codecs;
   if (!FLAGS_replacement_audio_file.empty()) {
-    // Find largest unused payload type.
-    int replacement_pt = 127;
-    while (!(codecs.find(replacement_pt) == codecs.end() &&
-             ext_codecs.find(replacement_pt) == ext_codecs.end())) {
-      --replacement_pt;
-      RTC_CHECK_GE(replacement_pt, 0);
-    }
-
-    auto std_set_int32_to_uint8 = [](const std::set<int32_t>& a) {
-      std::set<uint8_t> b;
-      for (auto& x : a) {
-        b.insert(static_cast<uint8_t>(x));
-      }
-      return b;
-    };
-
-    std::set<uint8_t> cn_types = std_set_int32_to_uint8(
-        {FLAGS_cn_nb, FLAGS_cn_wb, FLAGS_cn_swb32, FLAGS_cn_swb48});
-    std::set<uint8_t> forbidden_types =
-        std_set_int32_to_uint8({FLAGS_g722, FLAGS_red, FLAGS_avt});
-    input.reset(new NetEqReplacementInput(std::move(input), replacement_pt,
-                                          cn_types, forbidden_types));
-
-    replacement_decoder.reset(new FakeDecodeFromFile(
-        std::unique_ptr<InputAudioFile>(
-            new InputAudioFile(FLAGS_replacement_audio_file)),
-        48000, false));
-    NetEqTest::ExternalDecoderInfo ext_dec_info = {
-        replacement_decoder.get(), NetEqDecoder::kDecoderArbitrary,
-        "replacement codec"};
-    ext_codecs[replacement_pt] = ext_dec_info;
+    replacement_decoder = ReplacePayloads(FLAGS_replacement_audio_file, 48000,
+                                          codecs, &input, &ext_codecs);
   }
 
   DefaultNetEqTestErrorCallback error_cb;
@@ -1519,6 +1519,9 @@ AecCore* WebRtcAec_CreateAec(int instance_count) {
   if (WebRtc_GetCPUInfo(kSSE2)) {
     WebRtcAec_InitAec_SSE2();
   }
+  if (WebRtc_GetCPUInfo(kAVX2)) {
+    WebRtcAec_InitAec_AVX2();
+  }
 #endif
 
 #if defined(MIPS_FPU_LE)
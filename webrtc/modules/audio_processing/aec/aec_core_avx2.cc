@@ -0,0 +1,622 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * The core AEC algorithm, AVX2 version of speed-critical functions.
+ *
+ * The functions perform the same per-element operations in the same order as
+ * the SSE2 versions, and sums are accumulated in the same four lanes, so the
+ * output is bit-exact with the SSE2 path. Note that this file must not be
+ * built with FMA contraction enabled since that would change the rounding.
+ */
+
+#include <immintrin.h>
+#include <math.h>
+#include <string.h>  // memset
+
+extern "C" {
+#include "webrtc/common_audio/signal_processing/include/signal_processing_library.h"
+}
+#include "webrtc/modules/audio_processing/aec/aec_common.h"
+#include "webrtc/modules/audio_processing/aec/aec_core_optimized_methods.h"
+#include "webrtc/modules/audio_processing/utility/ooura_fft.h"
+
+namespace webrtc {
+
+namespace {
+
+__inline float MulRe(float aRe, float aIm, float bRe, float bIm) {
+  return aRe * bRe - aIm * bIm;
+}
+
+__inline float MulIm(float aRe, float aIm, float bRe, float bIm) {
+  return aRe * bIm + aIm * bRe;
+}
+
+// Splits eight interleaved complex values, stored as re, im, re, im, ..., into
+// their real and imaginary parts.
+__inline void Deinterleave(const float* data, __m256* re, __m256* im) {
+  const __m256 d0 = _mm256_loadu_ps(&data[0]);
+  const __m256 d8 = _mm256_loadu_ps(&data[8]);
+  // The in-lane shuffles leave the values in the order 0, 1, 4, 5, 2, 3, 6, 7.
+  const __m256 re_0145 = _mm256_shuffle_ps(d0, d8, _MM_SHUFFLE(2, 0, 2, 0));
+  const __m256 im_0145 = _mm256_shuffle_ps(d0, d8, _MM_SHUFFLE(3, 1, 3, 1));
+  *re = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(re_0145),
+                                               _MM_SHUFFLE(3, 1, 2, 0)));
+  *im = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(im_0145),
+                                               _MM_SHUFFLE(3, 1, 2, 0)));
+}
+
+// Inverse of Deinterleave().
+__inline void Interleave(__m256 re, __m256 im, float* data) {
+  const __m256 lo = _mm256_unpacklo_ps(re, im);  // 0, 1, 4, 5.
+  const __m256 hi = _mm256_unpackhi_ps(re, im);  // 2, 3, 6, 7.
+  _mm256_storeu_ps(&data[0], _mm256_permute2f128_ps(lo, hi, 0x20));
+  _mm256_storeu_ps(&data[8], _mm256_permute2f128_ps(lo, hi, 0x31));
+}
+
+// Adds the two halves of |a| to |sum| in the same order as when |sum| would
+// have been updated by two consecutive four-element steps.
+__inline __m128 AccumulateHalves(__m128 sum, __m256 a) {
+  sum = _mm_add_ps(sum, _mm256_castps256_ps128(a));
+  return _mm_add_ps(sum, _mm256_extractf128_ps(a, 1));
+}
+
+__inline void _mm_add_ps_4x1(__m128 sum, float* dst) {
+  // A+B C+D
+  sum = _mm_add_ps(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(0, 0, 3, 2)));
+  // A+B+C+D A+B+C+D
+  sum = _mm_add_ps(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 1, 1, 1)));
+  _mm_store_ss(dst, sum);
+}
+
+void FilterFarAVX2(int num_partitions,
+                   int x_fft_buf_block_pos,
+                   float x_fft_buf[2][kExtendedNumPartitions * PART_LEN1],
+                   float h_fft_buf[2][kExtendedNumPartitions * PART_LEN1],
+                   float y_fft[2][PART_LEN1]) {
+  int i;
+  for (i = 0; i < num_partitions; i++) {
+    int j;
+    int xPos = (i + x_fft_buf_block_pos) * PART_LEN1;
+    int pos = i * PART_LEN1;
+    // Check for wrap
+    if (i + x_fft_buf_block_pos >= num_partitions) {
+      xPos -= num_partitions * (PART_LEN1);
+    }
+
+    // vectorized code (eight at once)
+    for (j = 0; j + 7 < PART_LEN1; j += 8) {
+      const __m256 x_fft_buf_re = _mm256_loadu_ps(&x_fft_buf[0][xPos + j]);
+      const __m256 x_fft_buf_im = _mm256_loadu_ps(&x_fft_buf[1][xPos + j]);
+      const __m256 h_fft_buf_re = _mm256_loadu_ps(&h_fft_buf[0][pos + j]);
+      const __m256 h_fft_buf_im = _mm256_loadu_ps(&h_fft_buf[1][pos + j]);
+      const __m256 y_fft_re = _mm256_loadu_ps(&y_fft[0][j]);
+      const __m256 y_fft_im = _mm256_loadu_ps(&y_fft[1][j]);
+      const __m256 a = _mm256_mul_ps(x_fft_buf_re, h_fft_buf_re);
+      const __m256 b = _mm256_mul_ps(x_fft_buf_im, h_fft_buf_im);
+      const __m256 c = _mm256_mul_ps(x_fft_buf_re, h_fft_buf_im);
+      const __m256 d = _mm256_mul_ps(x_fft_buf_im, h_fft_buf_re);
+      const __m256 e = _mm256_sub_ps(a, b);
+      const __m256 f = _mm256_add_ps(c, d);
+      _mm256_storeu_ps(&y_fft[0][j], _mm256_add_ps(y_fft_re, e));
+      _mm256_storeu_ps(&y_fft[1][j], _mm256_add_ps(y_fft_im, f));
+    }
+    // scalar code for the remaining items.
+    for (; j < PART_LEN1; j++) {
+      y_fft[0][j] += MulRe(x_fft_buf[0][xPos + j], x_fft_buf[1][xPos + j],
+                           h_fft_buf[0][pos + j], h_fft_buf[1][pos + j]);
+      y_fft[1][j] += MulIm(x_fft_buf[0][xPos + j], x_fft_buf[1][xPos + j],
+                           h_fft_buf[0][pos + j], h_fft_buf[1][pos + j]);
+    }
+  }
+}
+
+void ScaleErrorSignalAVX2(float mu,
+                          float error_threshold,
+                          float x_pow[PART_LEN1],
+                          float ef[2][PART_LEN1]) {
+  const __m256 k1e_10f = _mm256_set1_ps(1e-10f);
+  const __m256 kMu = _mm256_set1_ps(mu);
+  const __m256 kThresh = _mm256_set1_ps(error_threshold);
+
+  int i;
+  // vectorized code (eight at once)
+  for (i = 0; i + 7 < PART_LEN1; i += 8) {
+    const __m256 x_pow_local = _mm256_loadu_ps(&x_pow[i]);
+    const __m256 ef_re_base = _mm256_loadu_ps(&ef[0][i]);
+    const __m256 ef_im_base = _mm256_loadu_ps(&ef[1][i]);
+
+    const __m256 xPowPlus = _mm256_add_ps(x_pow_local, k1e_10f);
+    const __m256 ef_re = _mm256_div_ps(ef_re_base, xPowPlus);
+    const __m256 ef_im = _mm256_div_ps(ef_im_base, xPowPlus);
+    const __m256 ef_re2 = _mm256_mul_ps(ef_re, ef_re);
+    const __m256 ef_im2 = _mm256_mul_ps(ef_im, ef_im);
+    const __m256 absEf = _mm256_sqrt_ps(_mm256_add_ps(ef_re2, ef_im2));
+    const __m256 bigger = _mm256_cmp_ps(absEf, kThresh, _CMP_GT_OS);
+    const __m256 absEfPlus = _mm256_add_ps(absEf, k1e_10f);
+    const __m256 absEfInv = _mm256_div_ps(kThresh, absEfPlus);
+    const __m256 ef_re_if = _mm256_mul_ps(ef_re, absEfInv);
+    const __m256 ef_im_if = _mm256_mul_ps(ef_im, absEfInv);
+    const __m256 ef_re_sel = _mm256_blendv_ps(ef_re, ef_re_if, bigger);
+    const __m256 ef_im_sel = _mm256_blendv_ps(ef_im, ef_im_if, bigger);
+
+    _mm256_storeu_ps(&ef[0][i], _mm256_mul_ps(ef_re_sel, kMu));
+    _mm256_storeu_ps(&ef[1][i], _mm256_mul_ps(ef_im_sel, kMu));
+  }
+  // scalar code for the remaining items.
+  for (; i < (PART_LEN1); i++) {
+    float abs_ef;
+    ef[0][i] /= (x_pow[i] + 1e-10f);
+    ef[1][i] /= (x_pow[i] + 1e-10f);
+    abs_ef = sqrtf(ef[0][i] * ef[0][i] + ef[1][i] * ef[1][i]);
+
+    if (abs_ef > error_threshold) {
+      abs_ef = error_threshold / (abs_ef + 1e-10f);
+      ef[0][i] *= abs_ef;
+      ef[1][i] *= abs_ef;
+    }
+
+    // Stepsize factor
+    ef[0][i] *= mu;
+    ef[1][i] *= mu;
+  }
+}
+
+void FilterAdaptationAVX2(
+    const OouraFft& ooura_fft,
+    int num_partitions,
+    int x_fft_buf_block_pos,
+    float x_fft_buf[2][kExtendedNumPartitions * PART_LEN1],
+    float e_fft[2][PART_LEN1],
+    float h_fft_buf[2][kExtendedNumPartitions * PART_LEN1]) {
+  float fft[PART_LEN2];
+  int i, j;
+  const __m256 scale = _mm256_set1_ps(2.0f / PART_LEN2);
+  for (i = 0; i < num_partitions; i++) {
+    int xPos = (i + x_fft_buf_block_pos) * (PART_LEN1);
+    int pos = i * PART_LEN1;
+    // Check for wrap
+    if (i + x_fft_buf_block_pos >= num_partitions) {
+      xPos -= num_partitions * PART_LEN1;
+    }
+
+    // Process the whole array...
+    for (j = 0; j < PART_LEN; j += 8) {
+      const __m256 x_fft_buf_re = _mm256_loadu_ps(&x_fft_buf[0][xPos + j]);
+      const __m256 x_fft_buf_im = _mm256_loadu_ps(&x_fft_buf[1][xPos + j]);
+      const __m256 e_fft_re = _mm256_loadu_ps(&e_fft[0][j]);
+      const __m256 e_fft_im = _mm256_loadu_ps(&e_fft[1][j]);
+      // Calculate the product of conjugate(x_fft_buf) by e_fft.
+      //   re(conjugate(a) * b) = aRe * bRe + aIm * bIm
+      //   im(conjugate(a) * b)=  aRe * bIm - aIm * bRe
+      const __m256 a = _mm256_mul_ps(x_fft_buf_re, e_fft_re);
+      const __m256 b = _mm256_mul_ps(x_fft_buf_im, e_fft_im);
+      const __m256 c = _mm256_mul_ps(x_fft_buf_re, e_fft_im);
+      const __m256 d = _mm256_mul_ps(x_fft_buf_im, e_fft_re);
+      Interleave(_mm256_add_ps(a, b), _mm256_sub_ps(c, d), &fft[2 * j]);
+    }
+    // ... and fixup the first imaginary entry.
+    fft[1] =
+        MulRe(x_fft_buf[0][xPos + PART_LEN], -x_fft_buf[1][xPos + PART_LEN],
+              e_fft[0][PART_LEN], e_fft[1][PART_LEN]);
+
+    ooura_fft.InverseFft(fft);
+    memset(fft + PART_LEN, 0, sizeof(float) * PART_LEN);
+
+    // fft scaling
+    for (j = 0; j < PART_LEN; j += 8) {
+      _mm256_storeu_ps(&fft[j], _mm256_mul_ps(_mm256_loadu_ps(&fft[j]), scale));
+    }
+    ooura_fft.Fft(fft);
+
+    {
+      float wt1 = h_fft_buf[1][pos];
+      h_fft_buf[0][pos + PART_LEN] += fft[1];
+      for (j = 0; j < PART_LEN; j += 8) {
+        __m256 fft_re, fft_im;
+        Deinterleave(&fft[2 * j], &fft_re, &fft_im);
+        const __m256 wtBuf_re = _mm256_loadu_ps(&h_fft_buf[0][pos + j]);
+        const __m256 wtBuf_im = _mm256_loadu_ps(&h_fft_buf[1][pos + j]);
+        _mm256_storeu_ps(&h_fft_buf[0][pos + j],
+                         _mm256_add_ps(wtBuf_re, fft_re));
+        _mm256_storeu_ps(&h_fft_buf[1][pos + j],
+                         _mm256_add_ps(wtBuf_im, fft_im));
+      }
+      h_fft_buf[1][pos] = wt1;
+    }
+  }
+}
+
+// Eight-wide version of mm_pow_ps() in aec_core_sse2.cc; see that function
+// for a description of the approximations.
+__m256 mm256_pow_ps(__m256 a, __m256 b) {
+  __m256 log2_a;
+  {
+    const __m256 two_n =
+        _mm256_and_ps(a, _mm256_castsi256_ps(_mm256_set1_epi32(0x7F800000)));
+    const __m256 n_1 = _mm256_castsi256_ps(
+        _mm256_srli_epi32(_mm256_castps_si256(two_n), 8));
+    const __m256 n_0 =
+        _mm256_or_ps(n_1, _mm256_castsi256_ps(_mm256_set1_epi32(0x43800000)));
+    const __m256 n =
+        _mm256_sub_ps(n_0, _mm256_castsi256_ps(_mm256_set1_epi32(0x43BF8000)));
+
+    const __m256 one = _mm256_castsi256_ps(_mm256_set1_epi32(0x3F800000));
+    const __m256 mantissa =
+        _mm256_and_ps(a, _mm256_castsi256_ps(_mm256_set1_epi32(0x007FFFFF)));
+    const __m256 y = _mm256_or_ps(mantissa, one);
+
+    __m256 pol5_y = _mm256_mul_ps(y, _mm256_set1_ps(-3.4436006e-2f));
+    pol5_y = _mm256_add_ps(pol5_y, _mm256_set1_ps(3.1821337e-1f));
+    pol5_y = _mm256_mul_ps(pol5_y, y);
+    pol5_y = _mm256_add_ps(pol5_y, _mm256_set1_ps(-1.2315303f));
+    pol5_y = _mm256_mul_ps(pol5_y, y);
+    pol5_y = _mm256_add_ps(pol5_y, _mm256_set1_ps(2.5988452f));
+    pol5_y = _mm256_mul_ps(pol5_y, y);
+    pol5_y = _mm256_add_ps(pol5_y, _mm256_set1_ps(-3.3241990f));
+    pol5_y = _mm256_mul_ps(pol5_y, y);
+    pol5_y = _mm256_add_ps(pol5_y, _mm256_set1_ps(3.1157899f));
+    const __m256 log2_y = _mm256_mul_ps(_mm256_sub_ps(y, one), pol5_y);
+
+    log2_a = _mm256_add_ps(n, log2_y);
+  }
+
+  const __m256 b_log2_a = _mm256_mul_ps(b, log2_a);
+
+  {
+    const __m256 x_min = _mm256_min_ps(b_log2_a, _mm256_set1_ps(129.f));
+    const __m256 x_max = _mm256_max_ps(x_min, _mm256_set1_ps(-126.99999f));
+    const __m256 x_minus_half = _mm256_sub_ps(x_max, _mm256_set1_ps(0.5f));
+    const __m256i x_minus_half_floor = _mm256_cvtps_epi32(x_minus_half);
+    const __m256i two_n_exponent =
+        _mm256_add_epi32(x_minus_half_floor, _mm256_set1_epi32(127));
+    const __m256 two_n =
+        _mm256_castsi256_ps(_mm256_slli_epi32(two_n_exponent, 23));
+    const __m256 y =
+        _mm256_sub_ps(x_max, _mm256_cvtepi32_ps(x_minus_half_floor));
+    __m256 exp2_y = _mm256_mul_ps(y, _mm256_set1_ps(3.3718944e-1f));
+    exp2_y = _mm256_add_ps(exp2_y, _mm256_set1_ps(6.5763628e-1f));
+    exp2_y = _mm256_mul_ps(exp2_y, y);
+    exp2_y = _mm256_add_ps(exp2_y, _mm256_set1_ps(1.0017247f));
+
+    return _mm256_mul_ps(exp2_y, two_n);
+  }
+}
+
+void OverdriveAVX2(float overdrive_scaling, float hNlFb, float hNl[PART_LEN1]) {
+  int i;
+  const __m256 vec_hNlFb = _mm256_set1_ps(hNlFb);
+  const __m256 vec_one = _mm256_set1_ps(1.0f);
+  const __m256 vec_overdrive_scaling = _mm256_set1_ps(overdrive_scaling);
+  // vectorized code (eight at once)
+  for (i = 0; i + 7 < PART_LEN1; i += 8) {
+    // Weight subbands
+    const __m256 vec_hNl = _mm256_loadu_ps(&hNl[i]);
+    const __m256 vec_weightCurve = _mm256_loadu_ps(&WebRtcAec_weightCurve[i]);
+    const __m256 bigger = _mm256_cmp_ps(vec_hNl, vec_hNlFb, _CMP_GT_OS);
+    const __m256 vec_weightCurve_hNlFb =
+        _mm256_mul_ps(vec_weightCurve, vec_hNlFb);
+    const __m256 vec_one_weightCurve = _mm256_sub_ps(vec_one, vec_weightCurve);
+    const __m256 vec_one_weightCurve_hNl =
+        _mm256_mul_ps(vec_one_weightCurve, vec_hNl);
+    const __m256 vec_weighted = _mm256_blendv_ps(
+        vec_hNl, _mm256_add_ps(vec_weightCurve_hNlFb, vec_one_weightCurve_hNl),
+        bigger);
+
+    const __m256 vec_overDriveCurve =
+        _mm256_loadu_ps(&WebRtcAec_overDriveCurve[i]);
+    const __m256 vec_overDriveSm_overDriveCurve =
+        _mm256_mul_ps(vec_overdrive_scaling, vec_overDriveCurve);
+    _mm256_storeu_ps(&hNl[i],
+                     mm256_pow_ps(vec_weighted, vec_overDriveSm_overDriveCurve));
+  }
+  // scalar code for the remaining items.
+  for (; i < PART_LEN1; i++) {
+    // Weight subbands
+    if (hNl[i] > hNlFb) {
+      hNl[i] = WebRtcAec_weightCurve[i] * hNlFb +
+               (1 - WebRtcAec_weightCurve[i]) * hNl[i];
+    }
+    hNl[i] = powf(hNl[i], overdrive_scaling * WebRtcAec_overDriveCurve[i]);
+  }
+}
+
+void SuppressAVX2(const float hNl[PART_LEN1], float efw[2][PART_LEN1]) {
+  int i;
+  const __m256 vec_minus_one = _mm256_set1_ps(-1.0f);
+  // vectorized code (eight at once)
+  for (i = 0; i + 7 < PART_LEN1; i += 8) {
+    // Suppress error signal
+    const __m256 vec_hNl = _mm256_loadu_ps(&hNl[i]);
+    const __m256 vec_efw_re =
+        _mm256_mul_ps(_mm256_loadu_ps(&efw[0][i]), vec_hNl);
+    const __m256 vec_efw_im =
+        _mm256_mul_ps(_mm256_loadu_ps(&efw[1][i]), vec_hNl);
+
+    // Ooura fft returns incorrect sign on imaginary component. It matters
+    // here because we are making an additive change with comfort noise.
+    _mm256_storeu_ps(&efw[0][i], vec_efw_re);
+    _mm256_storeu_ps(&efw[1][i], _mm256_mul_ps(vec_efw_im, vec_minus_one));
+  }
+  // scalar code for the remaining items.
+  for (; i < PART_LEN1; i++) {
+    // Suppress error signal
+    efw[0][i] *= hNl[i];
+    efw[1][i] *= hNl[i];
+
+    // Ooura fft returns incorrect sign on imaginary component. It matters
+    // here because we are making an additive change with comfort noise.
+    efw[1][i] *= -1;
+  }
+}
+
+int PartitionDelayAVX2(int num_partitions,
+                       float h_fft_buf[2][kExtendedNumPartitions * PART_LEN1]) {
+  // Measures the energy in each filter partition and returns the partition with
+  // highest energy.
+  float wfEnMax = 0;
+  int i;
+  int delay = 0;
+
+  for (i = 0; i < num_partitions; i++) {
+    int j;
+    int pos = i * PART_LEN1;
+    float wfEn = 0;
+    __m128 vec_wfEn = _mm_set1_ps(0.0f);
+    // vectorized code (eight at once)
+    for (j = 0; j + 7 < PART_LEN1; j += 8) {
+      const __m256 vec_wfBuf0 = _mm256_loadu_ps(&h_fft_buf[0][pos + j]);
+      const __m256 vec_wfBuf1 = _mm256_loadu_ps(&h_fft_buf[1][pos + j]);
+      const __m256 vec_wfBuf0_sq = _mm256_mul_ps(vec_wfBuf0, vec_wfBuf0);
+      const __m256 vec_wfBuf1_sq = _mm256_mul_ps(vec_wfBuf1, vec_wfBuf1);
+      // Keep the accumulation order of the four-wide implementation.
+      vec_wfEn = _mm_add_ps(vec_wfEn, _mm256_castps256_ps128(vec_wfBuf0_sq));
+      vec_wfEn = _mm_add_ps(vec_wfEn, _mm256_castps256_ps128(vec_wfBuf1_sq));
+      vec_wfEn = _mm_add_ps(vec_wfEn, _mm256_extractf128_ps(vec_wfBuf0_sq, 1));
+      vec_wfEn = _mm_add_ps(vec_wfEn, _mm256_extractf128_ps(vec_wfBuf1_sq, 1));
+    }
+    _mm_add_ps_4x1(vec_wfEn, &wfEn);
+
+    // scalar code for the remaining items.
+    for (; j < PART_LEN1; j++) {
+      wfEn += h_fft_buf[0][pos + j] * h_fft_buf[0][pos + j] +
+              h_fft_buf[1][pos + j] * h_fft_buf[1][pos + j];
+    }
+
+    if (wfEn > wfEnMax) {
+      wfEnMax = wfEn;
+      delay = i;
+    }
+  }
+  return delay;
+}
+
+// Updates the smoothed cross-PSD |s| of the complex spectra |a| and |b|, stored
+// as interleaved real and imaginary parts.
+__inline void UpdateCrossPsd(__m256 a_re,
+                             __m256 a_im,
+                             __m256 b_re,
+                             __m256 b_im,
+                             __m256 g_coh0,
+                             __m256 g_coh1,
+                             float* s) {
+  __m256 s_re, s_im;
+  Deinterleave(s, &s_re, &s_im);
+  const __m256 ab_re =
+      _mm256_add_ps(_mm256_mul_ps(a_re, b_re), _mm256_mul_ps(a_im, b_im));
+  const __m256 ab_im =
+      _mm256_sub_ps(_mm256_mul_ps(a_re, b_im), _mm256_mul_ps(a_im, b_re));
+  s_re = _mm256_add_ps(_mm256_mul_ps(s_re, g_coh0),
+                       _mm256_mul_ps(ab_re, g_coh1));
+  s_im = _mm256_add_ps(_mm256_mul_ps(s_im, g_coh0),
+                       _mm256_mul_ps(ab_im, g_coh1));
+  Interleave(s_re, s_im, s);
+}
+
+// Updates the following smoothed  Power Spectral Densities (PSD):
+//  - sd  : near-end
+//  - se  : residual echo
+//  - sx  : far-end
+//  - sde : cross-PSD of near-end and residual echo
+//  - sxd : cross-PSD of near-end and far-end
+//
+// In addition to updating the PSDs, also the filter diverge state is determined
+// upon actions are taken.
+void UpdateCoherenceSpectraAVX2(int mult,
+                                bool extended_filter_enabled,
+                                float efw[2][PART_LEN1],
+                                float dfw[2][PART_LEN1],
+                                float xfw[2][PART_LEN1],
+                                CoherenceState* coherence_state,
+                                short* filter_divergence_state,
+                                int* extreme_filter_divergence) {
+  // Power estimate smoothing coefficients.
+  const float* ptrGCoh =
+      extended_filter_enabled
+          ? WebRtcAec_kExtendedSmoothingCoefficients[mult - 1]
+          : WebRtcAec_kNormalSmoothingCoefficients[mult - 1];
+  int i;
+  float sdSum = 0, seSum = 0;
+  const __m256 vec_15 = _mm256_set1_ps(WebRtcAec_kMinFarendPSD);
+  const __m256 vec_GCoh0 = _mm256_set1_ps(ptrGCoh[0]);
+  const __m256 vec_GCoh1 = _mm256_set1_ps(ptrGCoh[1]);
+  __m128 vec_sdSum = _mm_set1_ps(0.0f);
+  __m128 vec_seSum = _mm_set1_ps(0.0f);
+
+  for (i = 0; i + 7 < PART_LEN1; i += 8) {
+    const __m256 vec_dfw0 = _mm256_loadu_ps(&dfw[0][i]);
+    const __m256 vec_dfw1 = _mm256_loadu_ps(&dfw[1][i]);
+    const __m256 vec_efw0 = _mm256_loadu_ps(&efw[0][i]);
+    const __m256 vec_efw1 = _mm256_loadu_ps(&efw[1][i]);
+    const __m256 vec_xfw0 = _mm256_loadu_ps(&xfw[0][i]);
+    const __m256 vec_xfw1 = _mm256_loadu_ps(&xfw[1][i]);
+    __m256 vec_sd =
+        _mm256_mul_ps(_mm256_loadu_ps(&coherence_state->sd[i]), vec_GCoh0);
+    __m256 vec_se =
+        _mm256_mul_ps(_mm256_loadu_ps(&coherence_state->se[i]), vec_GCoh0);
+    __m256 vec_sx =
+        _mm256_mul_ps(_mm256_loadu_ps(&coherence_state->sx[i]), vec_GCoh0);
+    __m256 vec_dfw_sumsq = _mm256_mul_ps(vec_dfw0, vec_dfw0);
+    __m256 vec_efw_sumsq = _mm256_mul_ps(vec_efw0, vec_efw0);
+    __m256 vec_xfw_sumsq = _mm256_mul_ps(vec_xfw0, vec_xfw0);
+    vec_dfw_sumsq =
+        _mm256_add_ps(vec_dfw_sumsq, _mm256_mul_ps(vec_dfw1, vec_dfw1));
+    vec_efw_sumsq =
+        _mm256_add_ps(vec_efw_sumsq, _mm256_mul_ps(vec_efw1, vec_efw1));
+    vec_xfw_sumsq =
+        _mm256_add_ps(vec_xfw_sumsq, _mm256_mul_ps(vec_xfw1, vec_xfw1));
+    vec_xfw_sumsq = _mm256_max_ps(vec_xfw_sumsq, vec_15);
+    vec_sd = _mm256_add_ps(vec_sd, _mm256_mul_ps(vec_dfw_sumsq, vec_GCoh1));
+    vec_se = _mm256_add_ps(vec_se, _mm256_mul_ps(vec_efw_sumsq, vec_GCoh1));
+    vec_sx = _mm256_add_ps(vec_sx, _mm256_mul_ps(vec_xfw_sumsq, vec_GCoh1));
+    _mm256_storeu_ps(&coherence_state->sd[i], vec_sd);
+    _mm256_storeu_ps(&coherence_state->se[i], vec_se);
+    _mm256_storeu_ps(&coherence_state->sx[i], vec_sx);
+
+    UpdateCrossPsd(vec_dfw0, vec_dfw1, vec_efw0, vec_efw1, vec_GCoh0,
+                   vec_GCoh1, &coherence_state->sde[i][0]);
+    UpdateCrossPsd(vec_dfw0, vec_dfw1, vec_xfw0, vec_xfw1, vec_GCoh0,
+                   vec_GCoh1, &coherence_state->sxd[i][0]);
+
+    vec_sdSum = AccumulateHalves(vec_sdSum, vec_sd);
+    vec_seSum = AccumulateHalves(vec_seSum, vec_se);
+  }
+
+  _mm_add_ps_4x1(vec_sdSum, &sdSum);
+  _mm_add_ps_4x1(vec_seSum, &seSum);
+
+  for (; i < PART_LEN1; i++) {
+    coherence_state->sd[i] =
+        ptrGCoh[0] * coherence_state->sd[i] +
+        ptrGCoh[1] * (dfw[0][i] * dfw[0][i] + dfw[1][i] * dfw[1][i]);
+    coherence_state->se[i] =
+        ptrGCoh[0] * coherence_state->se[i] +
+        ptrGCoh[1] * (efw[0][i] * efw[0][i] + efw[1][i] * efw[1][i]);
+    // We threshold here to protect against the ill-effects of a zero farend.
+    // The threshold is not arbitrarily chosen, but balances protection and
+    // adverse interaction with the algorithm's tuning.
+    coherence_state->sx[i] =
+        ptrGCoh[0] * coherence_state->sx[i] +
+        ptrGCoh[1] *
+            WEBRTC_SPL_MAX(xfw[0][i] * xfw[0][i] + xfw[1][i] * xfw[1][i],
+                           WebRtcAec_kMinFarendPSD);
+
+    coherence_state->sde[i][0] =
+        ptrGCoh[0] * coherence_state->sde[i][0] +
+        ptrGCoh[1] * (dfw[0][i] * efw[0][i] + dfw[1][i] * efw[1][i]);
+    coherence_state->sde[i][1] =
+        ptrGCoh[0] * coherence_state->sde[i][1] +
+        ptrGCoh[1] * (dfw[0][i] * efw[1][i] - dfw[1][i] * efw[0][i]);
+
+    coherence_state->sxd[i][0] =
+        ptrGCoh[0] * coherence_state->sxd[i][0] +
+        ptrGCoh[1] * (dfw[0][i] * xfw[0][i] + dfw[1][i] * xfw[1][i]);
+    coherence_state->sxd[i][1] =
+        ptrGCoh[0] * coherence_state->sxd[i][1] +
+        ptrGCoh[1] * (dfw[0][i] * xfw[1][i] - dfw[1][i] * xfw[0][i]);
+
+    sdSum += coherence_state->sd[i];
+    seSum += coherence_state->se[i];
+  }
+
+  // Divergent filter safeguard update.
+  *filter_divergence_state =
+      (*filter_divergence_state ? 1.05f : 1.0f) * seSum > sdSum;
+
+  // Signal extreme filter divergence if the error is significantly larger
+  // than the nearend (13 dB).
+  *extreme_filter_divergence = (seSum > (19.95f * sdSum));
+}
+
+// Window time domain data to be used by the fft.
+void WindowDataAVX2(float* x_windowed, const float* x) {
+  const __m256i reverse = _mm256_set_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  int i;
+  for (i = 0; i < PART_LEN; i += 8) {
+    const __m256 vec_Buf1 = _mm256_loadu_ps(&x[i]);
+    const __m256 vec_Buf2 = _mm256_loadu_ps(&x[PART_LEN + i]);
+    const __m256 vec_sqrtHanning = _mm256_loadu_ps(&WebRtcAec_sqrtHanning[i]);
+    const __m256 vec_sqrtHanning_rev = _mm256_permutevar8x32_ps(
+        _mm256_loadu_ps(&WebRtcAec_sqrtHanning[PART_LEN - i - 7]), reverse);
+    _mm256_storeu_ps(&x_windowed[i], _mm256_mul_ps(vec_Buf1, vec_sqrtHanning));
+    _mm256_storeu_ps(&x_windowed[PART_LEN + i],
+                     _mm256_mul_ps(vec_Buf2, vec_sqrtHanning_rev));
+  }
+}
+
+// Puts fft output data into a complex valued array.
+void StoreAsComplexAVX2(const float* data, float data_complex[2][PART_LEN1]) {
+  int i;
+  for (i = 0; i < PART_LEN; i += 8) {
+    __m256 vec_re, vec_im;
+    Deinterleave(&data[2 * i], &vec_re, &vec_im);
+    _mm256_storeu_ps(&data_complex[0][i], vec_re);
+    _mm256_storeu_ps(&data_complex[1][i], vec_im);
+  }
+  // fix beginning/end values
+  data_complex[1][0] = 0;
+  data_complex[1][PART_LEN] = 0;
+  data_complex[0][0] = data[0];
+  data_complex[0][PART_LEN] = data[1];
+}
+
+void ComputeCoherenceAVX2(const CoherenceState* coherence_state,
+                          float* cohde,
+                          float* cohxd) {
+  const __m256 vec_1eminus10 = _mm256_set1_ps(1e-10f);
+  int i;
+
+  // Subband coherence
+  for (i = 0; i + 7 < PART_LEN1; i += 8) {
+    const __m256 vec_sd = _mm256_loadu_ps(&coherence_state->sd[i]);
+    const __m256 vec_se = _mm256_loadu_ps(&coherence_state->se[i]);
+    const __m256 vec_sx = _mm256_loadu_ps(&coherence_state->sx[i]);
+    const __m256 vec_sdse =
+        _mm256_add_ps(vec_1eminus10, _mm256_mul_ps(vec_sd, vec_se));
+    const __m256 vec_sdsx =
+        _mm256_add_ps(vec_1eminus10, _mm256_mul_ps(vec_sd, vec_sx));
+    __m256 vec_sde_0, vec_sde_1, vec_sxd_0, vec_sxd_1;
+    Deinterleave(&coherence_state->sde[i][0], &vec_sde_0, &vec_sde_1);
+    Deinterleave(&coherence_state->sxd[i][0], &vec_sxd_0, &vec_sxd_1);
+    __m256 vec_cohde = _mm256_mul_ps(vec_sde_0, vec_sde_0);
+    __m256 vec_cohxd = _mm256_mul_ps(vec_sxd_0, vec_sxd_0);
+    vec_cohde = _mm256_add_ps(vec_cohde, _mm256_mul_ps(vec_sde_1, vec_sde_1));
+    vec_cohxd = _mm256_add_ps(vec_cohxd, _mm256_mul_ps(vec_sxd_1, vec_sxd_1));
+    _mm256_storeu_ps(&cohde[i], _mm256_div_ps(vec_cohde, vec_sdse));
+    _mm256_storeu_ps(&cohxd[i], _mm256_div_ps(vec_cohxd, vec_sdsx));
+  }
+
+  // scalar code for the remaining items.
+  for (; i < PART_LEN1; i++) {
+    cohde[i] = (coherence_state->sde[i][0] * coherence_state->sde[i][0] +
+                coherence_state->sde[i][1] * coherence_state->sde[i][1]) /
+               (coherence_state->sd[i] * coherence_state->se[i] + 1e-10f);
+    cohxd[i] = (coherence_state->sxd[i][0] * coherence_state->sxd[i][0] +
+                coherence_state->sxd[i][1] * coherence_state->sxd[i][1]) /
+               (coherence_state->sx[i] * coherence_state->sd[i] + 1e-10f);
+  }
+}
+
+}  // namespace
+
+void WebRtcAec_InitAec_AVX2(void) {
+  WebRtcAec_FilterFar = FilterFarAVX2;
+  WebRtcAec_ScaleErrorSignal = ScaleErrorSignalAVX2;
+  WebRtcAec_FilterAdaptation = FilterAdaptationAVX2;
+  WebRtcAec_Overdrive = OverdriveAVX2;
+  WebRtcAec_Suppress = SuppressAVX2;
+  WebRtcAec_ComputeCoherence = ComputeCoherenceAVX2;
+  WebRtcAec_UpdateCoherenceSpectra = UpdateCoherenceSpectraAVX2;
+  WebRtcAec_StoreAsComplex = StoreAsComplexAVX2;
+  WebRtcAec_PartitionDelay = PartitionDelayAVX2;
+  WebRtcAec_WindowData = WindowDataAVX2;
+}
+}  // namespace webrtc
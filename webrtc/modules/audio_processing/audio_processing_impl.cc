@@ -294,9 +294,9 @@ AudioProcessingImpl::AudioProcessingImpl(const webrtc::Config& config,
     rtc::CritScope cs_capture(&crit_capture_);
 
     public_submodules_->echo_cancellation.reset(
-        new EchoCancellationImpl(&crit_render_, &crit_capture_));
+        new EchoCancellationImpl(&crit_capture_));
     public_submodules_->echo_control_mobile.reset(
-        new EchoControlMobileImpl(&crit_render_, &crit_capture_));
+        new EchoControlMobileImpl(&crit_capture_));
     public_submodules_->gain_control.reset(
         new GainControlImpl(&crit_capture_, &crit_capture_));
     public_submodules_->high_pass_filter.reset(
@@ -394,6 +394,9 @@ AudioProcessingImpl::ApmDebugDumpState::~ApmDebugDumpState() {}
 
 // Calls InitializeLocked() if any of the audio parameters have changed from
 // their current values (needs to be called while holding the crit_render_lock).
+// The formats are only modified while holding both locks, which allows the
+// capture side to check for format changes while only holding the capture
+// lock, and only acquire the render lock when a change is detected.
 int AudioProcessingImpl::MaybeInitialize(
     const ProcessingConfig& processing_config,
     bool force_initialization) {
@@ -607,6 +610,7 @@ void AudioProcessingImpl::SetExtraOptions(const webrtc::Config& config) {
   rtc::CritScope cs_capture(&crit_capture_);
 
   public_submodules_->echo_cancellation->SetExtraOptions(config);
+  public_submodules_->noise_suppression->SetExtraOptions(config);
 
   if (capture_.transient_suppressor_enabled !=
       config.Get<ExperimentalNs>().enabled) {
@@ -716,6 +720,7 @@ int AudioProcessingImpl::ProcessStream(const float* const* src,
   TRACE_EVENT0("webrtc", "AudioProcessing::ProcessStream_StreamConfig");
   ProcessingConfig processing_config;
   bool reinitialization_required = false;
+  bool format_changed = false;
   {
     // Acquire the capture lock in order to safely call the function
     // that retrieves the render side data. This function accesses apm
@@ -729,13 +734,16 @@ int AudioProcessingImpl::ProcessStream(const float* const* src,
 
     processing_config = formats_.api_format;
     reinitialization_required = UpdateActiveSubmoduleStates();
-  }
 
-  processing_config.input_stream() = input_config;
-  processing_config.output_stream() = output_config;
+    processing_config.input_stream() = input_config;
+    processing_config.output_stream() = output_config;
+    format_changed = processing_config != formats_.api_format;
+  }
 
-  {
-    // Do conditional reinitialization.
+  if (reinitialization_required || format_changed) {
+    // Do conditional reinitialization. The render lock is only acquired when
+    // a reinitialization may be needed, so that the capture side does not
+    // wait for an ongoing render call on every frame.
     rtc::CritScope cs_render(&crit_render_);
     RETURN_ON_ERR(
         MaybeInitializeCapture(processing_config, reinitialization_required));
@@ -984,6 +992,7 @@ int AudioProcessingImpl::ProcessStream(AudioFrame* frame) {
 
   ProcessingConfig processing_config;
   bool reinitialization_required = false;
+  bool format_changed = false;
   {
     // Aquire lock for the access of api_format.
     // The lock is released immediately due to the conditional
@@ -994,14 +1003,19 @@ int AudioProcessingImpl::ProcessStream(AudioFrame* frame) {
     processing_config = formats_.api_format;
 
     reinitialization_required = UpdateActiveSubmoduleStates();
+
+    processing_config.input_stream().set_sample_rate_hz(
+        frame->sample_rate_hz_);
+    processing_config.input_stream().set_num_channels(frame->num_channels_);
+    processing_config.output_stream().set_sample_rate_hz(
+        frame->sample_rate_hz_);
+    processing_config.output_stream().set_num_channels(frame->num_channels_);
+    format_changed = processing_config != formats_.api_format;
   }
-  processing_config.input_stream().set_sample_rate_hz(frame->sample_rate_hz_);
-  processing_config.input_stream().set_num_channels(frame->num_channels_);
-  processing_config.output_stream().set_sample_rate_hz(frame->sample_rate_hz_);
-  processing_config.output_stream().set_num_channels(frame->num_channels_);
 
-  {
-    // Do conditional reinitialization.
+  if (reinitialization_required || format_changed) {
+    // Do conditional reinitialization. As above, the render lock is only
+    // acquired when a reinitialization may be needed.
     rtc::CritScope cs_render(&crit_render_);
     RETURN_ON_ERR(
         MaybeInitializeCapture(processing_config, reinitialization_required));
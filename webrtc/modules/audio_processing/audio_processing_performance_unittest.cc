@@ -280,6 +280,13 @@ class TimedThreadApiProcessor {
                                    GetDurationStandardDeviation()),
         "us", false);
 
+    // The maximum call durations mainly reflect the time spent waiting for
+    // the other thread, which makes them a measure of the lock contention
+    // between the render and capture sides.
+    webrtc::test::PrintResult("apm_timing_max", sample_rate_name,
+                              processor_name,
+                              std::to_string(GetDurationMax()), "us", false);
+
     if (kPrintAllDurations) {
       std::string value_string = "";
       for (int64_t duration : api_call_durations_) {
@@ -316,6 +323,15 @@ class TimedThreadApiProcessor {
                 : -1);
   }
 
+  int64_t GetDurationMax() const {
+    int64_t max_duration = -1;
+    for (size_t k = kNumInitializationFrames; k < api_call_durations_.size();
+         k++) {
+      max_duration = std::max(max_duration, api_call_durations_[k]);
+    }
+    return max_duration;
+  }
+
   int64_t GetDurationAverage() const {
     int64_t average_duration = 0;
     for (size_t k = kNumInitializationFrames; k < api_call_durations_.size();
@@ -461,21 +477,31 @@ class CallSimulator : public ::testing::TestWithParam<SimulationConfig> {
         capture_thread_(new rtc::PlatformThread(CaptureProcessorThreadFunc,
                                                 this,
                                                 "capture")),
+        runtime_settings_thread_(
+            new rtc::PlatformThread(RuntimeSettingsThreadFunc,
+                                    this,
+                                    "runtime_settings")),
         rand_gen_(42U),
         simulation_config_(static_cast<SimulationConfig>(GetParam())) {}
 
-  // Run the call simulation with a timeout.
-  EventTypeWrapper Run() {
+  // Run the call simulation with a timeout. If |change_settings| is true,
+  // the echo canceller settings are changed from a third thread during the
+  // call, which measures how much the render and capture calls wait for
+  // the settings changes.
+  EventTypeWrapper Run(bool change_settings) {
     StartThreads();
+    if (change_settings)
+      runtime_settings_thread_->Start();
 
     EventTypeWrapper result = test_complete_->Wait(kTestTimeout);
 
     StopThreads();
 
+    const std::string suffix = change_settings ? "_with_settings_changes" : "";
     render_thread_state_->print_processor_statistics(
-        simulation_config_.SettingsDescription() + "_render");
+        simulation_config_.SettingsDescription() + "_render" + suffix);
     capture_thread_state_->print_processor_statistics(
-        simulation_config_.SettingsDescription() + "_capture");
+        simulation_config_.SettingsDescription() + "_capture" + suffix);
 
     return result;
   }
@@ -494,6 +520,7 @@ class CallSimulator : public ::testing::TestWithParam<SimulationConfig> {
   static const float kCaptureInputFloatLevel;
   static const float kRenderInputFloatLevel;
   static const int kMinNumFramesToProcess = 150;
+  static const int kSettingsChangeIntervalMs = 1;
   static const int32_t kTestTimeout = 3 * 10 * kMinNumFramesToProcess;
 
   // ::testing::TestWithParam<> implementation.
@@ -503,6 +530,7 @@ class CallSimulator : public ::testing::TestWithParam<SimulationConfig> {
   void StopThreads() {
     render_thread_->Stop();
     capture_thread_->Stop();
+    runtime_settings_thread_->Stop();
   }
 
   // Simulator and APM setup.
@@ -659,6 +687,28 @@ class CallSimulator : public ::testing::TestWithParam<SimulationConfig> {
         ->capture_thread_state_->Process();
   }
 
+  // Thread callback for the runtime settings thread. Alternates the
+  // settings of the active echo canceller, which reconfigures it.
+  static bool RuntimeSettingsThreadFunc(void* context) {
+    CallSimulator* simulator = reinterpret_cast<CallSimulator*>(context);
+    AudioProcessing* apm = simulator->apm_.get();
+    const bool toggle = (simulator->num_settings_changes_++ % 2) == 0;
+    if (apm->echo_cancellation()->is_enabled()) {
+      EXPECT_EQ(AudioProcessing::kNoError,
+                apm->echo_cancellation()->set_suppression_level(
+                    toggle ? EchoCancellation::kHighSuppression
+                           : EchoCancellation::kModerateSuppression));
+    }
+    if (apm->echo_control_mobile()->is_enabled()) {
+      EXPECT_EQ(AudioProcessing::kNoError,
+                apm->echo_control_mobile()->set_routing_mode(
+                    toggle ? EchoControlMobile::kLoudSpeakerphone
+                           : EchoControlMobile::kSpeakerphone));
+    }
+    SleepMs(kSettingsChangeIntervalMs);
+    return true;
+  }
+
   // Start the threads used in the test.
   void StartThreads() {
     ASSERT_NO_FATAL_FAILURE(render_thread_->Start());
@@ -673,6 +723,8 @@ class CallSimulator : public ::testing::TestWithParam<SimulationConfig> {
   // Thread related variables.
   std::unique_ptr<rtc::PlatformThread> render_thread_;
   std::unique_ptr<rtc::PlatformThread> capture_thread_;
+  std::unique_ptr<rtc::PlatformThread> runtime_settings_thread_;
+  int num_settings_changes_ = 0;
   Random rand_gen_;
 
   std::unique_ptr<AudioProcessing> apm_;
@@ -716,7 +768,12 @@ const float CallSimulator::kCaptureInputFloatLevel = 0.03125f;
 
 TEST_P(CallSimulator, ApiCallDurationTest) {
   // Run test and verify that it did not time out.
-  EXPECT_EQ(kEventSignaled, Run());
+  EXPECT_EQ(kEventSignaled, Run(false));
+}
+
+TEST_P(CallSimulator, ApiCallDurationWithSettingsChangesTest) {
+  // Run test and verify that it did not time out.
+  EXPECT_EQ(kEventSignaled, Run(true));
 }
 
 INSTANTIATE_TEST_CASE_P(
@@ -0,0 +1,350 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_processing/batch_audio_processor.h"
+
+#include <algorithm>
+
+#include "webrtc/base/checks.h"
+#include "webrtc/common_audio/include/audio_util.h"
+#include "webrtc/common_audio/signal_processing/include/signal_processing_library.h"
+#include "webrtc/common_audio/vad/include/webrtc_vad.h"
+#include "webrtc/modules/audio_processing/agc/legacy/gain_control.h"
+#if defined(WEBRTC_NS_FLOAT)
+#include "webrtc/modules/audio_processing/ns/noise_suppression.h"
+#define NS_CREATE WebRtcNs_Create
+#define NS_FREE WebRtcNs_Free
+#define NS_INIT WebRtcNs_Init
+#define NS_SET_POLICY WebRtcNs_set_policy
+typedef NsHandle NsState;
+#elif defined(WEBRTC_NS_FIXED)
+#include "webrtc/modules/audio_processing/ns/noise_suppression_x.h"
+#define NS_CREATE WebRtcNsx_Create
+#define NS_FREE WebRtcNsx_Free
+#define NS_INIT WebRtcNsx_Init
+#define NS_SET_POLICY WebRtcNsx_set_policy
+typedef NsxHandle NsState;
+#endif
+
+namespace webrtc {
+namespace {
+
+// Same coefficients as in HighPassFilterImpl.
+const int16_t kFilterCoefficients8kHz[5] = {3798, -7596, 3798, 7807, -3733};
+const int16_t kFilterCoefficients[5] = {4012, -8024, 4012, 8002, -3913};
+
+const int kMinimumCaptureLevel = 0;
+const int kMaximumCaptureLevel = 255;
+
+int NoiseSuppressionPolicy(NoiseSuppression::Level level) {
+  switch (level) {
+    case NoiseSuppression::kLow:
+      return 0;
+    case NoiseSuppression::kModerate:
+      return 1;
+    case NoiseSuppression::kHigh:
+      return 2;
+    case NoiseSuppression::kVeryHigh:
+      return 3;
+  }
+  RTC_NOTREACHED();
+  return 1;
+}
+
+int VadMode(VoiceDetection::Likelihood likelihood) {
+  switch (likelihood) {
+    case VoiceDetection::kVeryLowLikelihood:
+      return 3;
+    case VoiceDetection::kLowLikelihood:
+      return 2;
+    case VoiceDetection::kModerateLikelihood:
+      return 1;
+    case VoiceDetection::kHighLikelihood:
+      return 0;
+  }
+  RTC_NOTREACHED();
+  return 2;
+}
+
+}  // namespace
+
+// Holds the per-stream state of the submodules that cannot be run across
+// streams.
+class BatchAudioProcessor::StreamProcessor {
+ public:
+  StreamProcessor(const Config& config, size_t num_frames)
+      : config_(config) {
+    if (config_.noise_suppression_enabled) {
+      ns_ = NS_CREATE();
+      RTC_CHECK(ns_);
+#if defined(WEBRTC_NS_FLOAT)
+      ns_frame_.resize(num_frames);
+#endif
+    }
+    if (config_.gain_control_enabled) {
+      agc_ = WebRtcAgc_Create();
+      RTC_CHECK(agc_);
+    }
+    if (config_.voice_detection_enabled) {
+      vad_ = WebRtcVad_Create();
+      RTC_CHECK(vad_);
+    }
+    Reset();
+  }
+
+  ~StreamProcessor() {
+    if (ns_) {
+      NS_FREE(ns_);
+    }
+    if (agc_) {
+      WebRtcAgc_Free(agc_);
+    }
+    if (vad_) {
+      WebRtcVad_Free(vad_);
+    }
+  }
+
+  void Reset() {
+    if (ns_) {
+      int error = NS_INIT(ns_, config_.sample_rate_hz);
+      RTC_DCHECK_EQ(0, error);
+      error = NS_SET_POLICY(ns_,
+                            NoiseSuppressionPolicy(config_.noise_suppression_level));
+      RTC_DCHECK_EQ(0, error);
+    }
+    if (agc_) {
+      int error = WebRtcAgc_Init(agc_, kMinimumCaptureLevel,
+                                 kMaximumCaptureLevel, kAgcModeAdaptiveDigital,
+                                 config_.sample_rate_hz);
+      RTC_DCHECK_EQ(0, error);
+      WebRtcAgcConfig agc_config;
+      agc_config.targetLevelDbfs =
+          static_cast<int16_t>(config_.gain_control_target_level_dbfs);
+      agc_config.compressionGaindB =
+          static_cast<int16_t>(config_.gain_control_compression_gain_db);
+      agc_config.limiterEnable = config_.gain_control_limiter_enabled;
+      error = WebRtcAgc_set_config(agc_, agc_config);
+      RTC_DCHECK_EQ(0, error);
+      capture_level_ = kMinimumCaptureLevel;
+    }
+    if (vad_) {
+      int error = WebRtcVad_Init(vad_);
+      RTC_DCHECK_EQ(0, error);
+      error = WebRtcVad_set_mode(vad_,
+                                 VadMode(config_.voice_detection_likelihood));
+      RTC_DCHECK_EQ(0, error);
+    }
+    has_voice_ = false;
+    is_saturated_ = false;
+  }
+
+  // Runs the submodules in the same order as AudioProcessingImpl does.
+  int Process(int16_t* frame, size_t num_frames) {
+    if (agc_) {
+      int32_t capture_level_out = 0;
+      if (WebRtcAgc_VirtualMic(agc_, &frame, 1, num_frames,
+                               kMinimumCaptureLevel, &capture_level_out) != 0) {
+        return AudioProcessing::kUnspecifiedError;
+      }
+      capture_level_ = capture_level_out;
+    }
+
+    if (ns_) {
+#if defined(WEBRTC_NS_FLOAT)
+      float* ns_frame = ns_frame_.data();
+      std::copy(frame, frame + num_frames, ns_frame);
+      WebRtcNs_Analyze(ns_, ns_frame);
+      WebRtcNs_Process(ns_, &ns_frame, 1, &ns_frame);
+      FloatS16ToS16(ns_frame, num_frames, frame);
+#elif defined(WEBRTC_NS_FIXED)
+      WebRtcNsx_Process(ns_, &frame, 1, &frame);
+#endif
+    }
+
+    if (vad_) {
+      int vad_ret = WebRtcVad_Process(vad_, config_.sample_rate_hz, frame,
+                                      num_frames);
+      RTC_DCHECK(vad_ret == 0 || vad_ret == 1);
+      has_voice_ = vad_ret == 1;
+    }
+
+    if (agc_) {
+      int32_t capture_level_out = 0;
+      uint8_t saturation_warning = 0;
+      if (WebRtcAgc_Process(agc_, &frame, 1, num_frames, &frame,
+                            capture_level_, &capture_level_out, 0,
+                            &saturation_warning) != 0) {
+        return AudioProcessing::kUnspecifiedError;
+      }
+      capture_level_ = capture_level_out;
+      is_saturated_ = saturation_warning == 1;
+    }
+    return AudioProcessing::kNoError;
+  }
+
+  bool has_voice() const { return has_voice_; }
+  bool is_saturated() const { return is_saturated_; }
+
+ private:
+  const Config& config_;
+  NsState* ns_ = nullptr;
+  void* agc_ = nullptr;
+  VadInst* vad_ = nullptr;
+#if defined(WEBRTC_NS_FLOAT)
+  std::vector<float> ns_frame_;
+#endif
+  int32_t capture_level_ = kMinimumCaptureLevel;
+  bool has_voice_ = false;
+  bool is_saturated_ = false;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(StreamProcessor);
+};
+
+BatchAudioProcessor::BatchAudioProcessor(const Config& config,
+                                         size_t num_streams)
+    : config_(config),
+      num_streams_(num_streams),
+      num_frames_(static_cast<size_t>(config.sample_rate_hz *
+                                      AudioProcessing::kChunkSizeMs / 1000)),
+      hpf_coefficients_(config.sample_rate_hz ==
+                                AudioProcessing::kSampleRate8kHz
+                            ? kFilterCoefficients8kHz
+                            : kFilterCoefficients),
+      hpf_x0_(num_streams, 0),
+      hpf_x1_(num_streams, 0),
+      hpf_y0_(num_streams, 0),
+      hpf_y1_(num_streams, 0),
+      hpf_y2_(num_streams, 0),
+      hpf_y3_(num_streams, 0),
+      stream_processors_(num_streams) {
+  RTC_CHECK(config_.sample_rate_hz == AudioProcessing::kSampleRate8kHz ||
+            config_.sample_rate_hz == AudioProcessing::kSampleRate16kHz);
+  if (config_.high_pass_filter_enabled) {
+    interleaved_frames_.resize(num_streams_ * num_frames_);
+  }
+  for (auto& processor : stream_processors_) {
+    processor.reset(new StreamProcessor(config_, num_frames_));
+  }
+}
+
+BatchAudioProcessor::~BatchAudioProcessor() {}
+
+int BatchAudioProcessor::ProcessStreams(
+    rtc::ArrayView<int16_t* const> frames) {
+  RTC_DCHECK_EQ(num_streams_, frames.size());
+  for (int16_t* frame : frames) {
+    if (!frame) {
+      return AudioProcessing::kNullPointerError;
+    }
+  }
+
+  if (config_.high_pass_filter_enabled) {
+    HighPassFilterStreams(frames);
+  }
+
+  int error = AudioProcessing::kNoError;
+  for (size_t k = 0; k < num_streams_; ++k) {
+    const int stream_error = stream_processors_[k]->Process(frames[k],
+                                                            num_frames_);
+    if (stream_error != AudioProcessing::kNoError) {
+      error = stream_error;
+    }
+  }
+  return error;
+}
+
+bool BatchAudioProcessor::stream_has_voice(size_t stream) const {
+  RTC_DCHECK_LT(stream, num_streams_);
+  return stream_processors_[stream]->has_voice();
+}
+
+bool BatchAudioProcessor::stream_is_saturated(size_t stream) const {
+  RTC_DCHECK_LT(stream, num_streams_);
+  return stream_processors_[stream]->is_saturated();
+}
+
+void BatchAudioProcessor::ResetStream(size_t stream) {
+  RTC_DCHECK_LT(stream, num_streams_);
+  hpf_x0_[stream] = 0;
+  hpf_x1_[stream] = 0;
+  hpf_y0_[stream] = 0;
+  hpf_y1_[stream] = 0;
+  hpf_y2_[stream] = 0;
+  hpf_y3_[stream] = 0;
+  stream_processors_[stream]->Reset();
+}
+
+// Bit-exact with HighPassFilterImpl, but with the loop over the streams as the
+// inner loop. As the streams are independent and the state is stored as struct
+// of arrays, the inner loop has no dependencies between iterations and can be
+// vectorized by the compiler.
+void BatchAudioProcessor::HighPassFilterStreams(
+    rtc::ArrayView<int16_t* const> frames) {
+  for (size_t k = 0; k < num_streams_; ++k) {
+    const int16_t* frame = frames[k];
+    for (size_t i = 0; i < num_frames_; ++i) {
+      interleaved_frames_[i * num_streams_ + k] = frame[i];
+    }
+  }
+
+  const int16_t* const ba = hpf_coefficients_;
+  int16_t* const x0 = hpf_x0_.data();
+  int16_t* const x1 = hpf_x1_.data();
+  int16_t* const y0 = hpf_y0_.data();
+  int16_t* const y1 = hpf_y1_.data();
+  int16_t* const y2 = hpf_y2_.data();
+  int16_t* const y3 = hpf_y3_.data();
+  for (size_t i = 0; i < num_frames_; ++i) {
+    int16_t* const data = &interleaved_frames_[i * num_streams_];
+    for (size_t k = 0; k < num_streams_; ++k) {
+      //  y[i] = b[0] * x[i] +  b[1] * x[i-1] +  b[2] * x[i-2]
+      //                     + -a[1] * y[i-1] + -a[2] * y[i-2];
+      int32_t tmp_int32 = y1[k] * ba[3];  // -a[1] * y[i-1] (low part)
+      tmp_int32 += y3[k] * ba[4];         // -a[2] * y[i-2] (low part)
+      tmp_int32 = (tmp_int32 >> 15);
+      tmp_int32 += y0[k] * ba[3];         // -a[1] * y[i-1] (high part)
+      tmp_int32 += y2[k] * ba[4];         // -a[2] * y[i-2] (high part)
+      tmp_int32 = (tmp_int32 << 1);
+
+      tmp_int32 += data[k] * ba[0];       // b[0] * x[0]
+      tmp_int32 += x0[k] * ba[1];         // b[1] * x[i-1]
+      tmp_int32 += x1[k] * ba[2];         // b[2] * x[i-2]
+
+      // Update state (input part).
+      x1[k] = x0[k];
+      x0[k] = data[k];
+
+      // Update state (filtered part).
+      y2[k] = y0[k];
+      y3[k] = y1[k];
+      y0[k] = static_cast<int16_t>(tmp_int32 >> 13);
+      y1[k] = static_cast<int16_t>(
+          (tmp_int32 - (static_cast<int32_t>(y0[k]) << 13)) << 2);
+
+      // Rounding in Q12, i.e. add 2^11.
+      tmp_int32 += 2048;
+
+      // Saturate (to 2^27) so that the HP filtered signal does not overflow.
+      tmp_int32 = std::min(std::max(tmp_int32, -134217728), 134217727);
+
+      // Convert back to Q0 and use rounding.
+      data[k] = static_cast<int16_t>(tmp_int32 >> 12);
+    }
+  }
+
+  for (size_t k = 0; k < num_streams_; ++k) {
+    int16_t* frame = frames[k];
+    for (size_t i = 0; i < num_frames_; ++i) {
+      frame[i] = interleaved_frames_[i * num_streams_ + k];
+    }
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,106 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_AUDIO_PROCESSING_BATCH_AUDIO_PROCESSOR_H_
+#define WEBRTC_MODULES_AUDIO_PROCESSING_BATCH_AUDIO_PROCESSOR_H_
+
+#include <memory>
+#include <vector>
+
+#include "webrtc/base/array_view.h"
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/modules/audio_processing/include/audio_processing.h"
+
+namespace webrtc {
+
+// Applies capture side processing (high-pass filter, noise suppression,
+// adaptive digital AGC and voice activity detection) to a batch of independent
+// mono streams, one 10 ms frame per stream and call. This is intended for
+// servers that process a large number of participant streams, where a full
+// AudioProcessing instance per stream is unnecessarily costly.
+//
+// The processing is equivalent to that of an AudioProcessing instance with the
+// corresponding submodules enabled that processes 8 or 16 kHz mono AudioFrames.
+// Only the sample rates that do not require band splitting are supported.
+//
+// The high-pass filter state is kept as a struct of arrays, with the streams
+// interleaved so that the filter is run across all streams for each sample.
+// The remaining submodules are run per stream, but without the AudioBuffer and
+// locking overhead of AudioProcessing.
+//
+// The class is not thread-safe.
+class BatchAudioProcessor {
+ public:
+  struct Config {
+    int sample_rate_hz = AudioProcessing::kSampleRate16kHz;
+    bool high_pass_filter_enabled = true;
+    bool noise_suppression_enabled = true;
+    NoiseSuppression::Level noise_suppression_level =
+        NoiseSuppression::kModerate;
+    // Runs the legacy AGC in GainControl::kAdaptiveDigital mode.
+    bool gain_control_enabled = true;
+    int gain_control_target_level_dbfs = 3;
+    int gain_control_compression_gain_db = 9;
+    bool gain_control_limiter_enabled = true;
+    bool voice_detection_enabled = true;
+    VoiceDetection::Likelihood voice_detection_likelihood =
+        VoiceDetection::kLowLikelihood;
+  };
+
+  BatchAudioProcessor(const Config& config, size_t num_streams);
+  ~BatchAudioProcessor();
+
+  size_t num_streams() const { return num_streams_; }
+  size_t num_frames() const { return num_frames_; }
+
+  // Processes one 10 ms frame in place for each of the streams. |frames| must
+  // contain num_streams() pointers to num_frames() samples each.
+  int ProcessStreams(rtc::ArrayView<int16_t* const> frames);
+
+  // Returns the voice activity decision for |stream| for the last processed
+  // frame. Always false if voice detection is disabled.
+  bool stream_has_voice(size_t stream) const;
+
+  // Returns the saturation warning of the AGC for |stream| for the last
+  // processed frame.
+  bool stream_is_saturated(size_t stream) const;
+
+  // Resets all the processing state of |stream|, e.g., when the stream slot is
+  // reused for a new participant.
+  void ResetStream(size_t stream);
+
+ private:
+  class StreamProcessor;
+
+  void HighPassFilterStreams(rtc::ArrayView<int16_t* const> frames);
+
+  const Config config_;
+  const size_t num_streams_;
+  const size_t num_frames_;
+
+  // High-pass filter state, in struct of arrays form.
+  const int16_t* const hpf_coefficients_;
+  std::vector<int16_t> hpf_x0_;
+  std::vector<int16_t> hpf_x1_;
+  std::vector<int16_t> hpf_y0_;
+  std::vector<int16_t> hpf_y1_;
+  std::vector<int16_t> hpf_y2_;
+  std::vector<int16_t> hpf_y3_;
+  // Samples of all streams, stored sample by sample.
+  std::vector<int16_t> interleaved_frames_;
+
+  std::vector<std::unique_ptr<StreamProcessor>> stream_processors_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(BatchAudioProcessor);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_AUDIO_PROCESSING_BATCH_AUDIO_PROCESSOR_H_
@@ -0,0 +1,186 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <math.h>
+
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "webrtc/base/random.h"
+#include "webrtc/modules/audio_processing/batch_audio_processor.h"
+#include "webrtc/modules/audio_processing/include/audio_processing.h"
+#include "webrtc/modules/include/module_common_types.h"
+#include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+const size_t kNumFramesToProcess = 100;
+const size_t kNumStreams = 100;
+
+class PerformanceTimer {
+ public:
+  PerformanceTimer() : clock_(webrtc::Clock::GetRealTimeClock()) {
+    timestamps_us_.reserve(kNumFramesToProcess);
+  }
+
+  void StartTimer() { start_timestamp_us_ = clock_->TimeInMicroseconds(); }
+  void StopTimer() {
+    timestamps_us_.push_back(clock_->TimeInMicroseconds() -
+                             start_timestamp_us_);
+  }
+
+  double GetDurationAverage() const {
+    RTC_DCHECK(!timestamps_us_.empty());
+    return static_cast<double>(std::accumulate(
+               timestamps_us_.begin(), timestamps_us_.end(), int64_t{0})) /
+           timestamps_us_.size();
+  }
+
+  double GetDurationStandardDeviation() const {
+    RTC_DCHECK(!timestamps_us_.empty());
+    const double average_duration = GetDurationAverage();
+    double variance = 0.0;
+    for (int64_t duration : timestamps_us_) {
+      variance += (duration - average_duration) * (duration - average_duration);
+    }
+    return sqrt(variance / timestamps_us_.size());
+  }
+
+ private:
+  webrtc::Clock* clock_;
+  int64_t start_timestamp_us_ = 0;
+  std::vector<int64_t> timestamps_us_;
+};
+
+std::string FormPerformanceMeasureString(const PerformanceTimer& timer) {
+  std::string s = std::to_string(timer.GetDurationAverage());
+  s += ", ";
+  s += std::to_string(timer.GetDurationStandardDeviation());
+  return s;
+}
+
+void FillFrames(Random* rand_gen,
+                std::vector<std::vector<int16_t>>* frames) {
+  for (auto& frame : *frames) {
+    for (auto& sample : frame) {
+      sample = rand_gen->Rand<int16_t>() / 4;
+    }
+  }
+}
+
+void PrintDurations(const std::string& description,
+                    int sample_rate_hz,
+                    const PerformanceTimer& timer) {
+  webrtc::test::PrintResultMeanAndError(
+      "batch_audio_processor_call_durations",
+      "_" + std::to_string(sample_rate_hz) + "Hz_" +
+          std::to_string(kNumStreams) + "_streams",
+      description, FormPerformanceMeasureString(timer), "us", false);
+}
+
+void RunBatchAudioProcessor(int sample_rate_hz) {
+  BatchAudioProcessor::Config config;
+  config.sample_rate_hz = sample_rate_hz;
+  BatchAudioProcessor batch_processor(config, kNumStreams);
+
+  std::vector<std::vector<int16_t>> frames(
+      kNumStreams, std::vector<int16_t>(batch_processor.num_frames()));
+  std::vector<int16_t*> frame_pointers;
+  for (auto& frame : frames) {
+    frame_pointers.push_back(frame.data());
+  }
+
+  Random rand_gen(42);
+  PerformanceTimer timer;
+  for (size_t frame_no = 0; frame_no < kNumFramesToProcess; ++frame_no) {
+    FillFrames(&rand_gen, &frames);
+
+    timer.StartTimer();
+    ASSERT_EQ(AudioProcessing::kNoError,
+              batch_processor.ProcessStreams(frame_pointers));
+    timer.StopTimer();
+  }
+  PrintDurations("BatchAudioProcessor", sample_rate_hz, timer);
+}
+
+void RunAudioProcessingPerStream(int sample_rate_hz) {
+  BatchAudioProcessor::Config batch_config;
+  std::vector<std::unique_ptr<AudioProcessing>> apms;
+  for (size_t k = 0; k < kNumStreams; ++k) {
+    webrtc::Config config;
+    config.Set<ExperimentalAgc>(new ExperimentalAgc(false));
+    std::unique_ptr<AudioProcessing> apm(AudioProcessing::Create(config));
+    ASSERT_TRUE(apm.get());
+    ASSERT_EQ(AudioProcessing::kNoError,
+              apm->high_pass_filter()->Enable(
+                  batch_config.high_pass_filter_enabled));
+    ASSERT_EQ(AudioProcessing::kNoError,
+              apm->noise_suppression()->Enable(
+                  batch_config.noise_suppression_enabled));
+    ASSERT_EQ(AudioProcessing::kNoError,
+              apm->gain_control()->set_mode(GainControl::kAdaptiveDigital));
+    ASSERT_EQ(AudioProcessing::kNoError,
+              apm->gain_control()->Enable(batch_config.gain_control_enabled));
+    ASSERT_EQ(AudioProcessing::kNoError,
+              apm->voice_detection()->Enable(
+                  batch_config.voice_detection_enabled));
+    apms.push_back(std::move(apm));
+  }
+
+  const size_t num_frames =
+      static_cast<size_t>(sample_rate_hz * AudioProcessing::kChunkSizeMs / 1000);
+  std::vector<std::vector<int16_t>> frames(kNumStreams,
+                                           std::vector<int16_t>(num_frames));
+  std::vector<AudioFrame> audio_frames(kNumStreams);
+
+  Random rand_gen(42);
+  PerformanceTimer timer;
+  for (size_t frame_no = 0; frame_no < kNumFramesToProcess; ++frame_no) {
+    FillFrames(&rand_gen, &frames);
+    for (size_t k = 0; k < kNumStreams; ++k) {
+      audio_frames[k].UpdateFrame(-1, 0, frames[k].data(), num_frames,
+                                  sample_rate_hz, AudioFrame::kNormalSpeech,
+                                  AudioFrame::kVadUnknown, 1);
+    }
+
+    timer.StartTimer();
+    for (size_t k = 0; k < kNumStreams; ++k) {
+      ASSERT_EQ(AudioProcessing::kNoError,
+                apms[k]->ProcessStream(&audio_frames[k]));
+    }
+    timer.StopTimer();
+  }
+  PrintDurations("AudioProcessingPerStream", sample_rate_hz, timer);
+}
+
+}  // namespace
+
+TEST(BatchAudioProcessorPerformanceTest, BatchProcessing) {
+  int sample_rates_to_test[] = {AudioProcessing::kSampleRate8kHz,
+                                AudioProcessing::kSampleRate16kHz};
+  for (auto sample_rate : sample_rates_to_test) {
+    RunBatchAudioProcessor(sample_rate);
+  }
+}
+
+TEST(BatchAudioProcessorPerformanceTest, AudioProcessingPerStream) {
+  int sample_rates_to_test[] = {AudioProcessing::kSampleRate8kHz,
+                                AudioProcessing::kSampleRate16kHz};
+  for (auto sample_rate : sample_rates_to_test) {
+    RunAudioProcessingPerStream(sample_rate);
+  }
+}
+
+}  // namespace webrtc
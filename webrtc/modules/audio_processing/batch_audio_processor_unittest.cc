@@ -0,0 +1,196 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "webrtc/base/random.h"
+#include "webrtc/modules/audio_processing/batch_audio_processor.h"
+#include "webrtc/modules/audio_processing/include/audio_processing.h"
+#include "webrtc/modules/include/module_common_types.h"
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+const size_t kNumFramesToProcess = 300;
+
+// Generates a signal with bursts of tones in noise, so that both the voice
+// activity detection and the gain control have something to act upon. The
+// signal differs between the streams.
+void GenerateFrame(size_t stream,
+                   size_t frame_index,
+                   int sample_rate_hz,
+                   Random* random_generator,
+                   int16_t* frame,
+                   size_t num_frames) {
+  const bool tone_active = ((frame_index + 7 * stream) / 25) % 2 == 0;
+  const float amplitude = 300.f + 2000.f * stream;
+  const float frequency_hz = 200.f + 150.f * stream;
+  for (size_t i = 0; i < num_frames; ++i) {
+    float sample = random_generator->Gaussian(0, 50 + 20 * stream);
+    if (tone_active) {
+      const size_t n = frame_index * num_frames + i;
+      sample += amplitude *
+                std::sin(2.f * 3.14159265f * frequency_hz * n / sample_rate_hz);
+    }
+    frame[i] = static_cast<int16_t>(
+        std::min(std::max(sample, -32768.f), 32767.f));
+  }
+}
+
+std::unique_ptr<AudioProcessing> CreateReferenceApm(
+    const BatchAudioProcessor::Config& config) {
+  webrtc::Config apm_config;
+  apm_config.Set<ExperimentalAgc>(new ExperimentalAgc(false));
+  std::unique_ptr<AudioProcessing> apm(AudioProcessing::Create(apm_config));
+  EXPECT_EQ(AudioProcessing::kNoError,
+            apm->high_pass_filter()->Enable(config.high_pass_filter_enabled));
+  EXPECT_EQ(AudioProcessing::kNoError,
+            apm->noise_suppression()->set_level(
+                config.noise_suppression_level));
+  EXPECT_EQ(AudioProcessing::kNoError,
+            apm->noise_suppression()->Enable(
+                config.noise_suppression_enabled));
+  EXPECT_EQ(AudioProcessing::kNoError,
+            apm->gain_control()->set_mode(GainControl::kAdaptiveDigital));
+  EXPECT_EQ(AudioProcessing::kNoError,
+            apm->gain_control()->set_target_level_dbfs(
+                config.gain_control_target_level_dbfs));
+  EXPECT_EQ(AudioProcessing::kNoError,
+            apm->gain_control()->set_compression_gain_db(
+                config.gain_control_compression_gain_db));
+  EXPECT_EQ(AudioProcessing::kNoError,
+            apm->gain_control()->enable_limiter(
+                config.gain_control_limiter_enabled));
+  EXPECT_EQ(AudioProcessing::kNoError,
+            apm->gain_control()->Enable(config.gain_control_enabled));
+  EXPECT_EQ(AudioProcessing::kNoError,
+            apm->voice_detection()->set_likelihood(
+                config.voice_detection_likelihood));
+  EXPECT_EQ(AudioProcessing::kNoError,
+            apm->voice_detection()->Enable(config.voice_detection_enabled));
+  return apm;
+}
+
+// Verifies that the batch processing is bit-exact with processing each of the
+// streams using a separate AudioProcessing instance. Stream
+// |stream_to_reset| is reset halfway through the processing.
+void RunBitExactnessTest(const BatchAudioProcessor::Config& config,
+                         size_t num_streams,
+                         size_t stream_to_reset) {
+  BatchAudioProcessor batch_processor(config, num_streams);
+  std::vector<std::unique_ptr<AudioProcessing>> apms;
+  for (size_t k = 0; k < num_streams; ++k) {
+    apms.push_back(CreateReferenceApm(config));
+  }
+
+  const size_t num_frames = batch_processor.num_frames();
+  std::vector<std::vector<int16_t>> frames(num_streams,
+                                           std::vector<int16_t>(num_frames));
+  std::vector<int16_t*> frame_pointers(num_streams);
+  for (size_t k = 0; k < num_streams; ++k) {
+    frame_pointers[k] = frames[k].data();
+  }
+
+  AudioFrame reference_frame;
+  Random random_generator(42);
+  for (size_t frame_index = 0; frame_index < kNumFramesToProcess;
+       ++frame_index) {
+    if (frame_index == kNumFramesToProcess / 2 && stream_to_reset < num_streams) {
+      batch_processor.ResetStream(stream_to_reset);
+      apms[stream_to_reset] = CreateReferenceApm(config);
+    }
+
+    for (size_t k = 0; k < num_streams; ++k) {
+      GenerateFrame(k, frame_index, config.sample_rate_hz, &random_generator,
+                    frame_pointers[k], num_frames);
+    }
+
+    std::vector<std::vector<int16_t>> reference_output(num_streams);
+    std::vector<bool> reference_has_voice(num_streams);
+    std::vector<bool> reference_is_saturated(num_streams);
+    for (size_t k = 0; k < num_streams; ++k) {
+      reference_frame.UpdateFrame(-1, 0, frames[k].data(), num_frames,
+                                  config.sample_rate_hz,
+                                  AudioFrame::kNormalSpeech,
+                                  AudioFrame::kVadUnknown, 1);
+      ASSERT_EQ(AudioProcessing::kNoError,
+                apms[k]->ProcessStream(&reference_frame));
+      reference_output[k].assign(reference_frame.data_,
+                                 reference_frame.data_ + num_frames);
+      reference_has_voice[k] = apms[k]->voice_detection()->stream_has_voice();
+      reference_is_saturated[k] =
+          apms[k]->gain_control()->stream_is_saturated();
+    }
+
+    ASSERT_EQ(AudioProcessing::kNoError,
+              batch_processor.ProcessStreams(frame_pointers));
+
+    for (size_t k = 0; k < num_streams; ++k) {
+      ASSERT_EQ(reference_output[k], frames[k])
+          << "stream " << k << ", frame " << frame_index;
+      if (config.voice_detection_enabled) {
+        EXPECT_EQ(reference_has_voice[k], batch_processor.stream_has_voice(k));
+      }
+      if (config.gain_control_enabled) {
+        EXPECT_EQ(reference_is_saturated[k],
+                  batch_processor.stream_is_saturated(k));
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST(BatchAudioProcessorTest, BitExactWithAudioProcessing16kHz) {
+  BatchAudioProcessor::Config config;
+  config.sample_rate_hz = AudioProcessing::kSampleRate16kHz;
+  RunBitExactnessTest(config, 5, 2);
+}
+
+TEST(BatchAudioProcessorTest, BitExactWithAudioProcessing8kHz) {
+  BatchAudioProcessor::Config config;
+  config.sample_rate_hz = AudioProcessing::kSampleRate8kHz;
+  RunBitExactnessTest(config, 5, 4);
+}
+
+TEST(BatchAudioProcessorTest, BitExactWithNonDefaultSettings) {
+  BatchAudioProcessor::Config config;
+  config.noise_suppression_level = NoiseSuppression::kVeryHigh;
+  config.gain_control_target_level_dbfs = 6;
+  config.gain_control_compression_gain_db = 15;
+  config.gain_control_limiter_enabled = false;
+  config.voice_detection_likelihood = VoiceDetection::kHighLikelihood;
+  RunBitExactnessTest(config, 3, 0);
+}
+
+TEST(BatchAudioProcessorTest, BitExactWithHighPassFilterOnly) {
+  BatchAudioProcessor::Config config;
+  config.noise_suppression_enabled = false;
+  config.gain_control_enabled = false;
+  config.voice_detection_enabled = false;
+  RunBitExactnessTest(config, 17, 16);
+}
+
+TEST(BatchAudioProcessorTest, NoVoiceReportedWhenVoiceDetectionIsDisabled) {
+  BatchAudioProcessor::Config config;
+  config.voice_detection_enabled = false;
+  BatchAudioProcessor batch_processor(config, 2);
+  std::vector<int16_t> frame(batch_processor.num_frames(), 10000);
+  int16_t* frames[] = {frame.data(), frame.data()};
+  EXPECT_EQ(AudioProcessing::kNoError, batch_processor.ProcessStreams(frames));
+  EXPECT_FALSE(batch_processor.stream_has_voice(0));
+  EXPECT_FALSE(batch_processor.stream_has_voice(1));
+}
+
+}  // namespace webrtc
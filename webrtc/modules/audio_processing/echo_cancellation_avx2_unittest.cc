@@ -0,0 +1,251 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include <algorithm>
+#include <vector>
+
+#include "webrtc/base/array_view.h"
+#include "webrtc/base/random.h"
+#include "webrtc/modules/audio_processing/audio_buffer.h"
+#include "webrtc/modules/audio_processing/echo_cancellation_impl.h"
+#include "webrtc/modules/audio_processing/test/audio_buffer_tools.h"
+#include "webrtc/modules/audio_processing/test/bitexactness_tools.h"
+#include "webrtc/modules/audio_processing/utility/ooura_fft.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+
+const int kNumFramesToProcess = 100;
+
+WebRtc_CPUInfo g_get_cpu_info = nullptr;
+
+int GetCPUInfoWithoutAvx2(CPUFeature feature) {
+  return feature == kAVX2 ? 0 : g_get_cpu_info(feature);
+}
+
+// Hides AVX2 from the CPU feature detection while in scope, so that the
+// components initialized meanwhile use the SSE2 code.
+class ScopedDisableAvx2 {
+ public:
+  ScopedDisableAvx2() {
+    g_get_cpu_info = WebRtc_GetCPUInfo;
+    WebRtc_GetCPUInfo = GetCPUInfoWithoutAvx2;
+  }
+  ~ScopedDisableAvx2() { WebRtc_GetCPUInfo = g_get_cpu_info; }
+};
+
+void SetupComponent(int sample_rate_hz,
+                    EchoCancellation::SuppressionLevel suppression_level,
+                    bool drift_compensation_enabled,
+                    EchoCancellationImpl* echo_canceller) {
+  echo_canceller->Initialize(sample_rate_hz, 1, 1, 1);
+  EchoCancellation* ec = static_cast<EchoCancellation*>(echo_canceller);
+  ec->Enable(true);
+  ec->set_suppression_level(suppression_level);
+  ec->enable_drift_compensation(drift_compensation_enabled);
+
+  Config config;
+  config.Set<DelayAgnostic>(new DelayAgnostic(true));
+  config.Set<ExtendedFilter>(new ExtendedFilter(true));
+  echo_canceller->SetExtraOptions(config);
+}
+
+void ProcessOneFrame(int sample_rate_hz,
+                     int stream_delay_ms,
+                     bool drift_compensation_enabled,
+                     int stream_drift_samples,
+                     AudioBuffer* render_audio_buffer,
+                     AudioBuffer* capture_audio_buffer,
+                     EchoCancellationImpl* echo_canceller) {
+  if (sample_rate_hz > AudioProcessing::kSampleRate16kHz) {
+    render_audio_buffer->SplitIntoFrequencyBands();
+    capture_audio_buffer->SplitIntoFrequencyBands();
+  }
+
+  std::vector<float> render_audio;
+  EchoCancellationImpl::PackRenderAudioBuffer(
+      render_audio_buffer, 1, render_audio_buffer->num_channels(),
+      &render_audio);
+  echo_canceller->ProcessRenderAudio(render_audio);
+
+  if (drift_compensation_enabled) {
+    static_cast<EchoCancellation*>(echo_canceller)
+        ->set_stream_drift_samples(stream_drift_samples);
+  }
+
+  echo_canceller->ProcessCaptureAudio(capture_audio_buffer, stream_delay_ms);
+
+  if (sample_rate_hz > AudioProcessing::kSampleRate16kHz) {
+    capture_audio_buffer->MergeFrequencyBands();
+  }
+}
+
+// Processes the APM test vectors and returns the output of all frames.
+std::vector<std::vector<float>> ProcessTestVectors(
+    int sample_rate_hz,
+    int stream_delay_ms,
+    bool drift_compensation_enabled,
+    int stream_drift_samples,
+    EchoCancellation::SuppressionLevel suppression_level) {
+  rtc::CriticalSection crit_capture;
+  EchoCancellationImpl echo_canceller(&crit_capture);
+  SetupComponent(sample_rate_hz, suppression_level, drift_compensation_enabled,
+                 &echo_canceller);
+
+  const int samples_per_channel = rtc::CheckedDivExact(sample_rate_hz, 100);
+  const StreamConfig render_config(sample_rate_hz, 1, false);
+  AudioBuffer render_buffer(
+      render_config.num_frames(), render_config.num_channels(),
+      render_config.num_frames(), 1, render_config.num_frames());
+  test::InputAudioFile render_file(
+      test::GetApmRenderTestVectorFileName(sample_rate_hz));
+  std::vector<float> render_input(samples_per_channel);
+
+  const StreamConfig capture_config(sample_rate_hz, 1, false);
+  AudioBuffer capture_buffer(
+      capture_config.num_frames(), capture_config.num_channels(),
+      capture_config.num_frames(), 1, capture_config.num_frames());
+  test::InputAudioFile capture_file(
+      test::GetApmCaptureTestVectorFileName(sample_rate_hz));
+  std::vector<float> capture_input(samples_per_channel);
+
+  std::vector<std::vector<float>> output(kNumFramesToProcess);
+  for (int frame_no = 0; frame_no < kNumFramesToProcess; ++frame_no) {
+    ReadFloatSamplesFromStereoFile(samples_per_channel, 1, &render_file,
+                                   render_input);
+    ReadFloatSamplesFromStereoFile(samples_per_channel, 1, &capture_file,
+                                   capture_input);
+
+    test::CopyVectorToAudioBuffer(render_config, render_input, &render_buffer);
+    test::CopyVectorToAudioBuffer(capture_config, capture_input,
+                                  &capture_buffer);
+
+    ProcessOneFrame(sample_rate_hz, stream_delay_ms, drift_compensation_enabled,
+                    stream_drift_samples, &render_buffer, &capture_buffer,
+                    &echo_canceller);
+
+    test::ExtractVectorFromAudioBuffer(capture_config, &capture_buffer,
+                                       &output[frame_no]);
+  }
+  return output;
+}
+
+// Verifies that the AVX2 code produces the same output as the SSE2 code. The
+// two are designed to be bit-exact, but the comparison uses the same error
+// bound as the bit-exactness tests against the reference output.
+void RunAvx2BitexactnessTest(
+    int sample_rate_hz,
+    int stream_delay_ms,
+    bool drift_compensation_enabled,
+    int stream_drift_samples,
+    EchoCancellation::SuppressionLevel suppression_level) {
+  if (!WebRtc_GetCPUInfo(kAVX2)) {
+    return;
+  }
+
+  std::vector<std::vector<float>> sse2_output;
+  {
+    ScopedDisableAvx2 disable_avx2;
+    sse2_output = ProcessTestVectors(sample_rate_hz, stream_delay_ms,
+                                     drift_compensation_enabled,
+                                     stream_drift_samples, suppression_level);
+  }
+  std::vector<std::vector<float>> avx2_output = ProcessTestVectors(
+      sample_rate_hz, stream_delay_ms, drift_compensation_enabled,
+      stream_drift_samples, suppression_level);
+
+  const StreamConfig capture_config(sample_rate_hz, 1, false);
+  const float kElementErrorBound = 1.0f / 32768.0f;
+  for (int frame_no = 0; frame_no < kNumFramesToProcess; ++frame_no) {
+    ASSERT_TRUE(test::VerifyDeinterleavedArray(
+        capture_config.num_frames(), capture_config.num_channels(),
+        sse2_output[frame_no], avx2_output[frame_no], kElementErrorBound))
+        << "frame " << frame_no;
+  }
+}
+
+void RunFftKernel(void (*kernel)(float*), const float* input, float* output) {
+  std::copy(input, input + 128, output);
+  kernel(output);
+}
+
+#endif  // defined(WEBRTC_ARCH_X86_FAMILY)
+
+}  // namespace
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+
+TEST(EchoCancellationAvx2Test, Mono8kHz_HighLevel_NoDrift_StreamDelay0) {
+  RunAvx2BitexactnessTest(8000, 0, false, 0,
+                          EchoCancellation::SuppressionLevel::kHighSuppression);
+}
+
+TEST(EchoCancellationAvx2Test, Mono16kHz_HighLevel_NoDrift_StreamDelay0) {
+  RunAvx2BitexactnessTest(16000, 0, false, 0,
+                          EchoCancellation::SuppressionLevel::kHighSuppression);
+}
+
+TEST(EchoCancellationAvx2Test, Mono32kHz_HighLevel_NoDrift_StreamDelay0) {
+  RunAvx2BitexactnessTest(32000, 0, false, 0,
+                          EchoCancellation::SuppressionLevel::kHighSuppression);
+}
+
+TEST(EchoCancellationAvx2Test, Mono48kHz_HighLevel_NoDrift_StreamDelay0) {
+  RunAvx2BitexactnessTest(48000, 0, false, 0,
+                          EchoCancellation::SuppressionLevel::kHighSuppression);
+}
+
+TEST(EchoCancellationAvx2Test, Mono16kHz_LowLevel_NoDrift_StreamDelay10) {
+  RunAvx2BitexactnessTest(16000, 10, false, 0,
+                          EchoCancellation::SuppressionLevel::kLowSuppression);
+}
+
+TEST(EchoCancellationAvx2Test, Mono16kHz_ModerateLevel_Drift5_StreamDelay0) {
+  RunAvx2BitexactnessTest(
+      16000, 0, true, 5,
+      EchoCancellation::SuppressionLevel::kModerateSuppression);
+}
+
+// The AVX2 FFT kernels must be bit-exact with the SSE2 kernels.
+TEST(OouraFftAvx2Test, KernelsBitExactWithSse2) {
+  if (!WebRtc_GetCPUInfo(kAVX2)) {
+    return;
+  }
+  struct {
+    void (*sse2)(float*);
+    void (*avx2)(float*);
+  } const kKernels[] = {{cft1st_128_SSE2, cft1st_128_AVX2},
+                        {cftmdl_128_SSE2, cftmdl_128_AVX2},
+                        {rftfsub_128_SSE2, rftfsub_128_AVX2},
+                        {rftbsub_128_SSE2, rftbsub_128_AVX2}};
+  Random random(42);
+  float input[128];
+  float sse2_output[128];
+  float avx2_output[128];
+  for (int trial = 0; trial < 20; ++trial) {
+    for (float& x : input) {
+      x = random.Gaussian(0, 1000);
+    }
+    for (const auto& kernel : kKernels) {
+      RunFftKernel(kernel.sse2, input, sse2_output);
+      RunFftKernel(kernel.avx2, input, avx2_output);
+      for (int i = 0; i < 128; ++i) {
+        ASSERT_EQ(sse2_output[i], avx2_output[i]) << "index " << i;
+      }
+    }
+  }
+}
+
+#endif  // defined(WEBRTC_ARCH_X86_FAMILY)
+
+}  // namespace webrtc
@@ -0,0 +1,156 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <math.h>
+
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "webrtc/base/random.h"
+#include "webrtc/modules/audio_processing/include/audio_processing.h"
+#include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+const size_t kNumFramesToProcess = 1000;
+
+class PerformanceTimer {
+ public:
+  PerformanceTimer() : clock_(webrtc::Clock::GetRealTimeClock()) {
+    timestamps_us_.reserve(kNumFramesToProcess);
+  }
+
+  void StartTimer() { start_timestamp_us_ = clock_->TimeInMicroseconds(); }
+  void StopTimer() {
+    timestamps_us_.push_back(clock_->TimeInMicroseconds() -
+                             start_timestamp_us_);
+  }
+
+  double GetDurationAverage() const {
+    RTC_DCHECK(!timestamps_us_.empty());
+    return static_cast<double>(std::accumulate(
+               timestamps_us_.begin(), timestamps_us_.end(), int64_t{0})) /
+           timestamps_us_.size();
+  }
+
+  double GetDurationStandardDeviation() const {
+    RTC_DCHECK(!timestamps_us_.empty());
+    const double average_duration = GetDurationAverage();
+    double variance = 0.0;
+    for (int64_t duration : timestamps_us_) {
+      variance += (duration - average_duration) * (duration - average_duration);
+    }
+    return sqrt(variance / timestamps_us_.size());
+  }
+
+ private:
+  webrtc::Clock* clock_;
+  int64_t start_timestamp_us_ = 0;
+  std::vector<int64_t> timestamps_us_;
+};
+
+std::string FormPerformanceMeasureString(const PerformanceTimer& timer) {
+  std::string s = std::to_string(timer.GetDurationAverage());
+  s += ", ";
+  s += std::to_string(timer.GetDurationStandardDeviation());
+  return s;
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+WebRtc_CPUInfo g_get_cpu_info = nullptr;
+
+int GetCPUInfoWithoutAvx2(CPUFeature feature) {
+  return feature == kAVX2 ? 0 : g_get_cpu_info(feature);
+}
+#endif
+
+// Runs the default desktop APM configuration, with the echo canceller using
+// either the AVX2 or the SSE2 code, and reports the capture call durations.
+void RunApm(int sample_rate_hz, bool use_avx2) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  g_get_cpu_info = WebRtc_GetCPUInfo;
+  if (!use_avx2) {
+    WebRtc_GetCPUInfo = GetCPUInfoWithoutAvx2;
+  }
+#endif
+  webrtc::Config config;
+  config.Set<ExtendedFilter>(new ExtendedFilter(true));
+  config.Set<DelayAgnostic>(new DelayAgnostic(true));
+  std::unique_ptr<AudioProcessing> apm(AudioProcessing::Create(config));
+  ASSERT_TRUE(apm.get());
+  ASSERT_EQ(AudioProcessing::kNoError, apm->echo_cancellation()->Enable(true));
+  ASSERT_EQ(AudioProcessing::kNoError, apm->noise_suppression()->Enable(true));
+  ASSERT_EQ(AudioProcessing::kNoError, apm->high_pass_filter()->Enable(true));
+  ASSERT_EQ(AudioProcessing::kNoError,
+            apm->gain_control()->set_mode(GainControl::kAdaptiveDigital));
+  ASSERT_EQ(AudioProcessing::kNoError, apm->gain_control()->Enable(true));
+
+  const StreamConfig stream_config(sample_rate_hz, 1, false);
+  ASSERT_EQ(AudioProcessing::kNoError,
+            apm->Initialize({stream_config, stream_config, stream_config,
+                             stream_config}));
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  WebRtc_GetCPUInfo = g_get_cpu_info;
+#endif
+
+  std::vector<float> render(stream_config.num_frames());
+  std::vector<float> capture(stream_config.num_frames());
+  float* render_channels[] = {render.data()};
+  float* capture_channels[] = {capture.data()};
+
+  Random rand_gen(42);
+  PerformanceTimer timer;
+  for (size_t frame_no = 0; frame_no < kNumFramesToProcess; ++frame_no) {
+    for (size_t k = 0; k < render.size(); ++k) {
+      render[k] = rand_gen.Gaussian(0, 0.1);
+      capture[k] = 0.5f * render[k] + rand_gen.Gaussian(0, 0.01);
+    }
+
+    ASSERT_EQ(AudioProcessing::kNoError,
+              apm->ProcessReverseStream(render_channels, stream_config,
+                                        stream_config, render_channels));
+    timer.StartTimer();
+    ASSERT_EQ(AudioProcessing::kNoError, apm->set_stream_delay_ms(0));
+    ASSERT_EQ(AudioProcessing::kNoError,
+              apm->ProcessStream(capture_channels, stream_config,
+                                 stream_config, capture_channels));
+    timer.StopTimer();
+  }
+  webrtc::test::PrintResultMeanAndError(
+      "echo_cancellation_call_durations",
+      "_" + std::to_string(sample_rate_hz) + "Hz",
+      use_avx2 ? "ApmWithAvx2" : "ApmWithSse2",
+      FormPerformanceMeasureString(timer), "us", false);
+}
+
+}  // namespace
+
+TEST(EchoCancellationPerformanceTest, Avx2ComparedToSse2) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (!WebRtc_GetCPUInfo(kAVX2)) {
+    return;
+  }
+  int sample_rates_to_test[] = {
+      AudioProcessing::kSampleRate16kHz, AudioProcessing::kSampleRate32kHz,
+      AudioProcessing::kSampleRate48kHz};
+  for (auto sample_rate : sample_rates_to_test) {
+    RunApm(sample_rate, false);
+    RunApm(sample_rate, true);
+  }
+#endif
+}
+
+}  // namespace webrtc
@@ -94,10 +94,8 @@ class EchoCancellationImpl::Canceller {
   void* state_;
 };
 
-EchoCancellationImpl::EchoCancellationImpl(rtc::CriticalSection* crit_render,
-                                           rtc::CriticalSection* crit_capture)
-    : crit_render_(crit_render),
-      crit_capture_(crit_capture),
+EchoCancellationImpl::EchoCancellationImpl(rtc::CriticalSection* crit_capture)
+    : crit_capture_(crit_capture),
       drift_compensation_enabled_(false),
       metrics_enabled_(false),
       suppression_level_(kModerateSuppression),
@@ -108,7 +106,6 @@ EchoCancellationImpl::EchoCancellationImpl(rtc::CriticalSection* crit_render,
       extended_filter_enabled_(false),
       delay_agnostic_enabled_(false),
       aec3_enabled_(false) {
-  RTC_DCHECK(crit_render);
   RTC_DCHECK(crit_capture);
 }
 
@@ -194,8 +191,6 @@ int EchoCancellationImpl::ProcessCaptureAudio(AudioBuffer* audio,
 }
 
 int EchoCancellationImpl::Enable(bool enable) {
-  // Run in a single-threaded manner.
-  rtc::CritScope cs_render(crit_render_);
   rtc::CritScope cs_capture(crit_capture_);
 
   if (enable && !enabled_) {
@@ -407,7 +402,6 @@ void EchoCancellationImpl::Initialize(int sample_rate_hz,
                                       size_t num_reverse_channels,
                                       size_t num_output_channels,
                                       size_t num_proc_channels) {
-  rtc::CritScope cs_render(crit_render_);
   rtc::CritScope cs_capture(crit_capture_);
 
   stream_properties_.reset(
@@ -479,7 +473,6 @@ void EchoCancellationImpl::SetExtraOptions(const webrtc::Config& config) {
 }
 
 int EchoCancellationImpl::Configure() {
-  rtc::CritScope cs_render(crit_render_);
   rtc::CritScope cs_capture(crit_capture_);
   AecConfig config;
   config.metricsMode = metrics_enabled_;
@@ -24,8 +24,10 @@ class AudioBuffer;
 
 class EchoCancellationImpl : public EchoCancellation {
  public:
-  EchoCancellationImpl(rtc::CriticalSection* crit_render,
-                       rtc::CriticalSection* crit_capture);
+  // The render side only reaches the cancellers through the render queue,
+  // which is emptied on the capture side, so all state is guarded by the
+  // capture lock.
+  explicit EchoCancellationImpl(rtc::CriticalSection* crit_capture);
   ~EchoCancellationImpl() override;
 
   void ProcessRenderAudio(rtc::ArrayView<const float> packed_render_audio);
@@ -91,7 +93,6 @@ class EchoCancellationImpl : public EchoCancellation {
   void AllocateRenderQueue();
   int Configure();
 
-  rtc::CriticalSection* const crit_render_ ACQUIRED_BEFORE(crit_capture_);
   rtc::CriticalSection* const crit_capture_;
 
   bool enabled_ = false;
@@ -108,14 +108,12 @@ class EchoControlMobileImpl::Canceller {
   RTC_DISALLOW_COPY_AND_ASSIGN(Canceller);
 };
 
-EchoControlMobileImpl::EchoControlMobileImpl(rtc::CriticalSection* crit_render,
-                                             rtc::CriticalSection* crit_capture)
-    : crit_render_(crit_render),
-      crit_capture_(crit_capture),
+EchoControlMobileImpl::EchoControlMobileImpl(
+    rtc::CriticalSection* crit_capture)
+    : crit_capture_(crit_capture),
       routing_mode_(kSpeakerphone),
       comfort_noise_enabled_(true),
       external_echo_path_(NULL) {
-  RTC_DCHECK(crit_render);
   RTC_DCHECK(crit_capture);
 }
 
@@ -229,7 +227,6 @@ int EchoControlMobileImpl::ProcessCaptureAudio(AudioBuffer* audio,
 
 int EchoControlMobileImpl::Enable(bool enable) {
   // Ensure AEC and AECM are not both enabled.
-  rtc::CritScope cs_render(crit_render_);
   rtc::CritScope cs_capture(crit_capture_);
   RTC_DCHECK(stream_properties_);
 
@@ -291,7 +288,6 @@ bool EchoControlMobileImpl::is_comfort_noise_enabled() const {
 int EchoControlMobileImpl::SetEchoPath(const void* echo_path,
                                        size_t size_bytes) {
   {
-    rtc::CritScope cs_render(crit_render_);
     rtc::CritScope cs_capture(crit_capture_);
     if (echo_path == NULL) {
       return AudioProcessing::kNullPointerError;
@@ -343,7 +339,6 @@ int EchoControlMobileImpl::GetEchoPath(void* echo_path,
 void EchoControlMobileImpl::Initialize(int sample_rate_hz,
                                        size_t num_reverse_channels,
                                        size_t num_output_channels) {
-  rtc::CritScope cs_render(crit_render_);
   rtc::CritScope cs_capture(crit_capture_);
 
   stream_properties_.reset(new StreamProperties(
@@ -373,7 +368,6 @@ void EchoControlMobileImpl::Initialize(int sample_rate_hz,
 }
 
 int EchoControlMobileImpl::Configure() {
-  rtc::CritScope cs_render(crit_render_);
   rtc::CritScope cs_capture(crit_capture_);
   AecmConfig config;
   config.cngMode = comfort_noise_enabled_;
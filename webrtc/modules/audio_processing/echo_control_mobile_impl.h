@@ -26,8 +26,8 @@ class AudioBuffer;
 
 class EchoControlMobileImpl : public EchoControlMobile {
  public:
-  EchoControlMobileImpl(rtc::CriticalSection* crit_render,
-                        rtc::CriticalSection* crit_capture);
+  // As for EchoCancellationImpl, all state is guarded by the capture lock.
+  explicit EchoControlMobileImpl(rtc::CriticalSection* crit_capture);
 
   ~EchoControlMobileImpl() override;
 
@@ -64,15 +64,13 @@ class EchoControlMobileImpl : public EchoControlMobile {
 
   int Configure();
 
-  rtc::CriticalSection* const crit_render_ ACQUIRED_BEFORE(crit_capture_);
   rtc::CriticalSection* const crit_capture_;
 
   bool enabled_ = false;
 
   RoutingMode routing_mode_ GUARDED_BY(crit_capture_);
   bool comfort_noise_enabled_ GUARDED_BY(crit_capture_);
-  unsigned char* external_echo_path_ GUARDED_BY(crit_render_)
-      GUARDED_BY(crit_capture_);
+  unsigned char* external_echo_path_ GUARDED_BY(crit_capture_);
 
   std::vector<std::unique_ptr<Canceller>> cancellers_;
   std::unique_ptr<StreamProperties> stream_properties_;
@@ -7,6 +7,8 @@
  *  in the file PATENTS.  All contributing project authors may
  *  be found in the AUTHORS file in the root of the source tree.
  */
+#include <math.h>
+
 #include <vector>
 
 #include "webrtc/base/array_view.h"
@@ -438,4 +440,40 @@ TEST(GainControlBitExactnessTest,
                       kOutputReference);
 }
 
+// The APM never calls WebRtcSpl_Init(), so the legacy AGC must work without
+// it, also in the adaptive analog mode where it analyzes the microphone
+// signal in WebRtcAgc_AddMic().
+TEST(GainControlTest, AdaptiveAnalogWorksWithoutSplInit) {
+  const int kSampleRateHz = 16000;
+  const int kAnalogLevelMin = 0;
+  const int kAnalogLevelMax = 255;
+  rtc::CriticalSection crit_render;
+  rtc::CriticalSection crit_capture;
+  GainControlImpl gain_controller(&crit_render, &crit_capture);
+  SetupComponent(kSampleRateHz, GainControl::Mode::kAdaptiveAnalog, 3, 128, 9,
+                 true, kAnalogLevelMin, kAnalogLevelMax, &gain_controller);
+
+  const StreamConfig config(kSampleRateHz, 1, false);
+  AudioBuffer render_buffer(config.num_frames(), config.num_channels(),
+                            config.num_frames(), 1, config.num_frames());
+  AudioBuffer capture_buffer(config.num_frames(), config.num_channels(),
+                             config.num_frames(), 1, config.num_frames());
+  std::vector<float> input(config.num_frames());
+  GainControl* gc = static_cast<GainControl*>(&gain_controller);
+  for (int frame_no = 0; frame_no < kNumFramesToProcess; ++frame_no) {
+    // A quiet tone, which the AGC should try to raise.
+    for (size_t i = 0; i < input.size(); ++i) {
+      const size_t t = frame_no * input.size() + i;
+      input[i] = 0.01f * sinf(2.f * 3.14159265f * 440.f * t / kSampleRateHz);
+    }
+    test::CopyVectorToAudioBuffer(config, input, &render_buffer);
+    test::CopyVectorToAudioBuffer(config, input, &capture_buffer);
+    ProcessOneFrame(kSampleRateHz, &render_buffer, &capture_buffer,
+                    &gain_controller);
+    gc->set_stream_analog_level(gc->stream_analog_level());
+  }
+  EXPECT_GE(gc->stream_analog_level(), kAnalogLevelMin);
+  EXPECT_LE(gc->stream_analog_level(), kAnalogLevelMax);
+}
+
 }  // namespace webrtc
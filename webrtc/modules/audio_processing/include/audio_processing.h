@@ -134,6 +134,19 @@ struct ExperimentalNs {
   bool enabled;
 };
 
+// Use to enable the vectorized implementation of the floating point noise
+// suppression. It uses fast approximations of log and exp and is therefore not
+// bit-exact with the reference implementation. Only has an effect on x86 with
+// SSE2 support. It can be set in the constructor or using
+// AudioProcessing::SetExtraOptions().
+struct NoiseSuppressionFastMath {
+  NoiseSuppressionFastMath() : enabled(false) {}
+  explicit NoiseSuppressionFastMath(bool enabled) : enabled(enabled) {}
+  static const ConfigOptionID identifier =
+      ConfigOptionID::kNoiseSuppressionFastMath;
+  bool enabled;
+};
+
 // Use to enable beamforming. Must be provided through the constructor. It will
 // have no impact if used with AudioProcessing::SetExtraOptions().
 struct Beamforming {
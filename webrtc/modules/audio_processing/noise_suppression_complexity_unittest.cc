@@ -0,0 +1,137 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <math.h>
+
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/random.h"
+#include "webrtc/modules/audio_processing/audio_buffer.h"
+#include "webrtc/modules/audio_processing/include/audio_processing.h"
+#include "webrtc/modules/audio_processing/noise_suppression_impl.h"
+#include "webrtc/modules/audio_processing/test/audio_buffer_tools.h"
+#include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+const size_t kNumFramesToProcess = 500;
+
+class SubmodulePerformanceTimer {
+ public:
+  SubmodulePerformanceTimer() : clock_(webrtc::Clock::GetRealTimeClock()) {
+    timestamps_us_.reserve(kNumFramesToProcess);
+  }
+
+  void StartTimer() { start_timestamp_us_ = clock_->TimeInMicroseconds(); }
+  void StopTimer() {
+    timestamps_us_.push_back(clock_->TimeInMicroseconds() -
+                             start_timestamp_us_);
+  }
+
+  double GetDurationAverage() const {
+    RTC_DCHECK(!timestamps_us_.empty());
+    return static_cast<double>(std::accumulate(
+               timestamps_us_.begin(), timestamps_us_.end(), int64_t{0})) /
+           timestamps_us_.size();
+  }
+
+  double GetDurationStandardDeviation() const {
+    RTC_DCHECK(!timestamps_us_.empty());
+    const double average_duration = GetDurationAverage();
+    double variance = 0.0;
+    for (int64_t duration : timestamps_us_) {
+      variance += (duration - average_duration) * (duration - average_duration);
+    }
+    return sqrt(variance / timestamps_us_.size());
+  }
+
+ private:
+  webrtc::Clock* clock_;
+  int64_t start_timestamp_us_ = 0;
+  std::vector<int64_t> timestamps_us_;
+};
+
+std::string FormPerformanceMeasureString(
+    const SubmodulePerformanceTimer& timer) {
+  std::string s = std::to_string(timer.GetDurationAverage());
+  s += ", ";
+  s += std::to_string(timer.GetDurationStandardDeviation());
+  return s;
+}
+
+void RunStandaloneSubmodule(int sample_rate_hz,
+                            size_t num_channels,
+                            bool fast_math) {
+  rtc::CriticalSection crit_capture;
+  NoiseSuppressionImpl noise_suppressor(&crit_capture);
+  webrtc::Config config;
+  config.Set<NoiseSuppressionFastMath>(new NoiseSuppressionFastMath(fast_math));
+  noise_suppressor.SetExtraOptions(config);
+  noise_suppressor.Initialize(num_channels, sample_rate_hz);
+  noise_suppressor.Enable(true);
+  noise_suppressor.set_level(NoiseSuppression::kHigh);
+
+  const StreamConfig capture_config(sample_rate_hz, num_channels, false);
+  AudioBuffer capture_buffer(
+      capture_config.num_frames(), capture_config.num_channels(),
+      capture_config.num_frames(), capture_config.num_channels(),
+      capture_config.num_frames());
+  std::vector<float> capture_input(capture_config.num_samples());
+
+  Random rand_gen(42);
+  SubmodulePerformanceTimer timer;
+  for (size_t frame_no = 0; frame_no < kNumFramesToProcess; ++frame_no) {
+    for (auto& v : capture_input) {
+      v = rand_gen.Gaussian(0, 1000);
+    }
+    test::CopyVectorToAudioBuffer(capture_config, capture_input,
+                                  &capture_buffer);
+
+    timer.StartTimer();
+    if (sample_rate_hz > AudioProcessing::kSampleRate16kHz) {
+      capture_buffer.SplitIntoFrequencyBands();
+    }
+    noise_suppressor.AnalyzeCaptureAudio(&capture_buffer);
+    noise_suppressor.ProcessCaptureAudio(&capture_buffer);
+    if (sample_rate_hz > AudioProcessing::kSampleRate16kHz) {
+      capture_buffer.MergeFrequencyBands();
+    }
+    timer.StopTimer();
+  }
+  webrtc::test::PrintResultMeanAndError(
+      "noise_suppression_call_durations",
+      "_" + std::to_string(sample_rate_hz) + "Hz_" +
+          std::to_string(num_channels) + "_channels",
+      fast_math ? "StandaloneNoiseSuppressionFastMath"
+                : "StandaloneNoiseSuppression",
+      FormPerformanceMeasureString(timer), "us", false);
+}
+
+}  // namespace
+
+TEST(NoiseSuppressionPerformanceTest, StandaloneProcessing) {
+  int sample_rates_to_test[] = {
+      AudioProcessing::kSampleRate8kHz, AudioProcessing::kSampleRate16kHz,
+      AudioProcessing::kSampleRate32kHz, AudioProcessing::kSampleRate48kHz};
+  for (auto sample_rate : sample_rates_to_test) {
+    for (size_t num_channels = 1; num_channels <= 2; ++num_channels) {
+      RunStandaloneSubmodule(sample_rate, num_channels, false);
+      RunStandaloneSubmodule(sample_rate, num_channels, true);
+    }
+  }
+}
+
+}  // namespace webrtc
@@ -66,6 +66,12 @@ void NoiseSuppressionImpl::Initialize(size_t channels, int sample_rate_hz) {
   }
   suppressors_.swap(new_suppressors);
   set_level(level_);
+#if defined(WEBRTC_NS_FLOAT)
+  for (auto& suppressor : suppressors_) {
+    int error = WebRtcNs_set_fast_math(suppressor->state(), fast_math_enabled_);
+    RTC_DCHECK_EQ(0, error);
+  }
+#endif
 }
 
 void NoiseSuppressionImpl::AnalyzeCaptureAudio(AudioBuffer* audio) {
@@ -109,6 +115,17 @@ void NoiseSuppressionImpl::ProcessCaptureAudio(AudioBuffer* audio) {
   }
 }
 
+void NoiseSuppressionImpl::SetExtraOptions(const webrtc::Config& config) {
+  rtc::CritScope cs(crit_);
+  fast_math_enabled_ = config.Get<NoiseSuppressionFastMath>().enabled;
+#if defined(WEBRTC_NS_FLOAT)
+  for (auto& suppressor : suppressors_) {
+    int error = WebRtcNs_set_fast_math(suppressor->state(), fast_math_enabled_);
+    RTC_DCHECK_EQ(0, error);
+  }
+#endif
+}
+
 int NoiseSuppressionImpl::Enable(bool enable) {
   rtc::CritScope cs(crit_);
   if (enabled_ != enable) {
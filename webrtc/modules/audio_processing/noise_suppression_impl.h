@@ -31,6 +31,7 @@ class NoiseSuppressionImpl : public NoiseSuppression {
   void Initialize(size_t channels, int sample_rate_hz);
   void AnalyzeCaptureAudio(AudioBuffer* audio);
   void ProcessCaptureAudio(AudioBuffer* audio);
+  void SetExtraOptions(const webrtc::Config& config);
 
   // NoiseSuppression implementation.
   int Enable(bool enable) override;
@@ -46,6 +47,7 @@ class NoiseSuppressionImpl : public NoiseSuppression {
   rtc::CriticalSection* const crit_;
   bool enabled_ GUARDED_BY(crit_) = false;
   Level level_ GUARDED_BY(crit_) = kModerate;
+  bool fast_math_enabled_ GUARDED_BY(crit_) = false;
   size_t channels_ GUARDED_BY(crit_) = 0;
   int sample_rate_hz_ GUARDED_BY(crit_) = 0;
   std::vector<std::unique_ptr<Suppressor>> suppressors_ GUARDED_BY(crit_);
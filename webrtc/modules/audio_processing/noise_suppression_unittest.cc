@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "webrtc/base/array_view.h"
+#include "webrtc/modules/audio_processing/include/config.h"
 #include "webrtc/modules/audio_processing/audio_buffer.h"
 #include "webrtc/modules/audio_processing/noise_suppression_impl.h"
 #include "webrtc/modules/audio_processing/test/audio_buffer_tools.h"
@@ -92,8 +93,98 @@ void RunBitexactnessTest(int sample_rate_hz,
       output_reference, capture_output, kVectorElementErrorBound));
 }
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// Verifies that the output of the vectorized implementation, which uses
+// approximations of log and exp, stays close to the output of the reference
+// implementation.
+void RunFastMathAccuracyTest(int sample_rate_hz,
+                             size_t num_channels,
+                             NoiseSuppressionImpl::Level level) {
+  rtc::CriticalSection crit_capture;
+  NoiseSuppressionImpl reference_suppressor(&crit_capture);
+  NoiseSuppressionImpl fast_suppressor(&crit_capture);
+  webrtc::Config config;
+  config.Set<NoiseSuppressionFastMath>(new NoiseSuppressionFastMath(true));
+  fast_suppressor.SetExtraOptions(config);
+  for (NoiseSuppressionImpl* suppressor :
+       {&reference_suppressor, &fast_suppressor}) {
+    suppressor->Initialize(num_channels, sample_rate_hz);
+    suppressor->Enable(true);
+    suppressor->set_level(level);
+  }
+
+  int samples_per_channel = rtc::CheckedDivExact(sample_rate_hz, 100);
+  const StreamConfig capture_config(sample_rate_hz, num_channels, false);
+  AudioBuffer reference_buffer(
+      capture_config.num_frames(), capture_config.num_channels(),
+      capture_config.num_frames(), capture_config.num_channels(),
+      capture_config.num_frames());
+  AudioBuffer fast_buffer(
+      capture_config.num_frames(), capture_config.num_channels(),
+      capture_config.num_frames(), capture_config.num_channels(),
+      capture_config.num_frames());
+  test::InputAudioFile capture_file(
+      test::GetApmCaptureTestVectorFileName(sample_rate_hz));
+  std::vector<float> capture_input(samples_per_channel * num_channels);
+  std::vector<float> reference_output;
+  std::vector<float> fast_output;
+  double reference_energy = 0.0;
+  double error_energy = 0.0;
+  for (size_t frame_no = 0; frame_no < kNumFramesToProcess; ++frame_no) {
+    ReadFloatSamplesFromStereoFile(samples_per_channel, num_channels,
+                                   &capture_file, capture_input);
+
+    test::CopyVectorToAudioBuffer(capture_config, capture_input,
+                                  &reference_buffer);
+    test::CopyVectorToAudioBuffer(capture_config, capture_input, &fast_buffer);
+    ProcessOneFrame(sample_rate_hz, &reference_buffer, &reference_suppressor);
+    ProcessOneFrame(sample_rate_hz, &fast_buffer, &fast_suppressor);
+
+    test::ExtractVectorFromAudioBuffer(capture_config, &reference_buffer,
+                                       &reference_output);
+    test::ExtractVectorFromAudioBuffer(capture_config, &fast_buffer,
+                                       &fast_output);
+    for (size_t k = 0; k < reference_output.size(); ++k) {
+      const double error = fast_output[k] - reference_output[k];
+      reference_energy += reference_output[k] * reference_output[k];
+      error_energy += error * error;
+    }
+  }
+
+  // Require the deviation to be at least 40 dB below the output.
+  EXPECT_LT(error_energy, 1e-4 * reference_energy);
+  EXPECT_NEAR(reference_suppressor.speech_probability(),
+              fast_suppressor.speech_probability(), 0.01f);
+  const std::vector<float> reference_noise =
+      reference_suppressor.NoiseEstimate();
+  const std::vector<float> fast_noise = fast_suppressor.NoiseEstimate();
+  ASSERT_EQ(reference_noise.size(), fast_noise.size());
+  for (size_t k = 0; k < reference_noise.size(); ++k) {
+    EXPECT_NEAR(reference_noise[k], fast_noise[k], 0.01f * reference_noise[k]);
+  }
+}
+#endif
+
 }  // namespace
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+TEST(NoiseSuppresionFastMathTest, Mono8kHzModerate) {
+  RunFastMathAccuracyTest(8000, 1, NoiseSuppression::Level::kModerate);
+}
+
+TEST(NoiseSuppresionFastMathTest, Mono16kHzLow) {
+  RunFastMathAccuracyTest(16000, 1, NoiseSuppression::Level::kLow);
+}
+
+TEST(NoiseSuppresionFastMathTest, Mono16kHzVeryHigh) {
+  RunFastMathAccuracyTest(16000, 1, NoiseSuppression::Level::kVeryHigh);
+}
+
+TEST(NoiseSuppresionFastMathTest, Stereo48kHzHigh) {
+  RunFastMathAccuracyTest(48000, 2, NoiseSuppression::Level::kHigh);
+}
+#endif
+
 TEST(NoiseSuppresionBitExactnessTest, Mono8kHzLow) {
 #if defined(WEBRTC_ARCH_ARM64)
   const float kSpeechProbabilityReference = -4.0f;
@@ -35,6 +35,10 @@ int WebRtcNs_set_policy(NsHandle* NS_inst, int mode) {
   return WebRtcNs_set_policy_core((NoiseSuppressionC*)NS_inst, mode);
 }
 
+int WebRtcNs_set_fast_math(NsHandle* NS_inst, int enable) {
+  return WebRtcNs_set_fast_math_core((NoiseSuppressionC*)NS_inst, enable);
+}
+
 void WebRtcNs_Analyze(NsHandle* NS_inst, const float* spframe) {
   WebRtcNs_AnalyzeCore((NoiseSuppressionC*)NS_inst, spframe);
 }
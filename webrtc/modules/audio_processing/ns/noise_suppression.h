@@ -66,6 +66,24 @@ int WebRtcNs_Init(NsHandle* NS_inst, uint32_t fs);
  */
 int WebRtcNs_set_policy(NsHandle* NS_inst, int mode);
 
+/*
+ * This enables or disables the vectorized implementation, which uses fast
+ * approximations of log and exp and therefore is not bit-exact with the
+ * reference implementation. It is only available on x86 with SSE2 and is
+ * ignored elsewhere. Has to be called after WebRtcNs_Init().
+ *
+ * Input:
+ *      - NS_inst       : Noise suppression instance.
+ *      - enable        : 0: Disable, 1: Enable
+ *
+ * Output:
+ *      - NS_inst       : Updated instance.
+ *
+ * Return value         :  0 - Ok
+ *                        -1 - Error
+ */
+int WebRtcNs_set_fast_math(NsHandle* NS_inst, int enable);
+
 /*
  * This functions estimates the background noise for the inserted speech frame.
  * The input and output signals should always be 10ms (80 or 160 samples).
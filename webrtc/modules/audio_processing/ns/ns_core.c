@@ -18,6 +18,9 @@
 #include "webrtc/modules/audio_processing/ns/noise_suppression.h"
 #include "webrtc/modules/audio_processing/ns/ns_core.h"
 #include "webrtc/modules/audio_processing/ns/windows_private.h"
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
+#endif
 
 // Set Feature Extraction Parameters.
 static void set_feature_extraction_parameters(NoiseSuppressionC* self) {
@@ -208,24 +211,29 @@ int WebRtcNs_InitCore(NoiseSuppressionC* self, uint32_t fs) {
 
   // Default mode.
   WebRtcNs_set_policy_core(self, 0);
+  self->fastMath = 0;
 
   self->initFlag = 1;
   return 0;
 }
 
 // Estimate noise.
+// |lmagn| is the log of the signal magnitude spectrum estimate.
 static void NoiseEstimation(NoiseSuppressionC* self,
-                            float* magn,
+                            const float* lmagn,
                             float* noise) {
   size_t i, s, offset;
-  float lmagn[HALF_ANAL_BLOCKL], delta;
+  float delta;
 
-  if (self->updates < END_STARTUP_LONG) {
-    self->updates++;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (self->fastMath) {
+    WebRtcNs_NoiseEstimationSSE2(self, lmagn, noise);
+    return;
   }
+#endif
 
-  for (i = 0; i < self->magnLen; i++) {
-    lmagn[i] = (float)log(magn[i]);
+  if (self->updates < END_STARTUP_LONG) {
+    self->updates++;
   }
 
   // Loop over simultaneous estimates.
@@ -518,10 +526,11 @@ static void FeatureParameterExtraction(NoiseSuppressionC* self, int flag) {
 }
 
 // Compute spectral flatness on input spectrum.
-// |magnIn| is the magnitude spectrum.
+// |magnIn| is the magnitude spectrum and |lmagnIn| its log.
 // Spectral flatness is returned in self->featureData[0].
 static void ComputeSpectralFlatness(NoiseSuppressionC* self,
-                                    const float* magnIn) {
+                                    const float* magnIn,
+                                    const float* lmagnIn) {
   size_t i;
   size_t shiftLP = 1;  // Option to remove first bin(s) from spectral measures.
   float avgSpectralFlatnessNum, avgSpectralFlatnessDen, spectralTmp;
@@ -536,13 +545,22 @@ static void ComputeSpectralFlatness(NoiseSuppressionC* self,
   // Compute log of ratio of the geometric to arithmetic mean: check for log(0)
   // case.
   for (i = shiftLP; i < self->magnLen; i++) {
-    if (magnIn[i] > 0.0) {
-      avgSpectralFlatnessNum += (float)log(magnIn[i]);
-    } else {
+    if (magnIn[i] <= 0.0) {
       self->featureData[0] -= SPECT_FL_TAVG * self->featureData[0];
       return;
     }
   }
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (self->fastMath) {
+    avgSpectralFlatnessNum =
+        WebRtcNs_SumSSE2(&lmagnIn[shiftLP], self->magnLen - shiftLP);
+  } else
+#endif
+  {
+    for (i = shiftLP; i < self->magnLen; i++) {
+      avgSpectralFlatnessNum += lmagnIn[i];
+    }
+  }
   // Normalize.
   avgSpectralFlatnessDen = avgSpectralFlatnessDen / self->magnLen;
   avgSpectralFlatnessNum = avgSpectralFlatnessNum / self->magnLen;
@@ -570,6 +588,13 @@ static void ComputeSnr(const NoiseSuppressionC* self,
                        float* snrLocPost) {
   size_t i;
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (self->fastMath) {
+    WebRtcNs_ComputeSnrSSE2(self, magn, noise, snrLocPrior, snrLocPost);
+    return;
+  }
+#endif
+
   for (i = 0; i < self->magnLen; i++) {
     // Previous post SNR.
     // Previous estimate: based on previous frame with gain filter.
@@ -674,13 +699,21 @@ static void SpeechNoiseProb(NoiseSuppressionC* self,
   // Compute feature based on average LR factor.
   // This is the average over all frequencies of the smooth log LRT.
   logLrtTimeAvgKsum = 0.0;
-  for (i = 0; i < self->magnLen; i++) {
-    tmpFloat1 = 1.f + 2.f * snrLocPrior[i];
-    tmpFloat2 = 2.f * snrLocPrior[i] / (tmpFloat1 + 0.0001f);
-    besselTmp = (snrLocPost[i] + 1.f) * tmpFloat2;
-    self->logLrtTimeAvg[i] +=
-        LRT_TAVG * (besselTmp - (float)log(tmpFloat1) - self->logLrtTimeAvg[i]);
-    logLrtTimeAvgKsum += self->logLrtTimeAvg[i];
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (self->fastMath) {
+    logLrtTimeAvgKsum =
+        WebRtcNs_UpdateLogLrtSSE2(self, snrLocPrior, snrLocPost);
+  } else
+#endif
+  {
+    for (i = 0; i < self->magnLen; i++) {
+      tmpFloat1 = 1.f + 2.f * snrLocPrior[i];
+      tmpFloat2 = 2.f * snrLocPrior[i] / (tmpFloat1 + 0.0001f);
+      besselTmp = (snrLocPost[i] + 1.f) * tmpFloat2;
+      self->logLrtTimeAvg[i] += LRT_TAVG * (besselTmp - (float)log(tmpFloat1) -
+                                            self->logLrtTimeAvg[i]);
+      logLrtTimeAvgKsum += self->logLrtTimeAvg[i];
+    }
   }
   logLrtTimeAvgKsum = (float)logLrtTimeAvgKsum / (self->magnLen);
   self->featureData[3] = logLrtTimeAvgKsum;
@@ -742,6 +775,12 @@ static void SpeechNoiseProb(NoiseSuppressionC* self,
 
   // Final speech probability: combine prior model with LR factor:.
   gainPrior = (1.f - self->priorSpeechProb) / (self->priorSpeechProb + 0.0001f);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (self->fastMath) {
+    WebRtcNs_SpeechProbabilitySSE2(self, gainPrior, probSpeechFinal);
+    return;
+  }
+#endif
   for (i = 0; i < self->magnLen; i++) {
     invLrt = (float)exp(-self->logLrtTimeAvg[i]);
     invLrt = (float)gainPrior * invLrt;
@@ -752,12 +791,14 @@ static void SpeechNoiseProb(NoiseSuppressionC* self,
 // Update the noise features.
 // Inputs:
 //   * |magn| is the signal magnitude spectrum estimate.
+//   * |lmagn| is the log of the signal magnitude spectrum estimate.
 //   * |updateParsFlag| is an update flag for parameters.
 static void FeatureUpdate(NoiseSuppressionC* self,
                           const float* magn,
+                          const float* lmagn,
                           int updateParsFlag) {
   // Compute spectral flatness on input spectrum.
-  ComputeSpectralFlatness(self, magn);
+  ComputeSpectralFlatness(self, magn, lmagn);
   // Compute difference of input spectrum with learned/estimated noise spectrum.
   ComputeSpectralDifference(self, magn);
   // Compute histograms for parameter decisions (thresholds and weights for
@@ -810,6 +851,13 @@ static void UpdateNoiseEstimate(NoiseSuppressionC* self,
   float gammaNoiseOld;
   float noiseUpdateTmp;
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (self->fastMath) {
+    WebRtcNs_UpdateNoiseEstimateSSE2(self, magn, noise);
+    return;
+  }
+#endif
+
   for (i = 0; i < self->magnLen; i++) {
     probSpeech = self->speechProb[i];
     probNonSpeech = 1.f - probSpeech;
@@ -989,6 +1037,13 @@ static void ComputeDdBasedWienerFilter(const NoiseSuppressionC* self,
   size_t i;
   float snrPrior, previousEstimateStsa, currentEstimateStsa;
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (self->fastMath) {
+    WebRtcNs_ComputeDdBasedWienerFilterSSE2(self, magn, theFilter);
+    return;
+  }
+#endif
+
   for (i = 0; i < self->magnLen; i++) {
     // Previous estimate: based on previous frame with gain filter.
     previousEstimateStsa = self->magnPrevProcess[i] /
@@ -1041,6 +1096,19 @@ int WebRtcNs_set_policy_core(NoiseSuppressionC* self, int mode) {
   return 0;
 }
 
+int WebRtcNs_set_fast_math_core(NoiseSuppressionC* self, int enable) {
+  if (self == NULL) {
+    return -1;
+  }
+  self->fastMath = 0;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (enable && WebRtc_GetCPUInfo(kSSE2)) {
+    self->fastMath = 1;
+  }
+#endif
+  return 0;
+}
+
 void WebRtcNs_AnalyzeCore(NoiseSuppressionC* self, const float* speechFrame) {
   size_t i;
   const size_t kStartBand = 5;  // Skip first frequency bins during estimation.
@@ -1050,7 +1118,8 @@ void WebRtcNs_AnalyzeCore(NoiseSuppressionC* self, const float* speechFrame) {
   float sumMagn = 0.f;
   float tmpFloat1, tmpFloat2, tmpFloat3;
   float winData[ANAL_BLOCKL_MAX];
-  float magn[HALF_ANAL_BLOCKL], noise[HALF_ANAL_BLOCKL];
+  float magn[HALF_ANAL_BLOCKL], lmagn[HALF_ANAL_BLOCKL];
+  float noise[HALF_ANAL_BLOCKL];
   float snrLocPost[HALF_ANAL_BLOCKL], snrLocPrior[HALF_ANAL_BLOCKL];
   float real[ANAL_BLOCKL_MAX], imag[HALF_ANAL_BLOCKL];
   // Variables during startup.
@@ -1086,6 +1155,19 @@ void WebRtcNs_AnalyzeCore(NoiseSuppressionC* self, const float* speechFrame) {
 
   FFT(self, winData, self->anaLen, self->magnLen, real, imag, magn);
 
+  // The log magnitude spectrum is used by both the noise estimation and the
+  // spectral flatness feature.
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (self->fastMath) {
+    WebRtcNs_LogSSE2(magn, self->magnLen, lmagn);
+  } else
+#endif
+  {
+    for (i = 0; i < self->magnLen; i++) {
+      lmagn[i] = (float)log(magn[i]);
+    }
+  }
+
   for (i = 0; i < self->magnLen; i++) {
     signalEnergy += real[i] * real[i] + imag[i] * imag[i];
     sumMagn += magn[i];
@@ -1094,7 +1176,7 @@ void WebRtcNs_AnalyzeCore(NoiseSuppressionC* self, const float* speechFrame) {
         tmpFloat2 = logf((float)i);
         sum_log_i += tmpFloat2;
         sum_log_i_square += tmpFloat2 * tmpFloat2;
-        tmpFloat1 = logf(magn[i]);
+        tmpFloat1 = self->fastMath ? lmagn[i] : logf(magn[i]);
         sum_log_magn += tmpFloat1;
         sum_log_i_log_magn += tmpFloat2 * tmpFloat1;
       }
@@ -1105,7 +1187,7 @@ void WebRtcNs_AnalyzeCore(NoiseSuppressionC* self, const float* speechFrame) {
   self->sumMagn = sumMagn;
 
   // Quantile noise estimate.
-  NoiseEstimation(self, magn, noise);
+  NoiseEstimation(self, lmagn, noise);
   // Compute simplified noise model during startup.
   if (self->blockInd < END_STARTUP_SHORT) {
     // Estimate White noise.
@@ -1172,7 +1254,7 @@ void WebRtcNs_AnalyzeCore(NoiseSuppressionC* self, const float* speechFrame) {
   // Post and prior SNR needed for SpeechNoiseProb.
   ComputeSnr(self, magn, noise, snrLocPrior, snrLocPost);
 
-  FeatureUpdate(self, magn, updateParsFlag);
+  FeatureUpdate(self, magn, lmagn, updateParsFlag);
   SpeechNoiseProb(self, self->speechProb, snrLocPrior, snrLocPost);
   UpdateNoiseEstimate(self, magn, snrLocPrior, snrLocPost, noise);
 
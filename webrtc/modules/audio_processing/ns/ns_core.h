@@ -12,6 +12,7 @@
 #define WEBRTC_MODULES_AUDIO_PROCESSING_NS_NS_CORE_H_
 
 #include "webrtc/modules/audio_processing/ns/defines.h"
+#include "webrtc/typedefs.h"
 
 typedef struct NSParaExtract_ {
   // Bin size of histogram.
@@ -62,6 +63,9 @@ typedef struct NoiseSuppressionC_ {
   float syntBuf[ANAL_BLOCKL_MAX];
 
   int initFlag;
+  // Use the SSE2 kernels with approximated log and exp, see
+  // WebRtcNs_set_fast_math_core().
+  int fastMath;
   // Parameters for quantile noise estimation.
   float density[SIMULT * HALF_ANAL_BLOCKL];
   float lquantile[SIMULT * HALF_ANAL_BLOCKL];
@@ -151,6 +155,26 @@ int WebRtcNs_InitCore(NoiseSuppressionC* self, uint32_t fs);
  */
 int WebRtcNs_set_policy_core(NoiseSuppressionC* self, int mode);
 
+/****************************************************************************
+ * WebRtcNs_set_fast_math_core(...)
+ *
+ * Enables the vectorized versions of the per frequency bin computations. These
+ * use approximations of log and exp, so the output is not bit-exact with the
+ * reference implementation. Only available on x86 with SSE2; on other
+ * platforms the reference implementation is always used.
+ *
+ * Input:
+ *      - self          : Instance that should be updated
+ *      - enable        : 0: Reference implementation, 1: Fast implementation
+ *
+ * Output:
+ *      - self          : Updated instance
+ *
+ * Return value         :  0 - Ok
+ *                        -1 - Error
+ */
+int WebRtcNs_set_fast_math_core(NoiseSuppressionC* self, int enable);
+
 /****************************************************************************
  * WebRtcNs_AnalyzeCore
  *
@@ -184,6 +208,33 @@ void WebRtcNs_ProcessCore(NoiseSuppressionC* self,
                           size_t num_bands,
                           float* const* outFrame);
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// SSE2 versions of the per frequency bin computations, used when fastMath is
+// set. See ns_core_sse2.c.
+void WebRtcNs_LogSSE2(const float* in, size_t length, float* out);
+float WebRtcNs_SumSSE2(const float* in, size_t length);
+void WebRtcNs_NoiseEstimationSSE2(NoiseSuppressionC* self,
+                                  const float* lmagn,
+                                  float* noise);
+void WebRtcNs_ComputeSnrSSE2(const NoiseSuppressionC* self,
+                             const float* magn,
+                             const float* noise,
+                             float* snrLocPrior,
+                             float* snrLocPost);
+float WebRtcNs_UpdateLogLrtSSE2(NoiseSuppressionC* self,
+                                const float* snrLocPrior,
+                                const float* snrLocPost);
+void WebRtcNs_SpeechProbabilitySSE2(const NoiseSuppressionC* self,
+                                    float gainPrior,
+                                    float* probSpeechFinal);
+void WebRtcNs_UpdateNoiseEstimateSSE2(NoiseSuppressionC* self,
+                                      const float* magn,
+                                      float* noise);
+void WebRtcNs_ComputeDdBasedWienerFilterSSE2(const NoiseSuppressionC* self,
+                                             const float* magn,
+                                             float* theFilter);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,454 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// SSE2 versions of the per frequency bin loops of the float noise suppressor.
+// The log and exp functions are computed with polynomial approximations
+// (Cephes style, with a maximum relative error of a few ulps) on four bins at
+// a time, so the output is close to, but not bit-exact with, the output of the
+// generic implementation in ns_core.c.
+
+#include <emmintrin.h>
+#include <math.h>
+#include <string.h>
+
+#include "webrtc/modules/audio_processing/ns/ns_core.h"
+
+// Natural logarithm of four values. The input is assumed to be positive and
+// finite, which holds for all the quantities the noise suppressor takes the
+// logarithm of.
+static __m128 LogPs(__m128 x) {
+  const __m128 kOne = _mm_set1_ps(1.f);
+  const __m128 kHalf = _mm_set1_ps(0.5f);
+  const __m128 kSqrtHalf = _mm_set1_ps(0.707106781186547524f);
+  const __m128i kMantissaMask = _mm_set1_epi32(0x007fffff);
+  const __m128i kHalfExponent = _mm_set1_epi32(0x3f000000);
+  const __m128i kExponentBias = _mm_set1_epi32(0x7e);
+
+  // Split x into an exponent e and a mantissa m in [0.5, 1), i.e.,
+  // x = m * 2^e.
+  const __m128i x_bits = _mm_castps_si128(x);
+  __m128 e = _mm_cvtepi32_ps(
+      _mm_sub_epi32(_mm_srli_epi32(x_bits, 23), kExponentBias));
+  __m128 m = _mm_castsi128_ps(
+      _mm_or_si128(_mm_and_si128(x_bits, kMantissaMask), kHalfExponent));
+
+  // Shift the mantissa range to [sqrt(0.5), sqrt(2)) in order to center the
+  // polynomial approximation around one.
+  const __m128 below_sqrt_half = _mm_cmplt_ps(m, kSqrtHalf);
+  e = _mm_sub_ps(e, _mm_and_ps(kOne, below_sqrt_half));
+  m = _mm_add_ps(_mm_sub_ps(m, kOne), _mm_and_ps(m, below_sqrt_half));
+
+  const __m128 z = _mm_mul_ps(m, m);
+  __m128 y = _mm_set1_ps(7.0376836292e-2f);
+  y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(-1.1514610310e-1f));
+  y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(1.1676998740e-1f));
+  y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(-1.2420140846e-1f));
+  y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(1.4249322787e-1f));
+  y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(-1.6668057665e-1f));
+  y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(2.0000714765e-1f));
+  y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(-2.4999993993e-1f));
+  y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(3.3333331174e-1f));
+  y = _mm_mul_ps(_mm_mul_ps(y, m), z);
+
+  // log(2) is split into two parts for accuracy.
+  y = _mm_add_ps(y, _mm_mul_ps(e, _mm_set1_ps(-2.12194440e-4f)));
+  y = _mm_sub_ps(y, _mm_mul_ps(z, kHalf));
+  return _mm_add_ps(_mm_add_ps(m, y),
+                    _mm_mul_ps(e, _mm_set1_ps(0.693359375f)));
+}
+
+// Natural exponential of four values.
+static __m128 ExpPs(__m128 x) {
+  const __m128 kOne = _mm_set1_ps(1.f);
+
+  x = _mm_min_ps(x, _mm_set1_ps(88.3762626647949f));
+  x = _mm_max_ps(x, _mm_set1_ps(-88.3762626647949f));
+
+  // Express exp(x) as exp(r) * 2^n, with n = round(x / log(2)).
+  __m128 n = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(1.44269504088896341f)),
+                        _mm_set1_ps(0.5f));
+  __m128i n_int = _mm_cvttps_epi32(n);
+  const __m128 n_trunc = _mm_cvtepi32_ps(n_int);
+  // Truncation rounds towards zero, correct to floor for negative values.
+  const __m128 correction = _mm_and_ps(_mm_cmpgt_ps(n_trunc, n), kOne);
+  n = _mm_sub_ps(n_trunc, correction);
+  n_int = _mm_cvttps_epi32(n);
+
+  x = _mm_sub_ps(x, _mm_mul_ps(n, _mm_set1_ps(0.693359375f)));
+  x = _mm_sub_ps(x, _mm_mul_ps(n, _mm_set1_ps(-2.12194440e-4f)));
+
+  const __m128 z = _mm_mul_ps(x, x);
+  __m128 y = _mm_set1_ps(1.9875691500e-4f);
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.3981999507e-3f));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(8.3334519073e-3f));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(4.1665795894e-2f));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.6666665459e-1f));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(5.0000001201e-1f));
+  y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(y, z), x), kOne);
+
+  // Build 2^n.
+  const __m128 pow2n = _mm_castsi128_ps(
+      _mm_slli_epi32(_mm_add_epi32(n_int, _mm_set1_epi32(0x7f)), 23));
+  return _mm_mul_ps(y, pow2n);
+}
+
+static float LogFast(float x) {
+  return _mm_cvtss_f32(LogPs(_mm_set1_ps(x)));
+}
+
+static float ExpFast(float x) {
+  return _mm_cvtss_f32(ExpPs(_mm_set1_ps(x)));
+}
+
+static float HorizontalSum(__m128 x) {
+  x = _mm_add_ps(x, _mm_movehl_ps(x, x));
+  x = _mm_add_ss(x, _mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 1, 1, 1)));
+  return _mm_cvtss_f32(x);
+}
+
+void WebRtcNs_LogSSE2(const float* in, size_t length, float* out) {
+  size_t i;
+  for (i = 0; i + 4 <= length; i += 4) {
+    _mm_storeu_ps(&out[i], LogPs(_mm_loadu_ps(&in[i])));
+  }
+  for (; i < length; ++i) {
+    out[i] = LogFast(in[i]);
+  }
+}
+
+float WebRtcNs_SumSSE2(const float* in, size_t length) {
+  size_t i;
+  __m128 sum = _mm_setzero_ps();
+  float sum_scalar;
+  for (i = 0; i + 4 <= length; i += 4) {
+    sum = _mm_add_ps(sum, _mm_loadu_ps(&in[i]));
+  }
+  sum_scalar = HorizontalSum(sum);
+  for (; i < length; ++i) {
+    sum_scalar += in[i];
+  }
+  return sum_scalar;
+}
+
+void WebRtcNs_NoiseEstimationSSE2(NoiseSuppressionC* self,
+                                  const float* lmagn,
+                                  float* noise) {
+  size_t i, s, offset = 0;
+  const __m128 kOne = _mm_set1_ps(1.f);
+  const __m128 kFactor = _mm_set1_ps(FACTOR);
+  const __m128 kQuantile = _mm_set1_ps(QUANTILE);
+  const __m128 kOneMinusQuantile = _mm_set1_ps(1.f - QUANTILE);
+  const __m128 kWidth = _mm_set1_ps(WIDTH);
+  const __m128 kDensityIncrement = _mm_set1_ps(1.f / (2.f * WIDTH));
+  const __m128 kAbsMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+
+  if (self->updates < END_STARTUP_LONG) {
+    self->updates++;
+  }
+
+  // Loop over simultaneous estimates.
+  for (s = 0; s < SIMULT; s++) {
+    const float counter = (float)self->counter[s];
+    const float counter_plus_one = (float)(self->counter[s] + 1);
+    const __m128 counter_4 = _mm_set1_ps(counter);
+    const __m128 counter_plus_one_4 = _mm_set1_ps(counter_plus_one);
+    float* lquantile = &self->lquantile[s * self->magnLen];
+    float* density = &self->density[s * self->magnLen];
+    offset = s * self->magnLen;
+
+    for (i = 0; i + 4 <= self->magnLen; i += 4) {
+      const __m128 lmagn_4 = _mm_loadu_ps(&lmagn[i]);
+      __m128 lquantile_4 = _mm_loadu_ps(&lquantile[i]);
+      __m128 density_4 = _mm_loadu_ps(&density[i]);
+
+      // Compute delta.
+      const __m128 delta = _mm_or_ps(
+          _mm_and_ps(_mm_cmpgt_ps(density_4, kOne),
+                     _mm_div_ps(kFactor, density_4)),
+          _mm_andnot_ps(_mm_cmpgt_ps(density_4, kOne), kFactor));
+
+      // Update log quantile estimate.
+      const __m128 step_up =
+          _mm_div_ps(_mm_mul_ps(kQuantile, delta), counter_plus_one_4);
+      const __m128 step_down =
+          _mm_div_ps(_mm_mul_ps(kOneMinusQuantile, delta), counter_plus_one_4);
+      const __m128 above = _mm_cmpgt_ps(lmagn_4, lquantile_4);
+      lquantile_4 = _mm_or_ps(
+          _mm_and_ps(above, _mm_add_ps(lquantile_4, step_up)),
+          _mm_andnot_ps(above, _mm_sub_ps(lquantile_4, step_down)));
+
+      // Update density estimate.
+      const __m128 in_width = _mm_cmplt_ps(
+          _mm_and_ps(_mm_sub_ps(lmagn_4, lquantile_4), kAbsMask), kWidth);
+      const __m128 new_density = _mm_div_ps(
+          _mm_add_ps(_mm_mul_ps(counter_4, density_4), kDensityIncrement),
+          counter_plus_one_4);
+      density_4 = _mm_or_ps(_mm_and_ps(in_width, new_density),
+                            _mm_andnot_ps(in_width, density_4));
+
+      _mm_storeu_ps(&lquantile[i], lquantile_4);
+      _mm_storeu_ps(&density[i], density_4);
+    }
+    for (; i < self->magnLen; i++) {
+      const float delta =
+          density[i] > 1.f ? FACTOR * 1.f / density[i] : FACTOR;
+      if (lmagn[i] > lquantile[i]) {
+        lquantile[i] += QUANTILE * delta / counter_plus_one;
+      } else {
+        lquantile[i] -= (1.f - QUANTILE) * delta / counter_plus_one;
+      }
+      if (fabsf(lmagn[i] - lquantile[i]) < WIDTH) {
+        density[i] =
+            (counter * density[i] + 1.f / (2.f * WIDTH)) / counter_plus_one;
+      }
+    }
+
+    if (self->counter[s] >= END_STARTUP_LONG) {
+      self->counter[s] = 0;
+      if (self->updates >= END_STARTUP_LONG) {
+        for (i = 0; i + 4 <= self->magnLen; i += 4) {
+          _mm_storeu_ps(&self->quantile[i],
+                        ExpPs(_mm_loadu_ps(&lquantile[i])));
+        }
+        for (; i < self->magnLen; i++) {
+          self->quantile[i] = ExpFast(lquantile[i]);
+        }
+      }
+    }
+
+    self->counter[s]++;
+  }  // End loop over simultaneous estimates.
+
+  // Sequentially update the noise during startup.
+  if (self->updates < END_STARTUP_LONG) {
+    // Use the last "s" to get noise during startup that differ from zero.
+    for (i = 0; i + 4 <= self->magnLen; i += 4) {
+      _mm_storeu_ps(&self->quantile[i],
+                    ExpPs(_mm_loadu_ps(&self->lquantile[offset + i])));
+    }
+    for (; i < self->magnLen; i++) {
+      self->quantile[i] = ExpFast(self->lquantile[offset + i]);
+    }
+  }
+
+  memcpy(noise, self->quantile, sizeof(*noise) * self->magnLen);
+}
+
+void WebRtcNs_ComputeSnrSSE2(const NoiseSuppressionC* self,
+                             const float* magn,
+                             const float* noise,
+                             float* snrLocPrior,
+                             float* snrLocPost) {
+  size_t i;
+  const __m128 kOne = _mm_set1_ps(1.f);
+  const __m128 kEpsilon = _mm_set1_ps(0.0001f);
+  const __m128 kDdPrSnr = _mm_set1_ps(DD_PR_SNR);
+  const __m128 kOneMinusDdPrSnr = _mm_set1_ps(1.f - DD_PR_SNR);
+
+  for (i = 0; i + 4 <= self->magnLen; i += 4) {
+    const __m128 magn_4 = _mm_loadu_ps(&magn[i]);
+    const __m128 noise_4 = _mm_loadu_ps(&noise[i]);
+    // Previous estimate: based on previous frame with gain filter.
+    const __m128 previous_estimate_stsa = _mm_mul_ps(
+        _mm_div_ps(_mm_loadu_ps(&self->magnPrevAnalyze[i]),
+                   _mm_add_ps(_mm_loadu_ps(&self->noisePrev[i]), kEpsilon)),
+        _mm_loadu_ps(&self->smooth[i]));
+    // Post SNR.
+    const __m128 post = _mm_and_ps(
+        _mm_cmpgt_ps(magn_4, noise_4),
+        _mm_sub_ps(_mm_div_ps(magn_4, _mm_add_ps(noise_4, kEpsilon)), kOne));
+    // Directed decision update of snrPrior.
+    const __m128 prior =
+        _mm_add_ps(_mm_mul_ps(kDdPrSnr, previous_estimate_stsa),
+                   _mm_mul_ps(kOneMinusDdPrSnr, post));
+    _mm_storeu_ps(&snrLocPost[i], post);
+    _mm_storeu_ps(&snrLocPrior[i], prior);
+  }
+  for (; i < self->magnLen; i++) {
+    const float previousEstimateStsa = self->magnPrevAnalyze[i] /
+        (self->noisePrev[i] + 0.0001f) * self->smooth[i];
+    snrLocPost[i] = 0.f;
+    if (magn[i] > noise[i]) {
+      snrLocPost[i] = magn[i] / (noise[i] + 0.0001f) - 1.f;
+    }
+    snrLocPrior[i] =
+        DD_PR_SNR * previousEstimateStsa + (1.f - DD_PR_SNR) * snrLocPost[i];
+  }
+}
+
+float WebRtcNs_UpdateLogLrtSSE2(NoiseSuppressionC* self,
+                                const float* snrLocPrior,
+                                const float* snrLocPost) {
+  size_t i;
+  const __m128 kOne = _mm_set1_ps(1.f);
+  const __m128 kTwo = _mm_set1_ps(2.f);
+  const __m128 kEpsilon = _mm_set1_ps(0.0001f);
+  const __m128 kLrtTavg = _mm_set1_ps(LRT_TAVG);
+  __m128 sum = _mm_setzero_ps();
+  float sum_scalar;
+
+  for (i = 0; i + 4 <= self->magnLen; i += 4) {
+    const __m128 prior = _mm_loadu_ps(&snrLocPrior[i]);
+    const __m128 tmp1 = _mm_add_ps(kOne, _mm_mul_ps(kTwo, prior));
+    const __m128 tmp2 =
+        _mm_div_ps(_mm_mul_ps(kTwo, prior), _mm_add_ps(tmp1, kEpsilon));
+    const __m128 bessel =
+        _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(&snrLocPost[i]), kOne), tmp2);
+    __m128 lrt = _mm_loadu_ps(&self->logLrtTimeAvg[i]);
+    lrt = _mm_add_ps(
+        lrt, _mm_mul_ps(kLrtTavg,
+                        _mm_sub_ps(_mm_sub_ps(bessel, LogPs(tmp1)), lrt)));
+    _mm_storeu_ps(&self->logLrtTimeAvg[i], lrt);
+    sum = _mm_add_ps(sum, lrt);
+  }
+  sum_scalar = HorizontalSum(sum);
+  for (; i < self->magnLen; i++) {
+    const float tmpFloat1 = 1.f + 2.f * snrLocPrior[i];
+    const float tmpFloat2 = 2.f * snrLocPrior[i] / (tmpFloat1 + 0.0001f);
+    const float besselTmp = (snrLocPost[i] + 1.f) * tmpFloat2;
+    self->logLrtTimeAvg[i] += LRT_TAVG * (besselTmp - LogFast(tmpFloat1) -
+                                          self->logLrtTimeAvg[i]);
+    sum_scalar += self->logLrtTimeAvg[i];
+  }
+  return sum_scalar;
+}
+
+void WebRtcNs_SpeechProbabilitySSE2(const NoiseSuppressionC* self,
+                                    float gainPrior,
+                                    float* probSpeechFinal) {
+  size_t i;
+  const __m128 kOne = _mm_set1_ps(1.f);
+  const __m128 kSignMask = _mm_set1_ps(-0.f);
+  const __m128 gain_prior = _mm_set1_ps(gainPrior);
+
+  for (i = 0; i + 4 <= self->magnLen; i += 4) {
+    const __m128 inv_lrt = _mm_mul_ps(
+        gain_prior,
+        ExpPs(_mm_xor_ps(_mm_loadu_ps(&self->logLrtTimeAvg[i]), kSignMask)));
+    _mm_storeu_ps(&probSpeechFinal[i],
+                  _mm_div_ps(kOne, _mm_add_ps(kOne, inv_lrt)));
+  }
+  for (; i < self->magnLen; i++) {
+    const float invLrt = gainPrior * ExpFast(-self->logLrtTimeAvg[i]);
+    probSpeechFinal[i] = 1.f / (1.f + invLrt);
+  }
+}
+
+void WebRtcNs_UpdateNoiseEstimateSSE2(NoiseSuppressionC* self,
+                                      const float* magn,
+                                      float* noise) {
+  size_t i;
+  const __m128 kOne = _mm_set1_ps(1.f);
+  const __m128 kProbRange = _mm_set1_ps(PROB_RANGE);
+  const __m128 kNoiseUpdate = _mm_set1_ps(NOISE_UPDATE);
+  const __m128 kSpeechUpdate = _mm_set1_ps(SPEECH_UPDATE);
+  const __m128 kGammaPause = _mm_set1_ps(GAMMA_PAUSE);
+  // The time constant of the temporary noise update of a bin depends on the
+  // speech probability of the previous bin.
+  float previous_gamma = NOISE_UPDATE;
+
+  for (i = 0; i + 4 <= self->magnLen; i += 4) {
+    const __m128 prob_speech = _mm_loadu_ps(&self->speechProb[i]);
+    const __m128 prob_non_speech = _mm_sub_ps(kOne, prob_speech);
+    const __m128 magn_4 = _mm_loadu_ps(&magn[i]);
+    const __m128 noise_prev = _mm_loadu_ps(&self->noisePrev[i]);
+    const __m128 is_speech = _mm_cmpgt_ps(prob_speech, kProbRange);
+    const __m128 gamma = _mm_or_ps(_mm_and_ps(is_speech, kSpeechUpdate),
+                                   _mm_andnot_ps(is_speech, kNoiseUpdate));
+    // [previous_gamma, gamma[0], gamma[1], gamma[2]].
+    const __m128 gamma_prev = _mm_castsi128_ps(_mm_or_si128(
+        _mm_slli_si128(_mm_castps_si128(gamma), 4),
+        _mm_castps_si128(_mm_set_ss(previous_gamma))));
+    const __m128 mixed = _mm_add_ps(_mm_mul_ps(prob_non_speech, magn_4),
+                                    _mm_mul_ps(prob_speech, noise_prev));
+    // Temporary noise update.
+    const __m128 noise_update_tmp =
+        _mm_add_ps(_mm_mul_ps(gamma_prev, noise_prev),
+                   _mm_mul_ps(_mm_sub_ps(kOne, gamma_prev), mixed));
+    // Noise update. The downwards update is allowed in all bins since it is a
+    // no-op when the time-constant is unchanged.
+    const __m128 noise_update =
+        _mm_add_ps(_mm_mul_ps(gamma, noise_prev),
+                   _mm_mul_ps(_mm_sub_ps(kOne, gamma), mixed));
+    _mm_storeu_ps(&noise[i], _mm_min_ps(noise_update, noise_update_tmp));
+
+    // Conservative noise update.
+    const __m128 is_pause = _mm_cmplt_ps(prob_speech, kProbRange);
+    __m128 avg_pause = _mm_loadu_ps(&self->magnAvgPause[i]);
+    avg_pause = _mm_add_ps(
+        avg_pause,
+        _mm_and_ps(is_pause,
+                   _mm_mul_ps(kGammaPause, _mm_sub_ps(magn_4, avg_pause))));
+    _mm_storeu_ps(&self->magnAvgPause[i], avg_pause);
+
+    previous_gamma = self->speechProb[i + 3] > PROB_RANGE ? SPEECH_UPDATE
+                                                          : NOISE_UPDATE;
+  }
+  for (; i < self->magnLen; i++) {
+    const float probSpeech = self->speechProb[i];
+    const float probNonSpeech = 1.f - probSpeech;
+    const float gamma =
+        probSpeech > PROB_RANGE ? SPEECH_UPDATE : NOISE_UPDATE;
+    const float mixed =
+        probNonSpeech * magn[i] + probSpeech * self->noisePrev[i];
+    const float noiseUpdateTmp =
+        previous_gamma * self->noisePrev[i] + (1.f - previous_gamma) * mixed;
+    const float noiseUpdate =
+        gamma * self->noisePrev[i] + (1.f - gamma) * mixed;
+    noise[i] = noiseUpdate < noiseUpdateTmp ? noiseUpdate : noiseUpdateTmp;
+    if (probSpeech < PROB_RANGE) {
+      self->magnAvgPause[i] += GAMMA_PAUSE * (magn[i] - self->magnAvgPause[i]);
+    }
+    previous_gamma = gamma;
+  }
+}
+
+void WebRtcNs_ComputeDdBasedWienerFilterSSE2(const NoiseSuppressionC* self,
+                                             const float* magn,
+                                             float* theFilter) {
+  size_t i;
+  const __m128 kOne = _mm_set1_ps(1.f);
+  const __m128 kEpsilon = _mm_set1_ps(0.0001f);
+  const __m128 kDdPrSnr = _mm_set1_ps(DD_PR_SNR);
+  const __m128 kOneMinusDdPrSnr = _mm_set1_ps(1.f - DD_PR_SNR);
+  const __m128 overdrive = _mm_set1_ps(self->overdrive);
+
+  for (i = 0; i + 4 <= self->magnLen; i += 4) {
+    const __m128 magn_4 = _mm_loadu_ps(&magn[i]);
+    const __m128 noise_4 = _mm_loadu_ps(&self->noise[i]);
+    // Previous estimate: based on previous frame with gain filter.
+    const __m128 previous_estimate_stsa = _mm_mul_ps(
+        _mm_div_ps(_mm_loadu_ps(&self->magnPrevProcess[i]),
+                   _mm_add_ps(_mm_loadu_ps(&self->noisePrev[i]), kEpsilon)),
+        _mm_loadu_ps(&self->smooth[i]));
+    // Post and prior SNR.
+    const __m128 current_estimate_stsa = _mm_and_ps(
+        _mm_cmpgt_ps(magn_4, noise_4),
+        _mm_sub_ps(_mm_div_ps(magn_4, _mm_add_ps(noise_4, kEpsilon)), kOne));
+    const __m128 snr_prior =
+        _mm_add_ps(_mm_mul_ps(kDdPrSnr, previous_estimate_stsa),
+                   _mm_mul_ps(kOneMinusDdPrSnr, current_estimate_stsa));
+    // Gain filter.
+    _mm_storeu_ps(&theFilter[i],
+                  _mm_div_ps(snr_prior, _mm_add_ps(overdrive, snr_prior)));
+  }
+  for (; i < self->magnLen; i++) {
+    const float previousEstimateStsa = self->magnPrevProcess[i] /
+        (self->noisePrev[i] + 0.0001f) * self->smooth[i];
+    float currentEstimateStsa = 0.f;
+    float snrPrior;
+    if (magn[i] > self->noise[i]) {
+      currentEstimateStsa = magn[i] / (self->noise[i] + 0.0001f) - 1.f;
+    }
+    snrPrior = DD_PR_SNR * previousEstimateStsa +
+               (1.f - DD_PR_SNR) * currentEstimateStsa;
+    theFilter[i] = snrPrior / (self->overdrive + snrPrior);
+  }
+}
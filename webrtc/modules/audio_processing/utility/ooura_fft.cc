@@ -319,8 +319,10 @@ static void rftbsub_128_C(float* a) {
 OouraFft::OouraFft() {
 #if defined(WEBRTC_ARCH_X86_FAMILY)
   use_sse2_ = (WebRtc_GetCPUInfo(kSSE2) != 0);
+  use_avx2_ = (WebRtc_GetCPUInfo(kAVX2) != 0);
 #else
   use_sse2_ = false;
+  use_avx2_ = false;
 #endif
 }
 
@@ -349,7 +351,9 @@ void OouraFft::cft1st_128(float* a) const {
 #elif defined(WEBRTC_HAS_NEON)
   cft1st_128_neon(a);
 #elif defined(WEBRTC_ARCH_X86_FAMILY)
-  if (use_sse2_) {
+  if (use_avx2_) {
+    cft1st_128_AVX2(a);
+  } else if (use_sse2_) {
     cft1st_128_SSE2(a);
   } else {
     cft1st_128_C(a);
@@ -364,7 +368,9 @@ void OouraFft::cftmdl_128(float* a) const {
 #elif defined(WEBRTC_HAS_NEON)
   cftmdl_128_neon(a);
 #elif defined(WEBRTC_ARCH_X86_FAMILY)
-  if (use_sse2_) {
+  if (use_avx2_) {
+    cftmdl_128_AVX2(a);
+  } else if (use_sse2_) {
     cftmdl_128_SSE2(a);
   } else {
     cftmdl_128_C(a);
@@ -379,7 +385,9 @@ void OouraFft::rftfsub_128(float* a) const {
 #elif defined(WEBRTC_HAS_NEON)
   rftfsub_128_neon(a);
 #elif defined(WEBRTC_ARCH_X86_FAMILY)
-  if (use_sse2_) {
+  if (use_avx2_) {
+    rftfsub_128_AVX2(a);
+  } else if (use_sse2_) {
     rftfsub_128_SSE2(a);
   } else {
     rftfsub_128_C(a);
@@ -395,7 +403,9 @@ void OouraFft::rftbsub_128(float* a) const {
 #elif defined(WEBRTC_HAS_NEON)
   rftbsub_128_neon(a);
 #elif defined(WEBRTC_ARCH_X86_FAMILY)
-  if (use_sse2_) {
+  if (use_avx2_) {
+    rftbsub_128_AVX2(a);
+  } else if (use_sse2_) {
     rftbsub_128_SSE2(a);
   } else {
     rftbsub_128_C(a);
@@ -20,6 +20,10 @@ void cft1st_128_SSE2(float* a);
 void cftmdl_128_SSE2(float* a);
 void rftfsub_128_SSE2(float* a);
 void rftbsub_128_SSE2(float* a);
+void cft1st_128_AVX2(float* a);
+void cftmdl_128_AVX2(float* a);
+void rftfsub_128_AVX2(float* a);
+void rftbsub_128_AVX2(float* a);
 #endif
 
 #if defined(MIPS_FPU_LE)
@@ -53,6 +57,7 @@ class OouraFft {
   void cftbsub_128(float* a) const;
   void bitrv2_128(float* a) const;
   bool use_sse2_;
+  bool use_avx2_;
 };
 
 }  // namespace webrtc
@@ -44,24 +44,56 @@ bool PartialBlockDifference(const uint8_t* old_buffer,
   return false;
 }
 
-// Compares columns in the range of [|left|, |right|), in a row in the
-// range of [|top|, |top| + |height|), starts from |old_buffer| and
-// |new_buffer|, and outputs updated regions into |output|. |stride| is the
-// DesktopFrame::stride().
+// Finds the first and the last of |height| lines of |width_bytes| starting from
+// |old_buffer| and |new_buffer| which differ. Returns false if all lines are
+// equal. memcmp() exits on the first difference, so a line is only read in
+// full when it has not changed.
+bool FindDirtyLines(const uint8_t* old_buffer,
+                    const uint8_t* new_buffer,
+                    const int width_bytes,
+                    const int height,
+                    const int stride,
+                    int* const first_dirty_line,
+                    int* const last_dirty_line) {
+  int first = 0;
+  while (first < height && memcmp(old_buffer + first * stride,
+                                  new_buffer + first * stride,
+                                  width_bytes) == 0) {
+    first++;
+  }
+  if (first == height) {
+    return false;
+  }
+  int last = height - 1;
+  while (last > first && memcmp(old_buffer + last * stride,
+                                new_buffer + last * stride, width_bytes) == 0) {
+    last--;
+  }
+  *first_dirty_line = first;
+  *last_dirty_line = last;
+  return true;
+}
+
+// Compares columns in the range of [|left|, |right|), in |height| lines
+// starting from |old_buffer| and |new_buffer|, and outputs updated regions in
+// the row in the range of [|top|, |bottom|) into |output|. |height| may be
+// less than the row height if the other lines in the row are known to be
+// equal. |stride| is the DesktopFrame::stride().
 void CompareRow(const uint8_t* old_buffer,
                 const uint8_t* new_buffer,
                 const int left,
                 const int right,
                 const int top,
                 const int bottom,
+                const int height,
                 const int stride,
                 DesktopRegion* const output) {
   const int block_x_offset = kBlockSize * DesktopFrame::kBytesPerPixel;
   const int width = right - left;
-  const int height = bottom - top;
   const int block_count = (width - 1) / kBlockSize;
   const int last_block_width = width - block_count * kBlockSize;
   RTC_DCHECK(last_block_width <= kBlockSize && last_block_width > 0);
+  RTC_DCHECK(height > 0 && height <= bottom - top);
 
   // The first block-column in a continuous dirty area in current block-row.
   int first_dirty_x_block = -1;
@@ -108,7 +140,10 @@ void CompareRow(const uint8_t* old_buffer,
 }
 
 // Compares |rect| area in |old_frame| and |new_frame|, and outputs dirty
-// regions into |output|.
+// regions into |output|. Each block-row is first compared line by line, and
+// only the lines between the first and the last dirty one are compared block
+// by block. Unchanged block-rows, e.g. all rows outside of a text cursor or a
+// video, are skipped after the line comparison.
 void CompareFrames(const DesktopFrame& old_frame,
                    const DesktopFrame& new_frame,
                    DesktopRect rect,
@@ -125,19 +160,27 @@ void CompareFrames(const DesktopFrame& old_frame,
       old_frame.GetFrameDataAtPos(rect.top_left());
   const uint8_t* curr_block_row_start =
       new_frame.GetFrameDataAtPos(rect.top_left());
+  const int width_bytes = rect.width() * DesktopFrame::kBytesPerPixel;
 
   int top = rect.top();
-  // The last row may have a different height, so we handle it separately.
-  for (int y = 0; y < y_block_count; y++) {
-    CompareRow(prev_block_row_start, curr_block_row_start, rect.left(),
-               rect.right(), top, top + kBlockSize, old_frame.stride(), output);
+  // The last row may have a different height.
+  for (int y = 0; y <= y_block_count; y++) {
+    const int height = y < y_block_count ? kBlockSize : last_y_block_height;
+    int first_dirty_line;
+    int last_dirty_line;
+    if (FindDirtyLines(prev_block_row_start, curr_block_row_start, width_bytes,
+                       height, old_frame.stride(), &first_dirty_line,
+                       &last_dirty_line)) {
+      const int offset = first_dirty_line * old_frame.stride();
+      CompareRow(prev_block_row_start + offset, curr_block_row_start + offset,
+                 rect.left(), rect.right(), top, top + height,
+                 last_dirty_line - first_dirty_line + 1, old_frame.stride(),
+                 output);
+    }
     top += kBlockSize;
     prev_block_row_start += block_y_stride;
     curr_block_row_start += block_y_stride;
   }
-  CompareRow(prev_block_row_start, curr_block_row_start, rect.left(),
-             rect.right(), top, top + last_y_block_height, old_frame.stride(),
-             output);
 }
 
 }  // namespace
@@ -10,13 +10,19 @@
 
 #include "webrtc/modules/desktop_capture/desktop_capturer_differ_wrapper.h"
 
+#include <string.h>
+
+#include <algorithm>
 #include <initializer_list>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
 #include "webrtc/base/random.h"
 #include "webrtc/base/timeutils.h"
+#include "webrtc/modules/desktop_capture/desktop_frame.h"
+#include "webrtc/modules/desktop_capture/desktop_frame_generator.h"
 #include "webrtc/modules/desktop_capture/desktop_geometry.h"
 #include "webrtc/modules/desktop_capture/desktop_region.h"
 #include "webrtc/modules/desktop_capture/differ_block.h"
@@ -24,6 +30,7 @@
 #include "webrtc/modules/desktop_capture/mock_desktop_capturer_callback.h"
 #include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
 #include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/perf_test.h"
 #include "webrtc/typedefs.h"
 
 namespace webrtc {
@@ -222,6 +229,197 @@ void ExecuteDifferWrapperTest(bool with_hints,
   }
 }
 
+// Screen sharing workloads emulated by WorkloadDesktopFramePainter.
+enum class Workload {
+  // A glyph is typed on every frame.
+  TYPING,
+  // A large window scrolls by a few lines on every frame.
+  SCROLLING,
+  // Every pixel of a 720p video changes on every frame.
+  VIDEO,
+};
+
+// Paints a persistent screen into each frame, and changes a part of the
+// screen on every frame according to |workload|.
+class WorkloadDesktopFramePainter final : public DesktopFramePainter {
+ public:
+  WorkloadDesktopFramePainter(Workload workload, DesktopSize size)
+      : workload_(workload), screen_(size), random_(1234), frame_count_(0) {
+    uint32_t* pixels = reinterpret_cast<uint32_t*>(screen_.data());
+    for (int i = 0; i < size.width() * size.height(); i++) {
+      pixels[i] = random_.Rand<uint32_t>();
+    }
+  }
+
+  // The area changed by the last Paint() call.
+  const DesktopRect& changed_rect() const { return changed_rect_; }
+
+  // DesktopFramePainter interface.
+  bool Paint(DesktopFrame* frame, DesktopRegion* updated_region) override {
+    RTC_DCHECK(frame->size().equals(screen_.size()));
+    switch (workload_) {
+      case Workload::TYPING:
+        Type();
+        break;
+      case Workload::SCROLLING:
+        Scroll();
+        break;
+      case Workload::VIDEO:
+        PlayVideo();
+        break;
+    }
+    frame_count_++;
+    frame->CopyPixelsFrom(screen_, DesktopVector(),
+                          DesktopRect::MakeSize(screen_.size()));
+    updated_region->SetRect(changed_rect_);
+    return true;
+  }
+
+ private:
+  // Returns the rectangle of |width| x |height| at (|left|, |top|) clipped to
+  // the screen.
+  DesktopRect ClippedRect(int left, int top, int width, int height) const {
+    DesktopRect rect = DesktopRect::MakeXYWH(left, top, width, height);
+    rect.IntersectWith(DesktopRect::MakeSize(screen_.size()));
+    return rect;
+  }
+
+  void FillRandom(const DesktopRect& rect) {
+    for (int y = rect.top(); y < rect.bottom(); y++) {
+      uint32_t* row = reinterpret_cast<uint32_t*>(
+          screen_.GetFrameDataAtPos(DesktopVector(rect.left(), y)));
+      for (int x = 0; x < rect.width(); x++) {
+        row[x] = random_.Rand<uint32_t>();
+      }
+    }
+  }
+
+  void Type() {
+    const int kGlyphWidth = 10;
+    const int kGlyphHeight = 20;
+    const int kGlyphsPerLine = 80;
+    const int kLines = 30;
+    const int column = frame_count_ % kGlyphsPerLine;
+    const int line = frame_count_ / kGlyphsPerLine % kLines;
+    changed_rect_ = ClippedRect(100 + column * kGlyphWidth,
+                                100 + line * (kGlyphHeight + 4), kGlyphWidth,
+                                kGlyphHeight);
+    FillRandom(changed_rect_);
+  }
+
+  void Scroll() {
+    const int kScrollLines = 20;
+    changed_rect_ = ClippedRect(screen_.size().width() / 8,
+                                screen_.size().height() / 16,
+                                screen_.size().width() / 2,
+                                screen_.size().height() * 7 / 8);
+    const int width_bytes =
+        changed_rect_.width() * DesktopFrame::kBytesPerPixel;
+    for (int y = changed_rect_.top(); y < changed_rect_.bottom() - kScrollLines;
+         y++) {
+      memcpy(screen_.GetFrameDataAtPos(DesktopVector(changed_rect_.left(), y)),
+             screen_.GetFrameDataAtPos(
+                 DesktopVector(changed_rect_.left(), y + kScrollLines)),
+             width_bytes);
+    }
+    FillRandom(DesktopRect::MakeLTRB(
+        changed_rect_.left(),
+        std::max(changed_rect_.top(), changed_rect_.bottom() - kScrollLines),
+        changed_rect_.right(), changed_rect_.bottom()));
+  }
+
+  void PlayVideo() {
+    changed_rect_ = ClippedRect(200, 200, 1280, 720);
+    // Adding a different odd value to each pixel changes all of them.
+    const uint32_t delta = 2 * random_.Rand(1, 1 << 20) + 1;
+    for (int y = changed_rect_.top(); y < changed_rect_.bottom(); y++) {
+      uint32_t* row = reinterpret_cast<uint32_t*>(
+          screen_.GetFrameDataAtPos(DesktopVector(changed_rect_.left(), y)));
+      for (int x = 0; x < changed_rect_.width(); x++) {
+        row[x] += delta;
+      }
+    }
+  }
+
+  const Workload workload_;
+  BasicDesktopFrame screen_;
+  Random random_;
+  int frame_count_;
+  DesktopRect changed_rect_;
+};
+
+// Forwards to |generator| and measures the time spent in generating frames,
+// which is excluded from the measured capture time.
+class TimedDesktopFrameGenerator final : public DesktopFrameGenerator {
+ public:
+  explicit TimedDesktopFrameGenerator(DesktopFrameGenerator* generator)
+      : generator_(generator), generation_time_us_(0) {}
+
+  std::unique_ptr<DesktopFrame> GetNextFrame(
+      SharedMemoryFactory* factory) override {
+    int64_t started_us = rtc::TimeMicros();
+    std::unique_ptr<DesktopFrame> frame = generator_->GetNextFrame(factory);
+    generation_time_us_ += rtc::TimeMicros() - started_us;
+    return frame;
+  }
+
+  int64_t generation_time_us() const { return generation_time_us_; }
+
+ private:
+  DesktopFrameGenerator* const generator_;
+  int64_t generation_time_us_;
+};
+
+// Captures |frame_count| frames of |workload| on a screen of |size|, without
+// updated region hints, so every frame is compared in full. Checks the
+// updated_region() of each frame if |check_result| is true, and returns the
+// average time per frame spent in DesktopCapturerDifferWrapper.
+int64_t ExecuteWorkload(Workload workload,
+                        DesktopSize size,
+                        int frame_count,
+                        bool check_result) {
+  WorkloadDesktopFramePainter frame_painter(workload, size);
+  PainterDesktopFrameGenerator painter_generator;
+  painter_generator.set_desktop_frame_painter(&frame_painter);
+  *painter_generator.size() = size;
+  TimedDesktopFrameGenerator frame_generator(&painter_generator);
+  std::unique_ptr<FakeDesktopCapturer<>> fake(new FakeDesktopCapturer<>());
+  fake->set_frame_generator(&frame_generator);
+  DesktopCapturerDifferWrapper capturer(std::move(fake));
+  MockDesktopCapturerCallback callback;
+  capturer.Start(&callback);
+
+  // The first frame is always fully updated.
+  ExecuteCapturer(&capturer, &callback);
+
+  const int64_t started_us = rtc::TimeMicros();
+  const int64_t generation_time_us = frame_generator.generation_time_us();
+  for (int i = 0; i < frame_count; i++) {
+    EXPECT_CALL(callback, OnCaptureResultPtr(DesktopCapturer::Result::SUCCESS,
+                                             testing::_))
+        .Times(1)
+        .WillOnce(testing::Invoke([&frame_painter, check_result](
+            DesktopCapturer::Result result,
+            std::unique_ptr<DesktopFrame>* frame) {
+          if (check_result) {
+            AssertUpdatedRegionCovers(**frame,
+                                      {frame_painter.changed_rect()});
+          }
+        }));
+    capturer.CaptureFrame();
+  }
+  return (rtc::TimeMicros() - started_us -
+          (frame_generator.generation_time_us() - generation_time_us)) /
+         frame_count;
+}
+
+void ExecuteWorkloadPerf(Workload workload, const std::string& trace) {
+  const int64_t time_us =
+      ExecuteWorkload(workload, DesktopSize(3840, 2160), 100, false);
+  test::PrintResult("differ_wrapper_capture_time", "", trace,
+                    static_cast<size_t>(time_us), "us", false);
+}
+
 }  // namespace
 
 TEST(DesktopCapturerDifferWrapperTest, CaptureWithoutHints) {
@@ -244,6 +442,18 @@ TEST(DesktopCapturerDifferWrapperTest, CaptureWithEnlargedAndRandomHints) {
   ExecuteDifferWrapperTest(true, true, true, true);
 }
 
+TEST(DesktopCapturerDifferWrapperTest, CaptureTyping) {
+  ExecuteWorkload(Workload::TYPING, DesktopSize(1024, 768), 200, true);
+}
+
+TEST(DesktopCapturerDifferWrapperTest, CaptureScrolling) {
+  ExecuteWorkload(Workload::SCROLLING, DesktopSize(1024, 768), 20, true);
+}
+
+TEST(DesktopCapturerDifferWrapperTest, CaptureVideo) {
+  ExecuteWorkload(Workload::VIDEO, DesktopSize(1024, 768), 20, true);
+}
+
 // When hints are provided, DesktopCapturerDifferWrapper has a slightly better
 // performance in current configuration, but not so significant. Following is
 // one run result.
@@ -288,4 +498,18 @@ TEST(DesktopCapturerDifferWrapperTest,
   ASSERT_LE(rtc::TimeMillis() - started, 15000);
 }
 
+// Report the time DesktopCapturerDifferWrapper spends on each 4K frame of
+// typical screen sharing workloads, when the capturer provides no hints.
+TEST(DesktopCapturerDifferWrapperTest, DISABLED_CaptureTypingPerf) {
+  ExecuteWorkloadPerf(Workload::TYPING, "typing");
+}
+
+TEST(DesktopCapturerDifferWrapperTest, DISABLED_CaptureScrollingPerf) {
+  ExecuteWorkloadPerf(Workload::SCROLLING, "scrolling");
+}
+
+TEST(DesktopCapturerDifferWrapperTest, DISABLED_CaptureVideoPerf) {
+  ExecuteWorkloadPerf(Workload::VIDEO, "video");
+}
+
 }  // namespace webrtc
@@ -71,6 +71,22 @@ TEST(BlockDifferenceTestMid, BlockDifference) {
   }
 }
 
+// On AVX2 hosts, BlockDifference() compares the rows in pairs, and the last row
+// of an odd height is compared on its own.
+TEST(BlockDifferenceTestOddHeight, BlockDifference) {
+  uint8_t* block1;
+  uint8_t* block2;
+  PrepareBuffers(block1, block2);
+  const int stride = kBlockSize * kBytesPerPixel;
+  const int height = kBlockSize - 1;
+  // Change the last compared row, and a row which is not compared.
+  block2[stride * (height - 1) + 5] += 1;
+  block2[stride * height + 5] += 1;
+
+  EXPECT_TRUE(BlockDifference(block1, block2, height, stride));
+  EXPECT_FALSE(BlockDifference(block1, block2, height - 1, stride));
+}
+
 TEST(BlockDifferenceTestFirst, BlockDifference) {
   uint8_t* block1;
   uint8_t* block2;
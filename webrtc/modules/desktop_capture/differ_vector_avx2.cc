@@ -0,0 +1,66 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/desktop_capture/differ_vector_avx2.h"
+
+#include <immintrin.h>
+
+namespace webrtc {
+
+namespace {
+
+// Returns the bitwise difference of a vector of 32 pixels, which is 128 bytes
+// or four 256-bit registers.
+inline __m256i Difference_W32(const uint8_t* image1, const uint8_t* image2) {
+  const __m256i* i1 = reinterpret_cast<const __m256i*>(image1);
+  const __m256i* i2 = reinterpret_cast<const __m256i*>(image2);
+  __m256i v0 = _mm256_xor_si256(_mm256_loadu_si256(i1),
+                                _mm256_loadu_si256(i2));
+  __m256i v1 = _mm256_xor_si256(_mm256_loadu_si256(i1 + 1),
+                                _mm256_loadu_si256(i2 + 1));
+  __m256i v2 = _mm256_xor_si256(_mm256_loadu_si256(i1 + 2),
+                                _mm256_loadu_si256(i2 + 2));
+  __m256i v3 = _mm256_xor_si256(_mm256_loadu_si256(i1 + 3),
+                                _mm256_loadu_si256(i2 + 3));
+  return _mm256_or_si256(_mm256_or_si256(v0, v1), _mm256_or_si256(v2, v3));
+}
+
+}  // namespace
+
+extern bool VectorDifference_AVX2_W32(const uint8_t* image1,
+                                      const uint8_t* image2) {
+  __m256i diff = Difference_W32(image1, image2);
+  return !_mm256_testz_si256(diff, diff);
+}
+
+extern bool BlockDifference_AVX2_W32(const uint8_t* image1,
+                                     const uint8_t* image2,
+                                     int height,
+                                     int stride) {
+  // Two rows are checked per iteration, which still exits early on the first
+  // differing row pair but halves the number of branches.
+  int i = 0;
+  for (; i + 1 < height; i += 2) {
+    __m256i diff = _mm256_or_si256(
+        Difference_W32(image1, image2),
+        Difference_W32(image1 + stride, image2 + stride));
+    if (!_mm256_testz_si256(diff, diff)) {
+      return true;
+    }
+    image1 += stride * 2;
+    image2 += stride * 2;
+  }
+  if (i < height) {
+    return VectorDifference_AVX2_W32(image1, image2);
+  }
+  return false;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,120 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_RTP_RTCP_INCLUDE_ACTIVE_SPEAKER_DETECTOR_H_
+#define WEBRTC_MODULES_RTP_RTCP_INCLUDE_ACTIVE_SPEAKER_DETECTOR_H_
+
+#include <unordered_map>
+#include <vector>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/thread_annotations.h"
+#include "webrtc/modules/include/module.h"
+
+namespace webrtc {
+
+class Clock;
+struct RTPHeader;
+
+class ActiveSpeakerObserver {
+ public:
+  // Called from ActiveSpeakerDetector::Process() when the active speakers
+  // change. |ssrcs| holds the streams that are speaking, at most
+  // |max_active_speakers| of them, with the dominant speaker first and the
+  // others from the loudest to the quietest. It is empty when nobody speaks.
+  virtual void OnActiveSpeakersChanged(const std::vector<uint32_t>& ssrcs) = 0;
+
+ protected:
+  virtual ~ActiveSpeakerObserver() {}
+};
+
+// Ranks the received audio streams by loudness, using only the audio levels in
+// the RTP header extension of RFC 6464, so that no stream has to be decoded.
+// The cost per packet is a hash map update; the ranking is made once per
+// |update_interval_ms| in Process(), which makes it cheap enough to run on a
+// server receiving thousands of streams.
+//
+// The level of each stream is averaged per interval and smoothed over
+// intervals. A stream starts speaking when its smoothed level rises above
+// |speech_start_level_dbov|, and stops when it falls below
+// |speech_end_level_dbov|. Of the speaking streams, the loudest
+// |max_active_speakers| are active; a stream only displaces an active stream,
+// or the dominant speaker, if it is |switch_margin_db| louder. In addition,
+// the dominant speaker is kept for |min_time_between_switches_ms| after a
+// switch as long as it speaks.
+class ActiveSpeakerDetector : public Module {
+ public:
+  struct Config {
+    size_t max_active_speakers = 3;
+    int64_t update_interval_ms = 100;
+    // Weight of the level of the last interval in the smoothed level.
+    float smoothing_factor = 0.3f;
+    // Audio levels, in -dBov as in the header extension (0 is the loudest).
+    int speech_start_level_dbov = 50;
+    int speech_end_level_dbov = 60;
+    float switch_margin_db = 3.0f;
+    int64_t min_time_between_switches_ms = 1000;
+    // Streams without packets for this long are forgotten.
+    int64_t stream_timeout_ms = 5000;
+  };
+
+  ActiveSpeakerDetector(Clock* clock, ActiveSpeakerObserver* observer);
+  ActiveSpeakerDetector(Clock* clock,
+                        ActiveSpeakerObserver* observer,
+                        const Config& config);
+  ~ActiveSpeakerDetector() override;
+
+  // Takes the audio level of a received packet. Packets without the audio
+  // level extension are ignored. May be called on any thread.
+  void IncomingPacket(const RTPHeader& header);
+
+  // Forgets the stream |ssrc|, e.g., when its sender leaves. The change of the
+  // active speakers, if any, is reported at the next Process().
+  void RemoveStream(uint32_t ssrc);
+
+  // Returns the active speakers, as last reported to the observer.
+  std::vector<uint32_t> active_speakers() const;
+
+  // Implements Module.
+  int64_t TimeUntilNextProcess() override;
+  void Process() override;
+
+ private:
+  struct Stream {
+    int level_sum = 0;
+    int num_levels = 0;
+    // Smoothed loudness, 127 minus the level in -dBov.
+    float loudness = 0.0f;
+    bool speaking = false;
+    int64_t last_packet_ms = 0;
+  };
+
+  // Returns the loudness of |stream| with the bonus for staying active.
+  float RankingLoudness(uint32_t ssrc, const Stream& stream) const
+      EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  bool UpdateActiveSpeakers(int64_t now_ms) EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  Clock* const clock_;
+  ActiveSpeakerObserver* const observer_;
+  const Config config_;
+
+  rtc::CriticalSection crit_;
+  std::unordered_map<uint32_t, Stream> streams_ GUARDED_BY(crit_);
+  std::vector<uint32_t> active_speakers_ GUARDED_BY(crit_);
+  int64_t last_switch_time_ms_ GUARDED_BY(crit_);
+  int64_t last_process_time_ms_ GUARDED_BY(crit_);
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(ActiveSpeakerDetector);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_RTP_RTCP_INCLUDE_ACTIVE_SPEAKER_DETECTOR_H_
@@ -435,6 +435,10 @@ class RtpRtcp : public Module {
   // return -1 on failure else 0.
   virtual int32_t SetAudioLevel(uint8_t level_dbov) = 0;
 
+  // Forgets the stored audio level, so that the audio level header extension
+  // is left out of the following packets until SetAudioLevel() is called.
+  virtual void ClearAudioLevel() = 0;
+
   // **************************************************************************
   // Video
   // **************************************************************************
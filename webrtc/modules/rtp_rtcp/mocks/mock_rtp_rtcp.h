@@ -186,6 +186,7 @@ class MockRtpRtcp : public RtpRtcp {
   MOCK_METHOD2(SetRTPAudioLevelIndicationStatus,
                int32_t(bool enable, uint8_t id));
   MOCK_METHOD1(SetAudioLevel, int32_t(uint8_t level_dbov));
+  MOCK_METHOD0(ClearAudioLevel, void());
   MOCK_METHOD1(SetTargetSendBitrate, void(uint32_t bitrate_bps));
   MOCK_METHOD2(SetUlpfecConfig,
                void(int red_payload_type, int fec_payload_type));
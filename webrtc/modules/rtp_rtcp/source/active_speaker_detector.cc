@@ -0,0 +1,180 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/rtp_rtcp/include/active_speaker_detector.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "webrtc/base/checks.h"
+#include "webrtc/common_types.h"
+#include "webrtc/system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+namespace {
+// The lowest audio level of the header extension, -127 dBov, is digital
+// silence.
+const int kMaxAudioLevelDbov = 127;
+}  // namespace
+
+ActiveSpeakerDetector::ActiveSpeakerDetector(Clock* clock,
+                                             ActiveSpeakerObserver* observer)
+    : ActiveSpeakerDetector(clock, observer, Config()) {}
+
+ActiveSpeakerDetector::ActiveSpeakerDetector(Clock* clock,
+                                             ActiveSpeakerObserver* observer,
+                                             const Config& config)
+    : clock_(clock),
+      observer_(observer),
+      config_(config),
+      last_switch_time_ms_(0),
+      last_process_time_ms_(clock->TimeInMilliseconds()) {
+  RTC_DCHECK(observer_);
+  RTC_DCHECK_GT(config_.update_interval_ms, 0);
+  RTC_DCHECK_LE(config_.speech_start_level_dbov,
+                config_.speech_end_level_dbov);
+}
+
+ActiveSpeakerDetector::~ActiveSpeakerDetector() {}
+
+void ActiveSpeakerDetector::IncomingPacket(const RTPHeader& header) {
+  if (!header.extension.hasAudioLevel)
+    return;
+  const int64_t now_ms = clock_->TimeInMilliseconds();
+  rtc::CritScope lock(&crit_);
+  Stream& stream = streams_[header.ssrc];
+  stream.level_sum += header.extension.audioLevel & kMaxAudioLevelDbov;
+  ++stream.num_levels;
+  stream.last_packet_ms = now_ms;
+}
+
+void ActiveSpeakerDetector::RemoveStream(uint32_t ssrc) {
+  rtc::CritScope lock(&crit_);
+  streams_.erase(ssrc);
+}
+
+std::vector<uint32_t> ActiveSpeakerDetector::active_speakers() const {
+  rtc::CritScope lock(&crit_);
+  return active_speakers_;
+}
+
+int64_t ActiveSpeakerDetector::TimeUntilNextProcess() {
+  rtc::CritScope lock(&crit_);
+  return std::max<int64_t>(last_process_time_ms_ + config_.update_interval_ms -
+                               clock_->TimeInMilliseconds(),
+                           0);
+}
+
+void ActiveSpeakerDetector::Process() {
+  std::vector<uint32_t> active_speakers;
+  {
+    rtc::CritScope lock(&crit_);
+    const int64_t now_ms = clock_->TimeInMilliseconds();
+    last_process_time_ms_ = now_ms;
+    const float start_loudness =
+        kMaxAudioLevelDbov - config_.speech_start_level_dbov;
+    const float end_loudness =
+        kMaxAudioLevelDbov - config_.speech_end_level_dbov;
+    for (auto it = streams_.begin(); it != streams_.end();) {
+      Stream& stream = it->second;
+      if (now_ms - stream.last_packet_ms > config_.stream_timeout_ms) {
+        it = streams_.erase(it);
+        continue;
+      }
+      // An interval without packets (e.g., with DTX) counts as silence.
+      const float loudness =
+          stream.num_levels > 0
+              ? kMaxAudioLevelDbov -
+                    static_cast<float>(stream.level_sum) / stream.num_levels
+              : 0.0f;
+      stream.loudness += config_.smoothing_factor * (loudness - stream.loudness);
+      stream.level_sum = 0;
+      stream.num_levels = 0;
+      if (!stream.speaking && stream.loudness >= start_loudness) {
+        stream.speaking = true;
+      } else if (stream.speaking && stream.loudness < end_loudness) {
+        stream.speaking = false;
+      }
+      ++it;
+    }
+    if (!UpdateActiveSpeakers(now_ms))
+      return;
+    active_speakers = active_speakers_;
+  }
+  observer_->OnActiveSpeakersChanged(active_speakers);
+}
+
+float ActiveSpeakerDetector::RankingLoudness(uint32_t ssrc,
+                                             const Stream& stream) const {
+  const bool is_active =
+      std::find(active_speakers_.begin(), active_speakers_.end(), ssrc) !=
+      active_speakers_.end();
+  return stream.loudness + (is_active ? config_.switch_margin_db : 0.0f);
+}
+
+bool ActiveSpeakerDetector::UpdateActiveSpeakers(int64_t now_ms) {
+  // Rank the speaking streams, loudest first. Ties go to the lowest SSRC, to
+  // keep the ranking deterministic.
+  std::vector<std::pair<float, uint32_t>> candidates;
+  for (const auto& it : streams_) {
+    if (it.second.speaking)
+      candidates.push_back(
+          std::make_pair(RankingLoudness(it.first, it.second), it.first));
+  }
+  const size_t num_active =
+      std::min(config_.max_active_speakers, candidates.size());
+  std::partial_sort(candidates.begin(), candidates.begin() + num_active,
+                    candidates.end(),
+                    [](const std::pair<float, uint32_t>& a,
+                       const std::pair<float, uint32_t>& b) {
+                      return a.first > b.first ||
+                             (a.first == b.first && a.second < b.second);
+                    });
+  std::vector<uint32_t> active_speakers;
+  for (size_t i = 0; i < num_active; ++i)
+    active_speakers.push_back(candidates[i].second);
+
+  // Keep the dominant speaker in front, unless another active speaker is
+  // clearly louder and the dominant speaker has been kept long enough.
+  if (!active_speakers_.empty() && !active_speakers.empty()) {
+    const uint32_t dominant_ssrc = active_speakers_[0];
+    auto dominant = std::find(active_speakers.begin(), active_speakers.end(),
+                              dominant_ssrc);
+    if (dominant != active_speakers.end() &&
+        dominant != active_speakers.begin()) {
+      const bool hold = now_ms - last_switch_time_ms_ <
+                        config_.min_time_between_switches_ms;
+      const bool clearly_louder =
+          streams_[active_speakers[0]].loudness >=
+          streams_[dominant_ssrc].loudness + config_.switch_margin_db;
+      if (hold || !clearly_louder)
+        std::rotate(active_speakers.begin(), dominant, dominant + 1);
+    }
+  }
+
+  const bool dominant_changed =
+      active_speakers.empty() != active_speakers_.empty() ||
+      (!active_speakers.empty() && active_speakers[0] != active_speakers_[0]);
+  if (dominant_changed && !active_speakers.empty())
+    last_switch_time_ms_ = now_ms;
+  if (!dominant_changed &&
+      active_speakers.size() == active_speakers_.size() &&
+      std::is_permutation(active_speakers.begin(), active_speakers.end(),
+                          active_speakers_.begin())) {
+    // Only the order of the other active speakers changed, which is not
+    // worth a callback.
+    return false;
+  }
+  active_speakers_ = active_speakers;
+  return true;
+}
+
+}  // namespace webrtc
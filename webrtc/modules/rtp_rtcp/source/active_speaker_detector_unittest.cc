@@ -0,0 +1,179 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <vector>
+
+#include "webrtc/common_types.h"
+#include "webrtc/modules/rtp_rtcp/include/active_speaker_detector.h"
+#include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/test/gmock.h"
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::AtLeast;
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using ::testing::Mock;
+using ::testing::_;
+
+const uint32_t kSsrc1 = 1;
+const uint32_t kSsrc2 = 2;
+const uint32_t kSsrc3 = 3;
+const uint32_t kSsrc4 = 4;
+const int kSilenceDbov = 127;
+const int kPacketIntervalMs = 20;
+
+class MockActiveSpeakerObserver : public ActiveSpeakerObserver {
+ public:
+  MOCK_METHOD1(OnActiveSpeakersChanged,
+               void(const std::vector<uint32_t>& ssrcs));
+};
+
+class ActiveSpeakerDetectorTest : public ::testing::Test {
+ protected:
+  ActiveSpeakerDetectorTest()
+      : clock_(1000),
+        detector_(new ActiveSpeakerDetector(&clock_, &observer_)) {}
+
+  void CreateDetector(const ActiveSpeakerDetector::Config& config) {
+    detector_.reset(new ActiveSpeakerDetector(&clock_, &observer_, config));
+  }
+
+  // Sends packets with the given audio levels, one level per stream, for
+  // |duration_ms|, and runs Process() at the default update interval.
+  void Run(const std::vector<uint32_t>& ssrcs,
+           const std::vector<int>& levels_dbov,
+           int duration_ms) {
+    ASSERT_EQ(ssrcs.size(), levels_dbov.size());
+    for (int time_ms = 0; time_ms < duration_ms;
+         time_ms += kPacketIntervalMs) {
+      for (size_t i = 0; i < ssrcs.size(); ++i) {
+        RTPHeader header;
+        header.ssrc = ssrcs[i];
+        header.extension.hasAudioLevel = true;
+        header.extension.voiceActivity = levels_dbov[i] < kSilenceDbov;
+        header.extension.audioLevel = static_cast<uint8_t>(levels_dbov[i]);
+        detector_->IncomingPacket(header);
+      }
+      clock_.AdvanceTimeMilliseconds(kPacketIntervalMs);
+      if (detector_->TimeUntilNextProcess() == 0)
+        detector_->Process();
+    }
+  }
+
+  SimulatedClock clock_;
+  ::testing::StrictMock<MockActiveSpeakerObserver> observer_;
+  std::unique_ptr<ActiveSpeakerDetector> detector_;
+};
+
+TEST_F(ActiveSpeakerDetectorTest, IgnoresPacketsWithoutAudioLevel) {
+  RTPHeader header;
+  header.ssrc = kSsrc1;
+  for (int i = 0; i < 100; ++i) {
+    detector_->IncomingPacket(header);
+    clock_.AdvanceTimeMilliseconds(kPacketIntervalMs);
+    detector_->Process();
+  }
+  EXPECT_THAT(detector_->active_speakers(), IsEmpty());
+}
+
+TEST_F(ActiveSpeakerDetectorTest, SilenceIsNotReported) {
+  Run({kSsrc1, kSsrc2}, {kSilenceDbov, 80}, 5000);
+  EXPECT_THAT(detector_->active_speakers(), IsEmpty());
+}
+
+TEST_F(ActiveSpeakerDetectorTest, SpeakerStartsAndStops) {
+  EXPECT_CALL(observer_, OnActiveSpeakersChanged(ElementsAre(kSsrc1)));
+  Run({kSsrc1, kSsrc2}, {30, kSilenceDbov}, 1000);
+  Mock::VerifyAndClearExpectations(&observer_);
+  EXPECT_THAT(detector_->active_speakers(), ElementsAre(kSsrc1));
+
+  // A short pause, e.g., between words, keeps the speaker active.
+  Run({kSsrc1, kSsrc2}, {kSilenceDbov, kSilenceDbov}, 60);
+  Run({kSsrc1, kSsrc2}, {30, kSilenceDbov}, 500);
+  Mock::VerifyAndClearExpectations(&observer_);
+
+  EXPECT_CALL(observer_, OnActiveSpeakersChanged(IsEmpty()));
+  Run({kSsrc1, kSsrc2}, {kSilenceDbov, kSilenceDbov}, 2000);
+}
+
+TEST_F(ActiveSpeakerDetectorTest, RanksLoudestSpeakers) {
+  ActiveSpeakerDetector::Config config;
+  config.max_active_speakers = 2;
+  CreateDetector(config);
+  EXPECT_CALL(observer_, OnActiveSpeakersChanged(_)).Times(AtLeast(1));
+  Run({kSsrc1, kSsrc2, kSsrc3, kSsrc4}, {40, 20, 30, kSilenceDbov}, 2000);
+  EXPECT_THAT(detector_->active_speakers(), ElementsAre(kSsrc2, kSsrc3));
+}
+
+TEST_F(ActiveSpeakerDetectorTest, DominantSpeakerNeedsMarginToSwitch) {
+  EXPECT_CALL(observer_, OnActiveSpeakersChanged(_)).Times(AtLeast(1));
+  Run({kSsrc1, kSsrc2}, {30, kSilenceDbov}, 2000);
+  EXPECT_THAT(detector_->active_speakers(), ElementsAre(kSsrc1));
+
+  // Slightly louder is not enough to take over.
+  Run({kSsrc1, kSsrc2}, {30, 29}, 3000);
+  EXPECT_THAT(detector_->active_speakers(), ElementsAre(kSsrc1, kSsrc2));
+
+  // Clearly louder is.
+  Run({kSsrc1, kSsrc2}, {30, 20}, 3000);
+  EXPECT_THAT(detector_->active_speakers(), ElementsAre(kSsrc2, kSsrc1));
+}
+
+TEST_F(ActiveSpeakerDetectorTest, DominantSpeakerIsKeptAfterSwitch) {
+  ActiveSpeakerDetector::Config config;
+  config.min_time_between_switches_ms = 5000;
+  CreateDetector(config);
+  EXPECT_CALL(observer_, OnActiveSpeakersChanged(_)).Times(AtLeast(1));
+  Run({kSsrc1, kSsrc2}, {30, kSilenceDbov}, 1000);
+  EXPECT_THAT(detector_->active_speakers(), ElementsAre(kSsrc1));
+
+  Run({kSsrc1, kSsrc2}, {30, 10}, 2000);
+  EXPECT_THAT(detector_->active_speakers(), ElementsAre(kSsrc1, kSsrc2));
+  Run({kSsrc1, kSsrc2}, {30, 10}, 3000);
+  EXPECT_THAT(detector_->active_speakers(), ElementsAre(kSsrc2, kSsrc1));
+}
+
+TEST_F(ActiveSpeakerDetectorTest, RemovedAndTimedOutStreamsAreDropped) {
+  ActiveSpeakerDetector::Config config;
+  config.stream_timeout_ms = 500;
+  CreateDetector(config);
+  EXPECT_CALL(observer_, OnActiveSpeakersChanged(_)).Times(AtLeast(1));
+  Run({kSsrc1, kSsrc2}, {30, 40}, 1000);
+  EXPECT_THAT(detector_->active_speakers(), ElementsAre(kSsrc1, kSsrc2));
+
+  detector_->RemoveStream(kSsrc1);
+  Run({kSsrc2}, {40}, 100);
+  EXPECT_THAT(detector_->active_speakers(), ElementsAre(kSsrc2));
+
+  // No more packets from |kSsrc2|.
+  Run({kSsrc3}, {kSilenceDbov}, 1000);
+  EXPECT_THAT(detector_->active_speakers(), IsEmpty());
+}
+
+TEST_F(ActiveSpeakerDetectorTest, ManyStreams) {
+  const uint32_t kNumStreams = 5000;
+  std::vector<uint32_t> ssrcs;
+  std::vector<int> levels;
+  for (uint32_t ssrc = 0; ssrc < kNumStreams; ++ssrc) {
+    ssrcs.push_back(ssrc);
+    // A few streams speak, the others send comfort noise.
+    levels.push_back(ssrc % 1000 == 7 ? 20 + ssrc / 1000 : 90);
+  }
+  EXPECT_CALL(observer_, OnActiveSpeakersChanged(_)).Times(AtLeast(1));
+  Run(ssrcs, levels, 1000);
+  EXPECT_THAT(detector_->active_speakers(), ElementsAre(7u, 1007u, 2007u));
+}
+
+}  // namespace
+}  // namespace webrtc
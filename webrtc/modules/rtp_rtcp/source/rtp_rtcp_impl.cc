@@ -787,6 +787,10 @@ int32_t ModuleRtpRtcpImpl::SetAudioLevel(
   return rtp_sender_.SetAudioLevel(level_d_bov);
 }
 
+void ModuleRtpRtcpImpl::ClearAudioLevel() {
+  rtp_sender_.ClearAudioLevel();
+}
+
 int32_t ModuleRtpRtcpImpl::SetKeyFrameRequestMethod(
     const KeyFrameRequestMethod method) {
   key_frame_req_method_ = method;
@@ -270,6 +270,8 @@ class ModuleRtpRtcpImpl : public RtpRtcp, public RTCPReceiver::ModuleRtpRtcp {
   // indication.
   int32_t SetAudioLevel(uint8_t level_d_bov) override;
 
+  void ClearAudioLevel() override;
+
   // Video part.
 
   int32_t SendRTCPSliceLossIndication(uint8_t picture_id) override;
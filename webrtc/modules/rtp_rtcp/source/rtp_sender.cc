@@ -1127,6 +1127,10 @@ int32_t RTPSender::SetAudioLevel(uint8_t level_d_bov) {
   return audio_->SetAudioLevel(level_d_bov);
 }
 
+void RTPSender::ClearAudioLevel() {
+  audio_->ClearAudioLevel();
+}
+
 RtpVideoCodecTypes RTPSender::VideoCodecType() const {
   assert(!audio_configured_ && "Sender is an audio stream!");
   return video_->VideoCodecType();
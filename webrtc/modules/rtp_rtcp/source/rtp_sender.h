@@ -182,6 +182,7 @@ class RTPSender {
   // Store the audio level in d_bov for
   // header-extension-for-audio-level-indication.
   int32_t SetAudioLevel(uint8_t level_d_bov);
+  void ClearAudioLevel();
 
   RtpVideoCodecTypes VideoCodecType() const;
 
@@ -46,7 +46,7 @@ RTPSenderAudio::RTPSenderAudio(Clock* clock, RTPSender* rtp_sender)
       cngswb_payload_type_(-1),
       cngfb_payload_type_(-1),
       last_payload_type_(-1),
-      audio_level_dbov_(0) {}
+      audio_level_dbov_(rtc::Optional<uint8_t>(0)) {}
 
 RTPSenderAudio::~RTPSenderAudio() {}
 
@@ -154,7 +154,7 @@ bool RTPSenderAudio::SendAudio(FrameType frame_type,
   // TODO(pwestin) Breakup function in smaller functions.
   uint16_t dtmf_length_ms = 0;
   uint8_t key = 0;
-  uint8_t audio_level_dbov;
+  rtc::Optional<uint8_t> audio_level_dbov;
   int8_t dtmf_payload_type;
   uint16_t packet_size_samples;
   {
@@ -248,8 +248,10 @@ bool RTPSenderAudio::SendAudio(FrameType frame_type,
   packet->SetTimestamp(rtp_timestamp);
   packet->set_capture_time_ms(clock_->TimeInMilliseconds());
   // Update audio level extension, if included.
-  packet->SetExtension<AudioLevel>(frame_type == kAudioFrameSpeech,
-                                   audio_level_dbov);
+  if (audio_level_dbov) {
+    packet->SetExtension<AudioLevel>(frame_type == kAudioFrameSpeech,
+                                     *audio_level_dbov);
+  }
 
   if (fragmentation && fragmentation->fragmentationVectorSize > 0) {
     // Use the fragment info if we have one.
@@ -291,10 +293,15 @@ int32_t RTPSenderAudio::SetAudioLevel(uint8_t level_dbov) {
     return -1;
   }
   rtc::CritScope cs(&send_audio_critsect_);
-  audio_level_dbov_ = level_dbov;
+  audio_level_dbov_ = rtc::Optional<uint8_t>(level_dbov);
   return 0;
 }
 
+void RTPSenderAudio::ClearAudioLevel() {
+  rtc::CritScope cs(&send_audio_critsect_);
+  audio_level_dbov_ = rtc::Optional<uint8_t>();
+}
+
 // Send a TelephoneEvent tone using RFC 2833 (4733)
 int32_t RTPSenderAudio::SendTelephoneEvent(uint8_t key,
                                            uint16_t time_ms,
@@ -15,6 +15,7 @@
 #include "webrtc/base/constructormagic.h"
 #include "webrtc/base/criticalsection.h"
 #include "webrtc/base/onetimeevent.h"
+#include "webrtc/base/optional.h"
 #include "webrtc/modules/rtp_rtcp/source/dtmf_queue.h"
 #include "webrtc/modules/rtp_rtcp/source/rtp_rtcp_config.h"
 #include "webrtc/modules/rtp_rtcp/source/rtp_sender.h"
@@ -51,6 +52,9 @@ class RTPSenderAudio {
   // Valid range is [0,100]. Actual value is negative.
   int32_t SetAudioLevel(uint8_t level_dbov);
 
+  // Leave the audio level extension out until the next SetAudioLevel().
+  void ClearAudioLevel();
+
   // Send a DTMF tone using RFC 2833 (4733)
   int32_t SendTelephoneEvent(uint8_t key, uint16_t time_ms, uint8_t level);
 
@@ -94,7 +98,7 @@ class RTPSenderAudio {
 
   // Audio level indication.
   // (https://datatracker.ietf.org/doc/draft-lennox-avt-rtp-audio-level-exthdr/)
-  uint8_t audio_level_dbov_ GUARDED_BY(send_audio_critsect_);
+  rtc::Optional<uint8_t> audio_level_dbov_ GUARDED_BY(send_audio_critsect_);
   OneTimeEvent first_packet_sent_;
 
   RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(RTPSenderAudio);
@@ -1275,6 +1275,25 @@ TEST_F(RtpSenderAudioTest, SendAudioWithAudioLevelExtension) {
   EXPECT_FALSE(voice_activity);
 }
 
+TEST_F(RtpSenderAudioTest, SendAudioWithoutAudioLevelAfterClear) {
+  EXPECT_EQ(0, rtp_sender_->SetAudioLevel(kAudioLevel));
+  rtp_sender_->ClearAudioLevel();
+  EXPECT_EQ(0, rtp_sender_->RegisterRtpHeaderExtension(kRtpExtensionAudioLevel,
+                                                       kAudioLevelExtensionId));
+
+  char payload_name[RTP_PAYLOAD_NAME_SIZE] = "PAYLOAD_NAME";
+  const uint8_t payload_type = 127;
+  ASSERT_EQ(0, rtp_sender_->RegisterPayload(payload_name, payload_type, 48000,
+                                            0, 1500));
+  uint8_t payload[] = {47, 11, 32, 93, 89};
+
+  ASSERT_TRUE(rtp_sender_->SendOutgoingData(
+      kAudioFrameSpeech, payload_type, 1234, 4321, payload, sizeof(payload),
+      nullptr, nullptr, nullptr));
+
+  EXPECT_FALSE(transport_.last_sent_packet().HasExtension<AudioLevel>());
+}
+
 // As RFC4733, named telephone events are carried as part of the audio stream
 // and must use the same sequence number and timestamp base as the regular
 // audio channel.
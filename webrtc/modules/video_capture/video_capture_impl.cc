@@ -272,6 +272,22 @@ int32_t VideoCaptureImpl::IncomingFrame(
           }
         }
 
+        // Pass NV12 frames on as they are, unless they need to be flipped or
+        // rotated. Consumers that need I420 convert them.
+        if (commonVideoType == kNV12 && height > 0 &&
+            (!apply_rotation || _rotateFrame == kVideoRotation_0)) {
+          rtc::scoped_refptr<NV12Buffer> buffer = NV12Buffer::Copy(
+              width, height, videoFrame, width, videoFrame + width * height,
+              width + (width & 1));
+          VideoFrame captureFrame(
+              buffer, 0, rtc::TimeMillis(),
+              !apply_rotation ? _rotateFrame : kVideoRotation_0);
+          captureFrame.set_ntp_time_ms(captureTime);
+
+          DeliverCapturedFrame(captureFrame);
+          return 0;
+        }
+
         // Setting absolute height (in case it was negative).
         // In Windows, the image starts bottom left, instead of top left.
         // Setting a negative source height, inverts the image (within LibYuv).
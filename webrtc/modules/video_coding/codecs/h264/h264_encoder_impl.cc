@@ -36,23 +36,6 @@ enum H264EncoderImplEvent {
   kH264EncoderEventMax = 16,
 };
 
-int NumberOfThreads(int width, int height, int number_of_cores) {
-  // TODO(hbos): In Chromium, multiple threads do not work with sandbox on Mac,
-  // see crbug.com/583348. Until further investigated, only use one thread.
-//  if (width * height >= 1920 * 1080 && number_of_cores > 8) {
-//    return 8;  // 8 threads for 1080p on high perf machines.
-//  } else if (width * height > 1280 * 960 && number_of_cores >= 6) {
-//    return 3;  // 3 threads for 1080p.
-//  } else if (width * height > 640 * 480 && number_of_cores >= 3) {
-//    return 2;  // 2 threads for qHD/HD.
-//  } else {
-//    return 1;  // 1 thread for VGA or less.
-//  }
-// TODO(sprang): Also check sSliceArgument.uiSliceNum om GetEncoderPrams(),
-//               before enabling multithreading here.
-  return 1;
-}
-
 FrameType ConvertToVideoFrameType(EVideoFrameType type) {
   switch (type) {
     case videoFrameTypeIDR:
@@ -217,6 +200,8 @@ int32_t H264EncoderImpl::InitEncode(const VideoCodec* codec_settings,
     target_bps_ = codec_settings->startBitrate * 1000;
   else
     target_bps_ = codec_settings->targetBitrate * 1000;
+  thread_policy_.Init(kVideoCodecH264, width_, height_, number_of_cores_,
+                      codec_settings->maxFramerate);
 
   SEncParamExt encoder_params = CreateEncoderParams();
   // Initialize.
@@ -308,6 +293,7 @@ int32_t H264EncoderImpl::Encode(const VideoFrame& input_frame,
                  << frame_buffer->height();
     width_ = frame_buffer->width();
     height_ = frame_buffer->height();
+    thread_policy_.SetResolution(width_, height_);
     SEncParamExt encoder_params = CreateEncoderParams();
     openh264_encoder_->SetOption(ENCODER_OPTION_SVC_ENCODE_PARAM_EXT,
                                  &encoder_params);
@@ -435,8 +421,7 @@ SEncParamExt H264EncoderImpl::CreateEncoderParams() const {
   //  0: auto (dynamic imp. internal encoder)
   //  1: single thread (default value)
   // >1: number of threads
-  encoder_params.iMultipleThreadIdc = NumberOfThreads(
-      encoder_params.iPicWidth, encoder_params.iPicHeight, number_of_cores_);
+  encoder_params.iMultipleThreadIdc = thread_policy_.settings().threads;
   // The base spatial layer 0 is the only one we use.
   encoder_params.sSpatialLayers[0].iVideoWidth = encoder_params.iPicWidth;
   encoder_params.sSpatialLayers[0].iVideoHeight = encoder_params.iPicHeight;
@@ -450,10 +435,11 @@ SEncParamExt H264EncoderImpl::CreateEncoderParams() const {
   encoder_params.sSpatialLayers[0].sSliceCfg.uiSliceMode = SM_AUTO_SLICE;
 #else
   // When uiSliceMode = SM_FIXEDSLCNUM_SLICE, uiSliceNum = 0 means auto design
-  // it with cpu core number.
+  // it with cpu core number. Use one slice per thread instead.
   // TODO(sprang): Set to 0 when we understand why the rate controller borks
   //               when uiSliceNum > 1.
-  encoder_params.sSpatialLayers[0].sSliceArgument.uiSliceNum = 1;
+  encoder_params.sSpatialLayers[0].sSliceArgument.uiSliceNum =
+      thread_policy_.settings().partitions;
   encoder_params.sSpatialLayers[0].sSliceArgument.uiSliceMode =
       SM_FIXEDSLCNUM_SLICE;
 #endif
@@ -17,6 +17,7 @@
 
 #include "webrtc/common_video/h264/h264_bitstream_parser.h"
 #include "webrtc/modules/video_coding/codecs/h264/include/h264.h"
+#include "webrtc/modules/video_coding/utility/encoder_thread_policy.h"
 #include "webrtc/modules/video_coding/utility/quality_scaler.h"
 
 #include "third_party/openh264/src/codec/api/svc/codec_app_def.h"
@@ -65,6 +66,9 @@ class H264EncoderImpl : public H264Encoder {
 
   webrtc::H264BitstreamParser h264_bitstream_parser_;
   QualityScaler quality_scaler_;
+  // Only consulted when the encoder is (re)configured; OpenH264 cannot change
+  // its thread count without a key frame.
+  EncoderThreadPolicy thread_policy_;
   // Reports statistics with histograms.
   void ReportInit();
   void ReportError();
@@ -13,7 +13,7 @@
 #include <assert.h>
 #include <stdio.h>
 
-#include <algorithm>  // min_element, max_element
+#include <algorithm>  // min_element, max_element, sort
 
 #include "webrtc/base/format_macros.h"
 
@@ -54,6 +54,16 @@ bool LessForBitRate(const FrameStatistic& s1, const FrameStatistic& s2) {
   return s1.bit_rate_in_kbps < s2.bit_rate_in_kbps;
 }
 
+// Nearest-rank percentile of |samples|, which is sorted in place.
+int Percentile(std::vector<int>* samples, int percentile) {
+  assert(percentile >= 0 && percentile <= 100);
+  if (samples->empty())
+    return -1;
+  std::sort(samples->begin(), samples->end());
+  size_t rank = (percentile * samples->size() + 99) / 100;
+  return (*samples)[rank == 0 ? 0 : rank - 1];
+}
+
 FrameStatistic& Stats::NewFrame(int frame_number) {
   assert(frame_number >= 0);
   FrameStatistic stat;
@@ -177,5 +187,23 @@ void Stats::PrintSummary() {
          (total_encoding_time_in_us + total_decoding_time_in_us) / 1000);
 }
 
+int Stats::EncodeTimePercentileInUs(int percentile) const {
+  std::vector<int> encode_times;
+  for (const FrameStatistic& stat : stats_) {
+    if (stat.encoding_successful)
+      encode_times.push_back(stat.encode_time_in_us);
+  }
+  return Percentile(&encode_times, percentile);
+}
+
+int Stats::DecodeTimePercentileInUs(int percentile) const {
+  std::vector<int> decode_times;
+  for (const FrameStatistic& stat : stats_) {
+    if (stat.decoding_successful)
+      decode_times.push_back(stat.decode_time_in_us);
+  }
+  return Percentile(&decode_times, percentile);
+}
+
 }  // namespace test
 }  // namespace webrtc
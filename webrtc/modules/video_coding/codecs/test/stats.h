@@ -61,6 +61,11 @@ class Stats {
   // processing
   void PrintSummary();
 
+  // Returns the |percentile| (0-100) of the encode or decode time of the
+  // successfully encoded or decoded frames, or -1 if there are no such frames.
+  int EncodeTimePercentileInUs(int percentile) const;
+  int DecodeTimePercentileInUs(int percentile) const;
+
   std::vector<FrameStatistic> stats_;
 };
 
@@ -54,5 +54,26 @@ TEST_F(StatsTest, AddMany) {
   stats_->PrintSummary();  // should not crash
 }
 
+TEST_F(StatsTest, TimePercentiles) {
+  EXPECT_EQ(-1, stats_->EncodeTimePercentileInUs(50));
+  EXPECT_EQ(-1, stats_->DecodeTimePercentileInUs(50));
+
+  for (int i = 0; i < 100; ++i) {
+    FrameStatistic& frame_stat = stats_->NewFrame(i);
+    frame_stat.encoding_successful = true;
+    frame_stat.encode_time_in_us = 100 - i;
+    // Only every other frame is decoded.
+    frame_stat.decoding_successful = (i % 2 == 0);
+    frame_stat.decode_time_in_us = i;
+  }
+  EXPECT_EQ(1, stats_->EncodeTimePercentileInUs(0));
+  EXPECT_EQ(50, stats_->EncodeTimePercentileInUs(50));
+  EXPECT_EQ(90, stats_->EncodeTimePercentileInUs(90));
+  EXPECT_EQ(100, stats_->EncodeTimePercentileInUs(100));
+  EXPECT_EQ(0, stats_->DecodeTimePercentileInUs(0));
+  EXPECT_EQ(48, stats_->DecodeTimePercentileInUs(50));
+  EXPECT_EQ(98, stats_->DecodeTimePercentileInUs(100));
+}
+
 }  // namespace test
 }  // namespace webrtc
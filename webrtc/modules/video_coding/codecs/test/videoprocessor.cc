@@ -34,6 +34,7 @@ TestConfig::TestConfig()
       exclude_frame_types(kExcludeOnlyFirstKeyFrame),
       frame_length_in_bytes(0),
       use_single_core(false),
+      number_of_cores(0),
       keyframe_interval(0),
       codec_settings(NULL),
       verbose(true) {}
@@ -108,7 +109,9 @@ bool VideoProcessorImpl::Init() {
   }
   // Init the encoder and decoder
   uint32_t nbr_of_cores = 1;
-  if (!config_.use_single_core) {
+  if (config_.number_of_cores > 0) {
+    nbr_of_cores = config_.number_of_cores;
+  } else if (!config_.use_single_core) {
     nbr_of_cores = CpuInfo::DetectNumberOfCores();
   }
   int32_t init_result =
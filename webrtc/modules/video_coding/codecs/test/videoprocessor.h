@@ -86,6 +86,11 @@ struct TestConfig {
   // Default: false.
   bool use_single_core;
 
+  // If set to a value >0 this is the number of cores the encoder and decoder
+  // are initialized with, overriding |use_single_core|.
+  // Default: 0.
+  int number_of_cores;
+
   // If set to a value >0 this setting forces the encoder to create a keyframe
   // every Nth frame. Note that the encoder may create a keyframe in other
   // locations in addition to the interval that is set using this parameter.
@@ -10,11 +10,16 @@
 
 #include <math.h>
 
+#include <algorithm>
+#include <vector>
+
+#include "webrtc/base/timeutils.h"
 #include "webrtc/modules/video_coding/codecs/h264/include/h264.h"
 #include "webrtc/modules/video_coding/codecs/test/packet_manipulator.h"
 #include "webrtc/modules/video_coding/codecs/test/videoprocessor.h"
 #include "webrtc/modules/video_coding/codecs/vp8/include/vp8.h"
 #include "webrtc/modules/video_coding/codecs/vp8/include/vp8_common_types.h"
+#include "webrtc/modules/video_coding/codecs/vp8/simulcast_encoder_adapter.h"
 #include "webrtc/modules/video_coding/codecs/vp9/include/vp9.h"
 #include "webrtc/modules/video_coding/include/video_codec_interface.h"
 #include "webrtc/modules/video_coding/include/video_coding.h"
@@ -1005,4 +1010,112 @@ TEST_F(VideoProcessorIntegrationTest, MAYBE_ProcessNoLossTemporalLayersVP8) {
   ProcessFramesAndVerify(quality_metrics, rate_profile, process_settings,
                          rc_metrics);
 }
+
+namespace {
+
+class Vp8EncoderFactory : public VideoEncoderFactory {
+ public:
+  VideoEncoder* Create() override { return VP8Encoder::Create(); }
+  void Destroy(VideoEncoder* encoder) override { delete encoder; }
+};
+
+// Counts the encoded bytes of all simulcast streams.
+class EncodedBytesCounter : public EncodedImageCallback {
+ public:
+  Result OnEncodedImage(const EncodedImage& encoded_image,
+                        const CodecSpecificInfo* codec_specific_info,
+                        const RTPFragmentationHeader* fragmentation) override {
+    bytes_ += encoded_image._length;
+    return Result(Result::OK, encoded_image._timeStamp);
+  }
+  size_t bytes() const { return bytes_; }
+
+ private:
+  size_t bytes_ = 0;
+};
+
+// Encodes the 720p clip in three simulcast streams, with the streams encoded on
+// |num_encoder_threads| worker threads besides the calling thread, and prints
+// the encode latency per frame (the time spent in Encode()) and the
+// throughput.
+void RunSimulcastEncodeBenchmark(size_t num_encoder_threads) {
+  const int kWidth = 1280;
+  const int kHeight = 720;
+  const int kNumStreams = 3;
+  const int kStreamBitratesKbps[kNumStreams] = {200, 700, 2500};
+  const int kFrameRate = 50;
+  VideoCodec codec_settings;
+  VideoCodingModule::Codec(kVideoCodecVP8, &codec_settings);
+  codec_settings.width = kWidth;
+  codec_settings.height = kHeight;
+  codec_settings.maxFramerate = kFrameRate;
+  codec_settings.VP8()->automaticResizeOn = false;
+  codec_settings.VP8()->frameDroppingOn = false;
+  codec_settings.numberOfSimulcastStreams = kNumStreams;
+  codec_settings.startBitrate = 0;
+  for (int i = 0; i < kNumStreams; ++i) {
+    SimulcastStream& stream = codec_settings.simulcastStream[i];
+    const int downscale = 1 << (kNumStreams - 1 - i);
+    stream.width = kWidth / downscale;
+    stream.height = kHeight / downscale;
+    stream.numberOfTemporalLayers = 1;
+    stream.maxBitrate = kStreamBitratesKbps[i];
+    stream.targetBitrate = kStreamBitratesKbps[i];
+    stream.minBitrate = kStreamBitratesKbps[i] / 5;
+    stream.qpMax = 56;
+    codec_settings.startBitrate += kStreamBitratesKbps[i];
+  }
+  codec_settings.maxBitrate = codec_settings.startBitrate;
+  codec_settings.minBitrate = codec_settings.simulcastStream[0].minBitrate;
+
+  SimulcastEncoderAdapter encoder(new Vp8EncoderFactory(),
+                                  num_encoder_threads);
+  ASSERT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            encoder.InitEncode(&codec_settings, 1, 1200));
+  EncodedBytesCounter encoded_bytes_counter;
+  encoder.RegisterEncodeCompleteCallback(&encoded_bytes_counter);
+  encoder.SetRates(codec_settings.startBitrate, kFrameRate);
+
+  webrtc::test::FrameReaderImpl frame_reader(
+      webrtc::test::ResourcePath("ConferenceMotion_1280_720_50", "yuv"), kWidth,
+      kHeight);
+  ASSERT_TRUE(frame_reader.Init());
+  webrtc::test::Stats stats;
+  std::vector<FrameType> frame_types(1, kVideoFrameDelta);
+  int frame_number = 0;
+  int64_t total_encode_time_us = 0;
+  int max_encode_time_us = 0;
+  while (rtc::scoped_refptr<I420Buffer> buffer = frame_reader.ReadFrame()) {
+    VideoFrame frame(buffer, frame_number * 90000 / kFrameRate, 0,
+                     kVideoRotation_0);
+    webrtc::test::FrameStatistic& stat = stats.NewFrame(frame_number);
+    const int64_t encode_start_us = rtc::TimeMicros();
+    stat.encode_return_code = encoder.Encode(frame, nullptr, &frame_types);
+    stat.encode_time_in_us =
+        static_cast<int>(rtc::TimeMicros() - encode_start_us);
+    EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK, stat.encode_return_code);
+    total_encode_time_us += stat.encode_time_in_us;
+    max_encode_time_us = std::max(max_encode_time_us, stat.encode_time_in_us);
+    ++frame_number;
+  }
+  frame_reader.Close();
+  ASSERT_GT(frame_number, 0);
+
+  printf(
+      "Simulcast VP8, %d streams, %zu encoder threads: encode time per frame "
+      "%.1f ms average, %.1f ms max; %.1f frames per second, %.0f kbps\n",
+      kNumStreams, num_encoder_threads,
+      total_encode_time_us / 1000.0 / frame_number, max_encode_time_us / 1000.0,
+      frame_number * 1e6 / total_encode_time_us,
+      encoded_bytes_counter.bytes() * 8.0 * kFrameRate / frame_number / 1000);
+}
+
+}  // namespace
+
+// Compares encoding the simulcast streams one by one with encoding them in
+// parallel. Not run by default since it only reports the timings.
+TEST(VideoProcessorSimulcastBenchmark, DISABLED_ParallelSimulcastEncodingVP8) {
+  RunSimulcastEncodeBenchmark(0);
+  RunSimulcastEncodeBenchmark(2);
+}
 }  // namespace webrtc
@@ -0,0 +1,463 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Offline codec throughput benchmark. Runs every combination of the given
+// codecs, clips, core counts, bitrates, temporal layer counts and encoder
+// thread policies through the VideoProcessor and writes encode/decode speed,
+// CPU usage, per-frame latency percentiles, bitrate accuracy and PSNR/SSIM of
+// each run to a JSON file.
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gflags/gflags.h"
+#include "webrtc/base/arraysize.h"
+#include "webrtc/base/stringencode.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/common_types.h"
+#include "webrtc/common_video/libyuv/include/webrtc_libyuv.h"
+#include "webrtc/modules/video_coding/codecs/h264/include/h264.h"
+#include "webrtc/modules/video_coding/codecs/test/packet_manipulator.h"
+#include "webrtc/modules/video_coding/codecs/test/stats.h"
+#include "webrtc/modules/video_coding/codecs/test/videoprocessor.h"
+#include "webrtc/modules/video_coding/codecs/vp8/include/vp8.h"
+#include "webrtc/modules/video_coding/codecs/vp9/include/vp9.h"
+#include "webrtc/modules/video_coding/include/video_coding.h"
+#include "webrtc/system_wrappers/include/field_trial_default.h"
+#include "webrtc/test/testsupport/fileutils.h"
+#include "webrtc/test/testsupport/frame_reader.h"
+#include "webrtc/test/testsupport/frame_writer.h"
+#include "webrtc/test/testsupport/metrics/video_metrics.h"
+#include "webrtc/test/testsupport/packet_reader.h"
+
+DEFINE_string(codecs, "VP8,VP9,H264", "Comma separated list of codecs.");
+DEFINE_string(clips,
+              "foreman_cif,ConferenceMotion_1280_720_50,"
+              "web_screenshot_1850_1110",
+              "Comma separated list of clips in the resources directory. "
+              "Must be clips known by this tool, see kClips.");
+DEFINE_string(cores,
+              "1,2,4",
+              "Comma separated list of the number of cores the encoder and "
+              "decoder are initialized with.");
+DEFINE_string(bitrates,
+              "300,1000,2500",
+              "Comma separated list of target bitrates in kbps.");
+DEFINE_string(temporal_layers,
+              "1,3",
+              "Comma separated list of temporal layer counts. Counts >1 are "
+              "skipped for codecs without temporal layer support.");
+DEFINE_string(thread_policies,
+              "adaptive",
+              "Comma separated list of encoder thread policies. 'fixed' keeps "
+              "the thread count chosen from resolution and cores, 'adaptive' "
+              "also adapts it to the measured encode time.");
+DEFINE_int32(num_frames,
+             300,
+             "Maximum number of frames to process from each clip.");
+DEFINE_string(output_json,
+              "video_codec_benchmark.json",
+              "File the JSON results are written to.");
+
+namespace webrtc {
+namespace test {
+namespace {
+
+struct Clip {
+  const char* name;
+  int width;
+  int height;
+  int framerate;
+};
+
+const Clip kClips[] = {
+    {"foreman_cif", 352, 288, 30},
+    {"paris_qcif", 176, 144, 30},
+    {"ConferenceMotion_1280_720_50", 1280, 720, 50},
+    {"web_screenshot_1850_1110", 1850, 1110, 5},
+    {"presentation_1850_1110", 1850, 1110, 5},
+    {"photo_1850_1110", 1850, 1110, 5},
+    {"difficult_photo_1850_1110", 1850, 1110, 5},
+};
+
+struct RunConfig {
+  VideoCodecType codec_type;
+  const Clip* clip;
+  int cores;
+  int bitrate_kbps;
+  int temporal_layers;
+  bool adaptive_threads;
+};
+
+struct RunResult {
+  RunConfig config;
+  int num_frames;
+  double wall_time_ms;
+  // Process CPU time, which sums all threads on POSIX.
+  double cpu_time_ms;
+  double cpu_usage_percent;
+  double encode_fps;
+  double decode_fps;
+  int encode_time_us[3];
+  int decode_time_us[3];
+  double actual_bitrate_kbps;
+  QualityMetricsResult psnr;
+  QualityMetricsResult ssim;
+};
+
+const int kPercentiles[] = {50, 90, 99};
+
+const Clip* FindClip(const std::string& name) {
+  for (const Clip& clip : kClips) {
+    if (name == clip.name)
+      return &clip;
+  }
+  return nullptr;
+}
+
+bool ParseCodec(const std::string& name, VideoCodecType* codec_type) {
+  if (name == "VP8") {
+    *codec_type = kVideoCodecVP8;
+  } else if (name == "VP9") {
+    *codec_type = kVideoCodecVP9;
+  } else if (name == "H264") {
+    *codec_type = kVideoCodecH264;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+const char* CodecName(VideoCodecType codec_type) {
+  switch (codec_type) {
+    case kVideoCodecVP8:
+      return "VP8";
+    case kVideoCodecVP9:
+      return "VP9";
+    case kVideoCodecH264:
+      return "H264";
+    default:
+      return "Unknown";
+  }
+}
+
+const char* ThreadPolicyName(bool adaptive_threads) {
+  return adaptive_threads ? "adaptive" : "fixed";
+}
+
+std::vector<std::string> SplitFlag(const std::string& flag) {
+  std::vector<std::string> fields;
+  rtc::split(flag, ',', &fields);
+  return fields;
+}
+
+bool ParseIntList(const std::string& flag, std::vector<int>* values) {
+  for (const std::string& field : SplitFlag(flag)) {
+    int value;
+    if (!rtc::FromString(field, &value) || value <= 0)
+      return false;
+    values->push_back(value);
+  }
+  return !values->empty();
+}
+
+bool RunBenchmark(const RunConfig& run, RunResult* result) {
+  // Read by EncoderThreadPolicy when the encoder is initialized.
+  field_trial::InitFieldTrialsFromString(
+      run.adaptive_threads ? "" : "WebRTC-EncoderThreadAdaptation/Disabled/");
+
+  std::unique_ptr<VideoEncoder> encoder;
+  std::unique_ptr<VideoDecoder> decoder;
+  switch (run.codec_type) {
+    case kVideoCodecVP8:
+      encoder.reset(VP8Encoder::Create());
+      decoder.reset(VP8Decoder::Create());
+      break;
+    case kVideoCodecVP9:
+      encoder.reset(VP9Encoder::Create());
+      decoder.reset(VP9Decoder::Create());
+      break;
+    case kVideoCodecH264:
+      encoder.reset(H264Encoder::Create());
+      decoder.reset(H264Decoder::Create());
+      break;
+    default:
+      return false;
+  }
+
+  VideoCodec codec_settings;
+  VideoCodingModule::Codec(run.codec_type, &codec_settings);
+  codec_settings.width = run.clip->width;
+  codec_settings.height = run.clip->height;
+  codec_settings.maxFramerate = run.clip->framerate;
+  codec_settings.startBitrate = run.bitrate_kbps;
+  codec_settings.maxBitrate =
+      std::max<unsigned int>(codec_settings.maxBitrate, run.bitrate_kbps);
+  switch (run.codec_type) {
+    case kVideoCodecVP8:
+      codec_settings.VP8()->numberOfTemporalLayers = run.temporal_layers;
+      codec_settings.VP8()->automaticResizeOn = false;
+      break;
+    case kVideoCodecVP9:
+      codec_settings.VP9()->numberOfTemporalLayers = run.temporal_layers;
+      codec_settings.VP9()->automaticResizeOn = false;
+      break;
+    default:
+      break;
+  }
+
+  TestConfig config;
+  config.input_filename = ResourcePath(run.clip->name, "yuv");
+  config.output_filename = TempFilename(OutputPath(), "video_codec_benchmark");
+  config.frame_length_in_bytes =
+      CalcBufferSize(kI420, run.clip->width, run.clip->height);
+  config.number_of_cores = run.cores;
+  config.codec_settings = &codec_settings;
+  config.verbose = false;
+
+  FrameReaderImpl frame_reader(config.input_filename, run.clip->width,
+                               run.clip->height);
+  FrameWriterImpl frame_writer(config.output_filename,
+                               config.frame_length_in_bytes);
+  if (!frame_reader.Init() || !frame_writer.Init()) {
+    fprintf(stderr, "Failed to open %s or %s\n", config.input_filename.c_str(),
+            config.output_filename.c_str());
+    return false;
+  }
+  PacketReader packet_reader;
+  PacketManipulatorImpl packet_manipulator(
+      &packet_reader, config.networking_config, config.verbose);
+  Stats stats;
+  std::unique_ptr<VideoProcessor> processor(new VideoProcessorImpl(
+      encoder.get(), decoder.get(), &frame_reader, &frame_writer,
+      &packet_manipulator, config, &stats));
+  if (!processor->Init())
+    return false;
+  processor->SetRates(run.bitrate_kbps, run.clip->framerate);
+
+  int64_t start_us = rtc::TimeMicros();
+  std::clock_t start_cpu = std::clock();
+  int frame_number = 0;
+  while (frame_number < FLAGS_num_frames &&
+         processor->ProcessFrame(frame_number)) {
+    ++frame_number;
+  }
+  encoder->Release();
+  decoder->Release();
+  int64_t wall_time_us = rtc::TimeMicros() - start_us;
+  std::clock_t cpu_time = std::clock() - start_cpu;
+  frame_reader.Close();
+  frame_writer.Close();
+
+  result->config = run;
+  result->num_frames = frame_number;
+  result->wall_time_ms = wall_time_us / 1000.0;
+  result->cpu_time_ms = cpu_time * 1000.0 / CLOCKS_PER_SEC;
+  result->cpu_usage_percent =
+      wall_time_us > 0 ? 100.0 * result->cpu_time_ms / result->wall_time_ms
+                       : 0.0;
+  int64_t total_encode_time_us = 0;
+  int64_t total_decode_time_us = 0;
+  int num_decoded_frames = 0;
+  size_t total_encoded_bytes = 0;
+  for (const FrameStatistic& stat : stats.stats_) {
+    total_encode_time_us += stat.encode_time_in_us;
+    total_encoded_bytes += stat.encoded_frame_length_in_bytes;
+    if (stat.decoding_successful) {
+      total_decode_time_us += stat.decode_time_in_us;
+      ++num_decoded_frames;
+    }
+  }
+  result->encode_fps = total_encode_time_us > 0
+                           ? frame_number * 1e6 / total_encode_time_us
+                           : 0.0;
+  result->decode_fps = total_decode_time_us > 0
+                           ? num_decoded_frames * 1e6 / total_decode_time_us
+                           : 0.0;
+  for (size_t i = 0; i < arraysize(kPercentiles); ++i) {
+    result->encode_time_us[i] = stats.EncodeTimePercentileInUs(kPercentiles[i]);
+    result->decode_time_us[i] = stats.DecodeTimePercentileInUs(kPercentiles[i]);
+  }
+  result->actual_bitrate_kbps =
+      frame_number > 0 ? total_encoded_bytes * 8.0 * run.clip->framerate /
+                             (frame_number * 1000.0)
+                       : 0.0;
+
+  int metrics_result = I420MetricsFromFiles(
+      config.input_filename.c_str(), config.output_filename.c_str(),
+      run.clip->width, run.clip->height, &result->psnr, &result->ssim);
+  if (remove(config.output_filename.c_str()) < 0)
+    fprintf(stderr, "Failed to remove temporary file!\n");
+  return metrics_result == 0;
+}
+
+void WritePercentiles(FILE* file, const char* name, const int* values) {
+  fprintf(file, "      \"%s\": {", name);
+  for (size_t i = 0; i < arraysize(kPercentiles); ++i) {
+    fprintf(file, "%s\"p%d\": %d", i == 0 ? "" : ", ", kPercentiles[i],
+            values[i]);
+  }
+  fprintf(file, "},\n");
+}
+
+bool WriteJson(const std::string& filename,
+               const std::vector<RunResult>& results) {
+  FILE* file = fopen(filename.c_str(), "w");
+  if (!file)
+    return false;
+  fprintf(file, "{\n  \"runs\": [\n");
+  for (size_t i = 0; i < results.size(); ++i) {
+    const RunResult& r = results[i];
+    fprintf(file, "    {\n");
+    fprintf(file, "      \"codec\": \"%s\",\n", CodecName(r.config.codec_type));
+    fprintf(file, "      \"clip\": \"%s\",\n", r.config.clip->name);
+    fprintf(file, "      \"width\": %d,\n", r.config.clip->width);
+    fprintf(file, "      \"height\": %d,\n", r.config.clip->height);
+    fprintf(file, "      \"framerate\": %d,\n", r.config.clip->framerate);
+    fprintf(file, "      \"cores\": %d,\n", r.config.cores);
+    fprintf(file, "      \"temporal_layers\": %d,\n", r.config.temporal_layers);
+    fprintf(file, "      \"frames\": %d,\n", r.num_frames);
+    fprintf(file, "      \"thread_policy\": \"%s\",\n",
+            ThreadPolicyName(r.config.adaptive_threads));
+    fprintf(file, "      \"wall_time_ms\": %.1f,\n", r.wall_time_ms);
+    fprintf(file, "      \"cpu_time_ms\": %.1f,\n", r.cpu_time_ms);
+    fprintf(file, "      \"cpu_usage_percent\": %.1f,\n",
+            r.cpu_usage_percent);
+    fprintf(file, "      \"encode_fps\": %.2f,\n", r.encode_fps);
+    fprintf(file, "      \"decode_fps\": %.2f,\n", r.decode_fps);
+    WritePercentiles(file, "encode_time_us", r.encode_time_us);
+    WritePercentiles(file, "decode_time_us", r.decode_time_us);
+    fprintf(file, "      \"target_bitrate_kbps\": %d,\n",
+            r.config.bitrate_kbps);
+    fprintf(file, "      \"actual_bitrate_kbps\": %.1f,\n",
+            r.actual_bitrate_kbps);
+    fprintf(file, "      \"bitrate_error_percent\": %.2f,\n",
+            100.0 * (r.actual_bitrate_kbps - r.config.bitrate_kbps) /
+                r.config.bitrate_kbps);
+    fprintf(file, "      \"psnr\": {\"avg\": %.3f, \"min\": %.3f},\n",
+            r.psnr.average, r.psnr.min);
+    fprintf(file, "      \"ssim\": {\"avg\": %.5f, \"min\": %.5f}\n",
+            r.ssim.average, r.ssim.min);
+    fprintf(file, "    }%s\n", i + 1 < results.size() ? "," : "");
+  }
+  fprintf(file, "  ]\n}\n");
+  return fclose(file) == 0;
+}
+
+int Run() {
+  std::vector<VideoCodecType> codecs;
+  for (const std::string& name : SplitFlag(FLAGS_codecs)) {
+    VideoCodecType codec_type;
+    if (!ParseCodec(name, &codec_type)) {
+      fprintf(stderr, "Unknown codec: %s\n", name.c_str());
+      return 1;
+    }
+    if (codec_type == kVideoCodecH264 && !H264Encoder::IsSupported()) {
+      fprintf(stderr, "H264 is not supported in this build, skipping.\n");
+      continue;
+    }
+    codecs.push_back(codec_type);
+  }
+  std::vector<const Clip*> clips;
+  for (const std::string& name : SplitFlag(FLAGS_clips)) {
+    const Clip* clip = FindClip(name);
+    if (!clip) {
+      fprintf(stderr, "Unknown clip: %s\n", name.c_str());
+      return 1;
+    }
+    clips.push_back(clip);
+  }
+  std::vector<int> cores;
+  std::vector<int> bitrates;
+  std::vector<int> temporal_layers;
+  if (!ParseIntList(FLAGS_cores, &cores) ||
+      !ParseIntList(FLAGS_bitrates, &bitrates) ||
+      !ParseIntList(FLAGS_temporal_layers, &temporal_layers)) {
+    fprintf(stderr, "--cores, --bitrates and --temporal_layers must be "
+                    "comma separated lists of positive integers.\n");
+    return 1;
+  }
+
+  std::vector<bool> adaptive_threads;
+  for (const std::string& name : SplitFlag(FLAGS_thread_policies)) {
+    if (name != "fixed" && name != "adaptive") {
+      fprintf(stderr, "Unknown thread policy: %s\n", name.c_str());
+      return 1;
+    }
+    adaptive_threads.push_back(name == "adaptive");
+  }
+
+  std::vector<RunConfig> runs;
+  for (VideoCodecType codec_type : codecs) {
+    for (const Clip* clip : clips) {
+      for (int num_cores : cores) {
+        for (int bitrate_kbps : bitrates) {
+          for (int num_temporal_layers : temporal_layers) {
+            if (num_temporal_layers > 1 && codec_type == kVideoCodecH264)
+              continue;
+            for (bool adaptive : adaptive_threads) {
+              runs.push_back({codec_type, clip, num_cores, bitrate_kbps,
+                              num_temporal_layers, adaptive});
+            }
+          }
+        }
+      }
+    }
+  }
+
+  std::vector<RunResult> results;
+  for (const RunConfig& run : runs) {
+    printf("%s %s cores=%d bitrate=%d kbps temporal_layers=%d threads=%s\n",
+           CodecName(run.codec_type), run.clip->name, run.cores,
+           run.bitrate_kbps, run.temporal_layers,
+           ThreadPolicyName(run.adaptive_threads));
+    RunResult result;
+    if (!RunBenchmark(run, &result)) {
+      fprintf(stderr, "Run failed, skipping.\n");
+      continue;
+    }
+    printf("  encode %.1f fps, decode %.1f fps, CPU %.0f%%, %.1f kbps, "
+           "PSNR %.2f dB\n",
+           result.encode_fps, result.decode_fps, result.cpu_usage_percent,
+           result.actual_bitrate_kbps, result.psnr.average);
+    results.push_back(result);
+  }
+
+  if (!WriteJson(FLAGS_output_json, results)) {
+    fprintf(stderr, "Failed to write %s\n", FLAGS_output_json.c_str());
+    return 1;
+  }
+  printf("Wrote %d runs to %s\n", static_cast<int>(results.size()),
+         FLAGS_output_json.c_str());
+  return 0;
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  std::string program_name = argv[0];
+  std::string usage =
+      "Encodes and decodes resource clips with the given codec settings and "
+      "reports throughput, latency, rate accuracy and quality as JSON.\n"
+      "Example usage:\n" +
+      program_name +
+      " --codecs=VP8,VP9 --clips=foreman_cif --cores=1,4 "
+      "--bitrates=500,1500 --temporal_layers=1,3 --output_json=out.json\n";
+  google::SetUsageMessage(usage);
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  return webrtc::test::Run();
+}
@@ -12,9 +12,6 @@
 
 #include <algorithm>
 
-// NOTE(ajm): Path provided by gyp.
-#include "libyuv/scale.h"  // NOLINT
-
 #include "webrtc/base/checks.h"
 #include "webrtc/modules/video_coding/codecs/vp8/screenshare_layers.h"
 #include "webrtc/modules/video_coding/utility/simulcast_rate_allocator.h"
@@ -120,10 +117,25 @@ class AdapterEncodedImageCallback : public webrtc::EncodedImageCallback {
 
 namespace webrtc {
 
+// An encoded image that is delivered after the streams that are encoded in
+// parallel are done. Owns copies of the data that the encoder may reuse.
+struct SimulcastEncoderAdapter::BufferedImage {
+  EncodedImage encoded_image;
+  std::unique_ptr<uint8_t[]> buffer;
+  CodecSpecificInfo codec_specific_info;
+  std::unique_ptr<RTPFragmentationHeader> fragmentation;
+};
+
 SimulcastEncoderAdapter::SimulcastEncoderAdapter(VideoEncoderFactory* factory)
+    : SimulcastEncoderAdapter(factory, 0) {}
+
+SimulcastEncoderAdapter::SimulcastEncoderAdapter(VideoEncoderFactory* factory,
+                                                 size_t num_encoder_threads)
     : factory_(factory),
       encoded_complete_callback_(nullptr),
-      implementation_name_("SimulcastEncoderAdapter") {
+      implementation_name_("SimulcastEncoderAdapter"),
+      num_encoder_threads_(num_encoder_threads),
+      encoding_in_parallel_(false) {
   memset(&codec_, 0, sizeof(webrtc::VideoCodec));
   rate_allocator_.reset(new SimulcastRateAllocator(codec_));
 }
@@ -227,6 +239,14 @@ int SimulcastEncoderAdapter::InitEncode(const VideoCodec* inst,
   } else {
     implementation_name_ = implementation_name;
   }
+
+  // One stream is always encoded on the calling thread.
+  const size_t num_encoder_threads =
+      std::min(num_encoder_threads_, streaminfos_.size() - 1);
+  while (encoder_threads_.size() < num_encoder_threads)
+    encoder_threads_.emplace_back(
+        new rtc::ParallelTaskThread("SimulcastEncoder", rtc::kHighPriority));
+  buffered_images_.resize(streaminfos_.size());
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
@@ -260,70 +280,123 @@ int SimulcastEncoderAdapter::Encode(
     }
   }
 
-  int src_width = input_image.width();
-  int src_height = input_image.height();
+  std::vector<FrameType> stream_frame_types(streaminfos_.size(),
+                                           kVideoFrameDelta);
+  std::vector<size_t> streams_to_encode;
   for (size_t stream_idx = 0; stream_idx < streaminfos_.size(); ++stream_idx) {
     // Don't encode frames in resolutions that we don't intend to send.
     if (!streaminfos_[stream_idx].send_stream)
       continue;
 
-    std::vector<FrameType> stream_frame_types;
     if (send_key_frame) {
-      stream_frame_types.push_back(kVideoFrameKey);
+      stream_frame_types[stream_idx] = kVideoFrameKey;
       streaminfos_[stream_idx].key_frame_request = false;
-    } else {
-      stream_frame_types.push_back(kVideoFrameDelta);
     }
+    streams_to_encode.push_back(stream_idx);
+  }
 
-    int dst_width = streaminfos_[stream_idx].width;
-    int dst_height = streaminfos_[stream_idx].height;
-    // If scaling isn't required, because the input resolution
-    // matches the destination or the input image is empty (e.g.
-    // a keyframe request for encoders with internal camera
-    // sources) or the source image has a native handle, pass the image on
-    // directly. Otherwise, we'll scale it to match what the encoder expects
-    // (below).
-    // For texture frames, the underlying encoder is expected to be able to
-    // correctly sample/scale the source texture.
-    // TODO(perkj): ensure that works going forward, and figure out how this
-    // affects webrtc:5683.
-    if ((dst_width == src_width && dst_height == src_height) ||
-        input_image.IsZeroSize() ||
-        input_image.video_frame_buffer()->native_handle()) {
-      int ret = streaminfos_[stream_idx].encoder->Encode(
-          input_image, codec_specific_info, &stream_frame_types);
+  if (encoder_threads_.empty() || streams_to_encode.size() < 2) {
+    for (size_t stream_idx : streams_to_encode) {
+      int ret = EncodeStream(stream_idx, input_image, codec_specific_info,
+                             stream_frame_types[stream_idx]);
       if (ret != WEBRTC_VIDEO_CODEC_OK) {
         return ret;
       }
-    } else {
-      // Aligning stride values based on width.
-      rtc::scoped_refptr<I420Buffer> dst_buffer =
-          I420Buffer::Create(dst_width, dst_height, dst_width,
-                             (dst_width + 1) / 2, (dst_width + 1) / 2);
-      libyuv::I420Scale(input_image.video_frame_buffer()->DataY(),
-                        input_image.video_frame_buffer()->StrideY(),
-                        input_image.video_frame_buffer()->DataU(),
-                        input_image.video_frame_buffer()->StrideU(),
-                        input_image.video_frame_buffer()->DataV(),
-                        input_image.video_frame_buffer()->StrideV(),
-                        src_width, src_height,
-                        dst_buffer->MutableDataY(), dst_buffer->StrideY(),
-                        dst_buffer->MutableDataU(), dst_buffer->StrideU(),
-                        dst_buffer->MutableDataV(), dst_buffer->StrideV(),
-                        dst_width, dst_height,
-                        libyuv::kFilterBilinear);
-
-      int ret = streaminfos_[stream_idx].encoder->Encode(
-          VideoFrame(dst_buffer, input_image.timestamp(),
-                     input_image.render_time_ms(), webrtc::kVideoRotation_0),
-          codec_specific_info, &stream_frame_types);
-      if (ret != WEBRTC_VIDEO_CODEC_OK) {
-        return ret;
+    }
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+
+  // Encode the highest resolution stream, which takes the longest, on this
+  // thread, and spread the other streams over the worker threads.
+  const size_t last_stream_idx = streams_to_encode.back();
+  streams_to_encode.pop_back();
+  const size_t num_threads =
+      std::min(encoder_threads_.size(), streams_to_encode.size());
+  std::vector<std::vector<size_t>> thread_streams(num_threads);
+  for (size_t i = 0; i < streams_to_encode.size(); ++i)
+    thread_streams[i % num_threads].push_back(streams_to_encode[i]);
+  streams_to_encode.push_back(last_stream_idx);
+
+  std::vector<int> results(streaminfos_.size(), WEBRTC_VIDEO_CODEC_OK);
+  encoding_in_parallel_ = true;
+  for (size_t i = 0; i < num_threads; ++i) {
+    const std::vector<size_t>* streams = &thread_streams[i];
+    encoder_threads_[i]->StartTask([this, &input_image, codec_specific_info,
+                                    &stream_frame_types, streams, &results] {
+      for (size_t stream_idx : *streams) {
+        results[stream_idx] =
+            EncodeStream(stream_idx, input_image, codec_specific_info,
+                         stream_frame_types[stream_idx]);
       }
+    });
+  }
+  results[last_stream_idx] =
+      EncodeStream(last_stream_idx, input_image, codec_specific_info,
+                   stream_frame_types[last_stream_idx]);
+  for (size_t i = 0; i < num_threads; ++i)
+    encoder_threads_[i]->WaitForTask();
+  encoding_in_parallel_ = false;
+
+  // Deliver the encoded images in the same order as when the streams are
+  // encoded one by one, and stop at the first failing stream.
+  int ret = WEBRTC_VIDEO_CODEC_OK;
+  for (size_t stream_idx : streams_to_encode) {
+    if (ret == WEBRTC_VIDEO_CODEC_OK) {
+      ret = results[stream_idx];
+    }
+    if (ret == WEBRTC_VIDEO_CODEC_OK) {
+      DeliverBufferedImages(stream_idx);
+    } else {
+      buffered_images_[stream_idx].clear();
     }
   }
+  return ret;
+}
 
-  return WEBRTC_VIDEO_CODEC_OK;
+int SimulcastEncoderAdapter::EncodeStream(
+    size_t stream_idx,
+    const VideoFrame& input_image,
+    const CodecSpecificInfo* codec_specific_info,
+    FrameType frame_type) {
+  std::vector<FrameType> stream_frame_types(1, frame_type);
+  int src_width = input_image.width();
+  int src_height = input_image.height();
+  int dst_width = streaminfos_[stream_idx].width;
+  int dst_height = streaminfos_[stream_idx].height;
+  // If scaling isn't required, because the input resolution
+  // matches the destination or the input image is empty (e.g.
+  // a keyframe request for encoders with internal camera
+  // sources) or the source image has a native handle, pass the image on
+  // directly. Otherwise, we'll scale it to match what the encoder expects
+  // (below).
+  // For texture frames, the underlying encoder is expected to be able to
+  // correctly sample/scale the source texture.
+  // TODO(perkj): ensure that works going forward, and figure out how this
+  // affects webrtc:5683.
+  if ((dst_width == src_width && dst_height == src_height) ||
+      input_image.IsZeroSize() ||
+      input_image.video_frame_buffer()->native_handle()) {
+    return streaminfos_[stream_idx].encoder->Encode(
+        input_image, codec_specific_info, &stream_frame_types);
+  }
+
+  // If the frame is wrapped by a VideoFramePyramidPool, a size also used by
+  // another consumer (e.g., a local preview) is scaled only once.
+  rtc::scoped_refptr<VideoFrameBuffer> dst_buffer =
+      input_image.video_frame_buffer()->GetScaledBuffer(dst_width, dst_height);
+
+  return streaminfos_[stream_idx].encoder->Encode(
+      VideoFrame(dst_buffer, input_image.timestamp(),
+                 input_image.render_time_ms(), webrtc::kVideoRotation_0),
+      codec_specific_info, &stream_frame_types);
+}
+
+void SimulcastEncoderAdapter::DeliverBufferedImages(size_t stream_idx) {
+  for (const auto& image : buffered_images_[stream_idx]) {
+    OnEncodedImage(stream_idx, image->encoded_image,
+                   &image->codec_specific_info, image->fragmentation.get());
+  }
+  buffered_images_[stream_idx].clear();
 }
 
 int SimulcastEncoderAdapter::RegisterEncodeCompleteCallback(
@@ -405,6 +478,26 @@ EncodedImageCallback::Result SimulcastEncoderAdapter::OnEncodedImage(
     const EncodedImage& encodedImage,
     const CodecSpecificInfo* codecSpecificInfo,
     const RTPFragmentationHeader* fragmentation) {
+  if (encoding_in_parallel_) {
+    // Called on the thread encoding |stream_idx|. Keep the image until all
+    // streams are encoded, with copies of the data that the encoder owns.
+    std::unique_ptr<BufferedImage> image(new BufferedImage());
+    image->encoded_image = encodedImage;
+    if (encodedImage._buffer) {
+      image->buffer.reset(new uint8_t[encodedImage._size]);
+      memcpy(image->buffer.get(), encodedImage._buffer, encodedImage._length);
+      image->encoded_image._buffer = image->buffer.get();
+    }
+    image->codec_specific_info = *codecSpecificInfo;
+    if (fragmentation) {
+      image->fragmentation.reset(new RTPFragmentationHeader());
+      image->fragmentation->CopyFrom(*fragmentation);
+    }
+    buffered_images_[stream_idx].push_back(std::move(image));
+    return EncodedImageCallback::Result(EncodedImageCallback::Result::OK,
+                                        encodedImage._timeStamp);
+  }
+
   CodecSpecificInfo stream_codec_specific = *codecSpecificInfo;
   stream_codec_specific.codec_name = implementation_name_.c_str();
   CodecSpecificInfoVP8* vp8Info = &(stream_codec_specific.codecSpecific.VP8);
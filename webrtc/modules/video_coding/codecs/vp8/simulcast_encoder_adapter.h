@@ -16,6 +16,7 @@
 #include <string>
 #include <vector>
 
+#include "webrtc/base/parallel_task_thread.h"
 #include "webrtc/modules/video_coding/codecs/vp8/include/vp8.h"
 
 namespace webrtc {
@@ -36,6 +37,13 @@ class VideoEncoderFactory {
 class SimulcastEncoderAdapter : public VP8Encoder {
  public:
   explicit SimulcastEncoderAdapter(VideoEncoderFactory* factory);
+  // Encodes the streams of each frame concurrently, on the calling thread and
+  // on up to |num_encoder_threads| worker threads, including the scaling of
+  // the input for each stream. The encoded images are still delivered on the
+  // calling thread, in stream order, before Encode() returns. The contained
+  // encoders are then called from different threads, but never concurrently.
+  SimulcastEncoderAdapter(VideoEncoderFactory* factory,
+                          size_t num_encoder_threads);
   virtual ~SimulcastEncoderAdapter();
 
   // Implements VideoEncoder
@@ -93,6 +101,17 @@ class SimulcastEncoderAdapter : public VP8Encoder {
     bool send_stream;
   };
 
+  struct BufferedImage;
+
+  // Scales |input_image| to the resolution of the stream, if needed, and
+  // encodes it. May be called on a worker thread.
+  int EncodeStream(size_t stream_idx,
+                   const VideoFrame& input_image,
+                   const CodecSpecificInfo* codec_specific_info,
+                   FrameType frame_type);
+  // Delivers the images buffered while the streams were encoded in parallel.
+  void DeliverBufferedImages(size_t stream_idx);
+
   // Populate the codec settings for each stream.
   void PopulateStreamCodec(const webrtc::VideoCodec* inst,
                            int stream_index,
@@ -109,6 +128,13 @@ class SimulcastEncoderAdapter : public VP8Encoder {
   EncodedImageCallback* encoded_complete_callback_;
   std::string implementation_name_;
   std::unique_ptr<SimulcastRateAllocator> rate_allocator_;
+
+  const size_t num_encoder_threads_;
+  std::vector<std::unique_ptr<rtc::ParallelTaskThread>> encoder_threads_;
+  // Set while the streams are encoded in parallel, when the encoded images are
+  // buffered per stream, in |buffered_images_|, instead of being delivered.
+  bool encoding_in_parallel_;
+  std::vector<std::vector<std::unique_ptr<BufferedImage>>> buffered_images_;
 };
 
 }  // namespace webrtc
@@ -21,11 +21,15 @@ namespace testing {
 
 class TestSimulcastEncoderAdapter : public TestVp8Simulcast {
  public:
-  TestSimulcastEncoderAdapter()
-      : TestVp8Simulcast(new SimulcastEncoderAdapter(new Vp8EncoderFactory()),
-                         VP8Decoder::Create()) {}
+  TestSimulcastEncoderAdapter() : TestSimulcastEncoderAdapter(0) {}
 
  protected:
+  explicit TestSimulcastEncoderAdapter(size_t num_encoder_threads)
+      : TestVp8Simulcast(
+            new SimulcastEncoderAdapter(new Vp8EncoderFactory(),
+                                        num_encoder_threads),
+            VP8Decoder::Create()) {}
+
   class Vp8EncoderFactory : public VideoEncoderFactory {
    public:
     VideoEncoder* Create() override { return VP8Encoder::Create(); }
@@ -105,6 +109,36 @@ TEST_F(TestSimulcastEncoderAdapter, DISABLED_TestRPSIEncoder) {
   TestVp8Simulcast::TestRPSIEncoder();
 }
 
+class TestParallelSimulcastEncoderAdapter : public TestSimulcastEncoderAdapter {
+ public:
+  TestParallelSimulcastEncoderAdapter() : TestSimulcastEncoderAdapter(2) {}
+};
+
+TEST_F(TestParallelSimulcastEncoderAdapter, TestKeyFrameRequestsOnAllStreams) {
+  TestVp8Simulcast::TestKeyFrameRequestsOnAllStreams();
+}
+
+TEST_F(TestParallelSimulcastEncoderAdapter, TestPaddingTwoStreams) {
+  TestVp8Simulcast::TestPaddingTwoStreams();
+}
+
+TEST_F(TestParallelSimulcastEncoderAdapter, TestSendAllStreams) {
+  TestVp8Simulcast::TestSendAllStreams();
+}
+
+TEST_F(TestParallelSimulcastEncoderAdapter, TestDisablingStreams) {
+  TestVp8Simulcast::TestDisablingStreams();
+}
+
+TEST_F(TestParallelSimulcastEncoderAdapter, TestStrideEncodeDecode) {
+  TestVp8Simulcast::TestStrideEncodeDecode();
+}
+
+TEST_F(TestParallelSimulcastEncoderAdapter,
+       TestSpatioTemporalLayers321PatternEncoder) {
+  TestVp8Simulcast::TestSpatioTemporalLayers321PatternEncoder();
+}
+
 class MockVideoEncoder : public VideoEncoder {
  public:
   // TODO(nisse): Valid overrides commented out, because the gmock
@@ -214,8 +248,8 @@ class TestSimulcastEncoderAdapterFakeHelper {
 
   // Can only be called once as the SimulcastEncoderAdapter will take the
   // ownership of |factory_|.
-  VP8Encoder* CreateMockEncoderAdapter() {
-    return new SimulcastEncoderAdapter(factory_);
+  VP8Encoder* CreateMockEncoderAdapter(size_t num_encoder_threads) {
+    return new SimulcastEncoderAdapter(factory_, num_encoder_threads);
   }
 
   void ExpectCallSetChannelParameters(uint32_t packetLoss, int64_t rtt) {
@@ -238,9 +272,10 @@ static const int kTestTemporalLayerProfile[3] = {3, 2, 1};
 class TestSimulcastEncoderAdapterFake : public ::testing::Test,
                                         public EncodedImageCallback {
  public:
-  TestSimulcastEncoderAdapterFake()
+  TestSimulcastEncoderAdapterFake() : TestSimulcastEncoderAdapterFake(0) {}
+  explicit TestSimulcastEncoderAdapterFake(size_t num_encoder_threads)
       : helper_(new TestSimulcastEncoderAdapterFakeHelper()),
-        adapter_(helper_->CreateMockEncoderAdapter()),
+        adapter_(helper_->CreateMockEncoderAdapter(num_encoder_threads)),
         last_encoded_image_width_(-1),
         last_encoded_image_height_(-1),
         last_encoded_image_simulcast_index_(-1) {}
@@ -254,6 +289,8 @@ class TestSimulcastEncoderAdapterFake : public ::testing::Test,
     if (codec_specific_info) {
       last_encoded_image_simulcast_index_ =
           codec_specific_info->codecSpecific.VP8.simulcastIdx;
+      encoded_image_simulcast_indices_.push_back(
+          last_encoded_image_simulcast_index_);
     }
     return Result(Result::OK, encoded_image._timeStamp);
   }
@@ -357,6 +394,7 @@ class TestSimulcastEncoderAdapterFake : public ::testing::Test,
   int last_encoded_image_width_;
   int last_encoded_image_height_;
   int last_encoded_image_simulcast_index_;
+  std::vector<int> encoded_image_simulcast_indices_;
 };
 
 TEST_F(TestSimulcastEncoderAdapterFake, InitEncode) {
@@ -536,5 +574,70 @@ TEST_F(TestSimulcastEncoderAdapterFake, TestFailureReturnCodesFromEncodeCalls) {
             adapter_->Encode(input_frame, nullptr, &frame_types));
 }
 
+class TestParallelSimulcastEncoderAdapterFake
+    : public TestSimulcastEncoderAdapterFake {
+ public:
+  TestParallelSimulcastEncoderAdapterFake()
+      : TestSimulcastEncoderAdapterFake(2) {}
+
+ protected:
+  // Makes each encoder send an image of its stream resolution when encoding,
+  // and returns the frame to encode.
+  VideoFrame SetupEncodersSendingImages() {
+    TestVp8Simulcast::DefaultSettings(
+        &codec_, static_cast<const int*>(kTestTemporalLayerProfile));
+    codec_.numberOfSimulcastStreams = 3;
+    // High start bitrate, so all streams are enabled.
+    codec_.startBitrate = 3000;
+    EXPECT_EQ(0, adapter_->InitEncode(&codec_, 1, 1200));
+    adapter_->RegisterEncodeCompleteCallback(this);
+    EXPECT_EQ(3u, helper_->factory()->encoders().size());
+    for (MockVideoEncoder* encoder : helper_->factory()->encoders()) {
+      ON_CALL(*encoder, Encode(_, _, _))
+          .WillByDefault(::testing::InvokeWithoutArgs([encoder]() {
+            encoder->SendEncodedImage(encoder->codec().width,
+                                      encoder->codec().height);
+            return WEBRTC_VIDEO_CODEC_OK;
+          }));
+    }
+    int half_width = (kDefaultWidth + 1) / 2;
+    rtc::scoped_refptr<I420Buffer> input_buffer = I420Buffer::Create(
+        kDefaultWidth, kDefaultHeight, kDefaultWidth, half_width, half_width);
+    input_buffer->InitializeData();
+    return VideoFrame(input_buffer, 0, 0, webrtc::kVideoRotation_0);
+  }
+};
+
+TEST_F(TestParallelSimulcastEncoderAdapterFake,
+       EncodedImagesAreDeliveredInStreamOrder) {
+  VideoFrame input_frame = SetupEncodersSendingImages();
+  std::vector<FrameType> frame_types(3, kVideoFrameKey);
+  for (int i = 0; i < 10; ++i) {
+    encoded_image_simulcast_indices_.clear();
+    EXPECT_EQ(0, adapter_->Encode(input_frame, nullptr, &frame_types));
+    EXPECT_EQ(std::vector<int>({0, 1, 2}), encoded_image_simulcast_indices_);
+  }
+  int width;
+  int height;
+  int simulcast_index;
+  EXPECT_TRUE(GetLastEncodedImageInfo(&width, &height, &simulcast_index));
+  EXPECT_EQ(kDefaultWidth, width);
+  EXPECT_EQ(kDefaultHeight, height);
+}
+
+TEST_F(TestParallelSimulcastEncoderAdapterFake,
+       TestFailureReturnCodesFromEncodeCalls) {
+  VideoFrame input_frame = SetupEncodersSendingImages();
+  // Tell the 2nd encoder to request software fallback.
+  EXPECT_CALL(*helper_->factory()->encoders()[1], Encode(_, _, _))
+      .WillOnce(Return(WEBRTC_VIDEO_CODEC_FALLBACK_SOFTWARE));
+  std::vector<FrameType> frame_types(3, kVideoFrameKey);
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_FALLBACK_SOFTWARE,
+            adapter_->Encode(input_frame, nullptr, &frame_types));
+  // Only the images of the streams before the failing one are delivered, as
+  // when the streams are encoded one by one.
+  EXPECT_EQ(std::vector<int>({0}), encoded_image_simulcast_indices_);
+}
+
 }  // namespace testing
 }  // namespace webrtc
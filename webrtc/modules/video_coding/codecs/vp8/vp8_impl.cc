@@ -269,6 +269,8 @@ int VP8EncoderImpl::SetRates(uint32_t new_bitrate_kbit,
 void VP8EncoderImpl::OnDroppedFrame() {
   if (quality_scaler_enabled_)
     quality_scaler_.ReportDroppedFrame();
+  for (ActiveMapTracker& tracker : active_map_trackers_)
+    tracker.OnDroppedFrame();
 }
 
 const char* VP8EncoderImpl::ImplementationName() const {
@@ -379,6 +381,7 @@ int VP8EncoderImpl::InitEncode(const VideoCodec* inst,
   downsampling_factors_.resize(number_of_streams);
   raw_images_.resize(number_of_streams);
   send_stream_.resize(number_of_streams);
+  active_map_trackers_.assign(number_of_streams, ActiveMapTracker());
   send_stream_[0] = true;  // For non-simulcast case.
   cpu_speed_.resize(number_of_streams);
   std::fill(key_frame_request_.begin(), key_frame_request_.end(), false);
@@ -505,8 +508,10 @@ int VP8EncoderImpl::InitEncode(const VideoCodec* inst,
 
   // Determine number of threads based on the image size and #cores.
   // TODO(fbarchard): Consider number of Simulcast layers.
-  configurations_[0].g_threads = NumberOfThreads(
-      configurations_[0].g_w, configurations_[0].g_h, number_of_cores);
+  thread_policy_.Init(kVideoCodecVP8, inst->width, inst->height,
+                      number_of_cores, inst->maxFramerate);
+  configurations_[0].g_threads = thread_policy_.settings().threads;
+  token_partitions_ = thread_policy_.settings().partitions;
 
   // Creating a wrapper to the image - setting image data to NULL.
   // Actual pointer will be set in encode. Setting align to 1, as it
@@ -593,36 +598,6 @@ int VP8EncoderImpl::SetCpuSpeed(int width, int height) {
 #endif
 }
 
-int VP8EncoderImpl::NumberOfThreads(int width, int height, int cpus) {
-#if defined(ANDROID)
-  if (width * height >= 320 * 180) {
-    if (cpus >= 4) {
-      // 3 threads for CPUs with 4 and more cores since most of times only 4
-      // cores will be active.
-      return 3;
-    } else if (cpus == 3 || cpus == 2) {
-      return 2;
-    } else {
-      return 1;
-    }
-  }
-  return 1;
-#else
-  if (width * height >= 1920 * 1080 && cpus > 8) {
-    return 8;  // 8 threads for 1080p on high perf machines.
-  } else if (width * height > 1280 * 960 && cpus >= 6) {
-    // 3 threads for 1080p.
-    return 3;
-  } else if (width * height > 640 * 480 && cpus >= 3) {
-    // 2 threads for qHD/HD.
-    return 2;
-  } else {
-    // 1 thread for VGA or less.
-    return 1;
-  }
-#endif
-}
-
 int VP8EncoderImpl::InitAndSetControlSettings() {
   vpx_codec_flags_t flags = 0;
   flags |= VPX_CODEC_USE_OUTPUT_PARTITION;
@@ -754,6 +729,12 @@ int VP8EncoderImpl::Encode(const VideoFrame& frame,
         raw_images_[i].stride[VPX_PLANE_V], raw_images_[i].d_w,
         raw_images_[i].d_h, libyuv::kFilterBilinear);
   }
+  // Also for frames which are dropped below, since the changes of a dropped
+  // frame must be encoded with the next frame.
+  for (size_t i = 0; i < encoders_.size(); ++i) {
+    active_map_trackers_[i].OnFrame(frame, raw_images_[i].d_w,
+                                    raw_images_[i].d_h);
+  }
   vpx_enc_frame_flags_t flags[kMaxSimulcastStreams];
   for (size_t i = 0; i < encoders_.size(); ++i) {
     int ret = temporal_layers_[i]->EncodeFlags(frame.timestamp());
@@ -859,6 +840,23 @@ int VP8EncoderImpl::Encode(const VideoFrame& frame,
     vpx_codec_control(&encoders_[i], VP8E_SET_FRAME_FLAGS, flags[stream_idx]);
     vpx_codec_control(&encoders_[i], VP8E_SET_TEMPORAL_LAYER_ID,
                       temporal_layers_[stream_idx]->CurrentLayerId());
+
+    // Macroblocks outside of the active map are copied from the last frame,
+    // so the map can't be used if the frame may not reference it. libvpx
+    // ignores maps that don't match the size it encodes at, so none is used
+    // if it may resize internally.
+    vpx_active_map_t active_map;
+    active_map.active_map = nullptr;
+    active_map.rows = active_map_trackers_[i].rows();
+    active_map.cols = active_map_trackers_[i].cols();
+    const bool references_last_frame =
+        (flags[stream_idx] & (VPX_EFLAG_FORCE_KF | VP8_EFLAG_NO_REF_LAST)) == 0;
+    if (references_last_frame && !configurations_[i].rc_resize_allowed &&
+        active_map_trackers_[i].BuildActiveMap()) {
+      active_map.active_map =
+          const_cast<uint8_t*>(active_map_trackers_[i].active_map());
+    }
+    vpx_codec_control(&encoders_[i], VP8E_SET_ACTIVEMAP, &active_map);
   }
   // TODO(holmer): Ideally the duration should be the timestamp diff of this
   // frame and the next frame to be encoded, which we don't have. Instead we
@@ -881,7 +879,15 @@ int VP8EncoderImpl::Encode(const VideoFrame& frame,
     return WEBRTC_VIDEO_CODEC_ERROR;
   timestamp_ += duration;
   // Examines frame timestamps only.
-  return GetEncodedPartitions(frame, only_predict_from_key_frame);
+  int result = GetEncodedPartitions(frame, only_predict_from_key_frame);
+  stream_idx = encoders_.size() - 1;
+  for (size_t i = 0; i < encoders_.size(); ++i, --stream_idx) {
+    if (encoded_images_[i]._length > 0 &&
+        (flags[stream_idx] & VP8_EFLAG_NO_UPD_LAST) == 0) {
+      active_map_trackers_[i].OnLastFrameUpdated();
+    }
+  }
+  return result;
 }
 
 // TODO(pbos): Make sure this works for properly for >1 encoders.
@@ -896,6 +902,10 @@ int VP8EncoderImpl::UpdateCodecFrameSize(int width, int height) {
   // Update the cpu_speed setting for resolution change.
   vpx_codec_control(&(encoders_[0]), VP8E_SET_CPUUSED,
                     SetCpuSpeed(codec_.width, codec_.height));
+  if (thread_policy_.SetResolution(codec_.width, codec_.height)) {
+    configurations_[0].g_threads = thread_policy_.settings().threads;
+    SetTokenPartitions(thread_policy_.settings().partitions);
+  }
   raw_images_[0].w = codec_.width;
   raw_images_[0].h = codec_.height;
   raw_images_[0].d_w = codec_.width;
@@ -912,6 +922,14 @@ int VP8EncoderImpl::UpdateCodecFrameSize(int width, int height) {
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
+void VP8EncoderImpl::SetTokenPartitions(int token_partitions) {
+  token_partitions_ = token_partitions;
+  for (size_t i = 0; i < encoders_.size(); ++i) {
+    vpx_codec_control(&(encoders_[i]), VP8E_SET_TOKEN_PARTITIONS,
+                      static_cast<vp8e_token_partitions>(token_partitions_));
+  }
+}
+
 void VP8EncoderImpl::PopulateCodecSpecific(
     CodecSpecificInfo* codec_specific,
     const vpx_codec_cx_pkt_t& pkt,
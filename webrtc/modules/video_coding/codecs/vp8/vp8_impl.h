@@ -27,6 +27,8 @@
 #include "webrtc/modules/video_coding/include/video_codec_interface.h"
 #include "webrtc/modules/video_coding/codecs/vp8/include/vp8.h"
 #include "webrtc/modules/video_coding/codecs/vp8/reference_picture_selection.h"
+#include "webrtc/modules/video_coding/utility/active_map_tracker.h"
+#include "webrtc/modules/video_coding/utility/encoder_thread_policy.h"
 #include "webrtc/modules/video_coding/utility/quality_scaler.h"
 #include "webrtc/video_frame.h"
 
@@ -69,15 +71,14 @@ class VP8EncoderImpl : public VP8Encoder {
   // Set the cpu_speed setting for encoder based on resolution and/or platform.
   int SetCpuSpeed(int width, int height);
 
-  // Determine number of encoder threads to use.
-  int NumberOfThreads(int width, int height, int number_of_cores);
-
   // Call encoder initialize function and set control settings.
   int InitAndSetControlSettings();
 
   // Update frame size for codec.
   int UpdateCodecFrameSize(int width, int height);
 
+  void SetTokenPartitions(int token_partitions);
+
   void PopulateCodecSpecific(CodecSpecificInfo* codec_specific,
                              const vpx_codec_cx_pkt& pkt,
                              int stream_idx,
@@ -119,6 +120,9 @@ class VP8EncoderImpl : public VP8Encoder {
   std::vector<vpx_rational_t> downsampling_factors_;
   QualityScaler quality_scaler_;
   bool quality_scaler_enabled_;
+  EncoderThreadPolicy thread_policy_;
+  // Per encoder, in the order of |encoders_|.
+  std::vector<ActiveMapTracker> active_map_trackers_;
 };  // end of VP8EncoderImpl class
 
 class VP8DecoderImpl : public VP8Decoder {
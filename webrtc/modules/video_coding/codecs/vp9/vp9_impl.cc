@@ -210,6 +210,7 @@ int VP9EncoderImpl::SetRates(uint32_t new_bitrate_kbit,
   }
   config_->rc_target_bitrate = new_bitrate_kbit;
   codec_.maxFramerate = new_framerate;
+  thread_policy_.SetFramerate(new_framerate);
   spatial_layer_->ConfigureBitrate(new_bitrate_kbit, 0);
 
   if (!SetSvcRates()) {
@@ -321,8 +322,10 @@ int VP9EncoderImpl::InitEncode(const VideoCodec* inst,
   }
   config_->rc_resize_allowed = inst->VP9().automaticResizeOn ? 1 : 0;
   // Determine number of threads based on the image size and #cores.
-  config_->g_threads =
-      NumberOfThreads(config_->g_w, config_->g_h, number_of_cores);
+  thread_policy_.Init(kVideoCodecVP9, config_->g_w, config_->g_h,
+                      number_of_cores, inst->maxFramerate);
+  config_->g_threads = thread_policy_.settings().threads;
+  active_map_tracker_ = ActiveMapTracker();
 
   cpu_speed_ = GetCpuSpeed(config_->g_w, config_->g_h);
 
@@ -371,21 +374,6 @@ int VP9EncoderImpl::InitEncode(const VideoCodec* inst,
   return InitAndSetControlSettings(inst);
 }
 
-int VP9EncoderImpl::NumberOfThreads(int width,
-                                    int height,
-                                    int number_of_cores) {
-  // Keep the number of encoder threads equal to the possible number of column
-  // tiles, which is (1, 2, 4, 8). See comments below for VP9E_SET_TILE_COLUMNS.
-  if (width * height >= 1280 * 720 && number_of_cores > 4) {
-    return 4;
-  } else if (width * height >= 640 * 480 && number_of_cores > 2) {
-    return 2;
-  } else {
-    // 1 thread less than VGA.
-    return 1;
-  }
-}
-
 int VP9EncoderImpl::InitAndSetControlSettings(const VideoCodec* inst) {
   // Set QP-min/max per spatial and temporal layer.
   int tot_num_layers = num_spatial_layers_ * num_temporal_layers_;
@@ -442,7 +430,8 @@ int VP9EncoderImpl::InitAndSetControlSettings(const VideoCodec* inst) {
   // log2 unit: e.g., 0 = 1 tile column, 1 = 2 tile columns, 2 = 4 tile columns.
   // The number tile columns will be capped by the encoder based on image size
   // (minimum width of tile column is 256 pixels, maximum is 4096).
-  vpx_codec_control(encoder_, VP9E_SET_TILE_COLUMNS, (config_->g_threads >> 1));
+  vpx_codec_control(encoder_, VP9E_SET_TILE_COLUMNS,
+                    thread_policy_.settings().partitions);
 #if !defined(WEBRTC_ARCH_ARM) && !defined(WEBRTC_ARCH_ARM64) && \
   !defined(ANDROID)
   // Note denoiser is still off by default until further testing/optimization,
@@ -542,14 +531,49 @@ int VP9EncoderImpl::Encode(const VideoFrame& input_image,
     vpx_codec_control(encoder_, VP9E_SET_SVC_REF_FRAME_CONFIG, &enc_layer_conf);
   }
 
+  // Macroblocks outside of the active map are copied from the last frame.
+  // With several layers, the last frame buffer may hold another layer than
+  // the one being encoded, so the map is only used for single layer streams.
+  // libvpx ignores maps that don't match the size it encodes at, so none is
+  // used if it may resize internally.
+  const bool single_layer = num_spatial_layers_ == 1 &&
+                            num_temporal_layers_ == 1 && !is_flexible_mode_;
+  active_map_tracker_.OnFrame(input_image, raw_->d_w, raw_->d_h);
+  vpx_active_map_t active_map;
+  active_map.active_map = nullptr;
+  active_map.rows = active_map_tracker_.rows();
+  active_map.cols = active_map_tracker_.cols();
+  if (single_layer && !send_keyframe && !config_->rc_resize_allowed &&
+      active_map_tracker_.BuildActiveMap()) {
+    active_map.active_map =
+        const_cast<uint8_t*>(active_map_tracker_.active_map());
+  }
+  vpx_codec_control(encoder_, VP9E_SET_ACTIVEMAP, &active_map);
+
   assert(codec_.maxFramerate > 0);
   uint32_t duration = 90000 / codec_.maxFramerate;
+  int64_t encode_start_us = rtc::TimeMicros();
+  encoded_image_._length = 0;
   if (vpx_codec_encode(encoder_, raw_, timestamp_, duration, flags,
                        VPX_DL_REALTIME)) {
     return WEBRTC_VIDEO_CODEC_ERROR;
   }
   timestamp_ += duration;
-
+  // Frames that are not dropped update the last frame buffer.
+  if (single_layer && encoded_image_._length > 0)
+    active_map_tracker_.OnLastFrameUpdated();
+
+  // Tile columns are signaled per frame, so tiling can change without a key
+  // frame. The thread count never goes above the one at InitEncode(), since
+  // libvpx allocates its tile workers for that count on the first frame.
+  if (thread_policy_.OnFrameEncoded(
+          static_cast<int>(rtc::TimeMicros() - encode_start_us))) {
+    config_->g_threads = thread_policy_.settings().threads;
+    if (vpx_codec_enc_config_set(encoder_, config_))
+      return WEBRTC_VIDEO_CODEC_ERROR;
+    vpx_codec_control(encoder_, VP9E_SET_TILE_COLUMNS,
+                      thread_policy_.settings().partitions);
+  }
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
@@ -17,6 +17,8 @@
 
 #include "webrtc/modules/video_coding/codecs/vp9/include/vp9.h"
 #include "webrtc/modules/video_coding/codecs/vp9/vp9_frame_buffer_pool.h"
+#include "webrtc/modules/video_coding/utility/active_map_tracker.h"
+#include "webrtc/modules/video_coding/utility/encoder_thread_policy.h"
 
 #include "vpx/svc_context.h"
 #include "vpx/vpx_decoder.h"
@@ -48,7 +50,7 @@ class VP9EncoderImpl : public VP9Encoder {
 
   int SetRates(uint32_t new_bitrate_kbit, uint32_t frame_rate) override;
 
-  void OnDroppedFrame() override {}
+  void OnDroppedFrame() override { active_map_tracker_.OnDroppedFrame(); }
 
   const char* ImplementationName() const override;
 
@@ -67,9 +69,6 @@ class VP9EncoderImpl : public VP9Encoder {
   };
 
  private:
-  // Determine number of encoder threads to use.
-  int NumberOfThreads(int width, int height, int number_of_cores);
-
   // Call encoder initialize function and set control settings.
   int InitAndSetControlSettings(const VideoCodec* inst);
 
@@ -130,6 +129,8 @@ class VP9EncoderImpl : public VP9Encoder {
   uint8_t num_ref_pics_[kMaxVp9NumberOfSpatialLayers];
   uint8_t p_diff_[kMaxVp9NumberOfSpatialLayers][kMaxVp9RefPics];
   std::unique_ptr<ScreenshareLayersVP9> spatial_layer_;
+  EncoderThreadPolicy thread_policy_;
+  ActiveMapTracker active_map_tracker_;
 };
 
 class VP9DecoderImpl : public VP9Decoder {
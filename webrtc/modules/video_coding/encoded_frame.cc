@@ -88,6 +88,7 @@ void VCMEncodedFrame::Reset() {
   _codec = kVideoCodecUnknown;
   rotation_ = kVideoRotation_0;
   _rotation_set = false;
+  timing_ = VideoFrameTiming();
 }
 
 void VCMEncodedFrame::CopyCodecSpecific(const RTPVideoHeader* header) {
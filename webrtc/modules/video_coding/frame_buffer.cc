@@ -101,6 +101,7 @@ VCMFrameBufferEnum VCMFrameBuffer::InsertPacket(
     // We only take the ntp timestamp of the first packet of a frame.
     ntp_time_ms_ = packet.ntp_time_ms_;
     _codec = packet.codec;
+    timing_.set_time_ms(VideoFrameTiming::kFirstPacket, timeInMs);
     if (packet.frameType != kEmptyFrame) {
       // first media packet
       SetState(kStateIncomplete);
@@ -159,6 +160,7 @@ VCMFrameBufferEnum VCMFrameBuffer::InsertPacket(
     RTC_DCHECK(!_rotation_set);
     rotation_ = packet.video_header.rotation;
     _rotation_set = true;
+    timing_.set_time_ms(VideoFrameTiming::kLastPacket, timeInMs);
   }
 
   if (packet.isFirstPacket) {
@@ -167,6 +169,8 @@ VCMFrameBufferEnum VCMFrameBuffer::InsertPacket(
 
   if (_sessionInfo.complete()) {
     SetState(kStateComplete);
+    if (timing_.time_ms(VideoFrameTiming::kComplete) < 0)
+      timing_.set_time_ms(VideoFrameTiming::kComplete, timeInMs);
     return kCompleteSession;
   } else if (_sessionInfo.decodable()) {
     SetState(kStateDecodable);
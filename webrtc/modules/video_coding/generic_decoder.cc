@@ -76,6 +76,9 @@ int32_t VCMDecodedFrameCallback::Decoded(VideoFrame& decodedImage,
 
   decodedImage.set_render_time_ms(frameInfo->renderTimeMs);
   decodedImage.set_rotation(frameInfo->rotation);
+  VideoFrameTiming timing = frameInfo->timing;
+  timing.set_time_ms(VideoFrameTiming::kDecodeEnd, now_ms);
+  decodedImage.set_timing(timing);
   // TODO(sakal): Investigate why callback is NULL sometimes and replace if
   // statement with a DCHECK.
   if (callback) {
@@ -151,6 +154,9 @@ int32_t VCMGenericDecoder::Decode(const VCMEncodedFrame& frame, int64_t nowMs) {
     _frameInfos[_nextFrameInfoIdx].decodeStartTimeMs = nowMs;
     _frameInfos[_nextFrameInfoIdx].renderTimeMs = frame.RenderTimeMs();
     _frameInfos[_nextFrameInfoIdx].rotation = frame.rotation();
+    _frameInfos[_nextFrameInfoIdx].timing = frame.EncodedImage().timing_;
+    _frameInfos[_nextFrameInfoIdx].timing.set_time_ms(
+        VideoFrameTiming::kDecodeStart, nowMs);
     _callback->Map(frame.TimeStamp(), &_frameInfos[_nextFrameInfoIdx]);
 
     _nextFrameInfoIdx = (_nextFrameInfoIdx + 1) % kDecoderFrameMemoryLength;
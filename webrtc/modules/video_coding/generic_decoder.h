@@ -28,6 +28,7 @@ struct VCMFrameInformation {
   int64_t decodeStartTimeMs;
   void* userData;
   VideoRotation rotation;
+  VideoFrameTiming timing;
 };
 
 class VCMDecodedFrameCallback : public DecodedImageCallback {
@@ -0,0 +1,98 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/video_coding/utility/active_map_tracker.h"
+
+#include <algorithm>
+
+#include "webrtc/system_wrappers/include/field_trial.h"
+
+namespace webrtc {
+
+namespace {
+const char kActiveMapsFieldTrial[] = "WebRTC-ActiveMaps";
+const int kMacroblockSize = 16;
+// Macroblocks next to a change are encoded too, since the loop filter
+// smooths the edges between them and the changed macroblocks.
+const int kPaddingMacroblocks = 1;
+}  // namespace
+
+ActiveMapTracker::ActiveMapTracker()
+    : enabled_(field_trial::FindFullName(kActiveMapsFieldTrial) != "Disabled"),
+      input_width_(0),
+      input_height_(0),
+      width_(0),
+      height_(0),
+      rows_(0),
+      cols_(0),
+      changes_known_(false),
+      changed_rect_({0, 0, 0, 0}) {}
+
+void ActiveMapTracker::OnFrame(const VideoFrame& frame, int width, int height) {
+  if (frame.width() != input_width_ || frame.height() != input_height_ ||
+      width != width_ || height != height_) {
+    input_width_ = frame.width();
+    input_height_ = frame.height();
+    width_ = width;
+    height_ = height;
+    rows_ = (height + kMacroblockSize - 1) / kMacroblockSize;
+    cols_ = (width + kMacroblockSize - 1) / kMacroblockSize;
+    changes_known_ = false;
+  }
+  if (!frame.update_rect()) {
+    changes_known_ = false;
+  } else if (changes_known_) {
+    changed_rect_.Union(*frame.update_rect());
+  }
+}
+
+void ActiveMapTracker::OnDroppedFrame() {
+  changes_known_ = false;
+}
+
+void ActiveMapTracker::OnLastFrameUpdated() {
+  changes_known_ = true;
+  changed_rect_ = {0, 0, 0, 0};
+}
+
+bool ActiveMapTracker::BuildActiveMap() {
+  if (!enabled_ || !changes_known_ || input_width_ <= 0 || input_height_ <= 0)
+    return false;
+  active_map_.assign(rows_ * cols_, 0);
+  if (changed_rect_.IsEmpty())
+    return true;
+
+  // Scale to the encoded resolution, rounding outwards.
+  const int left = changed_rect_.offset_x * width_ / input_width_;
+  const int top = changed_rect_.offset_y * height_ / input_height_;
+  const int right = ((changed_rect_.offset_x + changed_rect_.width) * width_ +
+                     input_width_ - 1) / input_width_;
+  const int bottom =
+      ((changed_rect_.offset_y + changed_rect_.height) * height_ +
+       input_height_ - 1) / input_height_;
+
+  const int first_col = std::max(left / kMacroblockSize - kPaddingMacroblocks,
+                                 0);
+  const int last_col = std::min(
+      (right - 1) / kMacroblockSize + kPaddingMacroblocks, cols_ - 1);
+  const int first_row = std::max(top / kMacroblockSize - kPaddingMacroblocks,
+                                 0);
+  const int last_row = std::min(
+      (bottom - 1) / kMacroblockSize + kPaddingMacroblocks, rows_ - 1);
+  if (first_col > last_col)
+    return true;
+  for (int row = first_row; row <= last_row; ++row) {
+    std::fill(active_map_.begin() + row * cols_ + first_col,
+              active_map_.begin() + row * cols_ + last_col + 1, 1);
+  }
+  return true;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,78 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_VIDEO_CODING_UTILITY_ACTIVE_MAP_TRACKER_H_
+#define WEBRTC_MODULES_VIDEO_CODING_UTILITY_ACTIVE_MAP_TRACKER_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "webrtc/video_frame.h"
+
+namespace webrtc {
+
+// Builds libvpx active maps from VideoFrame::update_rect() for one encoded
+// stream. libvpx codes the macroblocks outside of the active map as unchanged
+// from the last frame without analyzing them, which saves most of the encode
+// time of mostly static screen content.
+//
+// A macroblock can only be skipped if it has not changed since the frame in
+// the last frame buffer, which need not be the previous frame, e.g. with
+// temporal layers or after a dropped frame. The tracker therefore adds up the
+// update rects of all frames since the last frame buffer was updated.
+//
+// Active maps can be turned off with the field trial
+// "WebRTC-ActiveMaps/Disabled/", e.g. to compare encode usage.
+class ActiveMapTracker {
+ public:
+  ActiveMapTracker();
+
+  // Adds the changes of |frame|, which is encoded at |width| x |height|,
+  // possibly after scaling. The changes become unknown if |frame| has no
+  // update rect, or if a resolution changed.
+  void OnFrame(const VideoFrame& frame, int width, int height);
+
+  // A frame was dropped before it reached the encoder. Its changes are
+  // unknown.
+  void OnDroppedFrame();
+
+  // The frame passed to the last OnFrame() call was encoded into the last
+  // frame buffer.
+  void OnLastFrameUpdated();
+
+  // Builds the active map for the frame passed to the last OnFrame() call.
+  // Returns false if all macroblocks must be encoded, or if active maps are
+  // disabled.
+  bool BuildActiveMap();
+
+  // One entry per 16x16 macroblock, row by row, which is 1 if the macroblock
+  // must be encoded.
+  const uint8_t* active_map() const { return active_map_.data(); }
+  int rows() const { return rows_; }
+  int cols() const { return cols_; }
+
+ private:
+  bool enabled_;
+  int input_width_;
+  int input_height_;
+  int width_;
+  int height_;
+  int rows_;
+  int cols_;
+  bool changes_known_;
+  // In input frame coordinates.
+  VideoFrame::UpdateRect changed_rect_;
+  std::vector<uint8_t> active_map_;
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_VIDEO_CODING_UTILITY_ACTIVE_MAP_TRACKER_H_
@@ -0,0 +1,133 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/video_coding/utility/active_map_tracker.h"
+
+#include "webrtc/test/field_trial.h"
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+namespace {
+const int kWidth = 320;
+const int kHeight = 240;
+
+VideoFrame CreateFrame(int width, int height) {
+  return VideoFrame(I420Buffer::Create(width, height), kVideoRotation_0, 0);
+}
+
+VideoFrame CreateFrame(const VideoFrame::UpdateRect& update_rect) {
+  VideoFrame frame = CreateFrame(kWidth, kHeight);
+  frame.set_update_rect(rtc::Optional<VideoFrame::UpdateRect>(update_rect));
+  return frame;
+}
+
+int CountActive(const ActiveMapTracker& tracker) {
+  int active = 0;
+  for (int i = 0; i < tracker.rows() * tracker.cols(); ++i)
+    active += tracker.active_map()[i];
+  return active;
+}
+}  // namespace
+
+TEST(ActiveMapTrackerTest, EncodesEverythingUntilLastFrameIsKnown) {
+  ActiveMapTracker tracker;
+  tracker.OnFrame(CreateFrame({0, 0, 16, 16}), kWidth, kHeight);
+  EXPECT_FALSE(tracker.BuildActiveMap());
+  EXPECT_EQ(15, tracker.rows());
+  EXPECT_EQ(20, tracker.cols());
+
+  tracker.OnLastFrameUpdated();
+  tracker.OnFrame(CreateFrame({0, 0, 0, 0}), kWidth, kHeight);
+  ASSERT_TRUE(tracker.BuildActiveMap());
+  EXPECT_EQ(0, CountActive(tracker));
+}
+
+TEST(ActiveMapTrackerTest, MarksChangedMacroblocksAndNeighbors) {
+  ActiveMapTracker tracker;
+  tracker.OnFrame(CreateFrame(kWidth, kHeight), kWidth, kHeight);
+  tracker.OnLastFrameUpdated();
+
+  // Macroblock columns 2 to 3 and row 1.
+  tracker.OnFrame(CreateFrame({40, 20, 20, 8}), kWidth, kHeight);
+  ASSERT_TRUE(tracker.BuildActiveMap());
+  EXPECT_EQ(4 * 3, CountActive(tracker));
+  const uint8_t* map = tracker.active_map();
+  EXPECT_EQ(1, map[0 * 20 + 1]);
+  EXPECT_EQ(1, map[2 * 20 + 4]);
+  EXPECT_EQ(0, map[0 * 20 + 0]);
+  EXPECT_EQ(0, map[3 * 20 + 2]);
+  EXPECT_EQ(0, map[1 * 20 + 5]);
+}
+
+TEST(ActiveMapTrackerTest, AddsUpChangesUntilLastFrameIsUpdated) {
+  ActiveMapTracker tracker;
+  tracker.OnFrame(CreateFrame(kWidth, kHeight), kWidth, kHeight);
+  tracker.OnLastFrameUpdated();
+
+  tracker.OnFrame(CreateFrame({0, 0, 16, 16}), kWidth, kHeight);
+  ASSERT_TRUE(tracker.BuildActiveMap());
+  EXPECT_EQ(2 * 2, CountActive(tracker));
+
+  // The last frame was not updated, e.g. by an upper temporal layer frame.
+  tracker.OnFrame(CreateFrame({32, 0, 16, 16}), kWidth, kHeight);
+  ASSERT_TRUE(tracker.BuildActiveMap());
+  EXPECT_EQ(4 * 2, CountActive(tracker));
+  EXPECT_EQ(1, tracker.active_map()[0]);
+
+  tracker.OnLastFrameUpdated();
+  tracker.OnFrame(CreateFrame({32, 0, 16, 16}), kWidth, kHeight);
+  ASSERT_TRUE(tracker.BuildActiveMap());
+  EXPECT_EQ(3 * 2, CountActive(tracker));
+  EXPECT_EQ(0, tracker.active_map()[0]);
+}
+
+TEST(ActiveMapTrackerTest, ScalesToEncodedResolution) {
+  ActiveMapTracker tracker;
+  tracker.OnFrame(CreateFrame(kWidth, kHeight), kWidth / 2, kHeight / 2);
+  tracker.OnLastFrameUpdated();
+
+  // Scaled to the first macroblock.
+  tracker.OnFrame(CreateFrame({0, 0, 32, 32}), kWidth / 2, kHeight / 2);
+  ASSERT_TRUE(tracker.BuildActiveMap());
+  EXPECT_EQ(8, tracker.rows());
+  EXPECT_EQ(10, tracker.cols());
+  EXPECT_EQ(2 * 2, CountActive(tracker));
+}
+
+TEST(ActiveMapTrackerTest, UnknownChangesEncodeEverything) {
+  ActiveMapTracker tracker;
+  tracker.OnFrame(CreateFrame(kWidth, kHeight), kWidth, kHeight);
+  tracker.OnLastFrameUpdated();
+  tracker.OnFrame(CreateFrame(kWidth, kHeight), kWidth, kHeight);
+  EXPECT_FALSE(tracker.BuildActiveMap());
+
+  tracker.OnLastFrameUpdated();
+  tracker.OnDroppedFrame();
+  tracker.OnFrame(CreateFrame({0, 0, 0, 0}), kWidth, kHeight);
+  EXPECT_FALSE(tracker.BuildActiveMap());
+
+  tracker.OnLastFrameUpdated();
+  tracker.OnFrame(CreateFrame({0, 0, 0, 0}), kWidth, kHeight);
+  EXPECT_TRUE(tracker.BuildActiveMap());
+  // A new resolution.
+  tracker.OnFrame(CreateFrame({0, 0, 0, 0}), kWidth / 2, kHeight / 2);
+  EXPECT_FALSE(tracker.BuildActiveMap());
+}
+
+TEST(ActiveMapTrackerTest, FieldTrialDisablesActiveMaps) {
+  test::ScopedFieldTrials field_trials("WebRTC-ActiveMaps/Disabled/");
+  ActiveMapTracker tracker;
+  tracker.OnFrame(CreateFrame({0, 0, 0, 0}), kWidth, kHeight);
+  tracker.OnLastFrameUpdated();
+  tracker.OnFrame(CreateFrame({0, 0, 0, 0}), kWidth, kHeight);
+  EXPECT_FALSE(tracker.BuildActiveMap());
+}
+
+}  // namespace webrtc
@@ -0,0 +1,227 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/video_coding/utility/encoder_thread_policy.h"
+
+#include <algorithm>
+
+#include "webrtc/base/checks.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/system_wrappers/include/field_trial.h"
+
+namespace webrtc {
+
+namespace {
+const char kAdaptationFieldTrial[] = "WebRTC-EncoderThreadAdaptation";
+// Opts VP8 into one token partition per thread. This changes the bitstream,
+// so VP8 uses one token partition unless the field trial is "Enabled".
+const char kVp8TokenPartitionsFieldTrial[] =
+    "WebRTC-VP8TokenPartitionsPerThread";
+// VP9 tile columns are at least 256 pixels wide.
+const int kMinVp9TileWidth = 256;
+// Encode times are averaged over about a second, but no less than this many
+// frames, before the thread count is reconsidered.
+const int kMinFramesPerCheck = 10;
+// Add a thread back when frames take more than this share of the frame
+// interval.
+const int kHighUsagePercent = 85;
+// Remove a thread when frames are estimated to take less than this share of
+// the frame interval with one thread less.
+const int kLowUsagePercent = 50;
+
+int FloorLog2(int value) {
+  int log2 = 0;
+  while ((2 << log2) <= value)
+    ++log2;
+  return log2;
+}
+}  // namespace
+
+EncoderThreadPolicy::EncoderThreadPolicy()
+    : codec_type_(kVideoCodecUnknown),
+      width_(0),
+      height_(0),
+      number_of_cores_(1),
+      framerate_(1),
+      adapt_at_runtime_(false),
+      vp8_token_partitions_per_thread_(false),
+      init_threads_(1),
+      settings_({1, 0}),
+      encode_time_sum_us_(0),
+      encoded_frames_(0) {}
+
+void EncoderThreadPolicy::Init(VideoCodecType codec_type,
+                               int width,
+                               int height,
+                               int number_of_cores,
+                               int framerate) {
+  RTC_DCHECK(codec_type == kVideoCodecVP8 || codec_type == kVideoCodecVP9 ||
+             codec_type == kVideoCodecH264);
+  codec_type_ = codec_type;
+  width_ = width;
+  height_ = height;
+  number_of_cores_ = std::max(number_of_cores, 1);
+  framerate_ = std::max(framerate, 1);
+  // libvpx VP8 keeps running all the threads it was initialized with, so a
+  // lower thread count at runtime would only change the token partitions, and
+  // not save any CPU. OpenH264 only takes a new thread count when it is
+  // reinitialized, which produces a key frame.
+  adapt_at_runtime_ =
+      codec_type == kVideoCodecVP9 &&
+      field_trial::FindFullName(kAdaptationFieldTrial) != "Disabled";
+  vp8_token_partitions_per_thread_ =
+      codec_type == kVideoCodecVP8 &&
+      field_trial::FindFullName(kVp8TokenPartitionsFieldTrial) == "Enabled";
+  init_threads_ =
+      DefaultThreads(codec_type_, width_, height_, number_of_cores_);
+  settings_ = SettingsForThreads(init_threads_);
+  ResetMeasurements();
+}
+
+bool EncoderThreadPolicy::SetResolution(int width, int height) {
+  if (width == width_ && height == height_)
+    return false;
+  width_ = width;
+  height_ = height;
+  ResetMeasurements();
+  Settings settings = SettingsForThreads(std::min(
+      DefaultThreads(codec_type_, width_, height_, number_of_cores_),
+      MaxThreads()));
+  if (settings == settings_)
+    return false;
+  settings_ = settings;
+  return true;
+}
+
+void EncoderThreadPolicy::SetFramerate(int framerate) {
+  framerate_ = std::max(framerate, 1);
+}
+
+bool EncoderThreadPolicy::OnFrameEncoded(int encode_time_us) {
+  if (!adapt_at_runtime_)
+    return false;
+  encode_time_sum_us_ += encode_time_us;
+  ++encoded_frames_;
+  if (encoded_frames_ < std::max(framerate_, kMinFramesPerCheck))
+    return false;
+
+  int64_t avg_encode_time_us = encode_time_sum_us_ / encoded_frames_;
+  int64_t frame_interval_us = rtc::kNumMicrosecsPerSec / framerate_;
+  ResetMeasurements();
+
+  // VP9 threads are kept equal to the number of tile columns, which is a
+  // power of two.
+  const bool power_of_two = codec_type_ == kVideoCodecVP9;
+  int threads = settings_.threads;
+  if (avg_encode_time_us * 100 > frame_interval_us * kHighUsagePercent) {
+    threads = std::min(power_of_two ? threads * 2 : threads + 1, MaxThreads());
+  } else if (threads > 1) {
+    int fewer_threads = power_of_two ? threads / 2 : threads - 1;
+    // Assumes the encode time scales linearly with the number of threads,
+    // which overestimates the time it would take with fewer threads.
+    int64_t estimated_time_us = avg_encode_time_us * threads / fewer_threads;
+    if (estimated_time_us * 100 < frame_interval_us * kLowUsagePercent)
+      threads = fewer_threads;
+  }
+  Settings settings = SettingsForThreads(threads);
+  if (settings == settings_)
+    return false;
+  settings_ = settings;
+  return true;
+}
+
+int EncoderThreadPolicy::DefaultThreads(VideoCodecType codec_type,
+                                        int width,
+                                        int height,
+                                        int number_of_cores) {
+  switch (codec_type) {
+    case kVideoCodecVP8:
+#if defined(ANDROID)
+      if (width * height >= 320 * 180) {
+        if (number_of_cores >= 4) {
+          // 3 threads for CPUs with 4 and more cores since most of times only
+          // 4 cores will be active.
+          return 3;
+        } else if (number_of_cores == 3 || number_of_cores == 2) {
+          return 2;
+        }
+      }
+      return 1;
+#else
+      if (width * height >= 1920 * 1080 && number_of_cores > 8) {
+        return 8;  // 8 threads for 1080p on high perf machines.
+      } else if (width * height > 1280 * 960 && number_of_cores >= 6) {
+        return 3;  // 3 threads for 1080p.
+      } else if (width * height > 640 * 480 && number_of_cores >= 3) {
+        return 2;  // 2 threads for qHD/HD.
+      }
+      return 1;  // 1 thread for VGA or less.
+#endif
+    case kVideoCodecH264:
+      // TODO(hbos): In Chromium, multiple threads do not work with sandbox on
+      // Mac, see crbug.com/583348.
+      // TODO(sprang): The OpenH264 rate controller misbehaves with more than
+      // one slice, and slices follow the thread count. Until both are
+      // investigated, only use one thread.
+      return 1;
+    case kVideoCodecVP9:
+      // Keep the number of threads equal to the possible number of column
+      // tiles, which is (1, 2, 4, 8).
+      if (width * height >= 1280 * 720 && number_of_cores > 4) {
+        return 4;
+      } else if (width * height >= 640 * 480 && number_of_cores > 2) {
+        return 2;
+      }
+      return 1;  // 1 thread less than VGA.
+    default:
+      return 1;
+  }
+}
+
+int EncoderThreadPolicy::MaxThreads() const {
+  int max_threads = init_threads_;
+  if (codec_type_ == kVideoCodecVP9) {
+    max_threads = std::min(max_threads, std::max(width_ / kMinVp9TileWidth, 1));
+    max_threads = 1 << FloorLog2(max_threads);
+  }
+  return max_threads;
+}
+
+EncoderThreadPolicy::Settings EncoderThreadPolicy::SettingsForThreads(
+    int threads) const {
+  Settings settings;
+  settings.threads = threads;
+  switch (codec_type_) {
+    case kVideoCodecVP8:
+      // One token partition per thread, rounded up, if opted into; VP8 allows
+      // up to 8.
+      settings.partitions = vp8_token_partitions_per_thread_
+                                ? std::min(FloorLog2(2 * threads - 1), 3)
+                                : 0;
+      break;
+    case kVideoCodecVP9:
+      settings.partitions = FloorLog2(threads);
+      break;
+    case kVideoCodecH264:
+      settings.partitions = threads;
+      break;
+    default:
+      settings.partitions = 0;
+      break;
+  }
+  return settings;
+}
+
+void EncoderThreadPolicy::ResetMeasurements() {
+  encode_time_sum_us_ = 0;
+  encoded_frames_ = 0;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,99 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_VIDEO_CODING_UTILITY_ENCODER_THREAD_POLICY_H_
+#define WEBRTC_MODULES_VIDEO_CODING_UTILITY_ENCODER_THREAD_POLICY_H_
+
+#include <stdint.h>
+
+#include "webrtc/common_types.h"
+
+namespace webrtc {
+
+// Chooses the number of threads used by the VP8, VP9 and H.264 encoders, and
+// how a frame is split up between them, from the resolution, the number of
+// cores and the measured encode time per frame. The thread count starts out
+// from a resolution/core table. For VP9, it is lowered while frames are cheap
+// to encode, and is raised again while they take close to the frame interval.
+// VP8 and H.264 keep the table's count until the resolution changes.
+//
+// It never goes above the count the encoder was initialized with: libvpx
+// starts its worker threads at init and cannot run more later. This also
+// keeps a busy host, where frames take longer because the encoder threads wait
+// for a core, from getting even more threads competing for the cores.
+class EncoderThreadPolicy {
+ public:
+  struct Settings {
+    bool operator==(const Settings& o) const {
+      return threads == o.threads && partitions == o.partitions;
+    }
+    bool operator!=(const Settings& o) const { return !(*this == o); }
+
+    int threads;
+    // VP8: log2 of the number of token partitions, 0 unless opted into one
+    // per thread by the field trial WebRTC-VP8TokenPartitionsPerThread.
+    // VP9: log2 of the number of tile columns.
+    // H.264: the number of slices.
+    int partitions;
+  };
+
+  EncoderThreadPolicy();
+
+  // Resets the policy for a new encoder configuration.
+  void Init(VideoCodecType codec_type,
+            int width,
+            int height,
+            int number_of_cores,
+            int framerate);
+
+  // Updates the resolution, e.g. after internal downscaling, and starts over
+  // from the resolution/core table, capped at the thread count given at
+  // Init(). Returns true if settings() changed.
+  bool SetResolution(int width, int height);
+
+  void SetFramerate(int framerate);
+
+  // Reports the time it took to encode a frame. Returns true if settings()
+  // changed and should be applied to the encoder. Changes are only made if
+  // the codec can apply them without a key frame.
+  bool OnFrameEncoded(int encode_time_us);
+
+  const Settings& settings() const { return settings_; }
+
+  // Thread count used before any encode time has been measured.
+  static int DefaultThreads(VideoCodecType codec_type,
+                            int width,
+                            int height,
+                            int number_of_cores);
+
+ private:
+  int MaxThreads() const;
+  Settings SettingsForThreads(int threads) const;
+  void ResetMeasurements();
+
+  VideoCodecType codec_type_;
+  int width_;
+  int height_;
+  int number_of_cores_;
+  int framerate_;
+  // False if the codec can't use fewer threads without being reinitialized, or
+  // if runtime adaptation is disabled by field trial.
+  bool adapt_at_runtime_;
+  bool vp8_token_partitions_per_thread_;
+  // Thread count chosen by Init(), which the encoder was initialized with.
+  int init_threads_;
+  Settings settings_;
+  int64_t encode_time_sum_us_;
+  int encoded_frames_;
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_VIDEO_CODING_UTILITY_ENCODER_THREAD_POLICY_H_
@@ -0,0 +1,158 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/video_coding/utility/encoder_thread_policy.h"
+
+#include "webrtc/test/field_trial.h"
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+namespace {
+const int kFramerate = 30;
+const int kFrameIntervalUs = 1000000 / kFramerate;
+}  // namespace
+
+class EncoderThreadPolicyTest : public ::testing::Test {
+ protected:
+  // Reports |kFramerate| frames, which is what the policy averages over, and
+  // returns true if the settings changed after the last one.
+  bool ReportFrames(int encode_time_us) {
+    for (int i = 0; i < kFramerate - 1; ++i)
+      EXPECT_FALSE(policy_.OnFrameEncoded(encode_time_us));
+    return policy_.OnFrameEncoded(encode_time_us);
+  }
+
+  EncoderThreadPolicy policy_;
+};
+
+TEST_F(EncoderThreadPolicyTest, StartsFromResolutionAndCores) {
+  policy_.Init(kVideoCodecVP9, 1280, 720, 8, kFramerate);
+  EXPECT_EQ(4, policy_.settings().threads);
+  EXPECT_EQ(2, policy_.settings().partitions);
+
+  policy_.Init(kVideoCodecVP9, 640, 480, 4, kFramerate);
+  EXPECT_EQ(2, policy_.settings().threads);
+  EXPECT_EQ(1, policy_.settings().partitions);
+
+  policy_.Init(kVideoCodecVP9, 352, 288, 8, kFramerate);
+  EXPECT_EQ(1, policy_.settings().threads);
+  EXPECT_EQ(0, policy_.settings().partitions);
+
+  policy_.Init(kVideoCodecH264, 1280, 720, 8, kFramerate);
+  EXPECT_EQ(1, policy_.settings().threads);
+  EXPECT_EQ(1, policy_.settings().partitions);
+}
+
+#if !defined(ANDROID)
+TEST_F(EncoderThreadPolicyTest, Vp8UsesOneTokenPartitionByDefault) {
+  policy_.Init(kVideoCodecVP8, 1920, 1080, 6, kFramerate);
+  EXPECT_EQ(3, policy_.settings().threads);
+  EXPECT_EQ(0, policy_.settings().partitions);
+}
+
+TEST_F(EncoderThreadPolicyTest, FieldTrialGivesVp8TokenPartitionPerThread) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-VP8TokenPartitionsPerThread/Enabled/");
+  policy_.Init(kVideoCodecVP8, 1920, 1080, 6, kFramerate);
+  EXPECT_EQ(3, policy_.settings().threads);
+  EXPECT_EQ(2, policy_.settings().partitions);
+
+  // Two threads get two token partitions.
+  EXPECT_TRUE(policy_.SetResolution(1280, 720));
+  EXPECT_EQ(2, policy_.settings().threads);
+  EXPECT_EQ(1, policy_.settings().partitions);
+}
+
+TEST_F(EncoderThreadPolicyTest, ResolutionChangeKeepsInitialThreadsAsMax) {
+  policy_.Init(kVideoCodecVP8, 640, 480, 8, kFramerate);
+  EXPECT_EQ(1, policy_.settings().threads);
+
+  // The table has two threads for 720p, but the encoder was started with one.
+  EXPECT_FALSE(policy_.SetResolution(1280, 720));
+  EXPECT_EQ(1, policy_.settings().threads);
+}
+#endif
+
+TEST_F(EncoderThreadPolicyTest, RestoresThreadsWhenEncodingIsSlow) {
+  policy_.Init(kVideoCodecVP9, 1280, 720, 8, kFramerate);
+  EXPECT_EQ(4, policy_.settings().threads);
+  EXPECT_TRUE(ReportFrames(kFrameIntervalUs / 10));
+  EXPECT_EQ(2, policy_.settings().threads);
+
+  EXPECT_TRUE(ReportFrames(kFrameIntervalUs * 9 / 10));
+  EXPECT_EQ(4, policy_.settings().threads);
+  EXPECT_EQ(2, policy_.settings().partitions);
+}
+
+TEST_F(EncoderThreadPolicyTest, NeverAddsThreadsBeyondInit) {
+  // E.g., encoding is slow because the host is busy.
+  policy_.Init(kVideoCodecVP9, 640, 360, 4, kFramerate);
+  EXPECT_EQ(1, policy_.settings().threads);
+  EXPECT_FALSE(ReportFrames(2 * kFrameIntervalUs));
+  EXPECT_EQ(1, policy_.settings().threads);
+
+  policy_.Init(kVideoCodecVP9, 1280, 720, 8, kFramerate);
+  EXPECT_EQ(4, policy_.settings().threads);
+  EXPECT_FALSE(ReportFrames(2 * kFrameIntervalUs));
+  EXPECT_EQ(4, policy_.settings().threads);
+}
+
+TEST_F(EncoderThreadPolicyTest, RemovesThreadsWhenEncodingIsFast) {
+  policy_.Init(kVideoCodecVP9, 1280, 720, 8, kFramerate);
+  EXPECT_EQ(4, policy_.settings().threads);
+
+  // Would take 70% of the frame interval with half the threads.
+  EXPECT_FALSE(ReportFrames(kFrameIntervalUs * 35 / 100));
+  EXPECT_EQ(4, policy_.settings().threads);
+
+  EXPECT_TRUE(ReportFrames(kFrameIntervalUs / 10));
+  EXPECT_EQ(2, policy_.settings().threads);
+  EXPECT_EQ(1, policy_.settings().partitions);
+}
+
+TEST_F(EncoderThreadPolicyTest, AveragesOverFramerate) {
+  policy_.Init(kVideoCodecVP9, 1280, 720, 8, kFramerate);
+  policy_.SetFramerate(kFramerate / 2);
+  for (int i = 0; i < kFramerate / 2 - 1; ++i)
+    EXPECT_FALSE(policy_.OnFrameEncoded(kFrameIntervalUs / 10));
+  EXPECT_TRUE(policy_.OnFrameEncoded(kFrameIntervalUs / 10));
+}
+
+TEST_F(EncoderThreadPolicyTest, ResolutionChangeRestartsFromTable) {
+  policy_.Init(kVideoCodecVP9, 1280, 720, 8, kFramerate);
+  EXPECT_FALSE(policy_.SetResolution(1280, 720));
+  EXPECT_TRUE(policy_.SetResolution(320, 180));
+  EXPECT_EQ(1, policy_.settings().threads);
+  EXPECT_EQ(0, policy_.settings().partitions);
+}
+
+TEST_F(EncoderThreadPolicyTest, H264DoesNotAdaptAtRuntime) {
+  policy_.Init(kVideoCodecH264, 1280, 720, 8, kFramerate);
+  EXPECT_FALSE(ReportFrames(2 * kFrameIntervalUs));
+  EXPECT_EQ(1, policy_.settings().threads);
+}
+
+TEST_F(EncoderThreadPolicyTest, Vp8DoesNotAdaptAtRuntime) {
+  policy_.Init(kVideoCodecVP8, 1920, 1080, 16, kFramerate);
+  const int threads = policy_.settings().threads;
+  EXPECT_GT(threads, 1);
+  EXPECT_FALSE(ReportFrames(kFrameIntervalUs / 10));
+  EXPECT_EQ(threads, policy_.settings().threads);
+}
+
+TEST_F(EncoderThreadPolicyTest, FieldTrialDisablesRuntimeAdaptation) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-EncoderThreadAdaptation/Disabled/");
+  policy_.Init(kVideoCodecVP9, 1280, 720, 8, kFramerate);
+  EXPECT_FALSE(ReportFrames(kFrameIntervalUs / 10));
+  EXPECT_EQ(4, policy_.settings().threads);
+}
+
+}  // namespace webrtc
@@ -19,6 +19,10 @@
         '<(webrtc_root)/system_wrappers/system_wrappers.gyp:system_wrappers',
       ],
       'sources': [
+        'active_map_tracker.cc',
+        'active_map_tracker.h',
+        'encoder_thread_policy.cc',
+        'encoder_thread_policy.h',
         'frame_dropper.cc',
         'frame_dropper.h',
         'ivf_file_writer.cc',
@@ -298,6 +298,7 @@ int32_t VideoSender::AddVideoFrame(const VideoFrame& videoFrame,
                                  converted_frame.timestamp(),
                                  converted_frame.render_time_ms(),
                                  converted_frame.rotation());
+    converted_frame.set_update_rect(videoFrame.update_rect());
   }
   int32_t ret =
       _encoder->Encode(converted_frame, codecSpecificInfo, next_frame_types);
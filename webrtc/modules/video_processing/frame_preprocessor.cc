@@ -10,10 +10,20 @@
 
 #include "webrtc/modules/video_processing/frame_preprocessor.h"
 
+#include <algorithm>
+
 #include "webrtc/modules/video_processing/video_denoiser.h"
+#include "webrtc/system_wrappers/include/cpu_info.h"
 
 namespace webrtc {
 
+namespace {
+
+// Beyond this, the bands get too small to be worth a thread even at 1080p.
+const uint32_t kMaxDenoiserThreads = 3;
+
+}  // namespace
+
 VPMFramePreprocessor::VPMFramePreprocessor()
     : resampled_frame_(), frame_cnt_(0) {
   spatial_resampler_ = new VPMSimpleSpatialResampler();
@@ -76,7 +86,12 @@ uint32_t VPMFramePreprocessor::GetDecimatedHeight() const {
 
 void VPMFramePreprocessor::EnableDenoising(bool enable) {
   if (enable) {
-    denoiser_.reset(new VideoDenoiser(true));
+    // The calling thread denoises a band as well. Leave a core for the
+    // encoder.
+    const uint32_t num_cores = CpuInfo::DetectNumberOfCores();
+    const uint32_t num_threads =
+        num_cores > 2 ? std::min(num_cores - 2, kMaxDenoiserThreads) : 0;
+    denoiser_.reset(new VideoDenoiser(true, num_threads));
   } else {
     denoiser_.reset();
   }
@@ -8,18 +8,61 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <stdio.h>
 #include <string.h>
 
 #include <memory>
+#include <vector>
 
+#include "webrtc/base/random.h"
+#include "webrtc/base/timeutils.h"
 #include "webrtc/common_video/include/i420_buffer_pool.h"
 #include "webrtc/modules/video_processing/video_denoiser.h"
 #include "webrtc/test/gtest.h"
 #include "webrtc/test/frame_utils.h"
 #include "webrtc/test/testsupport/fileutils.h"
+#include "webrtc/typedefs.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include "webrtc/modules/video_processing/util/denoiser_filter_avx2.h"
+#include "webrtc/modules/video_processing/util/denoiser_filter_sse2.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
+#endif
 
 namespace webrtc {
 
+namespace {
+
+// Returns a frame of a noisy gradient, with a square moving across it from
+// frame to frame.
+rtc::scoped_refptr<I420Buffer> CreateSyntheticFrame(int width,
+                                                    int height,
+                                                    int frame_number,
+                                                    Random* random) {
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(width, height);
+  const int square_x = (frame_number * 24) % width;
+  const int square_y = height / 3;
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      int value = 64 + (x + y) / 16 + random->Rand(-6, 6);
+      if (x >= square_x && x < square_x + 64 && y >= square_y &&
+          y < square_y + 64) {
+        value = 200 + random->Rand(-6, 6);
+      }
+      buffer->MutableDataY()[y * buffer->StrideY() + x] = value;
+    }
+  }
+  for (int y = 0; y < (height + 1) / 2; ++y) {
+    for (int x = 0; x < (width + 1) / 2; ++x) {
+      buffer->MutableDataU()[y * buffer->StrideU() + x] = 128 + x % 16;
+      buffer->MutableDataV()[y * buffer->StrideV() + x] = 128 - y % 16;
+    }
+  }
+  return buffer;
+}
+
+}  // namespace
+
 TEST(VideoDenoiserTest, CopyMem) {
   std::unique_ptr<DenoiserFilter> df_c(DenoiserFilter::Create(false, nullptr));
   std::unique_ptr<DenoiserFilter> df_sse_neon(
@@ -158,4 +201,99 @@ TEST(VideoDenoiserTest, Denoiser) {
   ASSERT_NE(0, feof(source_file)) << "Error reading source file";
 }
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+TEST(VideoDenoiserTest, Avx2MatchesSse2) {
+  if (!WebRtc_GetCPUInfo(kAVX2)) {
+    printf("Skipping test, AVX2 is not supported.\n");
+    return;
+  }
+  DenoiserFilterSSE2 df_sse2;
+  DenoiserFilterAVX2 df_avx2;
+  Random random(0x12345678);
+  const int kStride = 24;
+  uint8_t running_src[16 * kStride], src[16 * kStride];
+  uint8_t dst_sse2[16 * kStride], dst_avx2[16 * kStride];
+  for (int test = 0; test < 1000; ++test) {
+    // Mostly small differences, which get filtered, and sometimes the largest
+    // adjustment on all pixels, to hit the limits of the accumulated
+    // difference.
+    const bool max_adjustment = test % 50 == 0;
+    const int max_diff = test % 4 == 0 ? 40 : 10;
+    const int fixed_diff = max_adjustment ? (test % 100 == 0 ? 16 : -16) : 0;
+    for (int i = 0; i < 16 * kStride; ++i) {
+      running_src[i] = random.Rand(40, 215);
+      src[i] = running_src[i] +
+               (fixed_diff ? fixed_diff : random.Rand(-max_diff, max_diff));
+    }
+
+    memcpy(dst_sse2, src, sizeof(dst_sse2));
+    memcpy(dst_avx2, src, sizeof(dst_avx2));
+    df_sse2.CopyMem16x16(running_src, kStride, dst_sse2, kStride);
+    df_avx2.CopyMem16x16(running_src, kStride, dst_avx2, kStride);
+    ASSERT_EQ(0, memcmp(dst_sse2, dst_avx2, sizeof(dst_sse2)));
+
+    uint32_t sse_sse2 = 0, sse_avx2 = 0;
+    ASSERT_EQ(
+        df_sse2.Variance16x8(running_src, kStride, src, kStride, &sse_sse2),
+        df_avx2.Variance16x8(running_src, kStride, src, kStride, &sse_avx2));
+    ASSERT_EQ(sse_sse2, sse_avx2);
+
+    const uint8_t motion_magnitude = !max_adjustment && test % 3 == 0 ? 30 : 0;
+    const int increase_denoising = max_adjustment || test % 2;
+    memset(dst_sse2, 0, sizeof(dst_sse2));
+    memset(dst_avx2, 0, sizeof(dst_avx2));
+    ASSERT_EQ(df_sse2.MbDenoise(running_src, kStride, dst_sse2, kStride, src,
+                                kStride, motion_magnitude, increase_denoising),
+              df_avx2.MbDenoise(running_src, kStride, dst_avx2, kStride, src,
+                                kStride, motion_magnitude, increase_denoising));
+    ASSERT_EQ(0, memcmp(dst_sse2, dst_avx2, sizeof(dst_sse2)));
+  }
+}
+#endif
+
+TEST(VideoDenoiserTest, ThreadsDoNotChangeResult) {
+  // Not a multiple of 16, to have margins.
+  const int kWidth = 360;
+  const int kHeight = 296;
+  VideoDenoiser denoiser(true);
+  VideoDenoiser denoiser_threads(true, 3);
+  Random random(0x1234);
+  for (int i = 0; i < 20; ++i) {
+    rtc::scoped_refptr<VideoFrameBuffer> frame(
+        CreateSyntheticFrame(kWidth, kHeight, i, &random));
+    // Enable noise estimation after a few frames, so that it has an effect.
+    const bool noise_estimation_enabled = i >= 5;
+    rtc::scoped_refptr<VideoFrameBuffer> denoised_frame(
+        denoiser.DenoiseFrame(frame, noise_estimation_enabled));
+    rtc::scoped_refptr<VideoFrameBuffer> denoised_frame_threads(
+        denoiser_threads.DenoiseFrame(frame, noise_estimation_enabled));
+    ASSERT_TRUE(test::FrameBufsEqual(denoised_frame, denoised_frame_threads));
+  }
+}
+
+TEST(VideoDenoiserTest, DISABLED_DenoiserPerformance) {
+  const int kNumFrames = 100;
+  const int kWidths[] = {1280, 1920};
+  const int kHeights[] = {720, 1080};
+  for (size_t size = 0; size < 2; ++size) {
+    Random random(0x1234);
+    std::vector<rtc::scoped_refptr<VideoFrameBuffer>> frames;
+    for (int i = 0; i < 10; ++i) {
+      frames.push_back(
+          CreateSyntheticFrame(kWidths[size], kHeights[size], i, &random));
+    }
+    for (size_t num_threads = 0; num_threads <= 3; ++num_threads) {
+      VideoDenoiser denoiser(true, num_threads);
+      denoiser.DenoiseFrame(frames[0], true);
+      const int64_t start_us = rtc::TimeMicros();
+      for (int i = 0; i < kNumFrames; ++i)
+        denoiser.DenoiseFrame(frames[i % frames.size()], true);
+      const int64_t elapsed_us = rtc::TimeMicros() - start_us;
+      printf("%dx%d, %d threads: %.2f ms per frame\n", kWidths[size],
+             kHeights[size], static_cast<int>(num_threads),
+             elapsed_us / 1000.0 / kNumFrames);
+    }
+  }
+}
+
 }  // namespace webrtc
@@ -10,10 +10,20 @@
 
 #include "webrtc/common_video/libyuv/include/webrtc_libyuv.h"
 #include "webrtc/modules/video_processing/video_denoiser.h"
+
+#include <algorithm>
+
 #include "libyuv/planar_functions.h"
 
 namespace webrtc {
 
+namespace {
+
+// Fewer rows per band make the threads cost more than they save.
+const int kMinMbRowsPerBand = 4;
+
+}  // namespace
+
 #if DISPLAY || DISPLAYNEON
 static void CopyMem8x8(const uint8_t* src,
                        int src_stride,
@@ -67,10 +77,16 @@ static void ShowRect(const std::unique_ptr<DenoiserFilter>& filter,
 #endif
 
 VideoDenoiser::VideoDenoiser(bool runtime_cpu_detection)
+    : VideoDenoiser(runtime_cpu_detection, 0) {}
+
+VideoDenoiser::VideoDenoiser(bool runtime_cpu_detection, size_t num_threads)
     : width_(0),
       height_(0),
       filter_(DenoiserFilter::Create(runtime_cpu_detection, &cpu_type_)),
-      ne_(new NoiseEstimation()) {}
+      ne_(new NoiseEstimation()),
+      num_threads_(num_threads) {}
+
+VideoDenoiser::~VideoDenoiser() {}
 
 void VideoDenoiser::DenoiserReset(rtc::scoped_refptr<VideoFrameBuffer> frame) {
   width_ = frame->width();
@@ -85,6 +101,136 @@ void VideoDenoiser::DenoiserReset(rtc::scoped_refptr<VideoFrameBuffer> frame) {
   x_density_.reset(new uint8_t[mb_cols_]);
   y_density_.reset(new uint8_t[mb_rows_]);
   moving_object_.reset(new uint8_t[mb_cols_ * mb_rows_]);
+
+  // Split the rows into bands, and start a worker for each band but the last.
+  const int num_bands =
+      std::max(1, std::min(static_cast<int>(num_threads_) + 1,
+                           mb_rows_ / kMinMbRowsPerBand));
+  bands_.clear();
+  bands_.resize(num_bands);
+  for (int i = 0; i < num_bands; ++i) {
+    bands_[i].first_mb_row = mb_rows_ * i / num_bands;
+    bands_[i].end_mb_row = mb_rows_ * (i + 1) / num_bands;
+    bands_[i].x_density.reset(new uint8_t[mb_cols_]);
+  }
+  while (workers_.size() + 1 < bands_.size())
+    workers_.emplace_back(
+        new rtc::ParallelTaskThread("VideoDenoiser", rtc::kHighPriority));
+}
+
+void VideoDenoiser::RunPass(Pass pass, const FrameData& frame_data) {
+  for (size_t i = 0; i + 1 < bands_.size(); ++i) {
+    Band* band = &bands_[i];
+    workers_[i]->StartTask([this, pass, &frame_data, band] {
+      RunPassOnBand(pass, frame_data, band);
+    });
+  }
+  RunPassOnBand(pass, frame_data, &bands_.back());
+  for (size_t i = 0; i + 1 < bands_.size(); ++i)
+    workers_[i]->WaitForTask();
+}
+
+void VideoDenoiser::RunPassOnBand(Pass pass,
+                                  const FrameData& frame_data,
+                                  Band* band) {
+  switch (pass) {
+    case Pass::kDenoise:
+      DenoiseBand(frame_data, band);
+      break;
+    case Pass::kCopySrc:
+      CopySrcOnMOB(frame_data.y_src, frame_data.stride_y_src, frame_data.y_dst,
+                   frame_data.stride_y_dst, band->first_mb_row,
+                   band->end_mb_row);
+      break;
+  }
+}
+
+void VideoDenoiser::DenoiseBand(const FrameData& frame_data, Band* band) {
+  const uint8_t* y_src = frame_data.y_src;
+  const int stride_y_src = frame_data.stride_y_src;
+  uint8_t* y_dst = frame_data.y_dst;
+  const int stride_y_dst = frame_data.stride_y_dst;
+  const uint8_t* y_dst_prev = frame_data.y_dst_prev;
+  const int stride_prev = frame_data.stride_prev;
+  const uint8_t noise_level = frame_data.noise_level;
+  uint8_t* x_density = band->x_density.get();
+  memset(x_density, 0, mb_cols_);
+  band->noise_samples.clear();
+
+  int thr_var_base = 16 * 16 * 2;
+  // Loop over blocks to accumulate/extract noise level and update x/y_density
+  // factors for moving object detection.
+  for (int mb_row = band->first_mb_row; mb_row < band->end_mb_row; ++mb_row) {
+    const int mb_index_base = mb_row * mb_cols_;
+    const uint8_t* mb_src_base = y_src + (mb_row << 4) * stride_y_src;
+    uint8_t* mb_dst_base = y_dst + (mb_row << 4) * stride_y_dst;
+    const uint8_t* mb_dst_prev_base = y_dst_prev + (mb_row << 4) * stride_prev;
+    for (int mb_col = 0; mb_col < mb_cols_; ++mb_col) {
+      const int mb_index = mb_index_base + mb_col;
+      const bool ne_enable = (mb_index % NOISE_SUBSAMPLE_INTERVAL == 0);
+      const int pos_factor = PositionCheck(mb_row, mb_col, noise_level);
+      const uint32_t thr_var_adp = thr_var_base * pos_factor;
+      const uint32_t offset_col = mb_col << 4;
+      const uint8_t* mb_src = mb_src_base + offset_col;
+      uint8_t* mb_dst = mb_dst_base + offset_col;
+      const uint8_t* mb_dst_prev = mb_dst_prev_base + offset_col;
+
+      // TODO(jackychen): Need SSE2/NEON opt.
+      int luma = 0;
+      if (ne_enable) {
+        for (int i = 4; i < 12; ++i) {
+          for (int j = 4; j < 12; ++j) {
+            luma += mb_src[i * stride_y_src + j];
+          }
+        }
+      }
+
+      // Get the filtered block and filter_decision.
+      mb_filter_decision_[mb_index] =
+          filter_->MbDenoise(mb_dst_prev, stride_prev, mb_dst, stride_y_dst,
+                             mb_src, stride_y_src, 0, noise_level);
+
+      // If filter decision is FILTER_BLOCK, no need to check moving edge.
+      // It is unlikely for a moving edge block to be filtered in current
+      // setting.
+      if (mb_filter_decision_[mb_index] == FILTER_BLOCK) {
+        uint32_t sse_t = 0;
+        if (ne_enable) {
+          // The variance used in noise estimation is based on the src block in
+          // time t (mb_src) and filtered block in time t-1 (mb_dist_prev).
+          uint32_t noise_var = filter_->Variance16x8(
+              mb_dst_prev, stride_y_dst, mb_src, stride_y_src, &sse_t);
+          band->noise_samples.push_back(
+              {mb_index, false, noise_var, static_cast<uint32_t>(luma)});
+        }
+        moving_edge_[mb_index] = 0;  // Not a moving edge block.
+      } else {
+        uint32_t sse_t = 0;
+        // The variance used in MOD is based on the filtered blocks in time
+        // T (mb_dst) and T-1 (mb_dst_prev).
+        uint32_t noise_var = filter_->Variance16x8(
+            mb_dst_prev, stride_prev, mb_dst, stride_y_dst, &sse_t);
+        if (noise_var > thr_var_adp) {  // Moving edge checking.
+          if (ne_enable) {
+            band->noise_samples.push_back({mb_index, true, 0, 0});
+          }
+          moving_edge_[mb_index] = 1;  // Mark as moving edge block.
+          x_density[mb_col] += (pos_factor < 3);
+          y_density_[mb_row] += (pos_factor < 3);
+        } else {
+          moving_edge_[mb_index] = 0;
+          if (ne_enable) {
+            // The variance used in noise estimation is based on the src block
+            // in time t (mb_src) and filtered block in time t-1 (mb_dist_prev).
+            uint32_t noise_var = filter_->Variance16x8(
+                mb_dst_prev, stride_prev, mb_src, stride_y_src, &sse_t);
+            band->noise_samples.push_back(
+                {mb_index, false, noise_var, static_cast<uint32_t>(luma)});
+          }
+        }
+      }
+    }  // End of for loop
+  }    // End of for loop
 }
 
 int VideoDenoiser::PositionCheck(int mb_row, int mb_col, int noise_level) {
@@ -166,10 +312,12 @@ bool VideoDenoiser::IsTrailingBlock(const std::unique_ptr<uint8_t[]>& d_status,
 void VideoDenoiser::CopySrcOnMOB(const uint8_t* y_src,
                                  int stride_src,
                                  uint8_t* y_dst,
-                                 int stride_dst) {
+                                 int stride_dst,
+                                 int first_mb_row,
+                                 int end_mb_row) {
   // Loop over to copy src block if the block is marked as moving object block
   // or if the block may cause trailing artifacts.
-  for (int mb_row = 0; mb_row < mb_rows_; ++mb_row) {
+  for (int mb_row = first_mb_row; mb_row < end_mb_row; ++mb_row) {
     const int mb_index_base = mb_row * mb_cols_;
     const uint8_t* mb_src_base = y_src + (mb_row << 4) * stride_src;
     uint8_t* mb_dst_base = y_dst + (mb_row << 4) * stride_dst;
@@ -222,99 +370,47 @@ rtc::scoped_refptr<VideoFrameBuffer> VideoDenoiser::DenoiseFrame(
     return frame;
   }
 
-  // Set buffer pointers.
-  const uint8_t* y_src = frame->DataY();
-  int stride_y_src = frame->StrideY();
   rtc::scoped_refptr<I420Buffer> dst =
       buffer_pool_.CreateBuffer(width_, height_);
 
-  uint8_t* y_dst = dst->MutableDataY();
-  int stride_y_dst = dst->StrideY();
-
-  const uint8_t* y_dst_prev = prev_buffer_->DataY();
-  int stride_prev = prev_buffer_->StrideY();
+  FrameData frame_data;
+  frame_data.y_src = frame->DataY();
+  frame_data.stride_y_src = frame->StrideY();
+  frame_data.y_dst = dst->MutableDataY();
+  frame_data.stride_y_dst = dst->StrideY();
+  frame_data.y_dst_prev = prev_buffer_->DataY();
+  frame_data.stride_prev = prev_buffer_->StrideY();
 
   memset(x_density_.get(), 0, mb_cols_);
   memset(y_density_.get(), 0, mb_rows_);
   memset(moving_object_.get(), 1, mb_cols_ * mb_rows_);
 
-  uint8_t noise_level = noise_estimation_enabled ? ne_->GetNoiseLevel() : 0;
-  int thr_var_base = 16 * 16 * 2;
-  // Loop over blocks to accumulate/extract noise level and update x/y_density
-  // factors for moving object detection.
-  for (int mb_row = 0; mb_row < mb_rows_; ++mb_row) {
-    const int mb_index_base = mb_row * mb_cols_;
-    const uint8_t* mb_src_base = y_src + (mb_row << 4) * stride_y_src;
-    uint8_t* mb_dst_base = y_dst + (mb_row << 4) * stride_y_dst;
-    const uint8_t* mb_dst_prev_base = y_dst_prev + (mb_row << 4) * stride_prev;
-    for (int mb_col = 0; mb_col < mb_cols_; ++mb_col) {
-      const int mb_index = mb_index_base + mb_col;
-      const bool ne_enable = (mb_index % NOISE_SUBSAMPLE_INTERVAL == 0);
-      const int pos_factor = PositionCheck(mb_row, mb_col, noise_level);
-      const uint32_t thr_var_adp = thr_var_base * pos_factor;
-      const uint32_t offset_col = mb_col << 4;
-      const uint8_t* mb_src = mb_src_base + offset_col;
-      uint8_t* mb_dst = mb_dst_base + offset_col;
-      const uint8_t* mb_dst_prev = mb_dst_prev_base + offset_col;
+  frame_data.noise_level = noise_estimation_enabled ? ne_->GetNoiseLevel() : 0;
+  RunPass(Pass::kDenoise, frame_data);
 
-      // TODO(jackychen): Need SSE2/NEON opt.
-      int luma = 0;
-      if (ne_enable) {
-        for (int i = 4; i < 12; ++i) {
-          for (int j = 4; j < 12; ++j) {
-            luma += mb_src[i * stride_y_src + j];
-          }
-        }
-      }
-
-      // Get the filtered block and filter_decision.
-      mb_filter_decision_[mb_index] =
-          filter_->MbDenoise(mb_dst_prev, stride_prev, mb_dst, stride_y_dst,
-                             mb_src, stride_y_src, 0, noise_level);
+  // Merge the results of the bands. The noise samples are passed on in block
+  // order, as when the frame is denoised in one piece. The column densities
+  // may wrap around, and do so the same way when summed up in any order.
+  for (const Band& band : bands_) {
+    for (int mb_col = 0; mb_col < mb_cols_; ++mb_col)
+      x_density_[mb_col] += band.x_density[mb_col];
+    for (const NoiseSample& sample : band.noise_samples) {
+      if (sample.reset)
+        ne_->ResetConsecLowVar(sample.mb_index);
+      else
+        ne_->GetNoise(sample.mb_index, sample.var, sample.luma);
+    }
+  }
 
-      // If filter decision is FILTER_BLOCK, no need to check moving edge.
-      // It is unlikely for a moving edge block to be filtered in current
-      // setting.
-      if (mb_filter_decision_[mb_index] == FILTER_BLOCK) {
-        uint32_t sse_t = 0;
-        if (ne_enable) {
-          // The variance used in noise estimation is based on the src block in
-          // time t (mb_src) and filtered block in time t-1 (mb_dist_prev).
-          uint32_t noise_var = filter_->Variance16x8(
-              mb_dst_prev, stride_y_dst, mb_src, stride_y_src, &sse_t);
-          ne_->GetNoise(mb_index, noise_var, luma);
-        }
-        moving_edge_[mb_index] = 0;  // Not a moving edge block.
-      } else {
-        uint32_t sse_t = 0;
-        // The variance used in MOD is based on the filtered blocks in time
-        // T (mb_dst) and T-1 (mb_dst_prev).
-        uint32_t noise_var = filter_->Variance16x8(
-            mb_dst_prev, stride_prev, mb_dst, stride_y_dst, &sse_t);
-        if (noise_var > thr_var_adp) {  // Moving edge checking.
-          if (ne_enable) {
-            ne_->ResetConsecLowVar(mb_index);
-          }
-          moving_edge_[mb_index] = 1;  // Mark as moving edge block.
-          x_density_[mb_col] += (pos_factor < 3);
-          y_density_[mb_row] += (pos_factor < 3);
-        } else {
-          moving_edge_[mb_index] = 0;
-          if (ne_enable) {
-            // The variance used in noise estimation is based on the src block
-            // in time t (mb_src) and filtered block in time t-1 (mb_dist_prev).
-            uint32_t noise_var = filter_->Variance16x8(
-                mb_dst_prev, stride_prev, mb_src, stride_y_src, &sse_t);
-            ne_->GetNoise(mb_index, noise_var, luma);
-          }
-        }
-      }
-    }  // End of for loop
-  }    // End of for loop
+  // This needs the moving edges of all bands.
+  ReduceFalseDetection(moving_edge_, &moving_object_, frame_data.noise_level);
 
-  ReduceFalseDetection(moving_edge_, &moving_object_, noise_level);
+  RunPass(Pass::kCopySrc, frame_data);
 
-  CopySrcOnMOB(y_src, stride_y_src, y_dst, stride_y_dst);
+  const uint8_t* y_src = frame_data.y_src;
+  int stride_y_src = frame_data.stride_y_src;
+  uint8_t* y_dst = frame_data.y_dst;
+  int stride_y_dst = frame_data.stride_y_dst;
 
   // When frame width/height not divisible by 16, copy the margin to
   // denoised_frame.
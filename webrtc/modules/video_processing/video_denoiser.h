@@ -12,7 +12,9 @@
 #define WEBRTC_MODULES_VIDEO_PROCESSING_VIDEO_DENOISER_H_
 
 #include <memory>
+#include <vector>
 
+#include "webrtc/base/parallel_task_thread.h"
 #include "webrtc/common_video/include/i420_buffer_pool.h"
 #include "webrtc/modules/video_processing/util/denoiser_filter.h"
 #include "webrtc/modules/video_processing/util/noise_estimation.h"
@@ -20,17 +22,68 @@
 
 namespace webrtc {
 
+// Denoises the luma plane of each frame against the previous denoised frame.
+// The frame is split into bands of macroblock rows, which are processed on the
+// calling thread and on up to |num_threads| worker threads. The result is the
+// same for any number of threads.
 class VideoDenoiser {
  public:
   explicit VideoDenoiser(bool runtime_cpu_detection);
+  VideoDenoiser(bool runtime_cpu_detection, size_t num_threads);
+  ~VideoDenoiser();
 
   rtc::scoped_refptr<VideoFrameBuffer> DenoiseFrame(
       rtc::scoped_refptr<VideoFrameBuffer> frame,
       bool noise_estimation_enabled);
 
  private:
+  // Noise estimation input of a block, recorded while the bands are denoised
+  // in parallel, and passed on to |ne_| in block order afterwards.
+  struct NoiseSample {
+    int mb_index;
+    // True to reset the low variance count of the block instead.
+    bool reset;
+    uint32_t var;
+    uint32_t luma;
+  };
+
+  // A range of macroblock rows, and the state that is merged across bands
+  // once they are all done.
+  struct Band {
+    int first_mb_row;
+    int end_mb_row;
+    std::unique_ptr<uint8_t[]> x_density;
+    std::vector<NoiseSample> noise_samples;
+  };
+
+  // The planes of the frame being denoised.
+  struct FrameData {
+    const uint8_t* y_src;
+    int stride_y_src;
+    uint8_t* y_dst;
+    int stride_y_dst;
+    const uint8_t* y_dst_prev;
+    int stride_prev;
+    uint8_t noise_level;
+  };
+
+  enum class Pass {
+    // Filters the blocks and detects moving edges.
+    kDenoise,
+    // Copies the source on the moving object blocks.
+    kCopySrc,
+  };
+
   void DenoiserReset(rtc::scoped_refptr<VideoFrameBuffer> frame);
 
+  // Runs |pass| on all bands, and returns when they are done.
+  void RunPass(Pass pass, const FrameData& frame_data);
+  void RunPassOnBand(Pass pass, const FrameData& frame_data, Band* band);
+
+  // Filters the blocks of |band| into the destination frame, and records the
+  // moving edge blocks and the noise samples.
+  void DenoiseBand(const FrameData& frame_data, Band* band);
+
   // Check the mb position, return 1: close to the frame center (between 1/8
   // and 7/8 of width/height), 3: close to the border (out of 1/16 and 15/16
   // of width/height), 2: in between.
@@ -51,7 +104,9 @@ class VideoDenoiser {
   void CopySrcOnMOB(const uint8_t* y_src,
                     int stride_src,
                     uint8_t* y_dst,
-                    int stride_dst);
+                    int stride_dst,
+                    int first_mb_row,
+                    int end_mb_row);
 
   // Copy luma margin blocks when frame width/height not divisible by 16.
   void CopyLumaOnMargin(const uint8_t* y_src,
@@ -77,6 +132,11 @@ class VideoDenoiser {
   std::unique_ptr<DenoiserDecision[]> mb_filter_decision_;
   I420BufferPool buffer_pool_;
   rtc::scoped_refptr<VideoFrameBuffer> prev_buffer_;
+  const size_t num_threads_;
+  std::vector<std::unique_ptr<rtc::ParallelTaskThread>> workers_;
+  // The last band is processed on the calling thread, and band i < last on
+  // workers_[i].
+  std::vector<Band> bands_;
 };
 
 }  // namespace webrtc
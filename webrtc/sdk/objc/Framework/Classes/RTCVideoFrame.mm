@@ -91,6 +91,9 @@
 }
 
 - (CVPixelBufferRef)nativeHandle {
+  if (_videoBuffer->type() != webrtc::VideoFrameBuffer::Type::kNative) {
+    return nullptr;
+  }
   return static_cast<CVPixelBufferRef>(_videoBuffer->native_handle());
 }
 
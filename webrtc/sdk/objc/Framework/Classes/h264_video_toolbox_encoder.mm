@@ -23,6 +23,7 @@
 #include "webrtc/base/checks.h"
 #include "webrtc/base/logging.h"
 #include "webrtc/common_video/include/corevideo_frame_buffer.h"
+#include "webrtc/common_video/libyuv/include/webrtc_libyuv.h"
 #include "webrtc/sdk/objc/Framework/Classes/h264_video_toolbox_nalu.h"
 #include "webrtc/system_wrappers/include/clock.h"
 
@@ -191,6 +192,37 @@ bool CopyVideoFrameToPixelBuffer(
   return true;
 }
 
+// NV12 frames are copied, and scaled if needed, without any format conversion.
+bool CopyNV12BufferToPixelBuffer(std::vector<uint8_t>* tmp_buffer,
+                                 const webrtc::NV12Buffer& frame,
+                                 CVPixelBufferRef pixel_buffer) {
+  RTC_DCHECK(pixel_buffer);
+  RTC_DCHECK_EQ(CVPixelBufferGetPixelFormatType(pixel_buffer),
+                kCVPixelFormatType_420YpCbCr8BiPlanarFullRange);
+
+  CVReturn cvRet = CVPixelBufferLockBaseAddress(pixel_buffer, 0);
+  if (cvRet != kCVReturnSuccess) {
+    LOG(LS_ERROR) << "Failed to lock base address: " << cvRet;
+    return false;
+  }
+  uint8_t* dst_y = reinterpret_cast<uint8_t*>(
+      CVPixelBufferGetBaseAddressOfPlane(pixel_buffer, 0));
+  int dst_stride_y = CVPixelBufferGetBytesPerRowOfPlane(pixel_buffer, 0);
+  uint8_t* dst_uv = reinterpret_cast<uint8_t*>(
+      CVPixelBufferGetBaseAddressOfPlane(pixel_buffer, 1));
+  int dst_stride_uv = CVPixelBufferGetBytesPerRowOfPlane(pixel_buffer, 1);
+  webrtc::NV12Scale(tmp_buffer,
+                    frame.DataY(), frame.StrideY(),
+                    frame.DataUV(), frame.StrideUV(),
+                    frame.width(), frame.height(),
+                    dst_y, dst_stride_y,
+                    dst_uv, dst_stride_uv,
+                    CVPixelBufferGetWidth(pixel_buffer),
+                    CVPixelBufferGetHeight(pixel_buffer));
+  CVPixelBufferUnlockBaseAddress(pixel_buffer, 0);
+  return true;
+}
+
 CVPixelBufferRef CreatePixelBuffer(CVPixelBufferPoolRef pixel_buffer_pool) {
   if (!pixel_buffer_pool) {
     LOG(LS_ERROR) << "Failed to get pixel buffer pool.";
@@ -319,10 +351,12 @@ int H264VideoToolboxEncoder::Encode(
   }
 #endif
 
-  CVPixelBufferRef pixel_buffer = static_cast<CVPixelBufferRef>(
-      frame.video_frame_buffer()->native_handle());
-  if (pixel_buffer) {
+  const VideoFrameBuffer::Type buffer_type = frame.video_frame_buffer()->type();
+  CVPixelBufferRef pixel_buffer = nullptr;
+  if (buffer_type == VideoFrameBuffer::Type::kNative) {
     // Native frame.
+    pixel_buffer = static_cast<CVPixelBufferRef>(
+        frame.video_frame_buffer()->native_handle());
     rtc::scoped_refptr<CoreVideoFrameBuffer> core_video_frame_buffer(
         static_cast<CoreVideoFrameBuffer*>(frame.video_frame_buffer().get()));
     if (!core_video_frame_buffer->RequiresCropping()) {
@@ -342,6 +376,19 @@ int H264VideoToolboxEncoder::Encode(
         return WEBRTC_VIDEO_CODEC_ERROR;
       }
     }
+  } else if (buffer_type == VideoFrameBuffer::Type::kNV12) {
+    pixel_buffer = internal::CreatePixelBuffer(pixel_buffer_pool);
+    if (!pixel_buffer) {
+      return WEBRTC_VIDEO_CODEC_ERROR;
+    }
+    if (!internal::CopyNV12BufferToPixelBuffer(
+            &nv12_scale_buffer_,
+            static_cast<const NV12Buffer&>(*frame.video_frame_buffer()),
+            pixel_buffer)) {
+      LOG(LS_ERROR) << "Failed to copy frame data.";
+      CVBufferRelease(pixel_buffer);
+      return WEBRTC_VIDEO_CODEC_ERROR;
+    }
   } else {
     pixel_buffer = internal::CreatePixelBuffer(pixel_buffer_pool);
     if (!pixel_buffer) {
@@ -18,9 +18,12 @@ extern "C" {
 #include "webrtc/typedefs.h"
 
 // List of features in x86.
+// kAVX2 is only reported when the operating system also saves the YMM
+// registers on context switches.
 typedef enum {
   kSSE2,
-  kSSE3
+  kSSE3,
+  kAVX2
 } CPUFeature;
 
 // List of features in ARM.
@@ -159,6 +159,8 @@ class ScrollingImageFrameGenerator : public FrameGenerator {
         target_height_(static_cast<int>(target_height)),
         current_frame_num_(num_frames_ - 1),
         current_source_frame_(nullptr),
+        pixels_scrolled_x_(-1),
+        pixels_scrolled_y_(-1),
         file_generator_(files, source_width, source_height, 1) {
     RTC_DCHECK(clock_ != nullptr);
     RTC_DCHECK_GT(num_frames_, 0u);
@@ -177,6 +179,7 @@ class ScrollingImageFrameGenerator : public FrameGenerator {
     int64_t ms_since_start = now - start_time_;
 
     size_t frame_num = (ms_since_start / kFrameDisplayTime) % num_frames_;
+    const bool source_changed = frame_num != current_frame_num_;
     UpdateSourceFrame(frame_num);
 
     double scroll_factor;
@@ -186,7 +189,7 @@ class ScrollingImageFrameGenerator : public FrameGenerator {
     } else {
       scroll_factor = 1.0;
     }
-    CropSourceToScrolledImage(scroll_factor);
+    CropSourceToScrolledImage(scroll_factor, source_changed);
 
     return &current_frame_;
   }
@@ -199,7 +202,7 @@ class ScrollingImageFrameGenerator : public FrameGenerator {
     RTC_DCHECK(current_source_frame_ != nullptr);
   }
 
-  void CropSourceToScrolledImage(double scroll_factor) {
+  void CropSourceToScrolledImage(double scroll_factor, bool source_changed) {
     int scroll_margin_x = current_source_frame_->width() - target_width_;
     int pixels_scrolled_x =
         static_cast<int>(scroll_margin_x * scroll_factor + 0.5);
@@ -227,6 +230,17 @@ class ScrollingImageFrameGenerator : public FrameGenerator {
             &frame_buffer->DataV()[offset_v], frame_buffer->StrideV(),
             KeepRefUntilDone(frame_buffer)),
         kVideoRotation_0, 0);
+
+    // Like a screen capturer, tell the encoder when nothing has changed.
+    VideoFrame::UpdateRect update_rect = {0, 0, 0, 0};
+    if (source_changed || pixels_scrolled_x != pixels_scrolled_x_ ||
+        pixels_scrolled_y != pixels_scrolled_y_) {
+      update_rect = {0, 0, target_width_, target_height_};
+    }
+    current_frame_.set_update_rect(
+        rtc::Optional<VideoFrame::UpdateRect>(update_rect));
+    pixels_scrolled_x_ = pixels_scrolled_x;
+    pixels_scrolled_y_ = pixels_scrolled_y;
   }
 
   Clock* const clock_;
@@ -239,6 +253,8 @@ class ScrollingImageFrameGenerator : public FrameGenerator {
 
   size_t current_frame_num_;
   VideoFrame* current_source_frame_;
+  int pixels_scrolled_x_;
+  int pixels_scrolled_y_;
   VideoFrame current_frame_;
   YuvFileGenerator file_generator_;
 };
@@ -58,6 +58,13 @@ class MockVoEChannelProxy : public voe::ChannelProxy {
   MOCK_METHOD1(SetChannelOutputVolumeScaling, void(float scaling));
   MOCK_METHOD1(SetRtcEventLog, void(RtcEventLog* event_log));
   MOCK_METHOD1(SetTransportOverhead, void(int transport_overhead_per_packet));
+  MOCK_METHOD1(SetEncodedAudioPassthrough, void(bool enable));
+  MOCK_METHOD5(SendEncodedAudio,
+               bool(FrameType frame_type,
+                    int payload_type,
+                    uint32_t rtp_timestamp,
+                    rtc::ArrayView<const uint8_t> payload,
+                    const rtc::Optional<uint8_t>& audio_level_dbov));
   MOCK_METHOD1(SetBitrate, void(int bitrate_bps));
   MOCK_METHOD1(EnableAudioNetworkAdaptor,
                void(const std::string& config_string));
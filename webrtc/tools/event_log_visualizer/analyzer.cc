@@ -31,6 +31,7 @@
 #include "webrtc/modules/rtp_rtcp/source/rtp_utility.h"
 #include "webrtc/modules/rtp_rtcp/source/rtcp_packet/common_header.h"
 #include "webrtc/modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
+#include "webrtc/system_wrappers/include/cpu_info.h"
 #include "webrtc/video_receive_stream.h"
 #include "webrtc/video_send_stream.h"
 
@@ -39,6 +40,10 @@ namespace plotting {
 
 namespace {
 
+// The number of events decoded ahead of the pass over the whole log in the
+// constructor. Well below the number of decoded events that the parser keeps.
+const size_t kEventsPerDecodePass = 1 << 16;
+
 std::string SsrcToString(uint32_t ssrc) {
   std::stringstream ss;
   ss << "SSRC " << ssrc;
@@ -303,7 +308,16 @@ EventLogAnalyzer::EventLogAnalyzer(const ParsedRtcEventLog& log)
   //             this can be removed. Tracking bug: webrtc:6399
   RtpHeaderExtensionMap default_extension_map = GetDefaultHeaderExtensionMap();
 
-  for (size_t i = 0; i < parsed_log_.GetNumberOfEvents(); i++) {
+  const size_t num_events = parsed_log_.GetNumberOfEvents();
+  const size_t num_cores = CpuInfo::DetectNumberOfCores();
+  for (size_t i = 0; i < num_events; i++) {
+    if (i % kEventsPerDecodePass == 0) {
+      // Decode the next events on all cores, rather than one at a time below.
+      if (!parsed_log_.DecodeEvents(
+              i, std::min(i + kEventsPerDecodePass, num_events), num_cores)) {
+        LOG(LS_WARNING) << "Malformed events in the log.";
+      }
+    }
     ParsedRtcEventLog::EventType event_type = parsed_log_.GetEventType(i);
     if (event_type != ParsedRtcEventLog::VIDEO_RECEIVER_CONFIG_EVENT &&
         event_type != ParsedRtcEventLog::VIDEO_SENDER_CONFIG_EVENT &&
@@ -601,22 +615,20 @@ void EventLogAnalyzer::CreatePlayoutGraph(Plot* plot) {
 
   uint32_t ssrc;
 
-  for (size_t i = 0; i < parsed_log_.GetNumberOfEvents(); i++) {
-    ParsedRtcEventLog::EventType event_type = parsed_log_.GetEventType(i);
-    if (event_type == ParsedRtcEventLog::AUDIO_PLAYOUT_EVENT) {
-      parsed_log_.GetAudioPlayout(i, &ssrc);
-      uint64_t timestamp = parsed_log_.GetTimestamp(i);
-      if (MatchingSsrc(ssrc, desired_ssrc_)) {
-        float x = static_cast<float>(timestamp - begin_time_) / 1000000;
-        float y = static_cast<float>(timestamp - last_playout[ssrc]) / 1000;
-        if (time_series[ssrc].points.size() == 0) {
-          // There were no previusly logged playout for this SSRC.
-          // Generate a point, but place it on the x-axis.
-          y = 0;
-        }
-        time_series[ssrc].points.push_back(TimeSeriesPoint(x, y));
-        last_playout[ssrc] = timestamp;
+  for (size_t i :
+       parsed_log_.GetEventIndices(ParsedRtcEventLog::AUDIO_PLAYOUT_EVENT)) {
+    parsed_log_.GetAudioPlayout(i, &ssrc);
+    uint64_t timestamp = parsed_log_.GetTimestamp(i);
+    if (MatchingSsrc(ssrc, desired_ssrc_)) {
+      float x = static_cast<float>(timestamp - begin_time_) / 1000000;
+      float y = static_cast<float>(timestamp - last_playout[ssrc]) / 1000;
+      if (time_series[ssrc].points.size() == 0) {
+        // There were no previusly logged playout for this SSRC.
+        // Generate a point, but place it on the x-axis.
+        y = 0;
       }
+      time_series[ssrc].points.push_back(TimeSeriesPoint(x, y));
+      last_playout[ssrc] = timestamp;
     }
   }
 
@@ -833,15 +845,12 @@ void EventLogAnalyzer::CreateTotalBitrateGraph(
   size_t total_length;
 
   // Extract timestamps and sizes for the relevant packets.
-  for (size_t i = 0; i < parsed_log_.GetNumberOfEvents(); i++) {
-    ParsedRtcEventLog::EventType event_type = parsed_log_.GetEventType(i);
-    if (event_type == ParsedRtcEventLog::RTP_EVENT) {
-      parsed_log_.GetRtpHeader(i, &direction, nullptr, nullptr, nullptr,
-                               &total_length);
-      if (direction == desired_direction) {
-        uint64_t timestamp = parsed_log_.GetTimestamp(i);
-        packets.push_back(TimestampSize(timestamp, total_length));
-      }
+  for (size_t i : parsed_log_.GetEventIndices(ParsedRtcEventLog::RTP_EVENT)) {
+    parsed_log_.GetRtpHeader(i, &direction, nullptr, nullptr, nullptr,
+                             &total_length);
+    if (direction == desired_direction) {
+      uint64_t timestamp = parsed_log_.GetTimestamp(i);
+      packets.push_back(TimestampSize(timestamp, total_length));
     }
   }
 
@@ -15,12 +15,15 @@
 #include "webrtc/base/checks.h"
 #include "webrtc/modules/video_coding/include/video_codec_interface.h"
 #include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/system_wrappers/include/field_trial.h"
 #include "webrtc/system_wrappers/include/metrics.h"
 
 namespace webrtc {
 namespace {
 // Periodic time interval for processing samples for |freq_offset_counter_|.
 const int64_t kFreqOffsetProcessIntervalMs = 40000;
+// VideoFrameTiming is only reported with this field trial set to "Enabled".
+const char kFrameTimingFieldTrial[] = "WebRTC-VideoFrameTiming";
 }  // namespace
 
 ReceiveStatisticsProxy::ReceiveStatisticsProxy(
@@ -29,6 +32,8 @@ ReceiveStatisticsProxy::ReceiveStatisticsProxy(
     : clock_(clock),
       config_(*config),
       start_ms_(clock->TimeInMilliseconds()),
+      frame_timing_enabled_(
+          field_trial::FindFullName(kFrameTimingFieldTrial) == "Enabled"),
       // 1000ms window, scale 1000 for ms to s.
       decode_fps_estimator_(1000, 1000),
       renders_fps_estimator_(1000, 1000),
@@ -112,6 +117,42 @@ void ReceiveStatisticsProxy::UpdateHistograms() {
   if (e2e_delay_ms != -1)
     RTC_HISTOGRAM_COUNTS_10000("WebRTC.Video.EndToEndDelayInMs", e2e_delay_ms);
 
+  int first_to_last_packet_ms =
+      first_to_last_packet_counter_.Avg(kMinRequiredSamples);
+  if (first_to_last_packet_ms != -1) {
+    RTC_HISTOGRAM_COUNTS_1000("WebRTC.Video.Timing.FirstToLastPacketInMs",
+                              first_to_last_packet_ms);
+  }
+  int last_packet_to_complete_ms =
+      last_packet_to_complete_counter_.Avg(kMinRequiredSamples);
+  if (last_packet_to_complete_ms != -1) {
+    RTC_HISTOGRAM_COUNTS_1000("WebRTC.Video.Timing.LastPacketToCompleteInMs",
+                              last_packet_to_complete_ms);
+  }
+  int frame_buffer_wait_ms =
+      frame_buffer_wait_counter_.Avg(kMinRequiredSamples);
+  if (frame_buffer_wait_ms != -1) {
+    RTC_HISTOGRAM_COUNTS_10000("WebRTC.Video.Timing.FrameBufferWaitInMs",
+                               frame_buffer_wait_ms);
+  }
+  int decode_duration_ms = decode_duration_counter_.Avg(kMinRequiredSamples);
+  if (decode_duration_ms != -1) {
+    RTC_HISTOGRAM_COUNTS_1000("WebRTC.Video.Timing.DecodeDurationInMs",
+                              decode_duration_ms);
+  }
+  int render_queue_delay_ms =
+      render_queue_delay_counter_.Avg(kMinRequiredSamples);
+  if (render_queue_delay_ms != -1) {
+    RTC_HISTOGRAM_COUNTS_10000("WebRTC.Video.Timing.RenderQueueDelayInMs",
+                               render_queue_delay_ms);
+  }
+  int first_packet_to_render_ms =
+      first_packet_to_render_counter_.Avg(kMinRequiredSamples);
+  if (first_packet_to_render_ms != -1) {
+    RTC_HISTOGRAM_COUNTS_10000("WebRTC.Video.Timing.FirstPacketToRenderInMs",
+                               first_packet_to_render_ms);
+  }
+
   StreamDataCounters rtp = stats_.rtp_stats;
   StreamDataCounters rtx;
   for (auto it : rtx_stats_)
@@ -284,6 +325,25 @@ void ReceiveStatisticsProxy::OnRenderedFrame(const VideoFrame& frame) {
     if (delay_ms >= 0)
       e2e_delay_counter_.Add(delay_ms);
   }
+
+  if (!frame_timing_enabled_)
+    return;
+
+  VideoFrameTiming timing = frame.timing();
+  timing.set_time_ms(VideoFrameTiming::kRender, now);
+  AddTimeBetween(timing, VideoFrameTiming::kFirstPacket,
+                 VideoFrameTiming::kLastPacket, &first_to_last_packet_counter_);
+  AddTimeBetween(timing, VideoFrameTiming::kLastPacket,
+                 VideoFrameTiming::kComplete,
+                 &last_packet_to_complete_counter_);
+  AddTimeBetween(timing, VideoFrameTiming::kComplete,
+                 VideoFrameTiming::kDecodeStart, &frame_buffer_wait_counter_);
+  AddTimeBetween(timing, VideoFrameTiming::kDecodeStart,
+                 VideoFrameTiming::kDecodeEnd, &decode_duration_counter_);
+  AddTimeBetween(timing, VideoFrameTiming::kDecodeEnd,
+                 VideoFrameTiming::kRender, &render_queue_delay_counter_);
+  AddTimeBetween(timing, VideoFrameTiming::kFirstPacket,
+                 VideoFrameTiming::kRender, &first_packet_to_render_counter_);
 }
 
 void ReceiveStatisticsProxy::OnSyncOffsetUpdated(int64_t sync_offset_ms,
@@ -327,6 +387,15 @@ void ReceiveStatisticsProxy::OnPreDecode(
   }
 }
 
+void ReceiveStatisticsProxy::AddTimeBetween(const VideoFrameTiming& timing,
+                                            VideoFrameTiming::Stage from,
+                                            VideoFrameTiming::Stage to,
+                                            SampleCounter* counter) {
+  int64_t time_ms = timing.TimeBetween(from, to);
+  if (time_ms != -1)
+    counter->Add(static_cast<int>(time_ms));
+}
+
 void ReceiveStatisticsProxy::SampleCounter::Add(int sample) {
   sum += sample;
   ++num_samples;
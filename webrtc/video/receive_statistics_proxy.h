@@ -95,6 +95,11 @@ class ReceiveStatisticsProxy : public VCMReceiveStatisticsCallback,
   };
 
   void UpdateHistograms() EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  // Adds the time between two stages to |counter|, if the frame passed both.
+  static void AddTimeBetween(const VideoFrameTiming& timing,
+                             VideoFrameTiming::Stage from,
+                             VideoFrameTiming::Stage to,
+                             SampleCounter* counter);
 
   Clock* const clock_;
   // Ownership of this object lies with the owner of the ReceiveStatisticsProxy
@@ -106,6 +111,8 @@ class ReceiveStatisticsProxy : public VCMReceiveStatisticsCallback,
   // then no longer store a pointer to the object).
   const VideoReceiveStream::Config& config_;
   const int64_t start_ms_;
+  // If false, the VideoFrameTiming of rendered frames is not aggregated.
+  const bool frame_timing_enabled_;
 
   rtc::CriticalSection crit_;
   VideoReceiveStream::Stats stats_ GUARDED_BY(crit_);
@@ -122,6 +129,13 @@ class ReceiveStatisticsProxy : public VCMReceiveStatisticsCallback,
   SampleCounter current_delay_counter_ GUARDED_BY(crit_);
   SampleCounter delay_counter_ GUARDED_BY(crit_);
   SampleCounter e2e_delay_counter_ GUARDED_BY(crit_);
+  // Delays between the receive side stages of VideoFrameTiming.
+  SampleCounter first_to_last_packet_counter_ GUARDED_BY(crit_);
+  SampleCounter last_packet_to_complete_counter_ GUARDED_BY(crit_);
+  SampleCounter frame_buffer_wait_counter_ GUARDED_BY(crit_);
+  SampleCounter decode_duration_counter_ GUARDED_BY(crit_);
+  SampleCounter render_queue_delay_counter_ GUARDED_BY(crit_);
+  SampleCounter first_packet_to_render_counter_ GUARDED_BY(crit_);
   MaxCounter freq_offset_counter_ GUARDED_BY(crit_);
   ReportBlockStats report_block_stats_ GUARDED_BY(crit_);
   QpCounters qp_counters_;  // Only accessed on the decoding thread.
@@ -13,7 +13,9 @@
 #include <memory>
 
 #include "webrtc/system_wrappers/include/metrics_default.h"
+#include "webrtc/test/field_trial.h"
 #include "webrtc/test/gtest.h"
+#include "webrtc/video_frame.h"
 
 namespace webrtc {
 namespace {
@@ -47,6 +49,16 @@ class ReceiveStatisticsProxyTest : public ::testing::Test {
   std::unique_ptr<ReceiveStatisticsProxy> statistics_proxy_;
 };
 
+class ReceiveStatisticsProxyFrameTimingTest
+    : public ReceiveStatisticsProxyTest {
+ public:
+  ReceiveStatisticsProxyFrameTimingTest()
+      : override_field_trials_("WebRTC-VideoFrameTiming/Enabled/") {}
+
+ private:
+  test::ScopedFieldTrials override_field_trials_;
+};
+
 TEST_F(ReceiveStatisticsProxyTest, OnDecodedFrameIncreasesFramesDecoded) {
   EXPECT_EQ(0u, statistics_proxy_->GetStats().frames_decoded);
   for (uint32_t i = 1; i <= 3; ++i) {
@@ -143,4 +155,69 @@ TEST_F(ReceiveStatisticsProxyTest, RtpToNtpFrequencyOffsetHistogramIsUpdated) {
   EXPECT_EQ(1, metrics::NumEvents("WebRTC.Video.RtpToNtpFreqOffsetInKhz", 3));
 }
 
+TEST_F(ReceiveStatisticsProxyTest, FrameTimingIsNotReportedByDefault) {
+  fake_clock_.AdvanceTimeMilliseconds(1000);
+  const int64_t kNowMs = fake_clock_.TimeInMilliseconds();
+  VideoFrameTiming timing;
+  timing.set_time_ms(VideoFrameTiming::kDecodeStart, kNowMs - 20);
+  timing.set_time_ms(VideoFrameTiming::kDecodeEnd, kNowMs - 10);
+  VideoFrame frame(I420Buffer::Create(16, 16), 0, 0, kVideoRotation_0);
+  frame.set_timing(timing);
+  for (int i = 0; i < kMinRequiredSamples; ++i)
+    statistics_proxy_->OnRenderedFrame(frame);
+  statistics_proxy_.reset();
+  EXPECT_EQ(0, metrics::NumSamples("WebRTC.Video.Timing.DecodeDurationInMs"));
+}
+
+TEST_F(ReceiveStatisticsProxyFrameTimingTest, HistogramsAreUpdated) {
+  fake_clock_.AdvanceTimeMilliseconds(1000);
+  const int64_t kNowMs = fake_clock_.TimeInMilliseconds();
+  VideoFrameTiming timing;
+  timing.set_time_ms(VideoFrameTiming::kFirstPacket, kNowMs - 60);
+  timing.set_time_ms(VideoFrameTiming::kLastPacket, kNowMs - 55);
+  timing.set_time_ms(VideoFrameTiming::kComplete, kNowMs - 45);
+  timing.set_time_ms(VideoFrameTiming::kDecodeStart, kNowMs - 25);
+  timing.set_time_ms(VideoFrameTiming::kDecodeEnd, kNowMs - 4);
+  VideoFrame frame(I420Buffer::Create(16, 16), 0, 0, kVideoRotation_0);
+  frame.set_timing(timing);
+  for (int i = 0; i < kMinRequiredSamples; ++i)
+    statistics_proxy_->OnRenderedFrame(frame);
+  // Histograms are updated when the statistics_proxy_ is deleted.
+  statistics_proxy_.reset();
+  EXPECT_EQ(1, metrics::NumEvents(
+                   "WebRTC.Video.Timing.FirstToLastPacketInMs", 5));
+  EXPECT_EQ(1, metrics::NumEvents(
+                   "WebRTC.Video.Timing.LastPacketToCompleteInMs", 10));
+  EXPECT_EQ(1,
+            metrics::NumEvents("WebRTC.Video.Timing.FrameBufferWaitInMs", 20));
+  EXPECT_EQ(1,
+            metrics::NumEvents("WebRTC.Video.Timing.DecodeDurationInMs", 21));
+  EXPECT_EQ(1,
+            metrics::NumEvents("WebRTC.Video.Timing.RenderQueueDelayInMs", 4));
+  EXPECT_EQ(1, metrics::NumEvents(
+                   "WebRTC.Video.Timing.FirstPacketToRenderInMs", 60));
+}
+
+TEST_F(ReceiveStatisticsProxyFrameTimingTest, SkipsStagesNotPassed) {
+  fake_clock_.AdvanceTimeMilliseconds(1000);
+  const int64_t kNowMs = fake_clock_.TimeInMilliseconds();
+  // Decoded before all packets were received.
+  VideoFrameTiming timing;
+  timing.set_time_ms(VideoFrameTiming::kFirstPacket, kNowMs - 30);
+  timing.set_time_ms(VideoFrameTiming::kDecodeStart, kNowMs - 20);
+  timing.set_time_ms(VideoFrameTiming::kDecodeEnd, kNowMs - 10);
+  VideoFrame frame(I420Buffer::Create(16, 16), 0, 0, kVideoRotation_0);
+  frame.set_timing(timing);
+  for (int i = 0; i < kMinRequiredSamples; ++i)
+    statistics_proxy_->OnRenderedFrame(frame);
+  statistics_proxy_.reset();
+  EXPECT_EQ(0,
+            metrics::NumSamples("WebRTC.Video.Timing.FirstToLastPacketInMs"));
+  EXPECT_EQ(0, metrics::NumSamples("WebRTC.Video.Timing.FrameBufferWaitInMs"));
+  EXPECT_EQ(1,
+            metrics::NumEvents("WebRTC.Video.Timing.DecodeDurationInMs", 10));
+  EXPECT_EQ(1, metrics::NumEvents(
+                   "WebRTC.Video.Timing.FirstPacketToRenderInMs", 30));
+}
+
 }  // namespace webrtc
@@ -209,6 +209,39 @@ void SendStatisticsProxy::UmaSamplesContainer::UpdateHistograms(
                                  max_delay_ms);
   }
 
+  int source_delay_ms = source_delay_counter_.Avg(kMinRequiredMetricsSamples);
+  if (source_delay_ms != -1) {
+    RTC_HISTOGRAMS_COUNTS_1000(kIndex, uma_prefix_ + "Timing.SourceDelayInMs",
+                               source_delay_ms);
+  }
+  int queue_delay_ms =
+      encode_queue_delay_counter_.Avg(kMinRequiredMetricsSamples);
+  if (queue_delay_ms != -1) {
+    RTC_HISTOGRAMS_COUNTS_1000(
+        kIndex, uma_prefix_ + "Timing.EncodeQueueDelayInMs", queue_delay_ms);
+  }
+  int encode_duration_ms =
+      encode_duration_counter_.Avg(kMinRequiredMetricsSamples);
+  if (encode_duration_ms != -1) {
+    RTC_HISTOGRAMS_COUNTS_1000(kIndex,
+                               uma_prefix_ + "Timing.EncodeDurationInMs",
+                               encode_duration_ms);
+  }
+  int packetization_ms =
+      packetization_time_counter_.Avg(kMinRequiredMetricsSamples);
+  if (packetization_ms != -1) {
+    RTC_HISTOGRAMS_COUNTS_1000(kIndex,
+                               uma_prefix_ + "Timing.PacketizationTimeInMs",
+                               packetization_ms);
+  }
+  int capture_to_packetized_ms =
+      capture_to_packetized_counter_.Avg(kMinRequiredMetricsSamples);
+  if (capture_to_packetized_ms != -1) {
+    RTC_HISTOGRAMS_COUNTS_10000(kIndex,
+                                uma_prefix_ + "Timing.CaptureToPacketizedInMs",
+                                capture_to_packetized_ms);
+  }
+
   for (const auto& it : qp_counters_) {
     int qp_vp8 = it.second.vp8.Avg(kMinRequiredMetricsSamples);
     if (qp_vp8 != -1) {
@@ -385,6 +418,34 @@ void SendStatisticsProxy::OnEncodedFrameTimeMeasured(
   stats_.encode_usage_percent = metrics.encode_usage_percent;
 }
 
+void SendStatisticsProxy::OnSendFrameTiming(const VideoFrameTiming& timing) {
+  typedef VideoFrameTiming Timing;
+  int source_delay_ms =
+      static_cast<int>(timing.TimeBetween(Timing::kCapture, Timing::kAdapt));
+  int queue_delay_ms = static_cast<int>(
+      timing.TimeBetween(Timing::kAdapt, Timing::kEncodeStart));
+  int encode_duration_ms = static_cast<int>(
+      timing.TimeBetween(Timing::kEncodeStart, Timing::kEncodeEnd));
+  int packetization_ms = static_cast<int>(
+      timing.TimeBetween(Timing::kEncodeEnd, Timing::kPacketize));
+  int capture_to_packetized_ms = static_cast<int>(
+      timing.TimeBetween(Timing::kCapture, Timing::kPacketize));
+
+  rtc::CritScope lock(&crit_);
+  if (source_delay_ms != -1)
+    uma_container_->source_delay_counter_.Add(source_delay_ms);
+  if (queue_delay_ms != -1)
+    uma_container_->encode_queue_delay_counter_.Add(queue_delay_ms);
+  if (encode_duration_ms != -1)
+    uma_container_->encode_duration_counter_.Add(encode_duration_ms);
+  if (packetization_ms != -1)
+    uma_container_->packetization_time_counter_.Add(packetization_ms);
+  if (capture_to_packetized_ms != -1) {
+    uma_container_->capture_to_packetized_counter_.Add(
+        capture_to_packetized_ms);
+  }
+}
+
 void SendStatisticsProxy::OnSuspendChange(bool is_suspended) {
   rtc::CritScope lock(&crit_);
   stats_.suspended = is_suspended;
@@ -569,6 +630,11 @@ void SendStatisticsProxy::OnIncomingFrame(int width, int height) {
   uma_container_->cpu_limited_frame_counter_.Add(stats_.cpu_limited_resolution);
 }
 
+void SendStatisticsProxy::OnInputFrameConvertedToI420() {
+  rtc::CritScope lock(&crit_);
+  ++stats_.input_frames_converted_to_i420;
+}
+
 void SendStatisticsProxy::SetCpuRestrictedResolution(
     bool cpu_restricted_resolution) {
   rtc::CritScope lock(&crit_);
@@ -55,6 +55,11 @@ class SendStatisticsProxy : public CpuOveruseMetricsObserver,
                                   const CodecSpecificInfo* codec_info);
   // Used to update incoming frame rate.
   void OnIncomingFrame(int width, int height);
+  // Used to count the input frames that needed a conversion to I420.
+  void OnInputFrameConvertedToI420();
+  // Used to update the delays of the send side stages, once the encoded
+  // frame has been packetized.
+  void OnSendFrameTiming(const VideoFrameTiming& timing);
 
   // Used to indicate that the current input frame resolution is restricted due
   // to cpu usage.
@@ -186,6 +191,11 @@ class SendStatisticsProxy : public CpuOveruseMetricsObserver,
     SampleCounter bw_resolutions_disabled_counter_;
     SampleCounter delay_counter_;
     SampleCounter max_delay_counter_;
+    SampleCounter source_delay_counter_;
+    SampleCounter encode_queue_delay_counter_;
+    SampleCounter encode_duration_counter_;
+    SampleCounter packetization_time_counter_;
+    SampleCounter capture_to_packetized_counter_;
     rtc::RateTracker input_frame_rate_tracker_;
     rtc::RateTracker sent_frame_rate_tracker_;
     int64_t first_rtcp_stats_time_ms_;
@@ -385,6 +385,27 @@ TEST_F(SendStatisticsProxyTest, CodecTypeHistogramIsUpdated) {
   EXPECT_EQ(1, metrics::NumSamples("WebRTC.Video.Encoder.CodecType"));
 }
 
+TEST_F(SendStatisticsProxyTest, FrameTimingHistogramsAreUpdated) {
+  VideoFrameTiming timing;
+  timing.set_time_ms(VideoFrameTiming::kCapture, 1000);
+  timing.set_time_ms(VideoFrameTiming::kAdapt, 1003);
+  timing.set_time_ms(VideoFrameTiming::kEncodeStart, 1010);
+  timing.set_time_ms(VideoFrameTiming::kEncodeEnd, 1030);
+  timing.set_time_ms(VideoFrameTiming::kPacketize, 1031);
+  for (int i = 0; i < SendStatisticsProxy::kMinRequiredMetricsSamples; ++i)
+    statistics_proxy_->OnSendFrameTiming(timing);
+  statistics_proxy_.reset();
+  EXPECT_EQ(1, metrics::NumEvents("WebRTC.Video.Timing.SourceDelayInMs", 3));
+  EXPECT_EQ(1,
+            metrics::NumEvents("WebRTC.Video.Timing.EncodeQueueDelayInMs", 7));
+  EXPECT_EQ(1,
+            metrics::NumEvents("WebRTC.Video.Timing.EncodeDurationInMs", 20));
+  EXPECT_EQ(1,
+            metrics::NumEvents("WebRTC.Video.Timing.PacketizationTimeInMs", 1));
+  EXPECT_EQ(1, metrics::NumEvents(
+                   "WebRTC.Video.Timing.CaptureToPacketizedInMs", 31));
+}
+
 TEST_F(SendStatisticsProxyTest, VerifyQpHistogramStats_Vp8) {
   EncodedImage encoded_image;
   CodecSpecificInfo codec_info;
@@ -21,6 +21,7 @@
 #include "webrtc/modules/pacing/paced_sender.h"
 #include "webrtc/modules/video_coding/include/video_coding.h"
 #include "webrtc/modules/video_coding/include/video_coding_defines.h"
+#include "webrtc/system_wrappers/include/field_trial.h"
 #include "webrtc/video/overuse_frame_detector.h"
 #include "webrtc/video/send_statistics_proxy.h"
 #include "webrtc/video_frame.h"
@@ -31,6 +32,10 @@ namespace {
 // Time interval for logging frame counts.
 const int64_t kFrameLogIntervalMs = 60000;
 
+// VideoFrameTiming is only stamped and reported with this field trial set to
+// "Enabled".
+const char kFrameTimingFieldTrial[] = "WebRTC-VideoFrameTiming";
+
 VideoCodecType PayloadNameToCodecType(const std::string& payload_name) {
   if (payload_name == "VP8")
     return kVideoCodecVP8;
@@ -236,6 +241,7 @@ class ViEEncoder::EncodeTask : public rtc::QueuedTask {
       LOG(LS_VERBOSE)
           << "Incoming frame dropped due to that the encoder is blocked.";
       ++vie_encoder_->dropped_frame_count_;
+      vie_encoder_->AccumulateUpdateRect(frame_);
     }
     if (log_stats_) {
       LOG(LS_INFO) << "Number of frames: captured "
@@ -391,6 +397,7 @@ ViEEncoder::ViEEncoder(uint32_t number_of_cores,
       picture_id_sli_(0),
       has_received_rpsi_(false),
       picture_id_rpsi_(0),
+      accumulated_update_rect_(VideoFrame::UpdateRect{0, 0, 0, 0}),
       clock_(Clock::GetRealTimeClock()),
       degradation_preference_(
           VideoSendStream::DegradationPreference::kBalanced),
@@ -398,11 +405,15 @@ ViEEncoder::ViEEncoder(uint32_t number_of_cores,
       last_frame_width_(0),
       last_frame_height_(0),
       last_captured_timestamp_(0),
+      incoming_frame_dropped_(false),
       delta_ntp_internal_ms_(clock_->CurrentNtpInMilliseconds() -
                              clock_->TimeInMilliseconds()),
       last_frame_log_ms_(clock_->TimeInMilliseconds()),
       captured_frame_count_(0),
       dropped_frame_count_(0),
+      frame_timing_enabled_(
+          field_trial::FindFullName(kFrameTimingFieldTrial) == "Enabled"),
+      next_encode_timing_(0),
       encoder_queue_("EncoderQueue") {
   encoder_queue_.PostTask([this] {
     RTC_DCHECK_RUN_ON(&encoder_queue_);
@@ -557,6 +568,17 @@ void ViEEncoder::OnFrame(const VideoFrame& video_frame) {
   int64_t current_time = clock_->TimeInMilliseconds();
   incoming_frame.set_render_time_ms(current_time);
 
+  if (frame_timing_enabled_) {
+    VideoFrameTiming timing = video_frame.timing();
+    if (timing.time_ms(VideoFrameTiming::kCapture) < 0 &&
+        video_frame.render_time_ms() != 0) {
+      timing.set_time_ms(VideoFrameTiming::kCapture,
+                         video_frame.render_time_ms());
+    }
+    timing.set_time_ms(VideoFrameTiming::kAdapt, current_time);
+    incoming_frame.set_timing(timing);
+  }
+
   // Capture time may come from clock with an offset and drift from clock_.
   int64_t capture_ntp_time_ms;
   if (video_frame.ntp_time_ms() != 0) {
@@ -579,9 +601,16 @@ void ViEEncoder::OnFrame(const VideoFrame& video_frame) {
                     << incoming_frame.ntp_time_ms()
                     << " <= " << last_captured_timestamp_
                     << ") for incoming frame. Dropping.";
+    incoming_frame_dropped_ = true;
     return;
   }
 
+  if (incoming_frame_dropped_) {
+    // The encoder cannot be told what the dropped frame changed.
+    incoming_frame.set_update_rect(rtc::Optional<VideoFrame::UpdateRect>());
+    incoming_frame_dropped_ = false;
+  }
+
   bool log_stats = false;
   if (current_time - last_frame_log_ms_ > kFrameLogIntervalMs) {
     last_frame_log_ms_ = current_time;
@@ -593,6 +622,14 @@ void ViEEncoder::OnFrame(const VideoFrame& video_frame) {
       incoming_frame, this, clock_->TimeInMilliseconds(), log_stats)));
 }
 
+void ViEEncoder::AccumulateUpdateRect(const VideoFrame& dropped_frame) {
+  RTC_DCHECK_RUN_ON(&encoder_queue_);
+  if (accumulated_update_rect_ && dropped_frame.update_rect())
+    accumulated_update_rect_->Union(*dropped_frame.update_rect());
+  else
+    accumulated_update_rect_.reset();
+}
+
 bool ViEEncoder::EncoderPaused() const {
   RTC_DCHECK_RUN_ON(&encoder_queue_);
   // Pause video if paused by caller or as long as the network is down or the
@@ -647,6 +684,7 @@ void ViEEncoder::EncodeVideoFrame(const VideoFrame& video_frame,
 
   if (EncoderPaused()) {
     TraceFrameDropStart();
+    AccumulateUpdateRect(video_frame);
     return;
   }
   TraceFrameDropEnd();
@@ -659,25 +697,55 @@ void ViEEncoder::EncodeVideoFrame(const VideoFrame& video_frame,
 
   overuse_detector_.FrameCaptured(video_frame, time_when_posted_in_ms);
 
+  if (frame_timing_enabled_) {
+    rtc::CritScope lock(&encode_timing_crit_);
+    EncodeTiming& encode_timing = encode_timings_[next_encode_timing_];
+    encode_timing.rtp_timestamp = video_frame.timestamp();
+    encode_timing.timing = video_frame.timing();
+    encode_timing.timing.set_time_ms(VideoFrameTiming::kEncodeStart,
+                                     clock_->TimeInMilliseconds());
+    next_encode_timing_ = (next_encode_timing_ + 1) % kEncodeTimingHistory;
+  }
+
+  // Screen content encoders skip what has not changed since the last frame
+  // they were given, so they must also be told what the frames dropped in
+  // between changed.
+  VideoFrame frame_to_encode = video_frame;
+  if (accumulated_update_rect_ && video_frame.update_rect()) {
+    VideoFrame::UpdateRect update_rect = *accumulated_update_rect_;
+    update_rect.Union(*video_frame.update_rect());
+    frame_to_encode.set_update_rect(
+        rtc::Optional<VideoFrame::UpdateRect>(update_rect));
+  } else {
+    frame_to_encode.set_update_rect(rtc::Optional<VideoFrame::UpdateRect>());
+  }
+  accumulated_update_rect_ =
+      rtc::Optional<VideoFrame::UpdateRect>(VideoFrame::UpdateRect{0, 0, 0, 0});
+
   if (codec_type_ == webrtc::kVideoCodecVP8) {
     webrtc::CodecSpecificInfo codec_specific_info;
     codec_specific_info.codecType = webrtc::kVideoCodecVP8;
 
-      codec_specific_info.codecSpecific.VP8.hasReceivedRPSI =
-          has_received_rpsi_;
-      codec_specific_info.codecSpecific.VP8.hasReceivedSLI =
-          has_received_sli_;
-      codec_specific_info.codecSpecific.VP8.pictureIdRPSI =
-          picture_id_rpsi_;
-      codec_specific_info.codecSpecific.VP8.pictureIdSLI  =
-          picture_id_sli_;
-      has_received_sli_ = false;
-      has_received_rpsi_ = false;
-
-      video_sender_.AddVideoFrame(video_frame, &codec_specific_info);
-      return;
+    codec_specific_info.codecSpecific.VP8.hasReceivedRPSI = has_received_rpsi_;
+    codec_specific_info.codecSpecific.VP8.hasReceivedSLI = has_received_sli_;
+    codec_specific_info.codecSpecific.VP8.pictureIdRPSI = picture_id_rpsi_;
+    codec_specific_info.codecSpecific.VP8.pictureIdSLI = picture_id_sli_;
+    has_received_sli_ = false;
+    has_received_rpsi_ = false;
+
+    video_sender_.AddVideoFrame(frame_to_encode, &codec_specific_info);
+  } else {
+    video_sender_.AddVideoFrame(frame_to_encode, nullptr);
+  }
+
+  // An encoder that needs I420 has converted the frame by now, unless another
+  // consumer did so before.
+  rtc::scoped_refptr<VideoFrameBuffer> buffer =
+      video_frame.video_frame_buffer();
+  if (buffer->type() == VideoFrameBuffer::Type::kNV12 &&
+      static_cast<NV12Buffer*>(buffer.get())->num_i420_conversions() > 0) {
+    stats_proxy_->OnInputFrameConvertedToI420();
   }
-  video_sender_.AddVideoFrame(video_frame, nullptr);
 }
 
 void ViEEncoder::SendKeyFrame() {
@@ -696,16 +764,35 @@ EncodedImageCallback::Result ViEEncoder::OnEncodedImage(
   // Encoded is called on whatever thread the real encoder implementation run
   // on. In the case of hardware encoders, there might be several encoders
   // running in parallel on different threads.
+  EncodedImage image(encoded_image);
+  if (frame_timing_enabled_) {
+    // Simulcast layers of a frame all find the timing of the input frame.
+    rtc::CritScope lock(&encode_timing_crit_);
+    for (const EncodeTiming& encode_timing : encode_timings_) {
+      if (encode_timing.rtp_timestamp == image._timeStamp) {
+        image.timing_ = encode_timing.timing;
+        break;
+      }
+    }
+    image.timing_.set_time_ms(VideoFrameTiming::kEncodeEnd,
+                              clock_->TimeInMilliseconds());
+  }
+
   if (stats_proxy_) {
-    stats_proxy_->OnSendEncodedImage(encoded_image, codec_specific_info);
+    stats_proxy_->OnSendEncodedImage(image, codec_specific_info);
   }
 
   EncodedImageCallback::Result result =
-      sink_->OnEncodedImage(encoded_image, codec_specific_info, fragmentation);
+      sink_->OnEncodedImage(image, codec_specific_info, fragmentation);
 
   int64_t time_sent = clock_->TimeInMilliseconds();
   uint32_t timestamp = encoded_image._timeStamp;
 
+  if (frame_timing_enabled_ && stats_proxy_) {
+    image.timing_.set_time_ms(VideoFrameTiming::kPacketize, time_sent);
+    stats_proxy_->OnSendFrameTiming(image.timing_);
+  }
+
   encoder_queue_.PostTask([this, timestamp, time_sent] {
     RTC_DCHECK_RUN_ON(&encoder_queue_);
     overuse_detector_.FrameSent(timestamp, time_sent);
@@ -124,6 +124,15 @@ class ViEEncoder : public rtc::VideoSinkInterface<VideoFrame>,
   class EncodeTask;
   class VideoSourceProxy;
 
+  // Number of frames in encoding whose timing is remembered. Enough for
+  // encoders that buffer a few frames, such as hardware encoders.
+  static const size_t kEncodeTimingHistory = 16;
+
+  struct EncodeTiming {
+    uint32_t rtp_timestamp = 0;
+    VideoFrameTiming timing;
+  };
+
   struct VideoFrameInfo {
     VideoFrameInfo(int width,
                    int height,
@@ -159,6 +168,10 @@ class ViEEncoder : public rtc::VideoSinkInterface<VideoFrame>,
       const CodecSpecificInfo* codec_specific_info,
       const RTPFragmentationHeader* fragmentation) override;
 
+  // Adds the changes of a frame that is dropped before it reaches the encoder
+  // to the next frame that does.
+  void AccumulateUpdateRect(const VideoFrame& dropped_frame);
+
   bool EncoderPaused() const;
   void TraceFrameDropStart();
   void TraceFrameDropEnd();
@@ -202,6 +215,10 @@ class ViEEncoder : public rtc::VideoSinkInterface<VideoFrame>,
   uint8_t picture_id_sli_ ACCESS_ON(&encoder_queue_);
   bool has_received_rpsi_ ACCESS_ON(&encoder_queue_);
   uint64_t picture_id_rpsi_ ACCESS_ON(&encoder_queue_);
+  // Changes of the frames dropped since the last frame passed to the encoder.
+  // Unset if they are unknown.
+  rtc::Optional<VideoFrame::UpdateRect> accumulated_update_rect_
+      ACCESS_ON(&encoder_queue_);
   Clock* const clock_;
 
   VideoSendStream::DegradationPreference degradation_preference_
@@ -222,6 +239,9 @@ class ViEEncoder : public rtc::VideoSinkInterface<VideoFrame>,
   Atomic32 posted_frames_waiting_for_encode_;
   // Used to make sure incoming time stamp is increasing for every frame.
   int64_t last_captured_timestamp_ GUARDED_BY(incoming_frame_race_checker_);
+  // Set if the last incoming frame was dropped before it was posted to
+  // |encoder_queue_|.
+  bool incoming_frame_dropped_ GUARDED_BY(incoming_frame_race_checker_);
   // Delta used for translating between NTP and internal timestamps.
   const int64_t delta_ntp_internal_ms_ GUARDED_BY(incoming_frame_race_checker_);
 
@@ -229,6 +249,16 @@ class ViEEncoder : public rtc::VideoSinkInterface<VideoFrame>,
   int captured_frame_count_ ACCESS_ON(&encoder_queue_);
   int dropped_frame_count_ ACCESS_ON(&encoder_queue_);
 
+  // If false, frames are not stamped with VideoFrameTiming, and the members
+  // below are unused.
+  const bool frame_timing_enabled_;
+  // Timing of the most recent frames handed to the encoder, written on
+  // |encoder_queue_| and read in OnEncodedImage() on the encoder threads.
+  rtc::CriticalSection encode_timing_crit_;
+  EncodeTiming encode_timings_[kEncodeTimingHistory]
+      GUARDED_BY(encode_timing_crit_);
+  size_t next_encode_timing_ GUARDED_BY(encode_timing_crit_);
+
   // All public methods are proxied to |encoder_queue_|. It must must be
   // destroyed first to make sure no tasks are run that use other members.
   rtc::TaskQueue encoder_queue_;
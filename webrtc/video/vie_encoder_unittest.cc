@@ -15,6 +15,7 @@
 #include "webrtc/system_wrappers/include/metrics_default.h"
 #include "webrtc/test/encoder_settings.h"
 #include "webrtc/test/fake_encoder.h"
+#include "webrtc/test/field_trial.h"
 #include "webrtc/test/frame_generator.h"
 #include "webrtc/test/gtest.h"
 #include "webrtc/video/send_statistics_proxy.h"
@@ -143,6 +144,11 @@ class ViEEncoderTest : public ::testing::Test {
       EXPECT_EQ(ntp_time_ms_, ntp_time_ms);
     }
 
+    rtc::Optional<VideoFrame::UpdateRect> last_update_rect() const {
+      rtc::CritScope lock(&crit_);
+      return last_update_rect_;
+    }
+
    private:
     int32_t Encode(const VideoFrame& input_image,
                    const CodecSpecificInfo* codec_specific_info,
@@ -158,6 +164,7 @@ class ViEEncoderTest : public ::testing::Test {
         ntp_time_ms_ = input_image.ntp_time_ms();
         last_input_width_ = input_image.width();
         last_input_height_ = input_image.height();
+        last_update_rect_ = input_image.update_rect();
         block_encode = block_next_encode_;
         block_next_encode_ = false;
       }
@@ -175,6 +182,7 @@ class ViEEncoderTest : public ::testing::Test {
     int64_t ntp_time_ms_ = 0;
     int last_input_width_ = 0;
     int last_input_height_ = 0;
+    rtc::Optional<VideoFrame::UpdateRect> last_update_rect_;
   };
 
   class TestSink : public ViEEncoder::EncoderSink {
@@ -207,6 +215,11 @@ class ViEEncoderTest : public ::testing::Test {
       return min_transmit_bitrate_bps_;
     }
 
+    VideoFrameTiming last_timing() {
+      rtc::CritScope lock(&crit_);
+      return timing_;
+    }
+
    private:
     Result OnEncodedImage(
         const EncodedImage& encoded_image,
@@ -215,6 +228,7 @@ class ViEEncoderTest : public ::testing::Test {
       rtc::CritScope lock(&crit_);
       EXPECT_TRUE(expect_frames_);
       timestamp_ = encoded_image._timeStamp;
+      timing_ = encoded_image.timing_;
       encoded_frame_event_.Set();
       return Result(Result::OK, timestamp_);
     }
@@ -230,6 +244,7 @@ class ViEEncoderTest : public ::testing::Test {
     TestEncoder* test_encoder_;
     rtc::Event encoded_frame_event_;
     uint32_t timestamp_ = 0;
+    VideoFrameTiming timing_;
     bool expect_frames_ = true;
     int number_of_reconfigurations_ = 0;
     int min_transmit_bitrate_bps_ = 0;
@@ -285,6 +300,48 @@ TEST_F(ViEEncoderTest, DropsFramesWhenRateSetToZero) {
   vie_encoder_->Stop();
 }
 
+TEST_F(ViEEncoderTest, AddsUpdateRectsOfDroppedFrames) {
+  const int kTargetBitrateBps = 100000;
+  const VideoFrame::UpdateRect kNoChange = {0, 0, 0, 0};
+  const VideoFrame::UpdateRect kChange = {8, 16, 32, 64};
+  vie_encoder_->OnBitrateUpdated(kTargetBitrateBps, 0, 0);
+  VideoFrame frame = CreateFrame(1, nullptr);
+  frame.set_update_rect(rtc::Optional<VideoFrame::UpdateRect>(kNoChange));
+  video_source_.IncomingCapturedFrame(frame);
+  sink_.WaitForEncodedFrame(1);
+  ASSERT_TRUE(fake_encoder_.last_update_rect());
+  EXPECT_TRUE(fake_encoder_.last_update_rect()->IsEmpty());
+
+  vie_encoder_->OnBitrateUpdated(0, 0, 0);
+  // Dropped since bitrate is zero.
+  frame = CreateFrame(2, nullptr);
+  frame.set_update_rect(rtc::Optional<VideoFrame::UpdateRect>(kChange));
+  video_source_.IncomingCapturedFrame(frame);
+
+  vie_encoder_->OnBitrateUpdated(kTargetBitrateBps, 0, 0);
+  frame = CreateFrame(3, nullptr);
+  frame.set_update_rect(rtc::Optional<VideoFrame::UpdateRect>(kNoChange));
+  video_source_.IncomingCapturedFrame(frame);
+  sink_.WaitForEncodedFrame(3);
+  ASSERT_TRUE(fake_encoder_.last_update_rect());
+  EXPECT_EQ(8, fake_encoder_.last_update_rect()->offset_x);
+  EXPECT_EQ(16, fake_encoder_.last_update_rect()->offset_y);
+  EXPECT_EQ(32, fake_encoder_.last_update_rect()->width);
+  EXPECT_EQ(64, fake_encoder_.last_update_rect()->height);
+
+  vie_encoder_->OnBitrateUpdated(0, 0, 0);
+  // Dropped, and what it changed is unknown.
+  video_source_.IncomingCapturedFrame(CreateFrame(4, nullptr));
+
+  vie_encoder_->OnBitrateUpdated(kTargetBitrateBps, 0, 0);
+  frame = CreateFrame(5, nullptr);
+  frame.set_update_rect(rtc::Optional<VideoFrame::UpdateRect>(kNoChange));
+  video_source_.IncomingCapturedFrame(frame);
+  sink_.WaitForEncodedFrame(5);
+  EXPECT_FALSE(fake_encoder_.last_update_rect());
+  vie_encoder_->Stop();
+}
+
 TEST_F(ViEEncoderTest, DropsFramesWithSameOrOldNtpTimestamp) {
   const int kTargetBitrateBps = 100000;
   vie_encoder_->OnBitrateUpdated(kTargetBitrateBps, 0, 0);
@@ -496,6 +553,79 @@ TEST_F(ViEEncoderTest,
   vie_encoder_->Stop();
 }
 
+TEST_F(ViEEncoderTest, StatsCountsInputFramesConvertedToI420) {
+  const int kTargetBitrateBps = 100000;
+  vie_encoder_->OnBitrateUpdated(kTargetBitrateBps, 0, 0);
+
+  rtc::scoped_refptr<NV12Buffer> nv12_buffer =
+      NV12Buffer::Create(codec_width_, codec_height_);
+  memset(nv12_buffer->MutableDataY(), 0,
+         nv12_buffer->StrideY() * codec_height_);
+  memset(nv12_buffer->MutableDataUV(), 128,
+         nv12_buffer->StrideUV() * ((codec_height_ + 1) / 2));
+  VideoFrame nv12_frame(nv12_buffer, 99, 99, kVideoRotation_0);
+  nv12_frame.set_ntp_time_ms(1);
+  video_source_.IncomingCapturedFrame(nv12_frame);
+  sink_.WaitForEncodedFrame(1);
+  EXPECT_EQ(1, nv12_buffer->num_i420_conversions());
+
+  // I420 frames are not counted. Once this frame is encoded, the stats of the
+  // previous one are up to date.
+  video_source_.IncomingCapturedFrame(CreateFrame(2, nullptr));
+  sink_.WaitForEncodedFrame(2);
+  EXPECT_EQ(1u, stats_proxy_->GetStats().input_frames_converted_to_i420);
+
+  vie_encoder_->Stop();
+}
+
+class ViEEncoderFrameTimingTest : public ViEEncoderTest {
+ public:
+  ViEEncoderFrameTimingTest()
+      : override_field_trials_("WebRTC-VideoFrameTiming/Enabled/") {}
+
+ private:
+  test::ScopedFieldTrials override_field_trials_;
+};
+
+TEST_F(ViEEncoderTest, EncodedImageHasNoFrameTimingByDefault) {
+  const int kTargetBitrateBps = 100000;
+  vie_encoder_->OnBitrateUpdated(kTargetBitrateBps, 0, 0);
+
+  video_source_.IncomingCapturedFrame(CreateFrame(1, nullptr));
+  sink_.WaitForEncodedFrame(1);
+
+  const VideoFrameTiming timing = sink_.last_timing();
+  EXPECT_EQ(-1, timing.time_ms(VideoFrameTiming::kAdapt));
+  EXPECT_EQ(-1, timing.time_ms(VideoFrameTiming::kEncodeStart));
+  EXPECT_EQ(-1, timing.time_ms(VideoFrameTiming::kEncodeEnd));
+  vie_encoder_->Stop();
+}
+
+TEST_F(ViEEncoderFrameTimingTest, EncodedImageCarriesFrameTiming) {
+  const int kTargetBitrateBps = 100000;
+  vie_encoder_->OnBitrateUpdated(kTargetBitrateBps, 0, 0);
+
+  const int64_t kCaptureTimeMs = rtc::TimeMillis() - 5;
+  VideoFrame frame = CreateFrame(1, nullptr);
+  VideoFrameTiming timing;
+  timing.set_time_ms(VideoFrameTiming::kCapture, kCaptureTimeMs);
+  frame.set_timing(timing);
+  video_source_.IncomingCapturedFrame(frame);
+  sink_.WaitForEncodedFrame(1);
+
+  timing = sink_.last_timing();
+  EXPECT_EQ(kCaptureTimeMs, timing.time_ms(VideoFrameTiming::kCapture));
+  EXPECT_GE(timing.TimeBetween(VideoFrameTiming::kCapture,
+                               VideoFrameTiming::kAdapt), 5);
+  EXPECT_GE(timing.TimeBetween(VideoFrameTiming::kAdapt,
+                               VideoFrameTiming::kEncodeStart), 0);
+  EXPECT_GE(timing.TimeBetween(VideoFrameTiming::kEncodeStart,
+                               VideoFrameTiming::kEncodeEnd), 0);
+  // Packetization happens after the sink has returned.
+  EXPECT_EQ(-1, timing.time_ms(VideoFrameTiming::kPacketize));
+  vie_encoder_->Stop();
+}
+
 TEST_F(ViEEncoderTest, StatsTracksAdaptationStats) {
   const int kTargetBitrateBps = 100000;
   vie_encoder_->OnBitrateUpdated(kTargetBitrateBps, 0, 0);
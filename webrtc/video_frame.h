@@ -11,6 +11,7 @@
 #ifndef WEBRTC_VIDEO_FRAME_H_
 #define WEBRTC_VIDEO_FRAME_H_
 
+#include "webrtc/base/optional.h"
 #include "webrtc/base/scoped_ref_ptr.h"
 #include "webrtc/base/timeutils.h"
 #include "webrtc/common_types.h"
@@ -20,11 +21,69 @@
 
 namespace webrtc {
 
+// The times at which a frame passed the stages of the video pipeline, in
+// milliseconds of the local monotonic clock (same timebase as
+// rtc::TimeMillis()). Stages the frame has not passed are -1. The record
+// travels with the VideoFrame and the EncodedImage of the frame, so that the
+// delay of each stage can be attributed per frame. The send side stages are
+// only stamped, and the stages only reported, with the field trial
+// WebRTC-VideoFrameTiming set to "Enabled".
+class VideoFrameTiming {
+ public:
+  enum Stage {
+    // Send side.
+    kCapture,      // Captured by the source.
+    kAdapt,        // Adapted by the source and delivered to the encoder.
+    kEncodeStart,
+    kEncodeEnd,
+    kPacketize,    // Packetized and handed to the pacer.
+    // Receive side.
+    kFirstPacket,  // First packet of the frame received.
+    kLastPacket,   // Packet with the marker bit received.
+    kComplete,     // All packets of the frame received.
+    kDecodeStart,
+    kDecodeEnd,
+    kRender,       // Delivered to the renderer.
+    kNumStages
+  };
+
+  VideoFrameTiming() {
+    for (int64_t& time_ms : times_ms_)
+      time_ms = -1;
+  }
+
+  int64_t time_ms(Stage stage) const { return times_ms_[stage]; }
+  void set_time_ms(Stage stage, int64_t time_ms) { times_ms_[stage] = time_ms; }
+
+  // Returns the time from stage |from| to stage |to|, or -1 if the frame has
+  // not passed both stages, or if the clocks of the two disagree.
+  int64_t TimeBetween(Stage from, Stage to) const {
+    if (times_ms_[from] < 0 || times_ms_[to] < times_ms_[from])
+      return -1;
+    return times_ms_[to] - times_ms_[from];
+  }
+
+ private:
+  int64_t times_ms_[kNumStages];
+};
+
 // TODO(nisse): This class duplicates cricket::VideoFrame. There's
 // ongoing work to merge the classes. See
 // https://bugs.chromium.org/p/webrtc/issues/detail?id=5682.
 class VideoFrame {
  public:
+  // A rectangle of the frame, in pixels.
+  struct UpdateRect {
+    bool IsEmpty() const { return width == 0 || height == 0; }
+    // Makes this the bounding rectangle of this and |other|.
+    void Union(const UpdateRect& other);
+
+    int offset_x;
+    int offset_y;
+    int width;
+    int height;
+  };
+
   // TODO(nisse): Deprecated. Using the default constructor violates the
   // reasonable assumption that video_frame_buffer() returns a valid buffer.
   VideoFrame();
@@ -109,6 +168,21 @@ class VideoFrame {
     return timestamp_us() / rtc::kNumMicrosecsPerMillisec;
   }
 
+  // Times at which the frame passed the stages of the pipeline.
+  const VideoFrameTiming& timing() const { return timing_; }
+  void set_timing(const VideoFrameTiming& timing) { timing_ = timing; }
+
+  // The part of the frame which changed since the previous frame of the
+  // source, e.g. the bounding rectangle of DesktopFrame::updated_region() of a
+  // screen capturer. An empty rectangle means that nothing changed. Frames
+  // without an update rect may have changed anywhere, which is the default.
+  // Code which drops frames must add their update rects to the next frame it
+  // passes on, or clear its update rect.
+  const rtc::Optional<UpdateRect>& update_rect() const { return update_rect_; }
+  void set_update_rect(const rtc::Optional<UpdateRect>& update_rect) {
+    update_rect_ = update_rect;
+  }
+
   // Return true if and only if video_frame_buffer() is null. Which is possible
   // only if the object was default-constructed.
   // TODO(nisse): Deprecated. Should be deleted in the cricket::VideoFrame and
@@ -125,7 +199,7 @@ class VideoFrame {
   // Return true if the frame is stored in a texture.
   bool is_texture() const {
     return video_frame_buffer() &&
-           video_frame_buffer()->native_handle() != nullptr;
+           video_frame_buffer()->type() == VideoFrameBuffer::Type::kNative;
   }
 
  private:
@@ -135,6 +209,8 @@ class VideoFrame {
   int64_t ntp_time_ms_;
   int64_t timestamp_us_;
   VideoRotation rotation_;
+  VideoFrameTiming timing_;
+  rtc::Optional<UpdateRect> update_rect_;
 };
 
 
@@ -183,6 +259,9 @@ class EncodedImage {
   // indication that all future frames will be constrained with those limits
   // until the application indicates a change again.
   PlayoutDelay playout_delay_ = {-1, -1};
+
+  // Times at which the frame passed the stages of the pipeline.
+  VideoFrameTiming timing_;
 };
 
 }  // namespace webrtc
@@ -56,6 +56,10 @@ class VideoSendStream {
     int avg_encode_time_ms = 0;
     int encode_usage_percent = 0;
     uint32_t frames_encoded = 0;
+    // Number of input frames in a format other than I420 (e.g., NV12) that
+    // had been converted to I420 when they were encoded. A frame is converted
+    // at most once, however many of its consumers need I420.
+    uint32_t input_frames_converted_to_i420 = 0;
     rtc::Optional<uint64_t> qp_sum;
     // Bitrate the encoder is currently configured to use due to bandwidth
     // limitations.
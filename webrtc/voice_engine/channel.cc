@@ -2796,6 +2796,15 @@ uint32_t Channel::EncodeAndSend() {
 
   _audioFrame.id_ = _channelId;
 
+  {
+    rtc::CritScope lock(&encoded_audio_lock_);
+    if (encoded_audio_passthrough_) {
+      // Only already encoded frames are sent; see SendEncodedAudio().
+      _timeStamp += static_cast<uint32_t>(_audioFrame.samples_per_channel_);
+      return 0;
+    }
+  }
+
   // --- Add 10ms of raw (PCM) audio data to the encoder @ 32kHz.
 
   // The ACM resamples internally.
@@ -2832,6 +2841,46 @@ void Channel::SetTransportOverhead(int transport_overhead_per_packet) {
   _rtpRtcpModule->SetTransportOverhead(transport_overhead_per_packet);
 }
 
+void Channel::SetEncodedAudioPassthrough(bool enable) {
+  rtc::CritScope lock(&encoded_audio_lock_);
+  encoded_audio_passthrough_ = enable;
+  first_encoded_audio_timestamp_ = rtc::Optional<uint32_t>();
+}
+
+bool Channel::SendEncodedAudio(FrameType frame_type,
+                               int payload_type,
+                               uint32_t rtp_timestamp,
+                               rtc::ArrayView<const uint8_t> payload,
+                               const rtc::Optional<uint8_t>& audio_level_dbov) {
+  rtc::CritScope lock(&encoded_audio_lock_);
+  if (!encoded_audio_passthrough_)
+    return false;
+  if (!first_encoded_audio_timestamp_)
+    first_encoded_audio_timestamp_ = rtc::Optional<uint32_t>(rtp_timestamp);
+
+  // Frames without a level are sent without one, rather than with the level
+  // of an earlier frame.
+  if (_includeAudioLevelIndication) {
+    if (audio_level_dbov)
+      _rtpRtcpModule->SetAudioLevel(*audio_level_dbov);
+    else
+      _rtpRtcpModule->ClearAudioLevel();
+  }
+
+  // The RTP module adds its own random offset to the timestamp, just like for
+  // the packets from the encoder.
+  if (!_rtpRtcpModule->SendOutgoingData(
+          frame_type, payload_type,
+          rtp_timestamp - *first_encoded_audio_timestamp_, -1, payload.data(),
+          payload.size(), nullptr, nullptr, nullptr)) {
+    _engineStatisticsPtr->SetLastError(
+        VE_RTP_RTCP_MODULE_ERROR, kTraceWarning,
+        "Channel::SendEncodedAudio() failed to send data to RTP/RTCP module");
+    return false;
+  }
+  return true;
+}
+
 int Channel::RegisterExternalMediaProcessing(ProcessingTypes type,
                                              VoEMediaProcess& processObject) {
   WEBRTC_TRACE(kTraceInfo, kTraceVoice, VoEId(_instanceId, _channelId),
@@ -15,6 +15,7 @@
 
 #include "webrtc/api/audio/audio_mixer.h"
 #include "webrtc/api/call/audio_sink.h"
+#include "webrtc/base/array_view.h"
 #include "webrtc/base/criticalsection.h"
 #include "webrtc/base/optional.h"
 #include "webrtc/common_audio/resampler/include/push_resampler.h"
@@ -419,6 +420,18 @@ class Channel
 
   void SetTransportOverhead(int transport_overhead_per_packet);
 
+  // Encoded audio passthrough. When enabled, the captured audio is no longer
+  // encoded and sent; only the frames passed to SendEncodedAudio() are.
+  void SetEncodedAudioPassthrough(bool enable);
+  // Sends an already encoded frame as is. The RTP timestamps are rewritten to
+  // continue from the first forwarded frame. Returns false if passthrough is
+  // not enabled, or if the frame could not be sent.
+  bool SendEncodedAudio(FrameType frame_type,
+                        int payload_type,
+                        uint32_t rtp_timestamp,
+                        rtc::ArrayView<const uint8_t> payload,
+                        const rtc::Optional<uint8_t>& audio_level_dbov);
+
  protected:
   void OnIncomingFractionLoss(int fraction_lost);
 
@@ -548,6 +561,13 @@ class Channel
 
   // TODO(ossu): Remove once GetAudioDecoderFactory() is no longer needed.
   rtc::scoped_refptr<AudioDecoderFactory> decoder_factory_;
+
+  rtc::CriticalSection encoded_audio_lock_;
+  bool encoded_audio_passthrough_ GUARDED_BY(encoded_audio_lock_) = false;
+  // RTP timestamp of the first forwarded frame, which the timestamps of the
+  // sent packets are relative to.
+  rtc::Optional<uint32_t> first_encoded_audio_timestamp_
+      GUARDED_BY(encoded_audio_lock_);
 };
 
 }  // namespace voe
@@ -236,6 +236,22 @@ void ChannelProxy::SetTransportOverhead(int transport_overhead_per_packet) {
   channel()->SetTransportOverhead(transport_overhead_per_packet);
 }
 
+void ChannelProxy::SetEncodedAudioPassthrough(bool enable) {
+  RTC_DCHECK(thread_checker_.CalledOnValidThread());
+  channel()->SetEncodedAudioPassthrough(enable);
+}
+
+bool ChannelProxy::SendEncodedAudio(
+    FrameType frame_type,
+    int payload_type,
+    uint32_t rtp_timestamp,
+    rtc::ArrayView<const uint8_t> payload,
+    const rtc::Optional<uint8_t>& audio_level_dbov) {
+  // May be called on different threads and needs to be handled by the channel.
+  return channel()->SendEncodedAudio(frame_type, payload_type, rtp_timestamp,
+                                     payload, audio_level_dbov);
+}
+
 Channel* ChannelProxy::channel() const {
   RTC_DCHECK(channel_owner_.channel());
   return channel_owner_.channel();
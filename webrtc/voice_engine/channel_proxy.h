@@ -12,9 +12,12 @@
 #define WEBRTC_VOICE_ENGINE_CHANNEL_PROXY_H_
 
 #include "webrtc/api/audio/audio_mixer.h"
+#include "webrtc/base/array_view.h"
 #include "webrtc/base/constructormagic.h"
+#include "webrtc/base/optional.h"
 #include "webrtc/base/race_checker.h"
 #include "webrtc/base/thread_checker.h"
+#include "webrtc/common_types.h"
 #include "webrtc/voice_engine/channel_manager.h"
 #include "webrtc/voice_engine/include/voe_rtp_rtcp.h"
 
@@ -96,6 +99,13 @@ class ChannelProxy {
 
   virtual void SetTransportOverhead(int transport_overhead_per_packet);
 
+  virtual void SetEncodedAudioPassthrough(bool enable);
+  virtual bool SendEncodedAudio(FrameType frame_type,
+                                int payload_type,
+                                uint32_t rtp_timestamp,
+                                rtc::ArrayView<const uint8_t> payload,
+                                const rtc::Optional<uint8_t>& audio_level_dbov);
+
  private:
   Channel* channel() const;
 
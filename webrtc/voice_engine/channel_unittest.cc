@@ -8,8 +8,174 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <memory>
+#include <vector>
+
+#include "webrtc/modules/rtp_rtcp/source/rtp_header_extensions.h"
+#include "webrtc/modules/rtp_rtcp/source/rtp_utility.h"
 #include "webrtc/test/gtest.h"
 #include "webrtc/voice_engine/channel.h"
+#include "webrtc/voice_engine/channel_proxy.h"
+#include "webrtc/voice_engine/include/voe_codec.h"
+#include "webrtc/voice_engine/voice_engine_fixture.h"
+#include "webrtc/voice_engine/voice_engine_impl.h"
 
 // Empty test just to get coverage metrics.
 TEST(ChannelTest, EmptyTestToGetCodeCoverage) {}
+
+namespace webrtc {
+namespace voe {
+namespace {
+
+const CodecInst kPcmuCodec = {0, "PCMU", 8000, 160, 1, 64000};
+const int kCnPayloadType = 13;
+const int kAudioLevelExtensionId = 1;
+const size_t kNumFrames = 10;
+
+struct SentPacket {
+  RTPHeader header;
+  std::vector<uint8_t> payload;
+};
+
+}  // namespace
+
+class ChannelEncodedAudioTest : public VoiceEngineFixture {
+ protected:
+  ChannelEncodedAudioTest() : channel_id_(-1), codec_(nullptr) {}
+
+  void SetUp() override {
+    EXPECT_EQ(0, base_->Init(&adm_, nullptr));
+    channel_id_ = base_->CreateChannel();
+    ASSERT_NE(-1, channel_id_);
+    EXPECT_EQ(0, network_->RegisterExternalTransport(channel_id_, transport_));
+    codec_ = VoECodec::GetInterface(voe_);
+    EXPECT_EQ(0, codec_->SetSendCodec(channel_id_, kPcmuCodec));
+    channel_proxy_ =
+        static_cast<VoiceEngineImpl*>(voe_)->GetChannelProxy(channel_id_);
+  }
+
+  void TearDown() override {
+    channel_proxy_.reset();
+    if (channel_id_ != -1)
+      EXPECT_EQ(0, base_->DeleteChannel(channel_id_));
+    if (codec_)
+      codec_->Release();
+  }
+
+  int channel_id_;
+  VoECodec* codec_;
+  std::unique_ptr<ChannelProxy> channel_proxy_;
+};
+
+// Sends already encoded frames through a channel in passthrough mode, and
+// verifies that the payloads leave the channel bit-exact, with the relative
+// timestamps of the source stream.
+TEST_F(ChannelEncodedAudioTest, ForwardsPayloadsUnchanged) {
+  using testing::_;
+  using testing::Invoke;
+  using testing::Return;
+
+  channel_proxy_->SetEncodedAudioPassthrough(true);
+
+  std::vector<SentPacket> sent_packets;
+  EXPECT_CALL(transport_, SendRtp(_, _, _))
+      .WillRepeatedly(Invoke([&sent_packets](const uint8_t* data, size_t len,
+                                             const PacketOptions& options) {
+        SentPacket packet;
+        RtpUtility::RtpHeaderParser parser(data, len);
+        EXPECT_TRUE(parser.Parse(&packet.header));
+        packet.payload.assign(data + packet.header.headerLength,
+                              data + len - packet.header.paddingLength);
+        sent_packets.push_back(packet);
+        return true;
+      }));
+  EXPECT_CALL(transport_, SendRtcp(_, _)).WillRepeatedly(Return(true));
+  EXPECT_EQ(0, base_->StartSend(channel_id_));
+
+  const uint32_t kFirstTimestamp = 0xfffffe00;  // Wraps around.
+  std::vector<std::vector<uint8_t>> payloads;
+  for (size_t i = 0; i < kNumFrames; ++i) {
+    std::vector<uint8_t> payload(kPcmuCodec.pacsize);
+    for (size_t j = 0; j < payload.size(); ++j)
+      payload[j] = static_cast<uint8_t>(i * 31 + j * 7);
+    EXPECT_TRUE(channel_proxy_->SendEncodedAudio(
+        kAudioFrameSpeech, kPcmuCodec.pltype,
+        kFirstTimestamp + i * kPcmuCodec.pacsize, payload,
+        rtc::Optional<uint8_t>()));
+    payloads.push_back(payload);
+  }
+
+  ASSERT_EQ(kNumFrames, sent_packets.size());
+  for (size_t i = 0; i < kNumFrames; ++i) {
+    EXPECT_EQ(kPcmuCodec.pltype, sent_packets[i].header.payloadType);
+    EXPECT_EQ(payloads[i], sent_packets[i].payload);
+    EXPECT_EQ(static_cast<uint16_t>(sent_packets[0].header.sequenceNumber + i),
+              sent_packets[i].header.sequenceNumber);
+    EXPECT_EQ(sent_packets[0].header.timestamp + i * kPcmuCodec.pacsize,
+              sent_packets[i].header.timestamp);
+  }
+
+  // Encoded frames are refused once the passthrough is turned off.
+  channel_proxy_->SetEncodedAudioPassthrough(false);
+  EXPECT_FALSE(channel_proxy_->SendEncodedAudio(
+      kAudioFrameSpeech, kPcmuCodec.pltype, kFirstTimestamp, payloads[0],
+      rtc::Optional<uint8_t>()));
+  EXPECT_EQ(kNumFrames, sent_packets.size());
+
+  EXPECT_EQ(0, base_->StopSend(channel_id_));
+}
+
+// The frame type and the audio level of each forwarded frame are kept. A frame
+// without an audio level is sent without the extension.
+TEST_F(ChannelEncodedAudioTest, ForwardsFrameTypeAndAudioLevel) {
+  using testing::_;
+  using testing::Invoke;
+  using testing::Return;
+
+  channel_proxy_->SetSendAudioLevelIndicationStatus(true,
+                                                    kAudioLevelExtensionId);
+  channel_proxy_->SetEncodedAudioPassthrough(true);
+
+  RtpHeaderExtensionMap extensions;
+  extensions.Register<webrtc::AudioLevel>(kAudioLevelExtensionId);
+  std::vector<RTPHeader> sent_headers;
+  EXPECT_CALL(transport_, SendRtp(_, _, _))
+      .WillRepeatedly(Invoke([&sent_headers, &extensions](
+                                 const uint8_t* data, size_t len,
+                                 const PacketOptions& options) {
+        RTPHeader header;
+        RtpUtility::RtpHeaderParser parser(data, len);
+        EXPECT_TRUE(parser.Parse(&header, &extensions));
+        sent_headers.push_back(header);
+        return true;
+      }));
+  EXPECT_CALL(transport_, SendRtcp(_, _)).WillRepeatedly(Return(true));
+  EXPECT_EQ(0, base_->StartSend(channel_id_));
+
+  const std::vector<uint8_t> payload(kPcmuCodec.pacsize, 0xff);
+  EXPECT_TRUE(channel_proxy_->SendEncodedAudio(
+      kAudioFrameSpeech, kPcmuCodec.pltype, 0, payload,
+      rtc::Optional<uint8_t>(30)));
+  EXPECT_TRUE(channel_proxy_->SendEncodedAudio(
+      kAudioFrameSpeech, kPcmuCodec.pltype, kPcmuCodec.pacsize, payload,
+      rtc::Optional<uint8_t>()));
+  EXPECT_TRUE(channel_proxy_->SendEncodedAudio(
+      kAudioFrameCN, kCnPayloadType, 2 * kPcmuCodec.pacsize,
+      rtc::ArrayView<const uint8_t>(payload.data(), 1),
+      rtc::Optional<uint8_t>(90)));
+
+  ASSERT_EQ(3u, sent_headers.size());
+  EXPECT_TRUE(sent_headers[0].extension.hasAudioLevel);
+  EXPECT_TRUE(sent_headers[0].extension.voiceActivity);
+  EXPECT_EQ(30, sent_headers[0].extension.audioLevel);
+  EXPECT_FALSE(sent_headers[1].extension.hasAudioLevel);
+  EXPECT_EQ(kCnPayloadType, sent_headers[2].payloadType);
+  EXPECT_TRUE(sent_headers[2].extension.hasAudioLevel);
+  EXPECT_FALSE(sent_headers[2].extension.voiceActivity);
+  EXPECT_EQ(90, sent_headers[2].extension.audioLevel);
+
+  EXPECT_EQ(0, base_->StopSend(channel_id_));
+}
+
+}  // namespace voe
+}  // namespace webrtc
@@ -67,6 +67,7 @@
           'dependencies': [
             'rtc_event_log_api',
             'rtc_event_log_proto',
+            'rtc_event_log_rtp_packet_batch',
             '<(webrtc_root)/api/api.gyp:call_api',
           ],
           'defines': [
@@ -95,6 +96,20 @@
           },
           'includes': ['build/protoc.gypi'],
         },
+        {
+          'target_name': 'rtc_event_log_rtp_packet_batch',
+          'type': 'static_library',
+          'sources': [
+            'logging/rtc_event_log/rtp_packet_batch.cc',
+            'logging/rtc_event_log/rtp_packet_batch.h',
+          ],
+          'dependencies': [
+            'rtc_event_log_proto',
+          ],
+          'export_dependent_settings': [
+            'rtc_event_log_proto',
+          ],
+        },
         {
           'target_name': 'rtc_event_log_parser',
           'type': 'static_library',
@@ -104,6 +119,8 @@
           ],
           'dependencies': [
             'rtc_event_log_proto',
+            'rtc_event_log_rtp_packet_batch',
+            '<(webrtc_root)/base/base.gyp:rtc_base_approved',
           ],
           'export_dependent_settings': [
             'rtc_event_log_proto',